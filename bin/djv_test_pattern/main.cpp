@@ -134,20 +134,17 @@ void Application::run()
 void Application::tick()
 {
     CmdLine::Application::tick();
+    auto& writeQueue = _write->getVideoQueue();
+    if (_images.size() && writeQueue.getCount() < writeQueue.getMax())
     {
-        std::lock_guard<std::mutex> writeLock(_write->getMutex());
-        auto& writeQueue = _write->getVideoQueue();
-        if (_images.size() && writeQueue.getCount() < writeQueue.getMax())
-        {
-            auto image = _images.front();
-            _images.pop_front();
-            writeQueue.addFrame(AV::IO::VideoFrame(_frame, image));
-            ++_frame;
-        }
-        if (_frame >= *_frameCount)
-        {
-            writeQueue.setFinished(true);
-        }
+        auto image = _images.front();
+        _images.pop_front();
+        writeQueue.addFrame(AV::IO::VideoFrame(_frame, image));
+        ++_frame;
+    }
+    if (_frame >= *_frameCount)
+    {
+        writeQueue.setFinished(true);
     }
     if (_frame < *_frameCount && !_images.size())
     {
@@ -9,9 +9,18 @@ in vec2 Texture;
 out vec4 FragColor;
 
 uniform sampler2D textureSampler;
+uniform bool      yuv = false;
+uniform mat4      yuvMatrix;
+uniform sampler2D textureSamplerCb;
+uniform sampler2D textureSamplerCr;
 
 void main()
 {
     vec4 t = texture(textureSampler, Texture);
+    if (yuv)
+    {
+        t = yuvMatrix * vec4(t.r, texture(textureSamplerCb, Texture).r, texture(textureSamplerCr, Texture).r, 1.0);
+        t = vec4(clamp(t.rgb, 0.0, 1.0), 1.0);
+    }
     FragColor = t;
 }
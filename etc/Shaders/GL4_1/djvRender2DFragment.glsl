@@ -40,6 +40,10 @@ uniform bool        exposureEnabled      = false;
 uniform float       softClip             = 0.0;
 uniform int         imageChannelsDisplay = 0;
 uniform sampler2D   textureSampler;
+uniform bool        yuv                  = false;
+uniform mat4        yuvMatrix;
+uniform sampler2D   textureSamplerCb;
+uniform sampler2D   textureSamplerCr;
 
 // djv::AV::Image::Channels
 #define IMAGE_CHANNELS_L    1
@@ -65,6 +69,12 @@ uniform sampler2D   textureSampler;
 
 //$colorSpaceFunctions
 
+vec4 yuvFunc(float y, float cb, float cr, mat4 m)
+{
+    vec4 tmp = m * vec4(y, cb, cr, 1.0);
+    return vec4(clamp(tmp.rgb, 0.0, 1.0), 1.0);
+}
+
 vec4 colorMatrixFunc(vec4 value, mat4 color)
 {
     vec4 tmp;
@@ -169,8 +179,12 @@ void main()
     }
     else if (COLOR_MODE_COLOR_AND_TEXTURE == colorMode)
     {
-        // Sample the texture.
+        // Sample the texture. YUV images have a texture for each plane.
         vec4 t = texture(textureSampler, Texture);
+        if (yuv)
+        {
+            t = yuvFunc(t.r, texture(textureSamplerCb, Texture).r, texture(textureSamplerCr, Texture).r, yuvMatrix);
+        }
 
         // Swizzle the channels for the given image format.
         if (IMAGE_CHANNELS_L == imageChannels)
@@ -7,6 +7,7 @@
 #include <djvAV/IOSystem.h>
 #include <djvAV/Speed.h>
 #include <djvAV/ThumbnailSystem.h>
+#include <djvAV/WaveformSystem.h>
 
 #include <djvOCIO/OCIOSystem.h>
 
@@ -30,6 +31,7 @@ namespace djv
             std::shared_ptr<Observer::ValueSubject<Time::Units> > timeUnits;
             std::shared_ptr<Observer::ValueSubject<FPS> > defaultSpeed;
             std::shared_ptr<ThumbnailSystem> thumbnailSystem;
+            std::shared_ptr<WaveformSystem> waveformSystem;
         };
 
         void AVSystem::_init(const std::shared_ptr<System::Context>& context)
@@ -41,17 +43,30 @@ namespace djv
             p.defaultSpeed = Observer::ValueSubject<FPS>::create(getDefaultSpeed());
 
             auto audioSystem = Audio::AudioSystem::create(context);
-            auto glfwSystem = GL::GLFW::GLFWSystem::create(context);
+            std::shared_ptr<GL::GLFW::GLFWSystem> glfwSystem;
+            try
+            {
+                glfwSystem = GL::GLFW::GLFWSystem::create(context);
+            }
+            catch (const std::exception& e)
+            {
+                _log(e.what(), System::LogLevel::Warning);
+            }
             auto shaderSystem = GL::ShaderSystem::create(context);
             auto ocioSystem = OCIO::OCIOSystem::create(context);
             auto ioSystem = IO::IOSystem::create(context);
             p.thumbnailSystem = ThumbnailSystem::create(context);
+            p.waveformSystem = WaveformSystem::create(context);
             addDependency(audioSystem);
-            addDependency(glfwSystem);
+            if (glfwSystem)
+            {
+                addDependency(glfwSystem);
+            }
             addDependency(shaderSystem);
             addDependency(ocioSystem);
             addDependency(ioSystem);
             addDependency(p.thumbnailSystem);
+            addDependency(p.waveformSystem);
 
             _logInitTime();
         }
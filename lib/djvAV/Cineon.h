@@ -223,13 +223,24 @@ namespace djv
                     const std::shared_ptr<System::ResourceSystem>&,
                     const std::shared_ptr<System::LogSystem>&);
 
+                //! Read the image data. When the proxy scale is greater than
+                //! one every nth scanline is read and every nth pixel is kept.
+                //! When the region of interest is valid only the pixels in the
+                //! region are read.
                 static std::shared_ptr<Image::Data> readImage(
                     const IO::Info&,
-                    const std::shared_ptr<System::File::IO>&);
+                    const std::shared_ptr<System::File::IO>&,
+                    const std::shared_ptr<Image::DataPool>& = nullptr,
+                    size_t proxyScale = 1,
+                    const Math::BBox2i& roi = Math::BBox2i());
+
+                bool hasROI() const override;
 
             protected:
                 IO::Info _readInfo(const std::string&) override;
                 std::shared_ptr<Image::Data> _readImage(const std::string&) override;
+                std::shared_ptr<Image::Data> _readProxy(const std::string&, size_t layer, size_t proxyScale) override;
+                std::shared_ptr<Image::Data> _readROI(const std::string&, size_t layer, const Math::BBox2i&) override;
 
             private:
                 IO::Info _open(const std::string&, const std::shared_ptr<System::File::IO>&);
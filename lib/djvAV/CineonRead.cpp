@@ -42,11 +42,11 @@ namespace djv
                 
             std::shared_ptr<Image::Data> Read::readImage(
                 const IO::Info& info,
-                const std::shared_ptr<System::File::IO>& io)
+                const std::shared_ptr<System::File::IO>& io,
+                const std::shared_ptr<Image::DataPool>& dataPool,
+                size_t proxyScale,
+                const Math::BBox2i& roi)
             {
-#if defined(DJV_MMAP)
-                auto out = Image::Data::create(info.video[0].info, io);
-#else // DJV_MMAP
                 auto infoTmp = info;
                 bool convertEndian = false;
                 if (infoTmp.video[0].layout.endian != Memory::getEndian())
@@ -54,8 +54,63 @@ namespace djv
                     convertEndian = true;
                     infoTmp.video[0].layout.endian = Memory::getEndian();
                 }
-                auto out = Image::Data::create(infoTmp.video[0]);
-                io->read(out->getData(), out->getDataByteCount());
+                std::shared_ptr<Image::Data> out;
+#if defined(DJV_MMAP)
+                // Data that does not need an endian conversion is used
+                // directly from the memory-mapped file.
+                if (!convertEndian && proxyScale <= 1 && !roi.isValid())
+                {
+                    out = Image::Data::create(infoTmp.video[0], io);
+                }
+#endif // DJV_MMAP
+                if (!out && proxyScale > 1)
+                {
+                    // Read every nth scanline and keep every nth pixel.
+                    const auto& imageInfo = infoTmp.video[0];
+                    auto proxyInfo = imageInfo;
+                    proxyInfo.size = IO::getProxySize(imageInfo.size, proxyScale);
+                    out = Image::Data::create(proxyInfo, dataPool);
+                    const size_t pixelByteCount = imageInfo.getPixelByteCount();
+                    const size_t scanlineByteCount = imageInfo.getScanlineByteCount();
+                    const size_t pos = io->getPos();
+                    std::vector<uint8_t> scanline(scanlineByteCount);
+                    for (uint16_t y = 0; y < proxyInfo.size.h; ++y)
+                    {
+                        io->setPos(pos + y * proxyScale * scanlineByteCount);
+                        io->read(scanline.data(), scanlineByteCount);
+                        const uint8_t* inP = scanline.data();
+                        uint8_t* outP = out->getData(y);
+                        for (uint16_t x = 0; x < proxyInfo.size.w; ++x)
+                        {
+                            memcpy(outP, inP, pixelByteCount);
+                            inP += pixelByteCount * proxyScale;
+                            outP += pixelByteCount;
+                        }
+                    }
+                }
+                else if (!out && roi.isValid())
+                {
+                    // Read the part of each scanline that is in the region.
+                    const auto& imageInfo = infoTmp.video[0];
+                    auto roiInfo = imageInfo;
+                    roiInfo.size = Image::Size(roi.w(), roi.h());
+                    out = Image::Data::create(roiInfo, dataPool);
+                    out->setROI(roi);
+                    const Math::BBox2i dataROI = IO::mirrorROI(roi, imageInfo);
+                    const size_t pixelByteCount = imageInfo.getPixelByteCount();
+                    const size_t scanlineByteCount = imageInfo.getScanlineByteCount();
+                    const size_t pos = io->getPos();
+                    for (uint16_t y = 0; y < roiInfo.size.h; ++y)
+                    {
+                        io->setPos(pos + (dataROI.min.y + y) * scanlineByteCount + dataROI.min.x * pixelByteCount);
+                        io->read(out->getData(y), roiInfo.size.w * pixelByteCount);
+                    }
+                }
+                else if (!out)
+                {
+                    out = Image::Data::create(infoTmp.video[0], dataPool);
+                    io->read(out->getData(), out->getDataByteCount());
+                }
                 if (convertEndian)
                 {
                     const size_t dataByteCount = out->getDataByteCount();
@@ -67,11 +122,15 @@ namespace djv
                         default: break;                            
                     }
                 }
-#endif // DJV_MMAP
                 out->setTags(infoTmp.tags);
                 return out;
             }
 
+            bool Read::hasROI() const
+            {
+                return true;
+            }
+
             IO::Info Read::_readInfo(const std::string& fileName)
             {
                 auto io = System::File::IO::create();
@@ -82,7 +141,25 @@ namespace djv
             {
                 auto io = System::File::IO::create();
                 const auto info = _open(fileName, io);
-                auto out = readImage(info, io);
+                auto out = readImage(info, io, _options.dataPool);
+                out->setPluginName(pluginName);
+                return out;
+            }
+
+            std::shared_ptr<Image::Data> Read::_readProxy(const std::string& fileName, size_t, size_t proxyScale)
+            {
+                auto io = System::File::IO::create();
+                const auto info = _open(fileName, io);
+                auto out = readImage(info, io, _options.dataPool, proxyScale);
+                out->setPluginName(pluginName);
+                return out;
+            }
+
+            std::shared_ptr<Image::Data> Read::_readROI(const std::string& fileName, size_t, const Math::BBox2i& roi)
+            {
+                auto io = System::File::IO::create();
+                const auto info = _open(fileName, io);
+                auto out = readImage(info, io, _options.dataPool, 1, roi);
                 out->setPluginName(pluginName);
                 return out;
             }
@@ -335,9 +335,13 @@ namespace djv
                     const std::shared_ptr<System::ResourceSystem>&,
                     const std::shared_ptr<System::LogSystem>&);
 
+                bool hasROI() const override;
+
             protected:
                 IO::Info _readInfo(const std::string&) override;
                 std::shared_ptr<Image::Data> _readImage(const std::string&) override;
+                std::shared_ptr<Image::Data> _readProxy(const std::string&, size_t layer, size_t proxyScale) override;
+                std::shared_ptr<Image::Data> _readROI(const std::string&, size_t layer, const Math::BBox2i&) override;
 
             private:
                 IO::Info _open(const std::string&, const std::shared_ptr<System::File::IO>&);
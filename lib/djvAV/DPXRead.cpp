@@ -45,6 +45,11 @@ namespace djv
                 return out;
             }
 
+            bool Read::hasROI() const
+            {
+                return true;
+            }
+
             IO::Info Read::_readInfo(const std::string& fileName)
             {
                 auto io = System::File::IO::create();
@@ -55,7 +60,25 @@ namespace djv
             {
                 auto io = System::File::IO::create();
                 const auto info = _open(fileName, io);
-                auto out = Cineon::Read::readImage(info, io);
+                auto out = Cineon::Read::readImage(info, io, _options.dataPool);
+                out->setPluginName(pluginName);
+                return out;
+            }
+
+            std::shared_ptr<Image::Data> Read::_readProxy(const std::string& fileName, size_t, size_t proxyScale)
+            {
+                auto io = System::File::IO::create();
+                const auto info = _open(fileName, io);
+                auto out = Cineon::Read::readImage(info, io, _options.dataPool, proxyScale);
+                out->setPluginName(pluginName);
+                return out;
+            }
+
+            std::shared_ptr<Image::Data> Read::_readROI(const std::string& fileName, size_t, const Math::BBox2i& roi)
+            {
+                auto io = System::File::IO::create();
+                const auto info = _open(fileName, io);
+                auto out = Cineon::Read::readImage(info, io, _options.dataPool, 1, roi);
                 out->setPluginName(pluginName);
                 return out;
             }
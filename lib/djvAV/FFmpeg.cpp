@@ -15,8 +15,11 @@
 extern "C"
 {
 #include <libavformat/avformat.h>
+#include <libavutil/pixdesc.h>
 }
 
+#include <array>
+
 using namespace djv::Core;
 
 namespace djv
@@ -25,6 +28,125 @@ namespace djv
     {
         namespace FFmpeg
         {
+            DJV_ENUM_HELPERS_IMPLEMENTATION(VideoOutput);
+
+            AVPixelFormat getOutputFormat(AVPixelFormat value, VideoOutput videoOutput)
+            {
+                AVPixelFormat out = AV_PIX_FMT_RGBA;
+                switch (videoOutput)
+                {
+                case VideoOutput::Native:
+                    switch (value)
+                    {
+                    case AV_PIX_FMT_YUV420P:
+                    case AV_PIX_FMT_YUV422P:
+                    case AV_PIX_FMT_YUV444P:
+                    case AV_PIX_FMT_YUVJ420P:
+                    case AV_PIX_FMT_YUVJ422P:
+                    case AV_PIX_FMT_YUVJ444P:
+                    case AV_PIX_FMT_YUV420P10:
+                    case AV_PIX_FMT_YUV422P10:
+                    case AV_PIX_FMT_YUV444P10:
+                    case AV_PIX_FMT_YUV420P16:
+                    case AV_PIX_FMT_YUV422P16:
+                    case AV_PIX_FMT_YUV444P16:
+                        out = value;
+                        break;
+                    // The 12-bit formats are shifted to 16-bit.
+                    case AV_PIX_FMT_YUV420P12: out = AV_PIX_FMT_YUV420P16; break;
+                    case AV_PIX_FMT_YUV422P12: out = AV_PIX_FMT_YUV422P16; break;
+                    case AV_PIX_FMT_YUV444P12: out = AV_PIX_FMT_YUV444P16; break;
+                    default:
+                    {
+                        const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(value);
+                        if (desc && desc->comp[0].depth > 8)
+                        {
+                            out = AV_PIX_FMT_RGBA64;
+                        }
+                        break;
+                    }
+                    }
+                    break;
+                case VideoOutput::RGB_U16:
+                    out = AV_PIX_FMT_RGB48;
+                    break;
+                default: break;
+                }
+                return out;
+            }
+
+            Image::Type toImageType(AVPixelFormat value)
+            {
+                Image::Type out = Image::Type::None;
+                switch (value)
+                {
+                case AV_PIX_FMT_RGBA:      out = Image::Type::RGBA_U8; break;
+                case AV_PIX_FMT_RGB48:     out = Image::Type::RGB_U16; break;
+                case AV_PIX_FMT_RGBA64:    out = Image::Type::RGBA_U16; break;
+                case AV_PIX_FMT_YUV420P:
+                case AV_PIX_FMT_YUVJ420P:  out = Image::Type::YUV_420P_U8; break;
+                case AV_PIX_FMT_YUV422P:
+                case AV_PIX_FMT_YUVJ422P:  out = Image::Type::YUV_422P_U8; break;
+                case AV_PIX_FMT_YUV444P:
+                case AV_PIX_FMT_YUVJ444P:  out = Image::Type::YUV_444P_U8; break;
+                case AV_PIX_FMT_YUV420P10: out = Image::Type::YUV_420P_U10; break;
+                case AV_PIX_FMT_YUV422P10: out = Image::Type::YUV_422P_U10; break;
+                case AV_PIX_FMT_YUV444P10: out = Image::Type::YUV_444P_U10; break;
+                case AV_PIX_FMT_YUV420P16: out = Image::Type::YUV_420P_U16; break;
+                case AV_PIX_FMT_YUV422P16: out = Image::Type::YUV_422P_U16; break;
+                case AV_PIX_FMT_YUV444P16: out = Image::Type::YUV_444P_U16; break;
+                default: break;
+                }
+                return out;
+            }
+
+            Image::YUVCoefficients toYUVCoefficients(AVColorSpace value, uint16_t height)
+            {
+                Image::YUVCoefficients out = Image::YUVCoefficients::BT709;
+                switch (value)
+                {
+                case AVCOL_SPC_BT470BG:
+                case AVCOL_SPC_SMPTE170M:
+                    out = Image::YUVCoefficients::BT601;
+                    break;
+                case AVCOL_SPC_BT2020_NCL:
+                case AVCOL_SPC_BT2020_CL:
+                    out = Image::YUVCoefficients::BT2020;
+                    break;
+                case AVCOL_SPC_BT709:
+                    break;
+                default:
+                    // Guess from the size when the color space is not
+                    // specified, the same as FFmpeg.
+                    if (height < 720)
+                    {
+                        out = Image::YUVCoefficients::BT601;
+                    }
+                    break;
+                }
+                return out;
+            }
+
+            Image::YUVRange toYUVRange(AVPixelFormat format, AVColorRange range)
+            {
+                Image::YUVRange out = Image::YUVRange::Video;
+                switch (format)
+                {
+                case AV_PIX_FMT_YUVJ420P:
+                case AV_PIX_FMT_YUVJ422P:
+                case AV_PIX_FMT_YUVJ444P:
+                    out = Image::YUVRange::Full;
+                    break;
+                default:
+                    if (AVCOL_RANGE_JPEG == range)
+                    {
+                        out = Image::YUVRange::Full;
+                    }
+                    break;
+                }
+                return out;
+            }
+
             Audio::Type toAudioType(AVSampleFormat value)
             {
                 Audio::Type out = Audio::Type::None;
@@ -210,9 +332,194 @@ namespace djv
                 return std::string(buf);
             }
 
+            GOPIndex::GOPIndex()
+            {}
+
+            size_t GOPIndex::getCount() const
+            {
+                return _keyFrames.size();
+            }
+
+            bool GOPIndex::isComplete() const
+            {
+                return _complete;
+            }
+
+            bool GOPIndex::getKeyFrame(Math::Frame::Number frame, Math::Frame::Number& keyFrame, int64_t& pts) const
+            {
+                // Find the last key frame at or before the frame. If the index
+                // is still being built the frame must also be before a known
+                // key frame, otherwise a later GOP may not be indexed yet.
+                auto i = _keyFrames.upper_bound(frame);
+                if (i == _keyFrames.begin() || (i == _keyFrames.end() && !_complete))
+                    return false;
+                --i;
+                keyFrame = i->first;
+                pts = i->second;
+                return true;
+            }
+
+            void GOPIndex::add(Math::Frame::Number frame, int64_t pts)
+            {
+                _keyFrames[frame] = pts;
+            }
+
+            void GOPIndex::setComplete(bool value)
+            {
+                _complete = value;
+            }
+
+            PacketQueue::PacketQueue(size_t max) :
+                _max(max)
+            {}
+
+            PacketQueue::~PacketQueue()
+            {
+                _clear();
+            }
+
+            size_t PacketQueue::getMax() const
+            {
+                return _max;
+            }
+
+            size_t PacketQueue::getCount() const
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _packets.size();
+            }
+
+            uint64_t PacketQueue::getGeneration() const
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _generation;
+            }
+
+            bool PacketQueue::waitForDemux(bool& seek, int& stream, int64_t& t, uint64_t& generation)
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cv.wait(
+                    lock,
+                    [this]
+                    {
+                        return _stopped || _seek || (!_end && _packets.size() < _max);
+                    });
+                seek = _seek;
+                stream = _seekStream;
+                t = _seekTime;
+                generation = _generation;
+                _seek = false;
+                return !_stopped;
+            }
+
+            void PacketQueue::push(AVPacket* packet, uint64_t generation)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (generation == _generation && !_stopped)
+                    {
+                        _packets.push_back(packet);
+                        packet = nullptr;
+                    }
+                }
+                if (packet)
+                {
+                    av_packet_free(&packet);
+                }
+                _cv.notify_all();
+            }
+
+            void PacketQueue::setEnd(int error, uint64_t generation)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (generation == _generation)
+                    {
+                        _end = error < 0 ? error : AVERROR_EOF;
+                    }
+                }
+                _cv.notify_all();
+            }
+
+            void PacketQueue::seek(int stream, int64_t t)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _clear();
+                    ++_generation;
+                    _seek = true;
+                    _seekStream = stream;
+                    _seekTime = t;
+                    _end = 0;
+                }
+                _cv.notify_all();
+            }
+
+            int PacketQueue::pop(AVPacket** packet)
+            {
+                int out = 0;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return _stopped || _packets.size() || _end;
+                        });
+                    if (_stopped)
+                    {
+                        out = AVERROR_EXIT;
+                    }
+                    else if (_packets.size())
+                    {
+                        *packet = _packets.front();
+                        _packets.pop_front();
+                    }
+                    else
+                    {
+                        out = _end;
+                    }
+                }
+                _cv.notify_all();
+                return out;
+            }
+
+            void PacketQueue::stop()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stopped = true;
+                }
+                _cv.notify_all();
+            }
+
+            void PacketQueue::_clear()
+            {
+                for (auto& i : _packets)
+                {
+                    av_packet_free(&i);
+                }
+                _packets.clear();
+            }
+
+            bool ReadStats::operator == (const ReadStats& other) const
+            {
+                return
+                    demuxPackets == other.demuxPackets &&
+                    demuxTime == other.demuxTime &&
+                    packetQueueCount == other.packetQueueCount &&
+                    decodeFrames == other.decodeFrames &&
+                    decodeTime == other.decodeTime &&
+                    convertFrames == other.convertFrames &&
+                    convertTime == other.convertTime &&
+                    convertPending == other.convertPending;
+            }
+
             bool Options::operator == (const Options& other) const
             {
-                return threadCount == other.threadCount;
+                return
+                    threadCount == other.threadCount &&
+                    videoOutput == other.videoOutput;
             }
                 
             namespace
@@ -283,11 +590,22 @@ namespace djv
         } // namespace FFmpeg
     } // namespace AV
 
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::FFmpeg,
+        VideoOutput,
+        DJV_TEXT("ffmpeg_video_output_native"),
+        DJV_TEXT("ffmpeg_video_output_rgba_u8"),
+        DJV_TEXT("ffmpeg_video_output_rgb_u16"));
+
     rapidjson::Value toJSON(const AV::FFmpeg::Options& value, rapidjson::Document::AllocatorType& allocator)
     {
         rapidjson::Value out(rapidjson::kObjectType);
         {
             out.AddMember("ThreadCount", toJSON(value.threadCount, allocator), allocator);
+            std::stringstream ss;
+            ss << value.videoOutput;
+            const std::string& s = ss.str();
+            out.AddMember("VideoOutput", rapidjson::Value(s.c_str(), s.size(), allocator), allocator);
         }
         return out;
     }
@@ -302,6 +620,11 @@ namespace djv
                 {
                     fromJSON(i.value, out.threadCount);
                 }
+                else if (0 == strcmp("VideoOutput", i.name.GetString()) && i.value.IsString())
+                {
+                    std::stringstream ss(i.value.GetString());
+                    ss >> out.videoOutput;
+                }
             }
         }
         else
@@ -16,6 +16,11 @@ extern "C"
 
 } // extern "C"
 
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+
 namespace djv
 {
     namespace AV
@@ -49,6 +54,33 @@ namespace djv
                 ".webp"
             };
                 
+            //! Video output.
+            enum class VideoOutput
+            {
+                Native,     //!< Planar YUV when it is supported, otherwise RGBA
+                RGBA_U8,
+                RGB_U16,
+
+                Count,
+                First = Native
+            };
+            DJV_ENUM_HELPERS(VideoOutput);
+
+            //! Get the pixel format that decoded video is converted to. When
+            //! this is the same as the input format the planes are copied
+            //! without conversion.
+            AVPixelFormat getOutputFormat(AVPixelFormat, VideoOutput);
+
+            //! Convert from FFmpeg. This returns Image::Type::None for pixel
+            //! formats that are not output formats.
+            Image::Type toImageType(AVPixelFormat);
+
+            //! Convert from FFmpeg.
+            Image::YUVCoefficients toYUVCoefficients(AVColorSpace, uint16_t height);
+
+            //! Convert from FFmpeg.
+            Image::YUVRange toYUVRange(AVPixelFormat, AVColorRange);
+
             //! Convert from FFmpeg.
             Audio::Type toAudioType(AVSampleFormat);
                 
@@ -65,15 +97,150 @@ namespace djv
             //! Get error string.
             std::string getErrorString(int);
 
+            //! Key frame index for a video stream.
+            //!
+            //! The index is built in the background from the packet key frame
+            //! flags so it may not be complete. Frames after the last key
+            //! frame are only covered once the index is complete.
+            class GOPIndex
+            {
+            public:
+                GOPIndex();
+
+                //! \name Information
+                ///@{
+
+                size_t getCount() const;
+                bool isComplete() const;
+
+                ///@}
+
+                //! \name Key Frames
+                ///@{
+
+                //! Get the key frame that starts the GOP containing the given
+                //! frame, and its time stamp in the stream time base. Returns
+                //! false if the frame is not covered by the index.
+                bool getKeyFrame(Math::Frame::Number, Math::Frame::Number&, int64_t&) const;
+
+                void add(Math::Frame::Number, int64_t);
+                void setComplete(bool);
+
+                ///@}
+
+            private:
+                std::map<Math::Frame::Number, int64_t> _keyFrames;
+                bool _complete = false;
+            };
+
+            //! Bounded packet queue between the demuxer and the decoder.
+            //!
+            //! The demux thread reads packets and adds them to the queue
+            //! until it is full. Seeks are requested by the decoder and run
+            //! by the demux thread, each seek starts a new generation so
+            //! packets that were read before the seek are discarded.
+            class PacketQueue
+            {
+                DJV_NON_COPYABLE(PacketQueue);
+
+            public:
+                explicit PacketQueue(size_t max);
+                ~PacketQueue();
+
+                //! \name Information
+                ///@{
+
+                size_t getMax() const;
+                size_t getCount() const;
+                uint64_t getGeneration() const;
+
+                ///@}
+
+                //! \name Demuxer
+                ///@{
+
+                //! Wait until a packet can be added or a seek is requested.
+                //! A requested seek is returned in the arguments and removed
+                //! from the queue. Returns false when the queue is stopped.
+                bool waitForDemux(bool& seek, int& stream, int64_t& t, uint64_t& generation);
+
+                //! Add a packet, the queue takes ownership. Packets from an
+                //! old generation are freed.
+                void push(AVPacket*, uint64_t generation);
+
+                //! Mark the end of the packets. The error is returned by pop()
+                //! once the queued packets have been read.
+                void setEnd(int error, uint64_t generation);
+
+                ///@}
+
+                //! \name Decoder
+                ///@{
+
+                //! Request a seek, the queued packets are freed.
+                void seek(int stream, int64_t t);
+
+                //! Get the next packet, the caller takes ownership. This blocks
+                //! until a packet is available and returns zero, or returns
+                //! the end error, or AVERROR_EXIT when the queue is stopped.
+                int pop(AVPacket**);
+
+                void stop();
+
+                ///@}
+
+            private:
+                void _clear();
+
+                const size_t _max = 0;
+                std::deque<AVPacket*> _packets;
+                uint64_t _generation = 0;
+                bool _seek = false;
+                int _seekStream = -1;
+                int64_t _seekTime = 0;
+                int _end = 0;
+                bool _stopped = false;
+                mutable std::mutex _mutex;
+                std::condition_variable _cv;
+            };
+
+            //! FFmpeg reader statistics. The times are the total time spent in
+            //! each stage, in seconds.
+            struct ReadStats
+            {
+                size_t demuxPackets     = 0;
+                double demuxTime        = 0.0;
+                size_t packetQueueCount = 0;
+                size_t decodeFrames     = 0;
+                double decodeTime       = 0.0;
+                size_t convertFrames    = 0;
+                double convertTime      = 0.0;
+                size_t convertPending   = 0;
+
+                bool operator == (const ReadStats&) const;
+            };
+
             //! FFmpeg I/O optioms.
             struct Options
             {
-                size_t threadCount = 4;
+                //! The number of threads used by the decoder, and the maximum
+                //! number of frames converted at the same time.
+                size_t      threadCount = 4;
+                VideoOutput videoOutput = VideoOutput::Native;
                     
                 bool operator == (const Options&) const;
             };
 
             //! FFmpeg reader.
+            //!
+            //! Decoded frames are added to the frame cache, scrubbing is
+            //! served from the cache before the decoder is moved. Reverse
+            //! playback decodes a GOP forward and then serves the frames in
+            //! reverse order.
+            //!
+            //! Packets are read by a separate demux thread, and decoded frames
+            //! are converted on the thread pool. Codecs that support it use
+            //! frame threading.
             class Read : public IO::IRead
             {
                 DJV_NON_COPYABLE(Read);
@@ -105,14 +272,36 @@ namespace djv
 
                 void seek(int64_t, IO::Direction) override;
 
+                bool hasCache() const override;
+
+                //! Get the statistics for each stage of the reader. The statistics
+                //! are also logged periodically while they are changing.
+                ReadStats getStats() const;
+
             private:
+                typedef std::map<Math::Frame::Number, std::shared_ptr<Image::Data> > GOPFrames;
+
+                void _seek(Math::Frame::Number, bool cacheEnabled);
+                void _readForward(bool playback, bool cacheEnabled);
+                void _readReverse(bool cacheEnabled);
+                void _decodeGOP(Math::Frame::Number, bool cacheEnabled);
+                bool _getFrame(Math::Frame::Number, bool cacheEnabled, std::shared_ptr<Image::Data>&) const;
+                void _indexGOPs();
+                void _demux();
+
                 struct DecodeVideo
                 {
                     AVPacket*           packet       = nullptr;
                     Math::Frame::Number seek         = -1;
                     bool                cacheEnabled = false;
+
+                    //! When this is set the frames up to and including the
+                    //! end frame are added here instead of the video queue.
+                    GOPFrames*          gopFrames    = nullptr;
+                    Math::Frame::Number gopEnd       = -1;
                 };
                 int _decodeVideo(const DecodeVideo&, Math::Frame::Number&);
+                void _finishConvert(bool wait, bool queue);
 
                 struct DecodeAudio
                 {
@@ -149,6 +338,8 @@ namespace djv
         } // namespace FFmpeg
     } // namespace AV
 
+    DJV_ENUM_SERIALIZE_HELPERS(AV::FFmpeg::VideoOutput);
+
     rapidjson::Value toJSON(const AV::FFmpeg::Options&, rapidjson::Document::AllocatorType&);
 
     //! Throws:
@@ -10,6 +10,7 @@
 #include <djvSystem/TextSystem.h>
 
 #include <djvCore/StringFormat.h>
+#include <djvCore/ThreadPool.h>
 
 extern "C"
 {
@@ -28,6 +29,149 @@ namespace djv
     {
         namespace FFmpeg
         {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const double infoTimeout = 0.5;
+
+                //! The interval at which the reader statistics are logged while
+                //! they are changing.
+                const double statsTimeout = 5.0;
+
+                //! The minimum number of frames kept from a GOP for reverse
+                //! playback when the cache is smaller.
+                const size_t gopFramesMin = 30;
+
+                //! The maximum number of packets read ahead of the decoder.
+                const size_t packetQueueMax = 64;
+
+                //! Software scaler contexts are not thread safe so each
+                //! conversion takes a context from the pool.
+                class SwsPool
+                {
+                public:
+                    SwsPool(int width, int height, AVPixelFormat inFormat, AVPixelFormat outFormat) :
+                        _width(width),
+                        _height(height),
+                        _inFormat(inFormat),
+                        _outFormat(outFormat)
+                    {}
+
+                    ~SwsPool()
+                    {
+                        for (auto i : _contexts)
+                        {
+                            sws_freeContext(i);
+                        }
+                    }
+
+                    SwsContext* acquire()
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            if (_contexts.size())
+                            {
+                                SwsContext* out = _contexts.back();
+                                _contexts.pop_back();
+                                return out;
+                            }
+                        }
+                        return sws_getContext(
+                            _width,
+                            _height,
+                            _inFormat,
+                            _width,
+                            _height,
+                            _outFormat,
+                            SWS_BILINEAR,
+                            0,
+                            0,
+                            0);
+                    }
+
+                    void release(SwsContext* value)
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _contexts.push_back(value);
+                    }
+
+                private:
+                    int _width = 0;
+                    int _height = 0;
+                    AVPixelFormat _inFormat = AV_PIX_FMT_NONE;
+                    AVPixelFormat _outFormat = AV_PIX_FMT_NONE;
+                    std::vector<SwsContext*> _contexts;
+                    std::mutex _mutex;
+                };
+
+                std::shared_ptr<Image::Data> convertFrame(
+                    const AVFrame*                          avFrame,
+                    const Image::Info&                      info,
+                    AVPixelFormat                           outFormat,
+                    const std::shared_ptr<SwsPool>&         swsPool,
+                    const std::shared_ptr<Image::DataPool>& dataPool)
+                {
+                    auto out = Image::Data::create(info, dataPool);
+                    out->setPluginName(pluginName);
+                    if (swsPool)
+                    {
+                        uint8_t* data[4];
+                        int linesize[4];
+                        av_image_fill_arrays(
+                            data,
+                            linesize,
+                            out->getData(),
+                            outFormat,
+                            out->getWidth(),
+                            out->getHeight(),
+                            1);
+                        SwsContext* swsContext = swsPool->acquire();
+                        sws_scale(
+                            swsContext,
+                            (uint8_t const* const*)avFrame->data,
+                            avFrame->linesize,
+                            0,
+                            info.size.h,
+                            data,
+                            linesize);
+                        swsPool->release(swsContext);
+                    }
+                    else
+                    {
+                        for (uint8_t plane = 0; plane < info.getPlaneCount(); ++plane)
+                        {
+                            const Image::Size size = info.getPlaneSize(plane);
+                            av_image_copy_plane(
+                                out->getPlaneData(plane),
+                                static_cast<int>(info.getPlaneScanlineByteCount(plane)),
+                                avFrame->data[plane],
+                                avFrame->linesize[plane],
+                                static_cast<int>(size.w * info.getPixelByteCount()),
+                                size.h);
+                        }
+                    }
+                    return out;
+                }
+
+                double getSeconds(const std::chrono::steady_clock::time_point& t)
+                {
+                    const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - t;
+                    return delta.count();
+                }
+
+                std::string getStatsText(const ReadStats& stats)
+                {
+                    std::stringstream ss;
+                    ss << "demux " << stats.demuxPackets << " packets " << stats.demuxTime << "s, ";
+                    ss << "packet queue " << stats.packetQueueCount << ", ";
+                    ss << "decode " << stats.decodeFrames << " frames " << stats.decodeTime << "s, ";
+                    ss << "convert " << stats.convertFrames << " frames " << stats.convertTime << "s, ";
+                    ss << "convert pending " << stats.convertPending;
+                    return ss.str();
+                }
+
+            } // namespace
+
             struct Read::Private
             {
                 Options options;
@@ -38,6 +182,48 @@ namespace djv
                 IO::Direction direction = IO::Direction::Forward;
                 std::thread thread;
                 std::atomic<bool> running;
+                std::atomic<bool> hasCache;
+                std::chrono::steady_clock::time_point infoTimer;
+                std::chrono::steady_clock::time_point statsTimer;
+                ReadStats statsLogged;
+
+                // The next frame for reverse playback.
+                Math::Frame::Number frame = Math::Frame::invalid;
+
+                // The queue generations, frames are added with the generation
+                // of the last seek so they are skipped after a new seek.
+                uint64_t videoGeneration = 0;
+                uint64_t audioGeneration = 0;
+
+                // The pending decoder seek. The decoder is only moved when
+                // frames that are not cached are needed.
+                Math::Frame::Number decodeSeek = Math::Frame::invalid;
+                Math::Frame::Number decodeVideoSeek = Math::Frame::invalid;
+
+                GOPIndex gopIndex;
+                std::mutex gopMutex;
+                std::thread gopThread;
+                GOPFrames gopFrames;
+
+                PacketQueue packetQueue{ packetQueueMax };
+                std::thread demuxThread;
+
+                // Decoded frames waiting for conversion on the thread pool,
+                // in decode order.
+                struct PendingFrame
+                {
+                    Math::Frame::Number frame     = Math::Frame::invalid;
+                    bool                keep      = false;
+                    bool                cache     = false;
+                    GOPFrames*          gopFrames = nullptr;
+                    std::future<std::shared_ptr<Image::Data> > image;
+                };
+                std::shared_ptr<Thread::WorkQueue> convertQueue;
+                std::deque<PendingFrame> pendingFrames;
+                std::shared_ptr<SwsPool> swsPool;
+
+                ReadStats stats;
+                mutable std::mutex statsMutex;
 
                 AVFormatContext* avFormatContext = nullptr;
                 int avVideoStream = -1;
@@ -45,8 +231,7 @@ namespace djv
                 std::map<int, AVCodecParameters*> avCodecParameters;
                 std::map<int, AVCodecContext*> avCodecContext;
                 AVFrame* avFrame = nullptr;
-                AVFrame* avFrameRgb = nullptr;
-                SwsContext* swsContext = nullptr;
+                AVPixelFormat avOutputFormat = AV_PIX_FMT_NONE;
             };
 
             void Read::_init(
@@ -61,6 +246,9 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 p.options = options;
                 p.running = true;
+                p.hasCache = false;
+                auto threadPool = readOptions.threadPool ? readOptions.threadPool : Thread::ThreadPool::create();
+                p.convertQueue = threadPool->createQueue(std::max(p.options.threadCount, static_cast<size_t>(1)));
                 p.thread = std::thread(
                     [this]
                 {
@@ -149,8 +337,15 @@ namespace djv
                                     arg(_fileInfo.getFileName()).
                                     arg(FFmpeg::getErrorString(r)));
                             }
+                            // Use frame threading when the codec supports
+                            // it, inter-frame codecs only use a few threads
+                            // with slice threading.
                             p.avCodecContext[p.avVideoStream]->thread_count = p.options.threadCount;
                             p.avCodecContext[p.avVideoStream]->thread_type = FF_THREAD_SLICE;
+                            if (avVideoCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS)
+                            {
+                                p.avCodecContext[p.avVideoStream]->thread_type |= FF_THREAD_FRAME;
+                            }
                             r = avcodec_open2(p.avCodecContext[p.avVideoStream], avVideoCodec, 0);
                             if (r < 0)
                             {
@@ -159,28 +354,32 @@ namespace djv
                                     arg(FFmpeg::getErrorString(r)));
                             }
 
-                            // Initialize the buffers.
-                            p.avFrameRgb = av_frame_alloc();
-
-                            // Initialize the software scaler.
-                            p.swsContext = sws_getContext(
-                                p.avCodecParameters[p.avVideoStream]->width,
-                                p.avCodecParameters[p.avVideoStream]->height,
-                                static_cast<AVPixelFormat>(p.avCodecParameters[p.avVideoStream]->format),
-                                p.avCodecParameters[p.avVideoStream]->width,
-                                p.avCodecParameters[p.avVideoStream]->height,
-                                AV_PIX_FMT_RGBA,
-                                SWS_BILINEAR,
-                                0,
-                                0,
-                                0);
+                            // Initialize the software scaler. Planar YUV data
+                            // is copied without conversion when the output
+                            // format is the same as the decoded format.
+                            const AVPixelFormat avFormat = static_cast<AVPixelFormat>(p.avCodecParameters[p.avVideoStream]->format);
+                            p.avOutputFormat = FFmpeg::getOutputFormat(avFormat, p.options.videoOutput);
+                            if (p.avOutputFormat != avFormat)
+                            {
+                                p.swsPool = std::make_shared<SwsPool>(
+                                    p.avCodecParameters[p.avVideoStream]->width,
+                                    p.avCodecParameters[p.avVideoStream]->height,
+                                    avFormat,
+                                    p.avOutputFormat);
+                            }
 
                             // Get information.
                             Image::Info imageInfo;
                             imageInfo.size.w = p.avCodecParameters[p.avVideoStream]->width;
                             imageInfo.size.h = p.avCodecParameters[p.avVideoStream]->height;
-                            imageInfo.type = Image::Type::RGBA_U8;
+                            imageInfo.type = FFmpeg::toImageType(p.avOutputFormat);
                             imageInfo.codec = avVideoCodec->long_name;
+                            imageInfo.yuvCoefficients = FFmpeg::toYUVCoefficients(
+                                p.avCodecParameters[p.avVideoStream]->color_space,
+                                imageInfo.size.h);
+                            imageInfo.yuvRange = FFmpeg::toYUVRange(
+                                avFormat,
+                                p.avCodecParameters[p.avVideoStream]->color_range);
                             if (avVideoStream->duration != AV_NOPTS_VALUE)
                             {
                                 AVRational r;
@@ -295,67 +494,83 @@ namespace djv
 
                         p.infoPromise.set_value(p.info);
 
+                        // When only the audio is read the video packets are
+                        // discarded by the demuxer, so they are neither
+                        // decoded nor converted.
+                        if (_options.audioOnly && p.avVideoStream != -1 && p.avAudioStream != -1)
+                        {
+                            p.avFormatContext->streams[p.avVideoStream]->discard = AVDISCARD_ALL;
+                            p.avVideoStream = -1;
+                        }
+
+                        p.hasCache = p.avVideoStream != -1 && p.info.videoSequence.getFrameCount() > 1;
+
+                        // Start reading packets.
+                        p.demuxThread = std::thread(
+                            [this]
+                            {
+                                _demux();
+                            });
+
+                        // Build the GOP index in the background.
+                        if (p.avVideoStream != -1)
+                        {
+                            p.gopThread = std::thread(
+                                [this]
+                                {
+                                    _indexGOPs();
+                                });
+                        }
+
+                        p.infoTimer = std::chrono::steady_clock::now();
+                        p.statsTimer = p.infoTimer;
                         while (p.running)
                         {
-                            //! \todo Implement me!
-                            /*bool cacheEnabled = false;
+                            // Update the options.
+                            bool playback = false;
+                            IO::InOutPoints inOutPoints;
+                            bool cacheEnabled = false;
                             size_t cacheMaxByteCount = 0;
                             {
                                 std::lock_guard<std::mutex> lock(_mutex);
+                                playback = _playback;
+                                inOutPoints = _inOutPoints;
                                 cacheEnabled = _cacheEnabled;
                                 cacheMaxByteCount = _cacheMaxByteCount;
-                                _cachedFrames = _getCachedFrames(_cache);
                             }
                             if (!cacheEnabled)
                             {
                                 _cache.clear();
                             }
-                            if (info.video.size() && _options.layer < info.video.size())
+                            _finishConvert(false, true);
+                            if (p.info.video.size())
                             {
-                                const size_t dataByteCount = info.video[_options.layer].info.getDataByteCount();
-                                _cache.setMax(cacheMaxByteCount / dataByteCount);
+                                const size_t dataByteCount = p.info.video[0].getDataByteCount();
+                                _cache.setMax(dataByteCount ? (cacheMaxByteCount / dataByteCount) : 0);
+                                _cache.setSequenceSize(p.info.videoSequence.getFrameCount());
+                                _cache.setInOutPoints(inOutPoints);
                             }
                             else
                             {
                                 _cache.setMax(0);
-                            }*/
+                            }
 
+                            // Check to see if there is work to be done. Audio
+                            // is only decoded during playback so scrubbing does
+                            // not need to move the decoder.
                             bool read = false;
                             int64_t seek = Math::Frame::invalid;
                             {
-                                //const std::vector<Math::Frame::Number> cachedFrames = _cache.getKeys();
                                 std::unique_lock<std::mutex> lock(_mutex);
                                 if (p.queueCV.wait_for(
                                     lock,
                                     System::getTimerDuration(System::TimerValue::Fast),
-                                    [this, sequenceSize]
-                                    //[this, sequenceSize, cacheEnabled, &cachedFrames]
+                                    [this, playback]
                                 {
                                     DJV_PRIVATE_PTR();
                                     const bool video = p.avVideoStream != -1 && (_videoQueue.isFinished() ? false : (_videoQueue.getCount() < _videoQueue.getMax()));
-                                    const bool audio = p.avAudioStream != -1 && (_audioQueue.isFinished() ? false : (_audioQueue.getCount() < _audioQueue.getMax()));
-
-                                    /*bool cache = false;
-                                    if (cacheEnabled && !_videoQueue.isFinished() && !_audioQueue.isFinished())
-                                    {
-                                        const size_t cacheMax = _cache.getMax();
-                                        cache |= _cache.getSize() < cacheMax;
-                                        if (_videoQueue.getFrameCount())
-                                        {
-                                            const auto& frame = _videoQueue.getFrame();
-                                            for (const auto& i : cachedFrames)
-                                            {
-                                                if (i < frame.frame || i > frame.frame + cacheMax)
-                                                {
-                                                    cache = true;
-                                                    break;
-                                                }
-                                            }
-                                        }
-                                    }*/
-                                        
+                                    const bool audio = playback && p.avAudioStream != -1 && (_audioQueue.isFinished() ? false : (_audioQueue.getCount() < _audioQueue.getMax()));
                                     return video || audio || p.seek != Math::Frame::invalid || p.direction != _direction;
-                                    //return video || audio || p.seek != Math::Frame::invalid || p.direction != _direction || cache;
                                 }))
                                 {
                                     read = true;
@@ -363,151 +578,37 @@ namespace djv
                                     {
                                         p.direction = _direction;
                                         _videoQueue.setFinished(false);
-                                        _videoQueue.clearFrames();
+                                        p.videoGeneration = _videoQueue.clearFrames();
                                         _audioQueue.setFinished(false);
-                                        _audioQueue.clearFrames();
+                                        p.audioGeneration = _audioQueue.clearFrames();
                                     }
                                     if (p.seek != Math::Frame::invalid)
                                     {
                                         seek = p.seek;
                                         p.seek = Math::Frame::invalid;
                                         _videoQueue.setFinished(false);
-                                        _videoQueue.clearFrames();
+                                        p.videoGeneration = _videoQueue.clearFrames();
                                         _audioQueue.setFinished(false);
-                                        _audioQueue.clearFrames();
+                                        p.audioGeneration = _audioQueue.clearFrames();
                                     }
                                 }
                             }
-                            AVPacket packet;
                             try
                             {
                                 if (seek != Math::Frame::invalid)
                                 {
-                                    int64_t t = 0;
-                                    int stream = -1;
-                                    if (p.avVideoStream != -1)
-                                    {
-                                        stream = p.avVideoStream;
-                                        AVRational r;
-                                        r.num = p.info.videoSpeed.getDen();
-                                        r.den = p.info.videoSpeed.getNum();
-                                        t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avVideoStream]->time_base);
-                                        //t = av_rescale_q(seek, r, av_get_time_base_q());
-                                    }
-                                    else if (p.avAudioStream != -1)
-                                    {
-                                        stream = p.avAudioStream;
-                                        AVRational r;
-                                        r.num = 1;
-                                        r.den = p.info.audio.sampleRate;
-                                        t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avAudioStream]->time_base);
-                                        //t = av_rescale_q(seek, r, av_get_time_base_q());
-                                    }
-                                    if (p.avVideoStream != -1)
-                                    {
-                                        avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                    }
-                                    if (p.avAudioStream != -1)
-                                    {
-                                        avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
-                                    }
-                                    if (av_seek_frame(
-                                        p.avFormatContext,
-                                        stream,
-                                        t,
-                                        AVSEEK_FLAG_BACKWARD) < 0)
-                                    {
-                                        throw std::exception();
-                                    }
-                                    Math::Frame::Number videoFrame = Math::Frame::invalid;
-                                    Math::Frame::Number audioFrame = Math::Frame::invalid;
-                                    while (videoFrame < seek - 1 || audioFrame < seek - 1)
-                                    {
-                                        if (av_read_frame(p.avFormatContext, &packet) < 0)
-                                        {
-                                            if (p.avVideoStream != -1)
-                                            {
-                                                DecodeVideo dv;
-                                                //dv.cacheEnabled = cacheEnabled;
-                                                dv.seek         = seek;
-                                                _decodeVideo(dv, videoFrame);
-                                                avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                            }
-                                            if (p.avAudioStream != -1)
-                                            {
-                                                DecodeAudio da;
-                                                da.seek = seek;
-                                                _decodeAudio(da, audioFrame);
-                                                avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
-                                            }
-                                            throw std::exception();
-                                        }
-                                        if (p.avVideoStream == packet.stream_index)
-                                        {
-                                            DecodeVideo dv;
-                                            dv.packet       = &packet;
-                                            dv.seek         = seek;
-                                            //dv.cacheEnabled = cacheEnabled;
-                                            if (_decodeVideo(dv, videoFrame) < 0)
-                                            {
-                                                throw std::exception();
-                                            }
-                                        }
-                                        else if (p.avAudioStream == packet.stream_index)
-                                        {
-                                            DecodeAudio da;
-                                            da.packet = &packet;
-                                            da.seek   = seek;
-                                            if (_decodeAudio(da, audioFrame) < 0)
-                                            {
-                                                throw std::exception();
-                                            }
-                                        }
-                                        av_packet_unref(&packet);
-                                    }
+                                    _seek(seek, cacheEnabled);
                                 }
                                 if (read)
                                 {
-                                    Math::Frame::Number videoFrame = Math::Frame::invalid;
-                                    Math::Frame::Number audioFrame = Math::Frame::invalid;
-                                    int r = av_read_frame(p.avFormatContext, &packet);
-                                    if (r < 0)
-                                    {
-                                        if (p.avVideoStream != -1)
-                                        {
-                                            DecodeVideo dv;
-                                            //dv.cacheEnabled = cacheEnabled;
-                                            _decodeVideo(dv, videoFrame);
-                                            avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                        }
-                                        if (p.avAudioStream != -1)
-                                        {
-                                            DecodeAudio da;
-                                            _decodeAudio(da, audioFrame);
-                                            avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
-                                        }
-                                        throw std::exception();
-                                    }
-                                    if (p.avVideoStream == packet.stream_index)
+                                    if (p.avVideoStream != -1 && IO::Direction::Reverse == p.direction)
                                     {
-                                        DecodeVideo dv;
-                                        dv.packet       = &packet;
-                                        //dv.cacheEnabled = cacheEnabled;
-                                        if (_decodeVideo(dv, videoFrame) < 0)
-                                        {
-                                            throw std::exception();
-                                        }
+                                        _readReverse(cacheEnabled);
                                     }
-                                    else if (p.avAudioStream == packet.stream_index)
+                                    else
                                     {
-                                        DecodeAudio da;
-                                        da.packet = &packet;
-                                        if (_decodeAudio(da, audioFrame) < 0)
-                                        {
-                                            throw std::exception();
-                                        }
+                                        _readForward(playback, cacheEnabled);
                                     }
-                                    av_packet_unref(&packet);
                                 }
                             }
                             catch (const std::exception&)
@@ -517,11 +618,52 @@ namespace djv
                                     ss << _fileInfo << ": finished";
                                     _logSystem->log("djv::AV::IO::FFmpeg::Read", ss.str());
                                 }*/
-                                av_packet_unref(&packet);
+                                _finishConvert(true, true);
+                                _videoQueue.setFinished(true);
+                                _audioQueue.setFinished(true);
+                            }
+
+                            // Move the cache window with the video queue.
+                            if (cacheEnabled)
+                            {
+                                const Math::Frame::Number frame = _videoQueue.getFrameNumber();
+                                _cache.setDirection(p.direction);
+                                if (frame != Math::Frame::invalid)
+                                {
+                                    _cache.setCurrentFrame(frame);
+                                }
+                            }
+
+                            // Update information.
+                            const auto now = std::chrono::steady_clock::now();
+                            std::chrono::duration<double> delta = now - p.infoTimer;
+                            if (delta.count() > infoTimeout)
+                            {
+                                p.infoTimer = now;
+                                size_t cacheByteCount = _cache.getTotalByteCount();
+                                auto cacheSequence = _cache.getSequence();
+                                auto cachedFrames = _cache.getFrames();
                                 {
                                     std::lock_guard<std::mutex> lock(_mutex);
-                                    _videoQueue.setFinished(true);
-                                    _audioQueue.setFinished(true);
+                                    _cacheByteCount = cacheByteCount;
+                                    _cacheSequence = cacheSequence;
+                                    _cachedFrames = std::move(cachedFrames);
+                                }
+                            }
+
+                            // Log the statistics so the slowest stage can be
+                            // seen during playback.
+                            delta = now - p.statsTimer;
+                            if (p.avVideoStream != -1 && delta.count() > statsTimeout)
+                            {
+                                p.statsTimer = now;
+                                const ReadStats stats = getStats();
+                                if (!(stats == p.statsLogged))
+                                {
+                                    p.statsLogged = stats;
+                                    std::stringstream ss;
+                                    ss << _fileInfo << ": " << getStatsText(stats);
+                                    _logSystem->log("djv::AV::IO::FFmpeg::Read", ss.str());
                                 }
                             }
                         }
@@ -531,13 +673,24 @@ namespace djv
                         p.infoPromise.set_value(IO::Info());
                         _logSystem->log("djvAV::IO::FFmpeg::Read", e.what(), System::LogLevel::Error);
                     }
-                    if (p.swsContext)
+                    p.running = false;
+                    p.packetQueue.stop();
+                    if (p.demuxThread.joinable())
                     {
-                        sws_freeContext(p.swsContext);
+                        p.demuxThread.join();
                     }
-                    if (p.avFrameRgb)
+                    if (p.gopThread.joinable())
                     {
-                        av_frame_free(&p.avFrameRgb);
+                        p.gopThread.join();
+                    }
+                    p.convertQueue->finish();
+                    p.pendingFrames.clear();
+                    p.swsPool.reset();
+                    if (p.avVideoStream != -1)
+                    {
+                        std::stringstream ss;
+                        ss << _fileInfo << ": " << getStatsText(getStats());
+                        _logSystem->log("djv::AV::IO::FFmpeg::Read", ss.str());
                     }
                     if (p.avFrame)
                     {
@@ -567,6 +720,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.running = false;
+                p.packetQueue.stop();
                 if (p.thread.joinable())
                 {
 					//! \todo How do we safely detach the thread here so we don't block?
@@ -597,25 +751,455 @@ namespace djv
                 return _p->infoPromise.get_future();
             }
 
-            void Read::seek(Math::Frame::Number value, IO::Direction)
+            void Read::seek(Math::Frame::Number value, IO::Direction direction)
             {
                 DJV_PRIVATE_PTR();
+                _videoQueue.clearFrames();
+                _audioQueue.clearFrames();
                 {
                     std::lock_guard<std::mutex> lock(_mutex);
-                    _videoQueue.clearFrames();
-                    _audioQueue.clearFrames();
                     p.seek = value;
+                    _direction = direction;
                 }
                 p.queueCV.notify_one();
             }
 
+            bool Read::hasCache() const
+            {
+                return _p->hasCache;
+            }
+
+            ReadStats Read::getStats() const
+            {
+                DJV_PRIVATE_PTR();
+                ReadStats out;
+                {
+                    std::lock_guard<std::mutex> lock(p.statsMutex);
+                    out = p.stats;
+                }
+                out.packetQueueCount = p.packetQueue.getCount();
+                return out;
+            }
+
+            void Read::_seek(Math::Frame::Number value, bool cacheEnabled)
+            {
+                DJV_PRIVATE_PTR();
+
+                // Frames that are still being converted are only added to
+                // the cache.
+                _finishConvert(true, false);
+
+                p.frame = value;
+                p.decodeSeek = value;
+                p.decodeVideoSeek = value;
+                if (cacheEnabled)
+                {
+                    _cache.setDirection(p.direction);
+                    _cache.setCurrentFrame(value);
+                }
+
+                // Use a cached frame if there is one, the decoder is then
+                // started from the next frame.
+                std::shared_ptr<Image::Data> image;
+                if (p.avVideoStream != -1 &&
+                    IO::Direction::Forward == p.direction &&
+                    _getFrame(value, cacheEnabled, image))
+                {
+                    _videoQueue.addFrameWait(IO::VideoFrame(value, image), p.videoGeneration, p.running);
+                    p.decodeVideoSeek = value + 1;
+                }
+            }
+
+            void Read::_readForward(bool playback, bool cacheEnabled)
+            {
+                DJV_PRIVATE_PTR();
+                const bool video = p.avVideoStream != -1 && !_videoQueue.isFinished() && _videoQueue.getCount() < _videoQueue.getMax();
+                const bool audio = playback && p.avAudioStream != -1 && !_audioQueue.isFinished() && _audioQueue.getCount() < _audioQueue.getMax();
+                if (!video && !audio)
+                {
+                    return;
+                }
+                AVPacket* packet = nullptr;
+                if (p.decodeSeek != Math::Frame::invalid)
+                {
+                    const Math::Frame::Number seek = p.decodeSeek;
+                    const Math::Frame::Number videoSeek = p.decodeVideoSeek;
+                    p.decodeSeek = Math::Frame::invalid;
+                    p.decodeVideoSeek = Math::Frame::invalid;
+                    p.gopFrames.clear();
+
+                    int64_t t = 0;
+                    int stream = -1;
+                    if (p.avVideoStream != -1)
+                    {
+                        stream = p.avVideoStream;
+                        AVRational r;
+                        r.num = p.info.videoSpeed.getDen();
+                        r.den = p.info.videoSpeed.getNum();
+                        t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avVideoStream]->time_base);
+                        //t = av_rescale_q(seek, r, av_get_time_base_q());
+                    }
+                    else if (p.avAudioStream != -1)
+                    {
+                        stream = p.avAudioStream;
+                        AVRational r;
+                        r.num = 1;
+                        r.den = p.info.audio.sampleRate;
+                        t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avAudioStream]->time_base);
+                        //t = av_rescale_q(seek, r, av_get_time_base_q());
+                    }
+                    if (p.avVideoStream != -1)
+                    {
+                        avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                    }
+                    if (p.avAudioStream != -1)
+                    {
+                        avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
+                    }
+                    p.packetQueue.seek(stream, t);
+                    Math::Frame::Number videoFrame = Math::Frame::invalid;
+                    Math::Frame::Number audioFrame = Math::Frame::invalid;
+                    while ((p.avVideoStream != -1 && videoFrame < videoSeek - 1) ||
+                        (p.avAudioStream != -1 && audioFrame < seek - 1))
+                    {
+                        if (p.packetQueue.pop(&packet) < 0)
+                        {
+                            if (p.avVideoStream != -1)
+                            {
+                                DecodeVideo dv;
+                                dv.seek         = videoSeek;
+                                dv.cacheEnabled = cacheEnabled;
+                                _decodeVideo(dv, videoFrame);
+                                avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                            }
+                            if (p.avAudioStream != -1)
+                            {
+                                DecodeAudio da;
+                                da.seek = seek;
+                                _decodeAudio(da, audioFrame);
+                                avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
+                            }
+                            throw std::exception();
+                        }
+                        if (p.avVideoStream == packet->stream_index)
+                        {
+                            DecodeVideo dv;
+                            dv.packet       = packet;
+                            dv.seek         = videoSeek;
+                            dv.cacheEnabled = cacheEnabled;
+                            if (_decodeVideo(dv, videoFrame) < 0)
+                            {
+                                av_packet_free(&packet);
+                                throw std::exception();
+                            }
+                        }
+                        else if (p.avAudioStream == packet->stream_index)
+                        {
+                            DecodeAudio da;
+                            da.packet = packet;
+                            da.seek   = seek;
+                            if (_decodeAudio(da, audioFrame) < 0)
+                            {
+                                av_packet_free(&packet);
+                                throw std::exception();
+                            }
+                        }
+                        av_packet_free(&packet);
+                    }
+                }
+                else
+                {
+                    Math::Frame::Number videoFrame = Math::Frame::invalid;
+                    Math::Frame::Number audioFrame = Math::Frame::invalid;
+                    int r = p.packetQueue.pop(&packet);
+                    if (r < 0)
+                    {
+                        if (p.avVideoStream != -1)
+                        {
+                            DecodeVideo dv;
+                            dv.cacheEnabled = cacheEnabled;
+                            _decodeVideo(dv, videoFrame);
+                            avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                        }
+                        if (p.avAudioStream != -1)
+                        {
+                            DecodeAudio da;
+                            _decodeAudio(da, audioFrame);
+                            avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
+                        }
+                        throw std::exception();
+                    }
+                    if (p.avVideoStream == packet->stream_index)
+                    {
+                        DecodeVideo dv;
+                        dv.packet       = packet;
+                        dv.cacheEnabled = cacheEnabled;
+                        if (_decodeVideo(dv, videoFrame) < 0)
+                        {
+                            av_packet_free(&packet);
+                            throw std::exception();
+                        }
+                    }
+                    else if (p.avAudioStream == packet->stream_index)
+                    {
+                        DecodeAudio da;
+                        da.packet = packet;
+                        if (_decodeAudio(da, audioFrame) < 0)
+                        {
+                            av_packet_free(&packet);
+                            throw std::exception();
+                        }
+                    }
+                    av_packet_free(&packet);
+                }
+            }
+
+            void Read::_readReverse(bool cacheEnabled)
+            {
+                DJV_PRIVATE_PTR();
+                _audioQueue.setFinished(true);
+                if (_videoQueue.isFinished() || _videoQueue.getCount() >= _videoQueue.getMax())
+                {
+                    return;
+                }
+                if (p.frame < 0)
+                {
+                    _videoQueue.setFinished(true);
+                    return;
+                }
+
+                // Decode the GOP containing the frame if it is not cached.
+                std::shared_ptr<Image::Data> image;
+                if (!_getFrame(p.frame, cacheEnabled, image))
+                {
+                    _decodeGOP(p.frame, cacheEnabled);
+                    _getFrame(p.frame, cacheEnabled, image);
+                }
+                if (image)
+                {
+                    _videoQueue.addFrameWait(IO::VideoFrame(p.frame, image), p.videoGeneration, p.running);
+                }
+                --p.frame;
+
+                // The decoder needs to be moved before reading forward again.
+                p.decodeSeek = p.frame + 1;
+                p.decodeVideoSeek = p.frame + 1;
+            }
+
+            void Read::_decodeGOP(Math::Frame::Number value, bool cacheEnabled)
+            {
+                DJV_PRIVATE_PTR();
+
+                // Find the start of the GOP. If the GOP has not been indexed
+                // yet let FFmpeg find the previous key frame.
+                Math::Frame::Number keyFrame = Math::Frame::invalid;
+                int64_t t = 0;
+                bool indexed = false;
+                {
+                    std::lock_guard<std::mutex> lock(p.gopMutex);
+                    indexed = p.gopIndex.getKeyFrame(value, keyFrame, t);
+                }
+                if (!indexed)
+                {
+                    AVRational r;
+                    r.num = p.info.videoSpeed.getDen();
+                    r.den = p.info.videoSpeed.getNum();
+                    t = av_rescale_q(value, r, p.avFormatContext->streams[p.avVideoStream]->time_base);
+                }
+
+                // Only keep the end of long GOPs.
+                const size_t gopFramesMax = std::max(_cache.getMax(), gopFramesMin);
+                Math::Frame::Number first = value - static_cast<Math::Frame::Number>(gopFramesMax) + 1;
+                if (indexed)
+                {
+                    first = std::max(first, keyFrame);
+                }
+
+                _finishConvert(true, false);
+                avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                p.packetQueue.seek(p.avVideoStream, t);
+                p.gopFrames.clear();
+                AVPacket* packet = nullptr;
+                Math::Frame::Number frame = Math::Frame::invalid;
+                while (frame < value)
+                {
+                    if (p.packetQueue.pop(&packet) < 0)
+                    {
+                        DecodeVideo dv;
+                        dv.seek         = first;
+                        dv.cacheEnabled = cacheEnabled;
+                        dv.gopFrames    = &p.gopFrames;
+                        dv.gopEnd       = value;
+                        _decodeVideo(dv, frame);
+                        avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                        break;
+                    }
+                    if (p.avVideoStream == packet->stream_index)
+                    {
+                        DecodeVideo dv;
+                        dv.packet       = packet;
+                        dv.seek         = first;
+                        dv.cacheEnabled = cacheEnabled;
+                        dv.gopFrames    = &p.gopFrames;
+                        dv.gopEnd       = value;
+                        if (_decodeVideo(dv, frame) < 0)
+                        {
+                            av_packet_free(&packet);
+                            throw std::exception();
+                        }
+                    }
+                    av_packet_free(&packet);
+                }
+                _finishConvert(true, false);
+            }
+
+            bool Read::_getFrame(Math::Frame::Number value, bool cacheEnabled, std::shared_ptr<Image::Data>& out) const
+            {
+                DJV_PRIVATE_PTR();
+                const auto i = p.gopFrames.find(value);
+                if (i != p.gopFrames.end())
+                {
+                    out = i->second;
+                    return true;
+                }
+                return cacheEnabled && _cache.get(value, out);
+            }
+
+            void Read::_indexGOPs()
+            {
+                DJV_PRIVATE_PTR();
+                AVFormatContext* avFormatContext = nullptr;
+                try
+                {
+                    // Use a separate context so the index can be read while
+                    // the video is decoded.
+                    int r = avformat_open_input(
+                        &avFormatContext,
+                        _fileInfo.getFileName().c_str(),
+                        nullptr,
+                        nullptr);
+                    if (r < 0)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(_fileInfo.getFileName()).
+                            arg(FFmpeg::getErrorString(r)));
+                    }
+                    r = avformat_find_stream_info(avFormatContext, 0);
+                    if (r < 0)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(_fileInfo.getFileName()).
+                            arg(FFmpeg::getErrorString(r)));
+                    }
+                    for (unsigned int i = 0; i < avFormatContext->nb_streams; ++i)
+                    {
+                        if (static_cast<int>(i) != p.avVideoStream)
+                        {
+                            avFormatContext->streams[i]->discard = AVDISCARD_ALL;
+                        }
+                    }
+
+                    // Only the packet flags are needed, the packets are not
+                    // decoded.
+                    const auto avVideoStream = avFormatContext->streams[p.avVideoStream];
+                    AVRational rate;
+                    rate.num = p.info.videoSpeed.getDen();
+                    rate.den = p.info.videoSpeed.getNum();
+                    AVPacket packet;
+                    while (p.running && av_read_frame(avFormatContext, &packet) >= 0)
+                    {
+                        if (p.avVideoStream == packet.stream_index &&
+                            (packet.flags & AV_PKT_FLAG_KEY) &&
+                            packet.pts != AV_NOPTS_VALUE)
+                        {
+                            const Math::Frame::Number frame = av_rescale_q(packet.pts, avVideoStream->time_base, rate);
+                            std::lock_guard<std::mutex> lock(p.gopMutex);
+                            p.gopIndex.add(frame, packet.pts);
+                        }
+                        av_packet_unref(&packet);
+                    }
+                    if (p.running)
+                    {
+                        std::lock_guard<std::mutex> lock(p.gopMutex);
+                        p.gopIndex.setComplete(true);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    _logSystem->log("djvAV::IO::FFmpeg::Read", e.what(), System::LogLevel::Warning);
+                }
+                if (avFormatContext)
+                {
+                    avformat_close_input(&avFormatContext);
+                }
+            }
+
+            void Read::_demux()
+            {
+                DJV_PRIVATE_PTR();
+                bool seek = false;
+                int stream = -1;
+                int64_t t = 0;
+                uint64_t generation = 0;
+                while (p.packetQueue.waitForDemux(seek, stream, t, generation))
+                {
+                    if (seek)
+                    {
+                        const int r = av_seek_frame(
+                            p.avFormatContext,
+                            stream,
+                            t,
+                            AVSEEK_FLAG_BACKWARD);
+                        if (r < 0)
+                        {
+                            p.packetQueue.setEnd(r, generation);
+                            continue;
+                        }
+                    }
+                    const auto timer = std::chrono::steady_clock::now();
+                    AVPacket* packet = av_packet_alloc();
+                    const int r = av_read_frame(p.avFormatContext, packet);
+                    {
+                        std::lock_guard<std::mutex> lock(p.statsMutex);
+                        p.stats.demuxTime += getSeconds(timer);
+                        if (r >= 0)
+                        {
+                            ++p.stats.demuxPackets;
+                        }
+                    }
+                    if (r < 0)
+                    {
+                        av_packet_free(&packet);
+                        p.packetQueue.setEnd(r, generation);
+                    }
+                    else if (packet->stream_index != p.avVideoStream &&
+                        packet->stream_index != p.avAudioStream)
+                    {
+                        av_packet_free(&packet);
+                    }
+                    else
+                    {
+                        p.packetQueue.push(packet, generation);
+                    }
+                }
+            }
+
             int Read::_decodeVideo(const DecodeVideo& dv, Math::Frame::Number& frame)
             {
                 DJV_PRIVATE_PTR();
+                auto t = std::chrono::steady_clock::now();
                 int r = avcodec_send_packet(p.avCodecContext[p.avVideoStream], dv.packet);
                 while (r >= 0)
                 {
                     r = avcodec_receive_frame(p.avCodecContext[p.avVideoStream], p.avFrame);
+                    {
+                        std::lock_guard<std::mutex> lock(p.statsMutex);
+                        p.stats.decodeTime += getSeconds(t);
+                        if (r >= 0)
+                        {
+                            ++p.stats.decodeFrames;
+                        }
+                    }
                     if (AVERROR(EAGAIN) == r)
                     {
                         r = 0;
@@ -635,11 +1219,31 @@ namespace djv
                         r);
                     //std::cout << "decode video = " << frame << std::endl;
 
-                    if (Math::Frame::invalid == dv.seek || frame >= dv.seek)
+                    // Frames before the seek are still added to the cache when
+                    // they are inside the cache window, so scrubbing backwards
+                    // does not need to decode them again.
+                    const bool keep =
+                        (Math::Frame::invalid == dv.seek || frame >= dv.seek) &&
+                        (!dv.gopFrames || frame <= dv.gopEnd);
+                    const bool cache =
+                        dv.cacheEnabled &&
+                        !_cache.contains(frame) &&
+                        _cache.getSequence().contains(frame);
+                    if (keep || cache)
                     {
+                        Private::PendingFrame pending;
+                        pending.frame     = frame;
+                        pending.keep      = keep;
+                        pending.cache     = dv.cacheEnabled;
+                        pending.gopFrames = dv.gopFrames;
                         std::shared_ptr<Image::Data> image;
                         if (dv.cacheEnabled && _cache.get(frame, image))
-                        {}
+                        {
+                            std::promise<std::shared_ptr<Image::Data> > promise;
+                            promise.set_value(image);
+                            pending.image = promise.get_future();
+                            pending.cache = false;
+                        }
                         else
                         {
                             Image::Info imageInfo;
@@ -652,41 +1256,80 @@ namespace djv
                             {
                                 imageInfo.pixelAspectRatio = p.avFrame->sample_aspect_ratio.num / static_cast<float>(p.avFrame->sample_aspect_ratio.den);
                             }
-                            image = Image::Data::create(imageInfo);
-                            image->setPluginName(pluginName);
-                            av_image_fill_arrays(
-                                p.avFrameRgb->data,
-                                p.avFrameRgb->linesize,
-                                image->getData(),
-                                AV_PIX_FMT_RGBA,
-                                image->getWidth(),
-                                image->getHeight(),
-                                1);
-                            sws_scale(
-                                p.swsContext,
-                                (uint8_t const* const*)p.avFrame->data,
-                                p.avFrame->linesize,
-                                0,
-                                p.avCodecParameters[p.avVideoStream]->height,
-                                p.avFrameRgb->data,
-                                p.avFrameRgb->linesize);
-                            if (dv.cacheEnabled)
-                            {
-                                _cache.add(frame, image);
-                            }
-                        }
-                        {
-                            std::lock_guard<std::mutex> lock(_mutex);
-                            if (Math::Frame::invalid == p.seek)
-                            {
-                                _videoQueue.addFrame(IO::VideoFrame(frame, image));
-                            }
+
+                            // Convert the frame on the thread pool. The frame
+                            // is a new reference to the decoded data so the
+                            // decoder can continue.
+                            auto avFrame = std::shared_ptr<AVFrame>(
+                                av_frame_clone(p.avFrame),
+                                [](AVFrame* value)
+                                {
+                                    av_frame_free(&value);
+                                });
+                            const AVPixelFormat avOutputFormat = p.avOutputFormat;
+                            auto swsPool = p.swsPool;
+                            auto dataPool = _options.dataPool;
+                            pending.image = p.convertQueue->push<std::shared_ptr<Image::Data> >(
+                                [this, avFrame, imageInfo, avOutputFormat, swsPool, dataPool]
+                                {
+                                    DJV_PRIVATE_PTR();
+                                    const auto t = std::chrono::steady_clock::now();
+                                    auto out = convertFrame(avFrame.get(), imageInfo, avOutputFormat, swsPool, dataPool);
+                                    std::lock_guard<std::mutex> lock(p.statsMutex);
+                                    p.stats.convertTime += getSeconds(t);
+                                    ++p.stats.convertFrames;
+                                    return out;
+                                });
                         }
+                        p.pendingFrames.push_back(std::move(pending));
+                        _finishConvert(false, true);
                     }
+                    t = std::chrono::steady_clock::now();
                 }
                 return r;
             }
 
+            void Read::_finishConvert(bool wait, bool queue)
+            {
+                DJV_PRIVATE_PTR();
+
+                // The frames are finished in decode order. The number of
+                // frames waiting is limited to the work queue concurrency.
+                const size_t pendingMax = p.convertQueue->getConcurrency();
+                while (p.pendingFrames.size() &&
+                    (wait ||
+                    p.pendingFrames.size() > pendingMax ||
+                    p.pendingFrames.front().image.wait_for(std::chrono::seconds(0)) == std::future_status::ready))
+                {
+                    auto pending = std::move(p.pendingFrames.front());
+                    p.pendingFrames.pop_front();
+                    std::shared_ptr<Image::Data> image;
+                    try
+                    {
+                        image = pending.image.get();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _logSystem->log("djvAV::IO::FFmpeg::Read", e.what(), System::LogLevel::Error);
+                        continue;
+                    }
+                    if (pending.cache)
+                    {
+                        _cache.add(pending.frame, image);
+                    }
+                    if (pending.keep && pending.gopFrames)
+                    {
+                        (*pending.gopFrames)[pending.frame] = image;
+                    }
+                    else if (pending.keep && queue)
+                    {
+                        _videoQueue.addFrameWait(IO::VideoFrame(pending.frame, image), p.videoGeneration, p.running);
+                    }
+                }
+                std::lock_guard<std::mutex> lock(p.statsMutex);
+                p.stats.convertPending = p.pendingFrames.size();
+            }
+
             int Read::_decodeAudio(const DecodeAudio& da, Math::Frame::Number& frame)
             {
                 DJV_PRIVATE_PTR();
@@ -721,13 +1364,7 @@ namespace djv
                             p.avCodecParameters[p.avAudioStream]->format,
                             p.avCodecParameters[p.avAudioStream]->channels,
                             audioData);
-                        {
-                            std::lock_guard<std::mutex> lock(_mutex);
-                            if (Math::Frame::invalid == p.seek)
-                            {
-                                _audioQueue.addFrame(IO::AudioFrame(audioData));
-                            }
-                        }
+                        _audioQueue.addFrameWait(IO::AudioFrame(audioData), p.audioGeneration, p.running);
                     }
                 }
                 return r;
@@ -26,43 +26,6 @@ namespace djv
                 data(data)
             {}
 
-            VideoQueue::VideoQueue()
-            {}
-
-            void VideoQueue::setMax(size_t value)
-            {
-                _max = value;
-            }
-
-            void VideoQueue::addFrame(const VideoFrame& value)
-            {
-                _queue.push(value);
-            }
-
-            VideoFrame VideoQueue::popFrame()
-            {
-                VideoFrame out;
-                if (_queue.size())
-                {
-                    out = _queue.front();
-                    _queue.pop();
-                }
-                return out;
-            }
-
-            void VideoQueue::clearFrames()
-            {
-                while (_queue.size())
-                {
-                    _queue.pop();
-                }
-            }
-
-            void VideoQueue::setFinished(bool value)
-            {
-                _finished = value;
-            }
-
             AudioFrame::AudioFrame()
             {}
 
@@ -70,43 +33,6 @@ namespace djv
                 data(data)
             {}
 
-            AudioQueue::AudioQueue()
-            {}
-
-            void AudioQueue::setMax(size_t value)
-            {
-                _max = value;
-            }
-
-            void AudioQueue::addFrame(const AudioFrame& value)
-            {
-                _queue.push(value);
-            }
-
-            AudioFrame AudioQueue::popFrame()
-            {
-                AudioFrame out;
-                if (_queue.size())
-                {
-                    out = _queue.front();
-                    _queue.pop();
-                }
-                return out;
-            }
-
-            void AudioQueue::clearFrames()
-            {
-                while (_queue.size())
-                {
-                    _queue.pop();
-                }
-            }
-
-            void AudioQueue::setFinished(bool value)
-            {
-                _finished = value;
-            }
-
             InOutPoints::InOutPoints()
             {}
 
@@ -129,37 +55,32 @@ namespace djv
 
             Math::Frame::Sequence Cache::getFrames() const
             {
-                Math::Frame::Sequence out;
-                std::vector<Math::Frame::Index> frames;
-                for (const auto& i : _cache)
+                // Walk the window in frame order, starting with the frames
+                // that have wrapped around to the start of the range.
+                std::vector<Math::Frame::Number> frames;
+                frames.reserve(_count);
+                if (_windowSize > 0)
                 {
-                    frames.push_back(i.first);
-                }
-                const size_t size = frames.size();
-                if (size)
-                {
-                    std::sort(frames.begin(), frames.end());
-                    Math::Frame::Number rangeStart = frames[0];
-                    Math::Frame::Number prevFrame = frames[0];
-                    size_t i = 1;
-                    for (; i < size; prevFrame = frames[i], ++i)
+                    const Math::Frame::Index rangeMax = _range.getMax();
+                    const size_t wrap = std::min(static_cast<size_t>(rangeMax - _windowStart + 1), _windowSize);
+                    for (size_t i = wrap; i < _windowSize; ++i)
                     {
-                        if (frames[i] != prevFrame + 1)
+                        const auto& entry = _ring[(_ringStart + i) % _windowSize];
+                        if (entry.frame != Math::Frame::invalid)
                         {
-                            out.add(Math::Frame::Range(rangeStart, prevFrame));
-                            rangeStart = frames[i];
+                            frames.push_back(entry.frame);
                         }
                     }
-                    if (size > 1)
-                    {
-                        out.add(Math::Frame::Range(rangeStart, prevFrame));
-                    }
-                    else
+                    for (size_t i = 0; i < wrap; ++i)
                     {
-                        out.add(Math::Frame::Range(rangeStart));
+                        const auto& entry = _ring[(_ringStart + i) % _windowSize];
+                        if (entry.frame != Math::Frame::invalid)
+                        {
+                            frames.push_back(entry.frame);
+                        }
                     }
                 }
-                return out;
+                return Math::Frame::fromFrames(frames);
             }
 
             void Cache::setSequenceSize(size_t value)
@@ -194,99 +115,343 @@ namespace djv
                 _cacheUpdate();
             }
 
-            void Cache::add(Math::Frame::Index index, const std::shared_ptr<Image::Data>& image)
+            void Cache::add(Math::Frame::Index value, const std::shared_ptr<Image::Data>& data)
             {
-                _cache[index] = image;
-                _cacheUpdate();
+                if (0 == _windowSize)
+                {
+                    _cacheUpdate();
+                }
+                if (_range.contains(value))
+                {
+                    const Math::Frame::Index rangeSize = _range.getMax() - _range.getMin() + 1;
+                    Math::Frame::Index offset = (value - _windowStart) % rangeSize;
+                    if (offset < 0)
+                    {
+                        offset += rangeSize;
+                    }
+                    if (offset < static_cast<Math::Frame::Index>(_windowSize))
+                    {
+                        auto& entry = _ring[(_ringStart + offset) % _windowSize];
+                        _clearEntry(entry);
+                        entry.frame = value;
+                        entry.data = data;
+                        ++_count;
+                        if (data)
+                        {
+                            _totalByteCount += data->getDataByteCount();
+                        }
+                    }
+                }
+            }
+
+            void Cache::clear()
+            {
+                for (auto& i : _ring)
+                {
+                    _clearEntry(i);
+                }
+            }
+
+            void Cache::_clearEntry(Entry& entry)
+            {
+                if (entry.frame != Math::Frame::invalid)
+                {
+                    if (entry.data)
+                    {
+                        _totalByteCount -= entry.data->getDataByteCount();
+                    }
+                    --_count;
+                    entry.frame = Math::Frame::invalid;
+                    entry.data.reset();
+                }
             }
 
             void Cache::_cacheUpdate()
             {
+                // Compute the new window.
                 const auto range = _inOutPoints.getRange(_sequenceSize);
-                Math::Frame::Index frame = _currentFrame;
-                _sequence = Math::Frame::Sequence();
-                switch (_direction)
+                const Math::Frame::Index rangeSize = range.getMax() - range.getMin() + 1;
+                const size_t windowSize = std::min(_max + 1, static_cast<size_t>(rangeSize));
+                Math::Frame::Index windowStart = range.getMin();
+                if (windowSize < static_cast<size_t>(rangeSize))
                 {
-                case Direction::Forward:
+                    // Small windows read behind less so the current frame
+                    // stays in the window.
+                    const size_t readBehind = std::min(_readBehind, windowSize / 2);
+                    switch (_direction)
+                    {
+                    case Direction::Forward:
+                        windowStart = _currentFrame - static_cast<Math::Frame::Index>(readBehind);
+                        break;
+                    case Direction::Reverse:
+                        windowStart = _currentFrame + static_cast<Math::Frame::Index>(readBehind) - static_cast<Math::Frame::Index>(windowSize - 1);
+                        break;
+                    default: break;
+                    }
+                    windowStart = (windowStart - range.getMin()) % rangeSize;
+                    if (windowStart < 0)
+                    {
+                        windowStart += rangeSize;
+                    }
+                    windowStart += range.getMin();
+                }
+
+                // Move the window. If the window only slides a short distance
+                // just the frames that leave the window are removed, otherwise
+                // the frames are re-inserted into a new ring.
+                Math::Frame::Index shift = 0;
+                bool rebuild = range != _range || windowSize != _windowSize;
+                if (!rebuild && windowStart != _windowStart)
                 {
-                    for (size_t i = 0; i < _readBehind; ++i)
+                    shift = (windowStart - _windowStart) % rangeSize;
+                    if (shift < 0)
                     {
-                        --frame;
-                        if (frame < range.getMin())
-                        {
-                            frame = range.getMax();
-                        }
+                        shift += rangeSize;
                     }
-                    _sequence.add(Math::Frame::Range(frame));
-                    const Math::Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
+                    const Math::Frame::Index size = static_cast<Math::Frame::Index>(windowSize);
+                    if (shift < size && shift + size <= rangeSize)
                     {
-                        ++frame;
-                        if (first == frame)
+                        for (Math::Frame::Index i = 0; i < shift; ++i)
                         {
-                            break;
+                            _clearEntry(_ring[(_ringStart + i) % windowSize]);
                         }
-                        if (frame > range.getMax())
+                        _ringStart = (_ringStart + shift) % windowSize;
+                    }
+                    else if (rangeSize - shift < size && rangeSize - shift + size <= rangeSize)
+                    {
+                        shift = rangeSize - shift;
+                        for (Math::Frame::Index i = 0; i < shift; ++i)
                         {
-                            frame = range.getMin();
-                            if (frame != _sequence.getRanges().back().getMax())
-                            {
-                                _sequence.add(Math::Frame::Range(frame));
-                            }
+                            _clearEntry(_ring[(_ringStart + windowSize - 1 - i) % windowSize]);
                         }
-                        else
+                        _ringStart = (_ringStart + windowSize - shift) % windowSize;
+                    }
+                    else
+                    {
+                        rebuild = true;
+                    }
+                }
+                if (rebuild)
+                {
+                    std::vector<Entry> entries;
+                    for (auto& i : _ring)
+                    {
+                        if (i.frame != Math::Frame::invalid)
                         {
-                            _sequence.add(Math::Frame::Range(frame));
+                            entries.push_back(std::move(i));
                         }
                     }
-                    break;
+                    _range = range;
+                    _windowStart = windowStart;
+                    _windowSize = windowSize;
+                    _ringStart = 0;
+                    _ring = std::vector<Entry>(windowSize);
+                    _count = 0;
+                    _totalByteCount = 0;
+                    for (const auto& i : entries)
+                    {
+                        add(i.frame, i.data);
+                    }
+                }
+                _windowStart = windowStart;
+
+                // Update the window sequence.
+                const Math::Frame::Index windowEnd = windowStart + static_cast<Math::Frame::Index>(windowSize) - 1;
+                if (windowEnd <= range.getMax())
+                {
+                    _sequence = Math::Frame::Sequence(Math::Frame::Range(windowStart, windowEnd));
+                }
+                else
+                {
+                    _sequence = Math::Frame::Sequence(std::vector<Math::Frame::Range>({
+                        Math::Frame::Range(range.getMin(), windowEnd - rangeSize),
+                        Math::Frame::Range(windowStart, range.getMax()) }));
                 }
-                case Direction::Reverse:
+            }
+
+            Image::Size getProxySize(const Image::Size& size, size_t proxyScale)
+            {
+                const size_t scale = std::max(proxyScale, static_cast<size_t>(1));
+                return Image::Size(
+                    static_cast<uint16_t>((size.w + scale - 1) / scale),
+                    static_cast<uint16_t>((size.h + scale - 1) / scale));
+            }
+
+            size_t getProxyScale(const Image::Size& imageSize, const Image::Size& size)
+            {
+                size_t out = 1;
+                if (size.isValid())
                 {
-                    for (size_t i = 0; i < _readBehind; ++i)
+                    for (size_t scale = 2; scale <= 8; scale *= 2)
                     {
-                        ++frame;
-                        if (frame > range.getMax())
+                        const Image::Size proxySize = getProxySize(imageSize, scale);
+                        if (proxySize.w < size.w || proxySize.h < size.h)
                         {
-                            frame = range.getMin();
+                            break;
                         }
+                        out = scale;
                     }
-                    _sequence.add(Math::Frame::Range(frame));
-                    const Math::Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
+                }
+                return out;
+            }
+
+            namespace
+            {
+                template<typename T>
+                T fromSum(double value)
+                {
+                    return static_cast<T>(value + .5);
+                }
+
+                template<>
+                Image::F16_T fromSum(double value)
+                {
+                    return static_cast<float>(value);
+                }
+
+                template<>
+                Image::F32_T fromSum(double value)
+                {
+                    return static_cast<float>(value);
+                }
+
+                template<typename T>
+                void boxFilter(const Image::Data& in, Image::Data& out, size_t scale)
+                {
+                    const size_t channelCount = Image::getChannelCount(in.getType());
+                    const size_t inW = in.getWidth();
+                    const size_t inH = in.getHeight();
+                    const size_t w = out.getWidth();
+                    const size_t h = out.getHeight();
+                    std::vector<double> sums(w * channelCount);
+                    for (size_t y = 0; y < h; ++y)
                     {
-                        --frame;
-                        if (first == frame)
+                        std::fill(sums.begin(), sums.end(), 0.0);
+                        const size_t y0 = y * scale;
+                        const size_t y1 = std::min(y0 + scale, inH);
+                        for (size_t inY = y0; inY < y1; ++inY)
                         {
-                            break;
+                            const T* inP = reinterpret_cast<const T*>(in.getData(static_cast<uint16_t>(inY)));
+                            for (size_t x = 0, inX = 0; x < w; ++x)
+                            {
+                                const size_t x1 = std::min(inX + scale, inW);
+                                double* sumP = sums.data() + x * channelCount;
+                                for (; inX < x1; ++inX)
+                                {
+                                    for (size_t c = 0; c < channelCount; ++c)
+                                    {
+                                        sumP[c] += static_cast<double>(inP[inX * channelCount + c]);
+                                    }
+                                }
+                            }
                         }
-                        if (frame < range.getMin())
+                        T* outP = reinterpret_cast<T*>(out.getData(static_cast<uint16_t>(y)));
+                        for (size_t x = 0; x < w; ++x)
                         {
-                            frame = range.getMax();
-                            if (frame != _sequence.getRanges().back().getMin())
+                            const size_t x0 = x * scale;
+                            const double count = static_cast<double>((std::min(x0 + scale, inW) - x0) * (y1 - y0));
+                            for (size_t c = 0; c < channelCount; ++c)
                             {
-                                _sequence.add(Math::Frame::Range(frame));
+                                outP[x * channelCount + c] = fromSum<T>(sums[x * channelCount + c] / count);
                             }
                         }
-                        else
+                    }
+                }
+
+                void pointSample(const Image::Data& in, Image::Data& out, size_t scale)
+                {
+                    const size_t pixelByteCount = in.getInfo().getPixelByteCount();
+                    const size_t w = out.getWidth();
+                    const size_t h = out.getHeight();
+                    for (size_t y = 0; y < h; ++y)
+                    {
+                        const uint8_t* inP = in.getData(static_cast<uint16_t>(y * scale));
+                        uint8_t* outP = out.getData(static_cast<uint16_t>(y));
+                        for (size_t x = 0; x < w; ++x, inP += pixelByteCount * scale, outP += pixelByteCount)
                         {
-                            _sequence.add(Math::Frame::Range(frame));
+                            memcpy(outP, inP, pixelByteCount);
                         }
                     }
-                    break;
                 }
-                default: break;
+
+            } // namespace
+
+            std::shared_ptr<Image::Data> scaleProxy(
+                const std::shared_ptr<Image::Data>& data,
+                size_t proxyScale,
+                const std::shared_ptr<Image::DataPool>& dataPool)
+            {
+                if (!data || proxyScale <= 1 || Image::isYUVType(data->getType()))
+                {
+                    return data;
+                }
+                Image::Info info = data->getInfo();
+                info.size = getProxySize(info.size, proxyScale);
+                auto out = Image::Data::create(info, dataPool);
+                out->setPluginName(data->getPluginName());
+                out->setTags(data->getTags());
+                const bool nativeEndian = info.layout.endian == Memory::getEndian();
+                switch (nativeEndian ? Image::getDataType(info.type) : Image::DataType::None)
+                {
+                case Image::DataType::U8:  boxFilter<Image::U8_T>(*data, *out, proxyScale); break;
+                case Image::DataType::U16: boxFilter<Image::U16_T>(*data, *out, proxyScale); break;
+                case Image::DataType::U32: boxFilter<Image::U32_T>(*data, *out, proxyScale); break;
+                case Image::DataType::F16: boxFilter<Image::F16_T>(*data, *out, proxyScale); break;
+                case Image::DataType::F32: boxFilter<Image::F32_T>(*data, *out, proxyScale); break;
+                default: pointSample(*data, *out, proxyScale); break;
                 }
-                auto i = _cache.begin();
-                while (i != _cache.end())
+                return out;
+            }
+
+            Math::BBox2i getROITiles(const Math::BBox2i& value, const Image::Size& size)
+            {
+                Math::BBox2i out;
+                if (value.isValid() && size.isValid())
                 {
-                    auto j = i;
-                    ++i;
-                    if (!_sequence.contains(j->first))
+                    const Math::BBox2i full(0, 0, size.w, size.h);
+                    const Math::BBox2i clipped = value.intersect(full);
+                    if (clipped.isValid())
                     {
-                        _cache.erase(j);
+                        out.min.x = clipped.min.x / roiTileSize * roiTileSize;
+                        out.min.y = clipped.min.y / roiTileSize * roiTileSize;
+                        out.max.x = std::min((clipped.max.x / roiTileSize + 1) * roiTileSize - 1, full.max.x);
+                        out.max.y = std::min((clipped.max.y / roiTileSize + 1) * roiTileSize - 1, full.max.y);
+                        if (out == full)
+                        {
+                            out = Math::BBox2i();
+                        }
                     }
                 }
+                return out;
+            }
+
+            bool coversROI(const std::shared_ptr<Image::Data>& data, const Math::BBox2i& roi)
+            {
+                bool out = false;
+                if (data)
+                {
+                    const Math::BBox2i& dataROI = data->getROI();
+                    out = !dataROI.isValid() || (roi.isValid() &&
+                        roi.min.x >= dataROI.min.x && roi.max.x <= dataROI.max.x &&
+                        roi.min.y >= dataROI.min.y && roi.max.y <= dataROI.max.y);
+                }
+                return out;
+            }
+
+            Math::BBox2i mirrorROI(const Math::BBox2i& value, const Image::Info& info)
+            {
+                Math::BBox2i out = value;
+                if (info.layout.mirror.x)
+                {
+                    out.min.x = info.size.w - 1 - value.max.x;
+                    out.max.x = info.size.w - 1 - value.min.x;
+                }
+                if (info.layout.mirror.y)
+                {
+                    out.min.y = info.size.h - 1 - value.max.y;
+                    out.max.y = info.size.h - 1 - value.min.y;
+                }
+                return out;
             }
 
         } // namespace IO
@@ -11,9 +11,10 @@
 #include <djvMath/FrameNumber.h>
 #include <djvMath/Rational.h>
 
+#include <atomic>
 #include <future>
-#include <queue>
 #include <set>
+#include <thread>
 
 namespace djv
 {
@@ -52,51 +53,6 @@ namespace djv
                 bool operator == (const VideoFrame&) const;
             };
 
-            //! Video frame queue.
-            class VideoQueue
-            {
-                DJV_NON_COPYABLE(VideoQueue);
-
-            public:
-                VideoQueue();
-
-                //! \name Size
-                ///@{
-                
-                size_t getMax() const;
-
-                void setMax(size_t);
-
-                ///@}
-
-                //! \name Frames
-                ///@{
-                
-                bool isEmpty() const;
-                size_t getCount() const;
-                VideoFrame getFrame() const;
-
-                void addFrame(const VideoFrame&);
-                VideoFrame popFrame();
-                void clearFrames();
-
-                ///@}
-
-                //! \name Finished
-                ///@{
-
-                bool isFinished() const;
-
-                void setFinished(bool);
-
-                ///@}
-
-            private:
-                size_t _max = 0;
-                std::queue<VideoFrame> _queue;
-                bool _finished = false;
-            };
-
             //! Audio frame.
             class AudioFrame
             {
@@ -109,19 +65,50 @@ namespace djv
                 bool operator == (const AudioFrame&) const;
             };
 
-            //! Audio frame queue.
-            class AudioQueue
+            //! Get the frame number of a video frame.
+            Math::Frame::Number getFrameNumber(const VideoFrame&);
+
+            //! Get the frame number of an audio frame, audio frames are not
+            //! numbered so this is always invalid.
+            Math::Frame::Number getFrameNumber(const AudioFrame&);
+
+            //! Frame queue.
+            //!
+            //! The queue is a lock-free ring buffer with a single producer
+            //! thread and a single consumer thread, for example a reader
+            //! thread and the UI thread. Clearing the queue starts a new
+            //! generation and the frames from older generations are skipped,
+            //! so either thread may clear the queue. The skipped frames are
+            //! released by the consumer the next time it calls isEmpty(),
+            //! getFrame(), or popFrame().
+            //!
+            //! Only the consumer may call isEmpty(), getFrame(), and
+            //! popFrame(). The producer uses getCount() and getFrameNumber()
+            //! instead, they do not touch the frames.
+            //!
+            //! The maximum is the number of frames the producer should add.
+            //! The ring buffer has room for more frames than the maximum,
+            //! addFrame() only fails when the ring buffer is full.
+            //!
+            //! The producer sets the finished flag after adding the last
+            //! frame, so the consumer should check isFinished() before
+            //! isEmpty().
+            template<typename T>
+            class FrameQueue
             {
-                DJV_NON_COPYABLE(AudioQueue);
+                DJV_NON_COPYABLE(FrameQueue);
 
             public:
-                AudioQueue();
+                FrameQueue();
 
                 //! \name Size
                 ///@{
 
                 size_t getMax() const;
+                size_t getCapacity() const;
 
+                //! Set the maximum. This re-allocates the ring buffer so it
+                //! should only be called before the queue is used.
                 void setMax(size_t);
 
                 ///@}
@@ -129,13 +116,37 @@ namespace djv
                 //! \name Frames
                 ///@{
 
+                //! Get whether the queue is empty (consumer).
                 bool isEmpty() const;
+
                 size_t getCount() const;
-                AudioFrame getFrame() const;
 
-                void addFrame(const AudioFrame&);
-                AudioFrame popFrame();
-                void clearFrames();
+                //! Get the first frame (consumer).
+                T getFrame() const;
+
+                //! Get the frame number of the first frame (producer).
+                Math::Frame::Number getFrameNumber() const;
+
+                uint64_t getGeneration() const;
+
+                //! Add a frame (producer). Returns false if the ring buffer
+                //! is full.
+                bool addFrame(const T&);
+
+                //! Add a frame from the given generation (producer). If the
+                //! queue has been cleared since then the frame is skipped.
+                bool addFrame(const T&, uint64_t generation);
+
+                //! Add a frame from the given generation (producer), waiting
+                //! while the ring buffer is full. Returns false if the flag
+                //! is cleared before the frame could be added.
+                bool addFrameWait(const T&, uint64_t generation, const std::atomic<bool>& running);
+
+                //! Remove the first frame (consumer).
+                T popFrame();
+
+                //! Clear the frames and return the new generation.
+                uint64_t clearFrames();
 
                 ///@}
 
@@ -143,17 +154,36 @@ namespace djv
                 ///@{
 
                 bool isFinished() const;
-                
+
                 void setFinished(bool);
 
                 ///@}
 
             private:
-                size_t _max = 0;
-                std::queue<AudioFrame> _queue;
-                bool _finished = false;
+                size_t _getFirst(size_t tail) const;
+                size_t _release(size_t tail) const;
+
+                struct Slot
+                {
+                    T                                frame;
+                    std::atomic<Math::Frame::Number> frameNumber;
+                    std::atomic<uint64_t>            generation;
+                };
+                std::unique_ptr<Slot[]> _slots;
+                size_t                  _capacity = 0;
+                std::atomic<size_t>     _max;
+                mutable std::atomic<size_t> _head;
+                std::atomic<size_t>     _tail;
+                std::atomic<uint64_t>   _generation;
+                std::atomic<bool>       _finished;
             };
 
+            //! Video frame queue.
+            typedef FrameQueue<VideoFrame> VideoQueue;
+
+            //! Audio frame queue.
+            typedef FrameQueue<AudioFrame> AudioQueue;
+
             //! Playback in/out points.
             class InOutPoints
             {
@@ -193,6 +223,11 @@ namespace djv
             };
 
             //! Frame cache.
+            //!
+            //! The cache holds the frames in a window around the current frame.
+            //! The frames are stored in a ring indexed by the offset from the
+            //! start of the window, so moving the window only touches the
+            //! frames that enter or leave it.
             class Cache
             {
             public:
@@ -213,7 +248,12 @@ namespace djv
                 ///@{
 
                 Math::Frame::Sequence getFrames() const;
+
+                //! Get the number of frames kept behind the current frame. This
+                //! is limited to half of the window, otherwise a window smaller
+                //! than the read behind would not contain the current frame.
                 size_t getReadBehind() const;
+
                 const Math::Frame::Sequence& getSequence() const;
 
                 void setSequenceSize(size_t);
@@ -230,6 +270,14 @@ namespace djv
                 ///@}
 
             private:
+                struct Entry
+                {
+                    Math::Frame::Index           frame = Math::Frame::invalid;
+                    std::shared_ptr<Image::Data> data;
+                };
+
+                size_t _getIndex(Math::Frame::Index) const;
+                void _clearEntry(Entry&);
                 void _cacheUpdate();
 
                 size_t _max = 0;
@@ -239,10 +287,59 @@ namespace djv
                 Math::Frame::Index _currentFrame = 0;
                 //! \todo Should this be configurable?
                 size_t _readBehind = 10;
+                Math::Range<Math::Frame::Index> _range;
+                Math::Frame::Index _windowStart = 0;
+                size_t _windowSize = 0;
+                size_t _ringStart = 0;
+                std::vector<Entry> _ring;
+                size_t _count = 0;
+                size_t _totalByteCount = 0;
                 Math::Frame::Sequence _sequence;
-                std::map<Math::Frame::Index, std::shared_ptr<Image::Data> > _cache;
             };
 
+            //! \name Proxies
+            ///@{
+
+            //! Get the size of an image read at the given proxy scale.
+            Image::Size getProxySize(const Image::Size&, size_t proxyScale);
+
+            //! Get the largest proxy scale (1, 2, 4, or 8) that keeps the
+            //! image at least as large as the given size.
+            size_t getProxyScale(const Image::Size& imageSize, const Image::Size&);
+
+            //! Scale an image down for a proxy. Images with 8, 16, 32-bit and
+            //! floating point channels are box filtered, other images are
+            //! point sampled. This is the fallback for readers that can't
+            //! read proxies directly.
+            std::shared_ptr<Image::Data> scaleProxy(
+                const std::shared_ptr<Image::Data>&,
+                size_t proxyScale,
+                const std::shared_ptr<Image::DataPool>& = nullptr);
+
+            ///@}
+
+            //! \name Regions of Interest
+            ///@{
+
+            //! The size of the tiles that regions of interest are aligned to.
+            const int roiTileSize = 256;
+
+            //! Expand a region of interest to the tile grid and clip it to the
+            //! image. An invalid region is returned when the tiles cover the
+            //! full image.
+            Math::BBox2i getROITiles(const Math::BBox2i&, const Image::Size&);
+
+            //! Get whether the image data covers a region of interest. Data
+            //! without a region is the full image and covers everything, an
+            //! invalid region of interest is only covered by the full image.
+            bool coversROI(const std::shared_ptr<Image::Data>&, const Math::BBox2i&);
+
+            //! Get where a region of interest is stored in an image with a
+            //! mirrored layout.
+            Math::BBox2i mirrorROI(const Math::BBox2i&, const Image::Info&);
+
+            ///@}
+
         } // namespace IO
     } // namespace AV
 } // namespace djv
@@ -25,59 +25,217 @@ namespace djv
                 return frame == other.frame && data == other.data;
             }
 
-            inline size_t VideoQueue::getMax() const
+            inline bool AudioFrame::operator == (const AudioFrame& other) const
+            {
+                return data == other.data;
+            }
+
+            inline Math::Frame::Number getFrameNumber(const VideoFrame& value)
+            {
+                return value.frame;
+            }
+
+            inline Math::Frame::Number getFrameNumber(const AudioFrame&)
+            {
+                return Math::Frame::invalid;
+            }
+
+            template<typename T>
+            inline FrameQueue<T>::FrameQueue() :
+                _max(0),
+                _head(0),
+                _tail(0),
+                _generation(0),
+                _finished(false)
+            {
+                setMax(0);
+            }
+
+            template<typename T>
+            inline size_t FrameQueue<T>::getMax() const
             {
                 return _max;
             }
 
-            inline bool VideoQueue::isEmpty() const
+            template<typename T>
+            inline size_t FrameQueue<T>::getCapacity() const
             {
-                return 0 == _queue.size();
+                return _capacity;
             }
 
-            inline size_t VideoQueue::getCount() const
+            template<typename T>
+            inline void FrameQueue<T>::setMax(size_t value)
             {
-                return _queue.size();
+                // Leave room for the frames that are added after the producer
+                // checks the count, and for the frames of the previous
+                // generation that have not been released yet.
+                size_t capacity = 1;
+                while (capacity < value * 2 + 64)
+                {
+                    capacity *= 2;
+                }
+                _max = value;
+                if (capacity != _capacity)
+                {
+                    _capacity = capacity;
+                    _slots.reset(new Slot[_capacity]);
+                    for (size_t i = 0; i < _capacity; ++i)
+                    {
+                        _slots[i].frameNumber.store(Math::Frame::invalid, std::memory_order_relaxed);
+                        _slots[i].generation.store(0, std::memory_order_relaxed);
+                    }
+                    _head.store(0);
+                    _tail.store(0);
+                }
             }
 
-            inline VideoFrame VideoQueue::getFrame() const
+            template<typename T>
+            inline bool FrameQueue<T>::isEmpty() const
             {
-                return _queue.size() ? _queue.front() : VideoFrame();
+                const size_t tail = _tail.load(std::memory_order_acquire);
+                return _release(tail) == tail;
             }
 
-            inline bool VideoQueue::isFinished() const
+            template<typename T>
+            inline size_t FrameQueue<T>::getCount() const
             {
-                return _finished;
+                const size_t tail = _tail.load(std::memory_order_acquire);
+                return tail - _getFirst(tail);
             }
-            
-            inline bool AudioFrame::operator == (const AudioFrame& other) const
+
+            template<typename T>
+            inline T FrameQueue<T>::getFrame() const
             {
-                return data == other.data;
+                const size_t tail = _tail.load(std::memory_order_acquire);
+                const size_t first = _release(tail);
+                return first != tail ? _slots[first & (_capacity - 1)].frame : T();
             }
 
-            inline size_t AudioQueue::getMax() const
+            template<typename T>
+            inline Math::Frame::Number FrameQueue<T>::getFrameNumber() const
             {
-                return _max;
+                // The frame number is read from its own atomic, the consumer
+                // may be moving the frame out of the slot at the same time.
+                const size_t tail = _tail.load(std::memory_order_acquire);
+                const size_t first = _getFirst(tail);
+                return first != tail ?
+                    _slots[first & (_capacity - 1)].frameNumber.load(std::memory_order_relaxed) :
+                    Math::Frame::invalid;
+            }
+
+            template<typename T>
+            inline uint64_t FrameQueue<T>::getGeneration() const
+            {
+                return _generation.load(std::memory_order_acquire);
+            }
+
+            template<typename T>
+            inline bool FrameQueue<T>::addFrame(const T& value)
+            {
+                return addFrame(value, _generation.load(std::memory_order_acquire));
+            }
+
+            template<typename T>
+            inline bool FrameQueue<T>::addFrame(const T& value, uint64_t generation)
+            {
+                if (generation < _generation.load(std::memory_order_acquire))
+                {
+                    return true;
+                }
+                const size_t tail = _tail.load(std::memory_order_relaxed);
+                if (tail - _head.load(std::memory_order_acquire) >= _capacity)
+                {
+                    return false;
+                }
+                Slot& slot = _slots[tail & (_capacity - 1)];
+                slot.frame = value;
+                slot.frameNumber.store(IO::getFrameNumber(value), std::memory_order_relaxed);
+                slot.generation.store(generation, std::memory_order_relaxed);
+                _tail.store(tail + 1, std::memory_order_release);
+                return true;
             }
 
-            inline bool AudioQueue::isEmpty() const
+            template<typename T>
+            inline bool FrameQueue<T>::addFrameWait(const T& value, uint64_t generation, const std::atomic<bool>& running)
             {
-                return 0 == _queue.size();
+                while (!addFrame(value, generation))
+                {
+                    if (!running)
+                    {
+                        return false;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                return true;
             }
 
-            inline size_t AudioQueue::getCount() const
+            template<typename T>
+            inline T FrameQueue<T>::popFrame()
             {
-                return _queue.size();
+                T out;
+                const size_t tail = _tail.load(std::memory_order_acquire);
+                size_t head = _release(tail);
+                if (head != tail)
+                {
+                    Slot& slot = _slots[head & (_capacity - 1)];
+                    out = std::move(slot.frame);
+                    slot.frame = T();
+                    _head.store(head + 1, std::memory_order_release);
+                }
+                return out;
             }
 
-            inline bool AudioQueue::isFinished() const
+            template<typename T>
+            inline uint64_t FrameQueue<T>::clearFrames()
+            {
+                return _generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+            }
+
+            template<typename T>
+            inline bool FrameQueue<T>::isFinished() const
             {
                 return _finished;
             }
 
-            inline AudioFrame AudioQueue::getFrame() const
+            template<typename T>
+            inline void FrameQueue<T>::setFinished(bool value)
             {
-                return _queue.size() ? _queue.front() : AudioFrame();
+                _finished = value;
+            }
+
+            template<typename T>
+            inline size_t FrameQueue<T>::_getFirst(size_t tail) const
+            {
+                // The generations do not decrease from the head to the tail,
+                // so the frames of the current generation are at the end.
+                const uint64_t generation = _generation.load(std::memory_order_acquire);
+                size_t out = _head.load(std::memory_order_acquire);
+                while (out != tail && _slots[out & (_capacity - 1)].generation.load(std::memory_order_relaxed) < generation)
+                {
+                    ++out;
+                }
+                return out;
+            }
+
+            template<typename T>
+            inline size_t FrameQueue<T>::_release(size_t tail) const
+            {
+                // Only the consumer moves the head, so the frames from older
+                // generations can be released here without waiting for them
+                // to be popped.
+                const uint64_t generation = _generation.load(std::memory_order_acquire);
+                size_t head = _head.load(std::memory_order_relaxed);
+                const size_t start = head;
+                while (head != tail && _slots[head & (_capacity - 1)].generation.load(std::memory_order_relaxed) < generation)
+                {
+                    _slots[head & (_capacity - 1)].frame = T();
+                    ++head;
+                }
+                if (head != start)
+                {
+                    _head.store(head, std::memory_order_release);
+                }
+                return head;
             }
 
             inline bool InOutPoints::isEnabled() const
@@ -127,25 +285,17 @@ namespace djv
             
             inline size_t Cache::getCount() const
             {
-                return _cache.size();
+                return _count;
             }
 
             inline size_t Cache::getTotalByteCount() const
             {
-                size_t out = 0;
-                for (const auto& i : _cache)
-                {
-                    if (i.second)
-                    {
-                        out += i.second->getDataByteCount();
-                    }
-                }
-                return out;
+                return _totalByteCount;
             }
 
             inline size_t Cache::getReadBehind() const
             {
-                return _readBehind;
+                return std::min(_readBehind, _windowSize / 2);
             }
 
             inline const Math::Frame::Sequence& Cache::getSequence() const
@@ -155,23 +305,41 @@ namespace djv
 
             inline bool Cache::contains(Math::Frame::Index value) const
             {
-                return _cache.find(value) != _cache.end();
+                return _getIndex(value) < _windowSize;
             }
 
-            inline bool Cache::get(Math::Frame::Index index, std::shared_ptr<Image::Data>& out) const
+            inline bool Cache::get(Math::Frame::Index value, std::shared_ptr<Image::Data>& out) const
             {
-                const auto i = _cache.find(index);
-                const bool found = i != _cache.end();
+                const size_t index = _getIndex(value);
+                const bool found = index < _windowSize;
                 if (found)
                 {
-                    out = i->second;
+                    out = _ring[index].data;
                 }
                 return found;
             }
 
-            inline void Cache::clear()
+            inline size_t Cache::_getIndex(Math::Frame::Index value) const
             {
-                _cache.clear();
+                size_t out = _windowSize;
+                if (_windowSize > 0 && _range.contains(value))
+                {
+                    const Math::Frame::Index rangeSize = _range.getMax() - _range.getMin() + 1;
+                    Math::Frame::Index offset = (value - _windowStart) % rangeSize;
+                    if (offset < 0)
+                    {
+                        offset += rangeSize;
+                    }
+                    if (offset < static_cast<Math::Frame::Index>(_windowSize))
+                    {
+                        const size_t index = (_ringStart + offset) % _windowSize;
+                        if (_ring[index].frame == value)
+                        {
+                            out = index;
+                        }
+                    }
+                }
+                return out;
             }
 
         } // namespace IO
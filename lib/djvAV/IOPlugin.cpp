@@ -53,11 +53,55 @@ namespace djv
             {
                 IIO::_init(fileInfo, options, textSystem, resourceSystem, logSystem);
                 _options = options;
+                _layer = options.layer;
+                _proxyScale = std::max(options.proxyScale, static_cast<size_t>(1));
             }
 
             IRead::~IRead()
             {}
 
+            size_t IRead::getLayer()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _layer;
+            }
+
+            void IRead::setLayer(size_t value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _layer = value;
+            }
+
+            size_t IRead::getProxyScale()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _proxyScale;
+            }
+
+            void IRead::setProxyScale(size_t value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _proxyScale = std::max(value, static_cast<size_t>(1));
+            }
+
+            float IRead::getDecodeTime()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _decodeTime;
+            }
+
+            Math::BBox2i IRead::getROI()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _roi;
+            }
+
+            void IRead::setROI(const Math::BBox2i& value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _roi = value;
+            }
+
             void IRead::setPlayback(bool value)
             {
                 std::lock_guard<std::mutex> lock(_mutex);
@@ -10,6 +10,21 @@
 
 namespace djv
 {
+    namespace Core
+    {
+        namespace Thread
+        {
+            class ThreadPool;
+
+        } // namespace Thread
+    } // namespace Core
+
+    namespace Image
+    {
+        class DataPool;
+
+    } // namespace Image
+
     namespace System
     {
         class Context;
@@ -57,6 +72,9 @@ namespace djv
 
                 size_t getThreadCount() const;
 
+                //! Set the maximum number of work items that may run at the
+                //! same time. The threads themselves may be shared with other
+                //! I/O objects.
                 void setThreadCount(size_t);
 
                 ///@}
@@ -64,6 +82,8 @@ namespace djv
                 //! \name Queues
                 ///@{
 
+                //! Get the mutex that protects the options. The queues are
+                //! lock-free and may be used without it.
                 std::mutex& getMutex();
                 VideoQueue& getVideoQueue();
                 AudioQueue& getAudioQueue();
@@ -88,6 +108,22 @@ namespace djv
                 
                 size_t layer = 0;
                 std::string colorSpace;
+
+                //! Read the images at a reduced resolution, one of 1, 2, 4,
+                //! or 8. See getProxySize().
+                size_t proxyScale = 1;
+
+                //! Read only the audio, the video is not decoded. This is
+                //! used for example to build audio waveforms.
+                bool audioOnly = false;
+
+                //! The thread pool used for reading. If this is not set the
+                //! reader creates its own thread pool.
+                std::shared_ptr<Core::Thread::ThreadPool> threadPool;
+
+                //! The pool used for image data buffers. If this is not set
+                //! the buffers are allocated for each image.
+                std::shared_ptr<Image::DataPool> dataPool;
             };
 
             //! Base interface for readers.
@@ -111,6 +147,58 @@ namespace djv
 
                 ///@}
 
+                //! \name Layers
+                ///@{
+
+                size_t getLayer();
+
+                //! Set the layer to read without re-opening the file. Readers
+                //! with a cache keep the frames of the previous layers. Call
+                //! seek() afterwards to refresh the video queue.
+                void setLayer(size_t);
+
+                ///@}
+
+                //! \name Proxies
+                ///@{
+
+                //! Get whether the reader can read images at a reduced
+                //! resolution.
+                virtual bool hasProxies() const;
+
+                size_t getProxyScale();
+
+                //! Set the proxy scale without re-opening the file. The cached
+                //! frames are discarded. Call seek() afterwards to refresh the
+                //! video queue.
+                void setProxyScale(size_t);
+
+                //! Get the average time in seconds to decode a frame. Frames
+                //! are decoded in parallel so this may be longer than the time
+                //! between frames.
+                float getDecodeTime();
+
+                ///@}
+
+                //! \name Regions of Interest
+                ///@{
+
+                //! Get whether the reader can decode only a region of the
+                //! images.
+                virtual bool hasROI() const;
+
+                Math::BBox2i getROI();
+
+                //! Set the region of the images to read, in pixels. Readers
+                //! that support it only decode the tiles that cover the
+                //! region (see getROITiles()), the image data records the
+                //! region it covers with Image::Data::getROI(). An invalid
+                //! region reads the full images. The region is ignored for
+                //! proxies. Call seek() afterwards to refresh the video queue.
+                void setROI(const Math::BBox2i&);
+
+                ///@}
+
                 //! \name Playback
                 ///@{
 
@@ -141,6 +229,10 @@ namespace djv
 
             protected:
                 ReadOptions _options;
+                size_t _layer = 0;
+                size_t _proxyScale = 1;
+                float _decodeTime = 0.F;
+                Math::BBox2i _roi;
                 InOutPoints _inOutPoints;
                 Direction _direction = Direction::Forward;
                 bool _playback = false;
@@ -157,6 +249,10 @@ namespace djv
             struct WriteOptions : IOOptions
             {
                 std::string colorSpace;
+
+                //! The thread pool used for converting images before they
+                //! are written.
+                std::shared_ptr<Core::Thread::ThreadPool> threadPool;
             };
 
             //! Base interface for writers.
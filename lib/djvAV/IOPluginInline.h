@@ -28,6 +28,16 @@ namespace djv
                 return  _audioQueue;
             }
 
+            inline bool IRead::hasProxies() const
+            {
+                return false;
+            }
+
+            inline bool IRead::hasROI() const
+            {
+                return false;
+            }
+
             inline bool IRead::hasCache() const
             {
                 return false;
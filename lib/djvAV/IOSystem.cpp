@@ -31,12 +31,17 @@
 
 #include <djvGL/GLFWSystem.h>
 
+#include <djvImage/DataPool.h>
+
 #include <djvSystem/Context.h>
+#include <djvSystem/CoreSystem.h>
 #include <djvSystem/File.h>
 #include <djvSystem/TextSystem.h>
 
+#include <djvCore/Memory.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/String.h>
+#include <djvCore/ThreadPool.h>
 
 using namespace djv::Core;
 
@@ -53,6 +58,8 @@ namespace djv
                 std::map<std::string, std::shared_ptr<IPlugin> > plugins;
                 std::set<std::string> sequenceExtensions;
                 std::set<std::string> nonSequenceExtensions;
+                std::shared_ptr<Thread::ThreadPool> threadPool;
+                std::shared_ptr<Image::DataPool> dataPool;
             };
 
             void IOSystem::_init(const std::shared_ptr<System::Context>& context)
@@ -61,12 +68,25 @@ namespace djv
 
                 DJV_PRIVATE_PTR();
 
-                addDependency(GL::GLFW::GLFWSystem::create(context));
+                // OpenGL is optional for I/O, the sequence writers convert
+                // images on the CPU when there is no context.
+                try
+                {
+                    addDependency(GL::GLFW::GLFWSystem::create(context));
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), System::LogLevel::Warning);
+                }
 
                 p.textSystem = context->getSystemT<System::TextSystem>();
 
                 p.optionsChanged = Observer::ValueSubject<bool>::create();
 
+                p.threadPool = context->getSystemT<System::CoreSystem>()->getThreadPool();
+
+                p.dataPool = Image::DataPool::create(512 * Memory::megabyte);
+
                 p.plugins[Cineon::pluginName] = Cineon::Plugin::create(context);
                 p.plugins[DPX::pluginName] = DPX::Plugin::create(context);
                 p.plugins[IFF::pluginName] = IFF::Plugin::create(context);
@@ -111,6 +131,12 @@ namespace djv
                     _log(ss.str());
                 }
 
+                {
+                    std::stringstream ss;
+                    ss << "Image data pool size: " << p.dataPool->getMaxByteCount() / Memory::megabyte << "MB";
+                    _log(ss.str());
+                }
+
                 _logInitTime();
             }
 
@@ -182,6 +208,16 @@ namespace djv
                 return _p->optionsChanged;
             }
 
+            const std::shared_ptr<Thread::ThreadPool>& IOSystem::getThreadPool() const
+            {
+                return _p->threadPool;
+            }
+
+            const std::shared_ptr<Image::DataPool>& IOSystem::getDataPool() const
+            {
+                return _p->dataPool;
+            }
+
             const std::set<std::string>& IOSystem::getSequenceExtensions() const
             {
                 return _p->sequenceExtensions;
@@ -218,11 +254,20 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 std::shared_ptr<IRead> out;
+                ReadOptions readOptions = options;
+                if (!readOptions.threadPool)
+                {
+                    readOptions.threadPool = p.threadPool;
+                }
+                if (!readOptions.dataPool)
+                {
+                    readOptions.dataPool = p.dataPool;
+                }
                 for (const auto& i : p.plugins)
                 {
                     if (i.second->canRead(fileInfo))
                     {
-                        out = i.second->read(fileInfo, options);
+                        out = i.second->read(fileInfo, readOptions);
                         break;
                     }
                 }
@@ -252,11 +297,16 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 std::shared_ptr<IWrite> out;
+                WriteOptions writeOptions = options;
+                if (!writeOptions.threadPool)
+                {
+                    writeOptions.threadPool = p.threadPool;
+                }
                 for (const auto& i : p.plugins)
                 {
                     if (i.second->canWrite(fileInfo, info))
                     {
-                        out = i.second->write(fileInfo, info, options);
+                        out = i.second->write(fileInfo, info, writeOptions);
                         break;
                     }
                 }
@@ -49,6 +49,23 @@ namespace djv
 
                 std::shared_ptr<Core::Observer::IValueSubject<bool> > observeOptionsChanged() const;
 
+                ///@}
+
+                //! \name Threads
+                ///@{
+
+                //! Get the thread pool that is shared by all of the readers,
+                //! this is the thread pool of System::CoreSystem.
+                const std::shared_ptr<Core::Thread::ThreadPool>& getThreadPool() const;
+
+                ///@}
+
+                //! \name Memory
+                ///@{
+
+                //! Get the image data pool that is shared by all of the readers.
+                const std::shared_ptr<Image::DataPool>& getDataPool() const;
+
                 ///@}
                 
                 //! \name Sequences
@@ -68,10 +68,12 @@ namespace djv
             protected:
                 IO::Info _readInfo(const std::string& fileName) override;
                 std::shared_ptr<Image::Data> _readImage(const std::string& fileName) override;
+                std::shared_ptr<Image::Data> _readProxy(const std::string& fileName, size_t layer, size_t proxyScale) override;
 
             private:
                 class File;
-                IO::Info _open(const std::string&, const std::shared_ptr<File>&);
+                std::shared_ptr<Image::Data> _read(const std::string& fileName, size_t proxyScale);
+                IO::Info _open(const std::string&, const std::shared_ptr<File>&, size_t proxyScale = 1);
             };
                 
             //! JPEG writer.
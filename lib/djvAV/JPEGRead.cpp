@@ -116,12 +116,23 @@ namespace djv
 
             std::shared_ptr<Image::Data> Read::_readImage(const std::string& fileName)
             {
-                // Open the file.
+                return _read(fileName, 1);
+            }
+
+            std::shared_ptr<Image::Data> Read::_readProxy(const std::string& fileName, size_t, size_t proxyScale)
+            {
+                return _read(fileName, proxyScale);
+            }
+
+            std::shared_ptr<Image::Data> Read::_read(const std::string& fileName, size_t proxyScale)
+            {
+                // Open the file, the decoder scales the image while it is
+                // decompressed.
                 auto f = File::create();
-                const auto info = _open(fileName, f);
+                const auto info = _open(fileName, f, proxyScale);
 
                 // Read the file.
-                auto out = Image::Data::create(info.video[0]);
+                auto out = Image::Data::create(info.video[0], _options.dataPool);
                 out->setPluginName(pluginName);
                 for (uint16_t y = 0; y < info.video[0].size.h; ++y)
                 {
@@ -180,6 +191,7 @@ namespace djv
                 bool jpegOpen(
                     FILE*                   f,
                     jpeg_decompress_struct* jpeg,
+                    unsigned int            scaleDenom,
                     JPEGErrorStruct*        error)
                 {
                     if (::setjmp(error->jump))
@@ -192,6 +204,8 @@ namespace djv
                     {
                         return false;
                     }
+                    jpeg->scale_num = 1;
+                    jpeg->scale_denom = scaleDenom;
                     if (!jpeg_start_decompress(jpeg))
                     {
                         return false;
@@ -201,7 +215,7 @@ namespace djv
 
             } // namespace
 
-            IO::Info Read::_open(const std::string& fileName, const std::shared_ptr<File>& f)
+            IO::Info Read::_open(const std::string& fileName, const std::shared_ptr<File>& f, size_t proxyScale)
             {
                 f->jpeg.err = jpeg_std_error(&f->jpegError.pub);
                 f->jpegError.pub.error_exit = djvJPEGError;
@@ -226,7 +240,7 @@ namespace djv
                         arg(fileName).
                         arg(_textSystem->getText(DJV_TEXT("error_file_open"))));
                 }
-                if (!jpegOpen(f->f, &f->jpeg, &f->jpegError))
+                if (!jpegOpen(f->f, &f->jpeg, static_cast<unsigned int>(proxyScale), &f->jpegError))
                 {
                     std::vector<std::string> messages;
                     messages.push_back(String::Format("{0}: {1}").
@@ -12,6 +12,7 @@
 #include <ImfChannelList.h>
 #include <ImfHeader.h>
 #include <ImfInputFile.h>
+#include <ImfMultiPartInputFile.h>
 #include <ImfPixelType.h>
 
 namespace djv
@@ -149,6 +150,66 @@ namespace djv
                 DJV_PRIVATE();
             };
 
+            //! OpenEXR input file.
+            //!
+            //! The file is opened once and any number of layers can be read
+            //! from it. The layers of multipart files are listed part by part,
+            //! and the layers that belong to the same part are decoded together
+            //! in a single pass.
+            class InputFile
+            {
+                DJV_NON_COPYABLE(InputFile);
+
+            public:
+                //! Throws:
+                //! - std::exception
+                InputFile(const std::string& fileName, Channels);
+                ~InputFile();
+
+                //! Get the header of the first part.
+                const Imf::Header& getHeader() const;
+
+                size_t getPartCount() const;
+                const Math::BBox2i& getDisplayWindow() const;
+                const std::vector<Layer>& getLayers() const;
+
+                //! Get the image information for a layer. The image type is
+                //! None if the layer is not supported.
+                Image::Info getInfo(size_t layer) const;
+
+                //! Read a list of layers. When the region of interest is valid
+                //! only the region is read, tiled parts only decode the tiles
+                //! that cover it.
+                //!
+                //! Throws:
+                //! - std::exception
+                std::vector<std::shared_ptr<Image::Data> > read(
+                    const std::vector<size_t>&              layers,
+                    const std::shared_ptr<Image::DataPool>& = nullptr,
+                    const Math::BBox2i&                     roi = Math::BBox2i());
+
+                //! Read a layer at a reduced resolution. Tiled parts with
+                //! mipmap or ripmap levels that cover the display window are
+                //! read from the level for the proxy scale, other parts are
+                //! read at full resolution and scaled down.
+                //!
+                //! Throws:
+                //! - std::exception
+                std::shared_ptr<Image::Data> readProxy(
+                    size_t                                  layer,
+                    size_t                                  proxyScale,
+                    const std::shared_ptr<Image::DataPool>& = nullptr);
+
+            private:
+                void _read(
+                    size_t                                             part,
+                    const std::vector<size_t>&                         layers,
+                    const std::vector<std::shared_ptr<Image::Data> >&,
+                    const Math::BBox2i&                                window);
+
+                DJV_PRIVATE();
+            };
+
             //! OpenEXR reader.
             class Read : public IO::ISequenceRead
             {
@@ -168,13 +229,27 @@ namespace djv
                     const std::shared_ptr<System::ResourceSystem>&,
                     const std::shared_ptr<System::LogSystem>&);
 
+                bool hasROI() const override;
+
             protected:
                 IO::Info _readInfo(const std::string& fileName) override;
                 std::shared_ptr<Image::Data> _readImage(const std::string& fileName) override;
+                std::shared_ptr<Image::Data> _readLayer(const std::string& fileName, size_t layer) override;
+                std::vector<std::shared_ptr<Image::Data> > _readLayers(
+                    const std::string&         fileName,
+                    const std::vector<size_t>& layers,
+                    const Math::BBox2i&        roi) override;
+                std::shared_ptr<Image::Data> _readProxy(
+                    const std::string& fileName,
+                    size_t             layer,
+                    size_t             proxyScale) override;
+                std::shared_ptr<Image::Data> _readROI(
+                    const std::string&  fileName,
+                    size_t              layer,
+                    const Math::BBox2i& roi) override;
 
             private:
-                struct File;
-                IO::Info _open(const std::string&, File&);
+                IO::Info _open(const std::string&, const InputFile&);
 
                 DJV_PRIVATE();
             };
@@ -13,7 +13,12 @@
 #include <ImfChannelList.h>
 #include <ImfHeader.h>
 #include <ImfInputFile.h>
+#include <ImfInputPart.h>
+#include <ImfPartType.h>
 #include <ImfRgbaYca.h>
+#include <ImfTiledInputPart.h>
+
+#include <algorithm>
 
 using namespace djv::Core;
 
@@ -85,188 +90,587 @@ namespace djv
             }
 #endif // DJV_MMAP
 
-            struct Read::File
+            namespace
             {
-                ~File()
+                struct Part
                 {
-                }
+                    int                                  index = 0;
+                    std::unique_ptr<Imf::InputPart>      f;
+                    std::unique_ptr<Imf::TiledInputPart> tiled;
+                    Math::BBox2i                         dataWindow;
+                };
 
-                std::unique_ptr<MemoryMappedIStream> s;
-                std::unique_ptr<Imf::InputFile>      f;
-                Math::BBox2i                         displayWindow;
-                Math::BBox2i                         dataWindow;
-                Math::BBox2i                         intersectedWindow;
-                std::vector<OpenEXR::Layer>          layers;
-                bool                                 fast              = false;
-            };
+            } // namespace
 
-            struct Read::Private
+            struct InputFile::Private
             {
-                Options options;
+                std::unique_ptr<MemoryMappedIStream>     s;
+                std::unique_ptr<Imf::MultiPartInputFile> f;
+                std::vector<Part>                        parts;
+                Math::BBox2i                             displayWindow;
+                std::vector<OpenEXR::Layer>              layers;
+                std::vector<size_t>                      layerParts;
             };
 
-            Read::Read() :
+            InputFile::InputFile(const std::string& fileName, Channels channels) :
                 _p(new Private)
+            {
+                DJV_PRIVATE_PTR();
+
+                // Open the file.
+#if defined(DJV_MMAP)
+                p.s.reset(new MemoryMappedIStream(fileName.c_str()));
+                p.f.reset(new Imf::MultiPartInputFile(*p.s.get()));
+#else // DJV_MMAP
+                p.f.reset(new Imf::MultiPartInputFile(fileName.c_str()));
+#endif // DJV_MMAP
+
+                // Get the parts. The display window is the same for all of the
+                // parts, deep data parts are skipped.
+                const int partCount = p.f->parts();
+                p.displayWindow = fromImath(p.f->header(0).displayWindow());
+                for (int i = 0; i < partCount; ++i)
+                {
+                    const Imf::Header& header = p.f->header(i);
+                    if (header.hasType() && Imf::isDeepData(header.type()))
+                    {
+                        continue;
+                    }
+                    Part part;
+                    part.index = i;
+                    part.dataWindow = fromImath(header.dataWindow());
+
+                    // Tiled parts are opened with the tiled interface so regions
+                    // can be read by tile and proxies can be read from the
+                    // mipmap or ripmap levels. A part can only be opened with
+                    // one interface.
+                    if (header.hasTileDescription())
+                    {
+                        part.tiled.reset(new Imf::TiledInputPart(*p.f, i));
+                    }
+                    else
+                    {
+                        part.f.reset(new Imf::InputPart(*p.f, i));
+                    }
+                    const size_t partIndex = p.parts.size();
+                    p.parts.push_back(std::move(part));
+
+                    // Get the layers. The layer names of multipart files are
+                    // prefixed with the part name.
+                    for (auto layer : OpenEXR::getLayers(header.channels(), channels))
+                    {
+                        if (partCount > 1 && header.hasName())
+                        {
+                            const std::string prefix = header.name() + ".";
+                            if (layer.name.compare(0, prefix.size(), prefix) != 0)
+                            {
+                                layer.name = prefix + layer.name;
+                            }
+                        }
+                        p.layers.push_back(layer);
+                        p.layerParts.push_back(partIndex);
+                    }
+                }
+            }
+
+            InputFile::~InputFile()
             {}
 
-            Read::~Read()
+            const Imf::Header& InputFile::getHeader() const
             {
-                _finish();
+                return _p->f->header(0);
             }
 
-            std::shared_ptr<Read> Read::create(
-                const System::File::Info& fileInfo,
-                const IO::ReadOptions& readOptions,
-                const Options& options,
-                const std::shared_ptr<System::TextSystem>& textSystem,
-                const std::shared_ptr<System::ResourceSystem>& resourceSystem,
-                const std::shared_ptr<System::LogSystem>& logSystem)
+            size_t InputFile::getPartCount() const
             {
-                auto out = std::shared_ptr<Read>(new Read);
-                out->_p->options = options;
-                out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+                return _p->parts.size();
+            }
+
+            const Math::BBox2i& InputFile::getDisplayWindow() const
+            {
+                return _p->displayWindow;
+            }
+
+            const std::vector<Layer>& InputFile::getLayers() const
+            {
+                return _p->layers;
+            }
+
+            Image::Info InputFile::getInfo(size_t value) const
+            {
+                DJV_PRIVATE_PTR();
+                Image::Info out;
+                const auto& layer = p.layers[value];
+                out.name = layer.name;
+                out.size.w = p.displayWindow.w();
+                out.size.h = p.displayWindow.h();
+                out.pixelAspectRatio = p.f->header(p.parts[p.layerParts[value]].index).pixelAspectRatio();
+                switch (layer.channels[0].type)
+                {
+                case Image::DataType::F16:
+                case Image::DataType::F32:
+                    out.type = Image::getFloatType(layer.channels.size(), Image::getBitDepth(layer.channels[0].type));
+                    break;
+                case Image::DataType::U32:
+                    out.type = Image::getIntType(layer.channels.size(), Image::getBitDepth(layer.channels[0].type));
+                    break;
+                default: break;
+                }
                 return out;
             }
 
-            IO::Info Read::_readInfo(const std::string& fileName)
+            std::vector<std::shared_ptr<Image::Data> > InputFile::read(
+                const std::vector<size_t>&              layers,
+                const std::shared_ptr<Image::DataPool>& dataPool,
+                const Math::BBox2i&                     roi)
             {
-                File f;
-                return _open(fileName, f);
+                DJV_PRIVATE_PTR();
+
+                // Get the window that is read, in the coordinates of the file.
+                const Math::BBox2i window = roi.isValid() ?
+                    Math::BBox2i(roi.min + p.displayWindow.min, roi.max + p.displayWindow.min) :
+                    p.displayWindow;
+
+                // Create the images, a layer that is requested more than once
+                // shares the same image.
+                std::vector<std::shared_ptr<Image::Data> > out;
+                std::vector<size_t> unique;
+                for (size_t i = 0; i < layers.size(); ++i)
+                {
+                    const size_t layer = std::min(layers[i], p.layers.size() - 1);
+                    const auto j = std::find(unique.begin(), unique.end(), layer);
+                    if (j != unique.end())
+                    {
+                        out.push_back(out[j - unique.begin()]);
+                    }
+                    else
+                    {
+                        Image::Info info = getInfo(layer);
+                        info.size.w = window.w();
+                        info.size.h = window.h();
+                        out.push_back(Image::Data::create(info, dataPool));
+                        if (roi.isValid())
+                        {
+                            out.back()->setROI(roi);
+                        }
+                    }
+                    unique.push_back(layer);
+                }
+
+                // Read the layers one part at a time.
+                for (size_t part = 0; part < p.parts.size(); ++part)
+                {
+                    std::vector<size_t> partLayers;
+                    std::vector<std::shared_ptr<Image::Data> > partImages;
+                    for (size_t i = 0; i < unique.size(); ++i)
+                    {
+                        if (p.layerParts[unique[i]] == part &&
+                            std::find(partLayers.begin(), partLayers.end(), unique[i]) == partLayers.end())
+                        {
+                            partLayers.push_back(unique[i]);
+                            partImages.push_back(out[i]);
+                        }
+                    }
+                    if (!partLayers.empty())
+                    {
+                        _read(part, partLayers, partImages, window);
+                    }
+                }
+
+                return out;
             }
 
-            std::shared_ptr<Image::Data> Read::_readImage(const std::string& fileName)
+            std::shared_ptr<Image::Data> InputFile::readProxy(
+                size_t                                  value,
+                size_t                                  proxyScale,
+                const std::shared_ptr<Image::DataPool>& dataPool)
             {
-                File f;
-                IO::Info info = _open(fileName, f);
-                Image::Info imageInfo = info.video[std::min(_options.layer, info.video.size() - 1)];
-                std::shared_ptr<Image::Data> out = Image::Data::create(imageInfo);
-                out->setPluginName(pluginName);
-                out->setTags(info.tags);
-                const size_t channels = Image::getChannelCount(imageInfo.type);
-                const size_t channelByteCount = Image::getByteCount(getDataType(imageInfo.type));
-                const size_t cb = channels * channelByteCount;
-                const size_t scb = imageInfo.size.w * channels * channelByteCount;
-                if (f.fast)
+                DJV_PRIVATE_PTR();
+                const size_t layer = std::min(value, p.layers.size() - 1);
+                auto& part = p.parts[p.layerParts[layer]];
+                if (!part.tiled ||
+                    part.tiled->header().tileDescription().mode == Imf::ONE_LEVEL ||
+                    part.dataWindow != p.displayWindow ||
+                    proxyScale <= 1)
+                {
+                    return IO::scaleProxy(read({ layer }, dataPool)[0], proxyScale, dataPool);
+                }
+
+                // Find the level for the proxy scale.
+                int level = 0;
+                for (size_t i = proxyScale; i > 1; i /= 2)
+                {
+                    ++level;
+                }
+                int levelX = level;
+                int levelY = level;
+                switch (part.tiled->header().tileDescription().mode)
+                {
+                case Imf::MIPMAP_LEVELS:
+                    levelX = levelY = std::min(level, part.tiled->numLevels() - 1);
+                    break;
+                case Imf::RIPMAP_LEVELS:
+                    levelX = std::min(level, part.tiled->numXLevels() - 1);
+                    levelY = std::min(level, part.tiled->numYLevels() - 1);
+                    break;
+                default: break;
+                }
+
+                // Read the tiles of the level directly into the image.
+                const Math::BBox2i levelWindow = fromImath(part.tiled->dataWindowForLevel(levelX, levelY));
+                Image::Info info = getInfo(layer);
+                info.size.w = levelWindow.w();
+                info.size.h = levelWindow.h();
+                auto out = Image::Data::create(info, dataPool);
+                const Image::DataType dataType = Image::getDataType(info.type);
+                const size_t channels = Image::getChannelCount(info.type);
+                const size_t channelByteCount = Image::getByteCount(dataType);
+                const ptrdiff_t cb = channels * channelByteCount;
+                const ptrdiff_t scb = info.size.w * cb;
+                char* base = reinterpret_cast<char*>(out->getData()) -
+                    levelWindow.min.x * cb -
+                    levelWindow.min.y * scb;
+                Imf::FrameBuffer frameBuffer;
+                for (size_t c = 0; c < channels; ++c)
+                {
+                    frameBuffer.insert(
+                        p.layers[layer].channels[c].name.c_str(),
+                        Imf::Slice(toImf(dataType), base + c * channelByteCount, cb, scb, 1, 1, 0.F));
+                }
+                part.tiled->setFrameBuffer(frameBuffer);
+                part.tiled->readTiles(
+                    0, part.tiled->numXTiles(levelX) - 1,
+                    0, part.tiled->numYTiles(levelY) - 1,
+                    levelX, levelY);
+                return out;
+            }
+
+            void InputFile::_read(
+                size_t                                             partIndex,
+                const std::vector<size_t>&                         layers,
+                const std::vector<std::shared_ptr<Image::Data> >&  images,
+                const Math::BBox2i&                                window)
+            {
+                DJV_PRIVATE_PTR();
+                auto& part = p.parts[partIndex];
+                const Math::BBox2i& dataWindow = part.dataWindow;
+                const Math::BBox2i intersectedWindow = window.intersect(dataWindow);
+                const bool intersects =
+                    intersectedWindow.min.x <= intersectedWindow.max.x &&
+                    intersectedWindow.min.y <= intersectedWindow.max.y;
+
+                // Sub-sampled channels are read one scanline at a time. Other
+                // channels are read with a single call so OpenEXR can decode
+                // the scanline blocks in parallel. The pixels are read directly
+                // into the images when the data window fits horizontally inside
+                // the window, otherwise they are read into a buffer and the
+                // visible columns are copied. Tiled parts can't have sub-sampled
+                // channels, they are read directly when the window is the full
+                // data window, otherwise only the tiles that cover the window
+                // are read into the buffer.
+                bool subsampled = false;
+                for (const auto i : layers)
                 {
-                    Imf::FrameBuffer frameBuffer;
+                    for (const auto& channel : p.layers[i].channels)
+                    {
+                        if (channel.sampling.x != 1 || channel.sampling.y != 1)
+                        {
+                            subsampled = true;
+                        }
+                    }
+                }
+                const bool direct = part.tiled ?
+                    (dataWindow == window) :
+                    (dataWindow.min.x >= window.min.x && dataWindow.max.x <= window.max.x);
+
+                // Get the pixels that are read into the buffer.
+                Math::BBox2i readWindow = dataWindow;
+                int tileX0 = 0;
+                int tileX1 = 0;
+                int tileY0 = 0;
+                int tileY1 = 0;
+                if (part.tiled && intersects)
+                {
+                    const Imf::TileDescription& tiles = part.tiled->header().tileDescription();
+                    const int tileW = static_cast<int>(tiles.xSize);
+                    const int tileH = static_cast<int>(tiles.ySize);
+                    tileX0 = (intersectedWindow.min.x - dataWindow.min.x) / tileW;
+                    tileX1 = (intersectedWindow.max.x - dataWindow.min.x) / tileW;
+                    tileY0 = (intersectedWindow.min.y - dataWindow.min.y) / tileH;
+                    tileY1 = (intersectedWindow.max.y - dataWindow.min.y) / tileH;
+                    readWindow.min.x = dataWindow.min.x + tileX0 * tileW;
+                    readWindow.min.y = dataWindow.min.y + tileY0 * tileH;
+                    readWindow.max.x = std::min(dataWindow.min.x + (tileX1 + 1) * tileW - 1, dataWindow.max.x);
+                    readWindow.max.y = std::min(dataWindow.min.y + (tileY1 + 1) * tileH - 1, dataWindow.max.y);
+                }
+                else if (intersects)
+                {
+                    readWindow.min.y = intersectedWindow.min.y;
+                    readWindow.max.y = intersectedWindow.max.y;
+                }
+
+                Imf::FrameBuffer frameBuffer;
+                std::vector<std::vector<char> > bufs(layers.size());
+                for (size_t i = 0; i < layers.size(); ++i)
+                {
+                    const auto& layer = p.layers[layers[i]];
+                    const Image::Info& info = images[i]->getInfo();
+                    const Image::DataType dataType = Image::getDataType(info.type);
+                    const size_t channels = Image::getChannelCount(info.type);
+                    const size_t channelByteCount = Image::getByteCount(dataType);
+                    const ptrdiff_t cb = channels * channelByteCount;
+                    const ptrdiff_t scb = info.size.w * cb;
+                    const ptrdiff_t bufScb = readWindow.w() * cb;
+                    char* base = nullptr;
+                    ptrdiff_t yStride = 0;
+                    if (subsampled)
+                    {
+                        bufs[i].resize(bufScb);
+                        base = bufs[i].data() - dataWindow.min.x * cb;
+                    }
+                    else if (direct)
+                    {
+                        base = reinterpret_cast<char*>(images[i]->getData()) -
+                            window.min.x * cb -
+                            window.min.y * scb;
+                        yStride = scb;
+                    }
+                    else
+                    {
+                        bufs[i].resize(intersects ? (bufScb * readWindow.h()) : 0);
+                        base = bufs[i].data() -
+                            readWindow.min.x * cb -
+                            readWindow.min.y * bufScb;
+                        yStride = bufScb;
+                    }
                     for (size_t c = 0; c < channels; ++c)
                     {
-                        const std::string& name = f.layers[_options.layer].channels[c].name;
-                        const glm::ivec2& sampling = f.layers[_options.layer].channels[c].sampling;
+                        const std::string& name = layer.channels[c].name;
+                        const glm::ivec2& sampling = layer.channels[c].sampling;
                         frameBuffer.insert(
                             name.c_str(),
                             Imf::Slice(
-                                toImf(Image::getDataType(imageInfo.type)),
-                                (char*)out->getData() + (c * channelByteCount),
+                                toImf(dataType),
+                                base + c * channelByteCount,
                                 cb,
-                                scb,
+                                yStride,
                                 sampling.x,
                                 sampling.y,
                                 0.F));
                     }
-                    f.f->setFrameBuffer(frameBuffer);
-                    f.f->readPixels(f.displayWindow.min.y, f.displayWindow.max.y);
+                }
+                if (part.tiled)
+                {
+                    part.tiled->setFrameBuffer(frameBuffer);
                 }
                 else
                 {
-                    Imf::FrameBuffer frameBuffer;
-                    std::vector<char> buf(f.dataWindow.w() * cb);
-                    for (int c = 0; c < channels; ++c)
+                    part.f->setFrameBuffer(frameBuffer);
+                }
+
+                if (subsampled)
+                {
+                    for (int y = window.min.y; y <= window.max.y; ++y)
                     {
-                        const std::string& name = f.layers[_options.layer].channels[c].name;
-                        const glm::ivec2& sampling = f.layers[_options.layer].channels[c].sampling;
-                        frameBuffer.insert(
-                            name.c_str(),
-                            Imf::Slice(
-                                toImf(Image::getDataType(imageInfo.type)),
-                                buf.data() - (f.dataWindow.min.x * cb) + (c * channelByteCount),
-                                cb,
-                                0,
-                                sampling.x,
-                                sampling.y,
-                                0.F));
+                        const bool line = intersects && y >= intersectedWindow.min.y && y <= intersectedWindow.max.y;
+                        if (line)
+                        {
+                            part.f->readPixels(y, y);
+                        }
+                        for (size_t i = 0; i < layers.size(); ++i)
+                        {
+                            const Image::Info& info = images[i]->getInfo();
+                            const size_t cb = Image::getChannelCount(info.type) *
+                                Image::getByteCount(Image::getDataType(info.type));
+                            const size_t scb = info.size.w * cb;
+                            uint8_t* data = images[i]->getData() + ((y - window.min.y) * scb);
+                            uint8_t* end = data + scb;
+                            if (line)
+                            {
+                                size_t size = (intersectedWindow.min.x - window.min.x) * cb;
+                                memset(data, 0, size);
+                                data += size;
+                                size = intersectedWindow.w() * cb;
+                                memcpy(
+                                    data,
+                                    bufs[i].data() + (intersectedWindow.min.x - dataWindow.min.x) * cb,
+                                    size);
+                                data += size;
+                            }
+                            memset(data, 0, end - data);
+                        }
                     }
-                    f.f->setFrameBuffer(frameBuffer);
-                    for (int y = f.displayWindow.min.y; y <= f.displayWindow.max.y; ++y)
+                }
+                else
+                {
+                    if (part.tiled && direct)
+                    {
+                        part.tiled->readTiles(
+                            0, part.tiled->numXTiles(0) - 1,
+                            0, part.tiled->numYTiles(0) - 1,
+                            0, 0);
+                    }
+                    else if (part.tiled && intersects)
                     {
-                        uint8_t* p = out->getData() + ((y - f.displayWindow.min.y) * scb);
-                        uint8_t* end = p + scb;
-                        if (y >= f.intersectedWindow.min.y && y <= f.intersectedWindow.max.y)
+                        part.tiled->readTiles(tileX0, tileX1, tileY0, tileY1, 0, 0);
+                    }
+                    else if (intersects)
+                    {
+                        part.f->readPixels(intersectedWindow.min.y, intersectedWindow.max.y);
+                    }
+                    for (size_t i = 0; i < layers.size(); ++i)
+                    {
+                        const Image::Info& info = images[i]->getInfo();
+                        const size_t cb = Image::getChannelCount(info.type) *
+                            Image::getByteCount(Image::getDataType(info.type));
+                        const size_t scb = info.size.w * cb;
+                        uint8_t* data = images[i]->getData();
+
+                        // Copy the visible columns from the buffer.
+                        if (intersects && !direct)
+                        {
+                            const size_t bufScb = readWindow.w() * cb;
+                            for (int y = intersectedWindow.min.y; y <= intersectedWindow.max.y; ++y)
+                            {
+                                memcpy(
+                                    data +
+                                    (y - window.min.y) * scb +
+                                    (intersectedWindow.min.x - window.min.x) * cb,
+                                    bufs[i].data() +
+                                    (y - readWindow.min.y) * bufScb +
+                                    (intersectedWindow.min.x - readWindow.min.x) * cb,
+                                    intersectedWindow.w() * cb);
+                            }
+                        }
+
+                        // Clear the pixels outside of the data window.
+                        for (int y = window.min.y; y <= window.max.y; ++y)
                         {
-                            size_t size = (f.intersectedWindow.min.x - f.displayWindow.min.x) * cb;
-                            memset(p, 0, size);
-                            p += size;
-                            size = f.intersectedWindow.w() * cb;
-                            f.f->readPixels(y, y);
-                            memcpy(
-                                p,
-                                buf.data() + std::max(f.displayWindow.min.x - f.dataWindow.min.x, 0) * cb,
-                                size);
-                            p += size;
+                            uint8_t* row = data + (y - window.min.y) * scb;
+                            if (intersects && y >= intersectedWindow.min.y && y <= intersectedWindow.max.y)
+                            {
+                                const size_t left = (intersectedWindow.min.x - window.min.x) * cb;
+                                const size_t right = (intersectedWindow.max.x - window.min.x + 1) * cb;
+                                memset(row, 0, left);
+                                memset(row + right, 0, scb - right);
+                            }
+                            else
+                            {
+                                memset(row, 0, scb);
+                            }
                         }
-                        memset(p, 0, end - p);
                     }
                 }
+            }
+
+            struct Read::Private
+            {
+                Options options;
+            };
+
+            Read::Read() :
+                _p(new Private)
+            {}
+
+            Read::~Read()
+            {
+                _finish();
+            }
+
+            std::shared_ptr<Read> Read::create(
+                const System::File::Info& fileInfo,
+                const IO::ReadOptions& readOptions,
+                const Options& options,
+                const std::shared_ptr<System::TextSystem>& textSystem,
+                const std::shared_ptr<System::ResourceSystem>& resourceSystem,
+                const std::shared_ptr<System::LogSystem>& logSystem)
+            {
+                auto out = std::shared_ptr<Read>(new Read);
+                out->_p->options = options;
+                out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
                 return out;
             }
 
-            IO::Info Read::_open(const std::string& fileName, File& f)
+            bool Read::hasROI() const
             {
-                DJV_PRIVATE_PTR();
+                return true;
+            }
 
-                IO::Info out;
+            IO::Info Read::_readInfo(const std::string& fileName)
+            {
+                const InputFile f(fileName, _p->options.channels);
+                return _open(fileName, f);
+            }
 
-                // Open the file.
-#if defined(DJV_MMAP)
-                f.s.reset(new MemoryMappedIStream(fileName.c_str()));
-                f.f.reset(new Imf::InputFile(*f.s.get()));
-#else // DJV_MMAP
-                f.f.reset(new Imf::InputFile(fileName.c_str()));
-#endif // DJV_MMAP
+            std::shared_ptr<Image::Data> Read::_readImage(const std::string& fileName)
+            {
+                return _readLayer(fileName, _options.layer);
+            }
+
+            std::shared_ptr<Image::Data> Read::_readLayer(const std::string& fileName, size_t value)
+            {
+                return _readLayers(fileName, { value }, Math::BBox2i())[0];
+            }
+
+            std::vector<std::shared_ptr<Image::Data> > Read::_readLayers(
+                const std::string&         fileName,
+                const std::vector<size_t>& layers,
+                const Math::BBox2i&        roi)
+            {
+                InputFile f(fileName, _p->options.channels);
+                const IO::Info info = _open(fileName, f);
+                auto out = f.read(layers, _options.dataPool, roi);
+                for (const auto& i : out)
+                {
+                    i->setPluginName(pluginName);
+                    i->setTags(info.tags);
+                }
+                return out;
+            }
+
+            std::shared_ptr<Image::Data> Read::_readProxy(const std::string& fileName, size_t layer, size_t proxyScale)
+            {
+                InputFile f(fileName, _p->options.channels);
+                const IO::Info info = _open(fileName, f);
+                auto out = f.readProxy(layer, proxyScale, _options.dataPool);
+                out->setPluginName(pluginName);
+                out->setTags(info.tags);
+                return out;
+            }
 
-                // Get the display and data windows.
-                f.displayWindow = fromImath(f.f->header().displayWindow());
-                f.dataWindow = fromImath(f.f->header().dataWindow());
-                f.intersectedWindow = f.displayWindow.intersect(f.dataWindow);
-                f.fast = f.displayWindow == f.dataWindow;
+            std::shared_ptr<Image::Data> Read::_readROI(const std::string& fileName, size_t layer, const Math::BBox2i& roi)
+            {
+                return _readLayers(fileName, { layer }, roi)[0];
+            }
+
+            IO::Info Read::_open(const std::string& fileName, const InputFile& f)
+            {
+                IO::Info out;
 
                 // Get the tags.
-                readTags(f.f->header(), out.tags, _speed);
+                readTags(f.getHeader(), out.tags, _speed);
 
                 // Get the layers.
-                f.layers = getLayers(f.f->header().channels(), p.options.channels);
                 out.fileName = fileName;
                 out.videoSequence = _sequence;
                 out.videoSpeed = _speed;
-                out.video.resize(f.layers.size());
-                for (size_t i = 0; i < f.layers.size(); ++i)
+                const size_t layerCount = f.getLayers().size();
+                for (size_t i = 0; i < layerCount; ++i)
                 {
-                    const auto& layer = f.layers[i];
-                    const glm::ivec2 sampling(layer.channels[0].sampling.x, layer.channels[0].sampling.y);
-                    if (sampling.x != 1 || sampling.y != 1)
-                        f.fast = false;
-                    auto& info = out.video[i];
-                    info.name = layer.name;
-                    info.size.w = f.displayWindow.w();
-                    info.size.h = f.displayWindow.h();
-                    info.pixelAspectRatio = f.f->header().pixelAspectRatio();
-                    switch (layer.channels[0].type)
-                    {
-                    case Image::DataType::F16:
-                    case Image::DataType::F32:
-                        info.type = Image::getFloatType(layer.channels.size(), Image::getBitDepth(layer.channels[0].type));
-                        break;
-                    case Image::DataType::U32:
-                        info.type = Image::getIntType(layer.channels.size(), Image::getBitDepth(layer.channels[0].type));
-                        break;
-                    default: break;
-                    }
+                    const Image::Info info = f.getInfo(i);
                     if (Image::Type::None == info.type)
                     {
                         throw System::File::Error(String::Format("{0}: {1}").
                             arg(fileName).
                             arg(_textSystem->getText(DJV_TEXT("error_unsupported_image_type"))));
                     }
+                    out.video.push_back(info);
+                }
+                if (out.video.empty())
+                {
+                    throw System::File::Error(String::Format("{0}: {1}").
+                        arg(fileName).
+                        arg(_textSystem->getText(DJV_TEXT("error_unsupported_image_type"))));
                 }
 
                 return out;
@@ -56,7 +56,7 @@ namespace djv
 #if defined(DJV_MMAP)
                 out = Image::Data::create(imageInfo, io);
 #else // DJV_MMAP
-                out = Image::Data::create(imageInfo);
+                out = Image::Data::create(imageInfo, _options.dataPool);
                 io->read(out->getData(), out->getDataByteCount());
 #endif // DJV_MMAP
 
@@ -209,7 +209,7 @@ namespace djv
                 const auto info = _open(fileName, f);
 
                 // Read the file.
-                auto out = Image::Data::create(info.video[0]);
+                auto out = Image::Data::create(info.video[0], _options.dataPool);
                 out->setPluginName(pluginName);
                 for (uint16_t y = 0; y < info.video[0].size.h; ++y)
                 {
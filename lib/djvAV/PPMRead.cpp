@@ -38,6 +38,11 @@ namespace djv
                 return out;
             }
 
+            bool Read::hasROI() const
+            {
+                return true;
+            }
+
             IO::Info Read::_readInfo(const std::string& fileName)
             {
                 auto io = System::File::IO::create();
@@ -46,6 +51,21 @@ namespace djv
             }
 
             std::shared_ptr<Image::Data> Read::_readImage(const std::string& fileName)
+            {
+                return _read(fileName, 1, Math::BBox2i());
+            }
+
+            std::shared_ptr<Image::Data> Read::_readProxy(const std::string& fileName, size_t, size_t proxyScale)
+            {
+                return _read(fileName, proxyScale, Math::BBox2i());
+            }
+
+            std::shared_ptr<Image::Data> Read::_readROI(const std::string& fileName, size_t, const Math::BBox2i& roi)
+            {
+                return _read(fileName, 1, roi);
+            }
+
+            std::shared_ptr<Image::Data> Read::_read(const std::string& fileName, size_t proxyScale, const Math::BBox2i& roi)
             {
                 auto io = System::File::IO::create();
                 Data data = Data::First;
@@ -56,7 +76,9 @@ namespace djv
                 {
                 case Data::ASCII:
                 {
-                    out = Image::Data::create(imageInfo);
+                    // ASCII scanlines have varying lengths so the full image
+                    // is always read.
+                    out = Image::Data::create(imageInfo, _options.dataPool);
                     out->setPluginName(pluginName);
                     const size_t channelCount = Image::getChannelCount(imageInfo.type);
                     const size_t bitDepth = Image::getBitDepth(imageInfo.type);
@@ -64,6 +86,7 @@ namespace djv
                     {
                         readASCII(io, out->getData(y), imageInfo.size.w * channelCount, bitDepth);
                     }
+                    out = IO::scaleProxy(out, proxyScale, _options.dataPool);
                     break;
                 }
                 case Data::Binary:
@@ -72,10 +95,54 @@ namespace djv
                     {
                         imageInfo.layout.endian = Memory::getEndian();
                     }
+                    if (proxyScale > 1)
+                    {
+                        // Read every nth scanline and keep every nth pixel.
+                        auto proxyInfo = imageInfo;
+                        proxyInfo.size = IO::getProxySize(imageInfo.size, proxyScale);
+                        out = Image::Data::create(proxyInfo, _options.dataPool);
+                        out->setPluginName(pluginName);
+                        const size_t pixelByteCount = imageInfo.getPixelByteCount();
+                        const size_t scanlineByteCount = imageInfo.getScanlineByteCount();
+                        const size_t pos = io->getPos();
+                        std::vector<uint8_t> scanline(scanlineByteCount);
+                        for (uint16_t y = 0; y < proxyInfo.size.h; ++y)
+                        {
+                            io->setPos(pos + y * proxyScale * scanlineByteCount);
+                            io->read(scanline.data(), scanlineByteCount);
+                            const uint8_t* inP = scanline.data();
+                            uint8_t* outP = out->getData(y);
+                            for (uint16_t x = 0; x < proxyInfo.size.w; ++x)
+                            {
+                                memcpy(outP, inP, pixelByteCount);
+                                inP += pixelByteCount * proxyScale;
+                                outP += pixelByteCount;
+                            }
+                        }
+                        break;
+                    }
+                    if (roi.isValid())
+                    {
+                        // Read the part of each scanline that is in the region.
+                        auto roiInfo = imageInfo;
+                        roiInfo.size = Image::Size(roi.w(), roi.h());
+                        out = Image::Data::create(roiInfo, _options.dataPool);
+                        out->setPluginName(pluginName);
+                        out->setROI(roi);
+                        const size_t pixelByteCount = imageInfo.getPixelByteCount();
+                        const size_t scanlineByteCount = imageInfo.getScanlineByteCount();
+                        const size_t pos = io->getPos();
+                        for (uint16_t y = 0; y < roiInfo.size.h; ++y)
+                        {
+                            io->setPos(pos + (roi.min.y + y) * scanlineByteCount + roi.min.x * pixelByteCount);
+                            io->read(out->getData(y), roiInfo.size.w * pixelByteCount);
+                        }
+                        break;
+                    }
 #if defined(DJV_MMAP)
                     out = Image::Data::create(imageInfo, io);
 #else // DJV_MMAP
-                    out = Image::Data::create(imageInfo);
+                    out = Image::Data::create(imageInfo, _options.dataPool);
                     io->read(out->getData(), out->getDataByteCount());
 #endif // DJV_MMAP
                     out->setPluginName(pluginName);
@@ -130,7 +130,7 @@ namespace djv
                 std::shared_ptr<Image::Data> out;
                 auto io = System::File::IO::create();
                 const auto info = _open(fileName, io);
-                out = Image::Data::create(info.video[0]);
+                out = Image::Data::create(info.video[0], _options.dataPool);
                 out->setPluginName(pluginName);
 
                 const size_t w = info.video[0].size.w;
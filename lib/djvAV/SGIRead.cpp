@@ -191,7 +191,7 @@ namespace djv
                 std::shared_ptr<Image::Data> out;
                 auto io = System::File::IO::create();
                 const auto info = _open(fileName, io);
-                out = Image::Data::create(info.video[0]);
+                out = Image::Data::create(info.video[0], _options.dataPool);
                 out->setPluginName(pluginName);
 
                 const size_t pos = io->getPos();
@@ -200,7 +200,7 @@ namespace djv
                 const size_t channels = Image::getChannelCount(imageInfo.type);
                 const size_t bytes = Image::getByteCount(Image::getDataType(imageInfo.type));
                 const size_t dataByteCount = out->getDataByteCount();
-                std::shared_ptr<Image::Data> tmp = Image::Data::create(imageInfo);
+                std::shared_ptr<Image::Data> tmp = Image::Data::create(imageInfo, _options.dataPool);
                 if (!_compression)
                 {
                     if (1 == bytes)
@@ -4,8 +4,11 @@
 
 #include <djvAV/SequenceIO.h>
 
+#include <djvGL/GLFWSystem.h>
 #include <djvGL/ImageConvert.h>
 
+#include <djvImage/Convert.h>
+
 #include <djvAV/Speed.h>
 
 #include <djvSystem/Context.h>
@@ -19,10 +22,13 @@
 #include <djvCore/OS.h>
 #include <djvCore/String.h>
 #include <djvCore/StringFormat.h>
+#include <djvCore/ThreadPool.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <deque>
 #include <future>
 
 using namespace djv::Core;
@@ -38,18 +44,45 @@ namespace djv
                 //! \todo Should this be configurable?
                 const double infoTimeout = 0.5;
 
+                //! The weight of the most recent frame in the average decode time.
+                const float decodeTimeWeight = .1F;
+
+                //! Get whether the cache has an image that covers the region of interest.
+                bool isCached(const Cache& cache, Math::Frame::Index frame, const Math::BBox2i& roi)
+                {
+                    std::shared_ptr<Image::Data> image;
+                    return cache.get(frame, image) && coversROI(image, roi);
+                }
+
             } // namespace
 
             struct ISequenceRead::Future
             {
                 Math::Frame::Number frame = Math::Frame::invalid;
+                size_t layer = 0;
+                size_t proxyScale = 1;
                 std::shared_ptr<Image::Data> image;
+                //! The images from other layers that were read at the same time.
+                std::vector<std::pair<size_t, std::shared_ptr<Image::Data> > > otherLayers;
             };
 
             struct ISequenceRead::Private
             {
                 Math::Frame::Number frame = Math::Frame::invalid;
+                size_t layer = 0;
+                size_t proxyScale = 1;
+                Math::BBox2i roi;
+                //! The caches of the layers that are not being read, the most
+                //! recently used first.
+                std::vector<std::pair<size_t, Cache> > layerCaches;
+                size_t layerCacheByteCount = 0;
+                size_t layerCacheMaxByteCount = 0;
+                size_t frameByteCount = 0;
                 std::promise<Info> infoPromise;
+                std::shared_ptr<Thread::WorkQueue> workQueue;
+                std::deque<std::future<Future> > queueFutures;
+                bool queueEnd = false;
+                uint64_t generation = 0;
                 std::vector<std::future<Future> > cacheFutures;
                 std::condition_variable queueCV;
                 Direction direction = Direction::Forward;
@@ -68,6 +101,8 @@ namespace djv
             {
                 IRead::_init(fileInfo, options, textSystem, resourceSystem, logSystem);
                 _speed = fromSpeed(getDefaultSpeed());
+                auto threadPool = options.threadPool ? options.threadPool : Thread::ThreadPool::create();
+                _p->workQueue = threadPool->createQueue(_threadCount);
                 _p->running = true;
                 _p->thread = std::thread(
                     [this]
@@ -77,6 +112,8 @@ namespace djv
                     // Get the sequence.
                     size_t sequenceFrameCount = 0;
                     p.frame = Math::Frame::invalid;
+                    p.layer = _options.layer;
+                    p.proxyScale = std::max(_options.proxyScale, static_cast<size_t>(1));
                     if (System::File::Type::Sequence == _fileInfo.getType())
                     {
                         _sequence = _fileInfo.getSequence();
@@ -105,11 +142,8 @@ namespace djv
                     {
                         try
                         {
-                            {
-                                std::lock_guard<std::mutex> lock(_mutex);
-                                _videoQueue.setFinished(true);
-                                _audioQueue.setFinished(true);
-                            }
+                            _videoQueue.setFinished(true);
+                            _audioQueue.setFinished(true);
                             p.running = false;
                             p.infoPromise.set_exception(std::current_exception());
                         }
@@ -131,8 +165,14 @@ namespace djv
                         InOutPoints inOutPoints;
                         bool cacheEnabled = false;
                         size_t cacheMaxByteCount = 0;
+                        size_t layer = 0;
+                        size_t proxyScale = 1;
+                        Math::BBox2i roi;
                         {
                             std::lock_guard<std::mutex> lock(_mutex);
+                            layer = _layer;
+                            proxyScale = _proxyScale;
+                            roi = _roi;
                             threadCount = _threadCount;
                             playback = _playback;
                             loop = _loop;
@@ -140,14 +180,42 @@ namespace djv
                             cacheEnabled = _cacheEnabled;
                             cacheMaxByteCount = _cacheMaxByteCount;
                         }
+                        p.workQueue->setConcurrency(threadCount);
+                        if (layer != p.layer)
+                        {
+                            _layerUpdate(layer);
+                        }
+                        if (proxyScale != p.proxyScale)
+                        {
+                            // The cached frames are the wrong size, and the
+                            // decode time is measured again for the new scale.
+                            p.proxyScale = proxyScale;
+                            _cache.clear();
+                            p.layerCaches.clear();
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            _decodeTime = 0.F;
+                        }
+
+                        // The cached frames are kept when the region of interest
+                        // changes, frames that don't cover the new region are
+                        // read again when they are needed.
+                        p.roi = proxyScale == 1 && hasROI() && p.layer < info.video.size() ?
+                            getROITiles(roi, info.video[p.layer].size) :
+                            Math::BBox2i();
                         if (!cacheEnabled)
                         {
                             _cache.clear();
+                            p.layerCaches.clear();
                         }
-                        if (info.video.size() && _options.layer < info.video.size())
+                        if (info.video.size() && p.layer < info.video.size())
                         {
-                            const size_t dataByteCount = info.video[_options.layer].getDataByteCount();
-                            _cache.setMax(dataByteCount ? (cacheMaxByteCount / dataByteCount) : 0);
+                            // Use the size of the frames that have already been
+                            // cached, the image information is only an estimate.
+                            const size_t cacheCount = _cache.getCount();
+                            const size_t dataByteCount = cacheCount > 0 ?
+                                (_cache.getTotalByteCount() / cacheCount) :
+                                (info.video[p.layer].getDataByteCount() / (p.proxyScale * p.proxyScale));
+                            _cacheUpdate(dataByteCount, cacheMaxByteCount, inOutPoints);
                             _cache.setSequenceSize(info.videoSequence.getFrameCount());
                             _cache.setInOutPoints(inOutPoints);
                         }
@@ -157,6 +225,7 @@ namespace djv
                         }
 
                         // Check to see if there is work to be done.
+                        const size_t window = playback ? std::max(threadCount / 2, static_cast<size_t>(1)) : 1;
                         size_t queueCount = 0;
                         Math::Frame::Number seek = Math::Frame::invalid;
                         {
@@ -164,25 +233,33 @@ namespace djv
                             if (p.queueCV.wait_for(
                                 lock,
                                 std::chrono::milliseconds(timeout),
-                                [this]
+                                [this, window]
                                 {
-                                    return _hasWork();
+                                    return _hasWork(window);
                                 }))
                             {
-                                queueCount = _getQueueCount(playback ? (threadCount / 2) : 1);
+                                bool queueReset = false;
                                 if (p.direction != _direction)
                                 {
                                     p.direction = _direction;
                                     _videoQueue.setFinished(false);
-                                    _videoQueue.clearFrames();
+                                    p.generation = _videoQueue.clearFrames();
+                                    queueReset = true;
                                 }
                                 if (p.seek != Math::Frame::invalid)
                                 {
                                     seek = p.seek;
                                     p.seek = Math::Frame::invalid;
                                     _videoQueue.setFinished(false);
-                                    _videoQueue.clearFrames();
+                                    p.generation = _videoQueue.clearFrames();
+                                    queueReset = true;
+                                }
+                                if (queueReset)
+                                {
+                                    p.queueFutures.clear();
+                                    p.queueEnd = false;
                                 }
+                                queueCount = _getQueueCount(window);
                             }
                         }
                         if (seek != Math::Frame::invalid)
@@ -196,16 +273,16 @@ namespace djv
                         }
 
                         // Fill the queue.
-                        size_t read = 0;
-                        if (queueCount > 0)
-                        {
-                            read = _readQueue(queueCount, loop, cacheEnabled);
-                        }
+                        _readQueue(queueCount, loop, cacheEnabled);
 
                         // Fill the cache.
                         if (cacheEnabled)
                         {
-                            _readCache(playback ? (threadCount / 2) : threadCount, inOutPoints);
+                            _readCache(
+                                playback ? (threadCount / 2) : threadCount,
+                                inOutPoints,
+                                info.video.size(),
+                                !playback);
                         }
 
                         // Update information.
@@ -247,6 +324,11 @@ namespace djv
                 return _p->infoPromise.get_future();
             }
 
+            bool ISequenceRead::hasProxies() const
+            {
+                return true;
+            }
+
             void ISequenceRead::seek(Math::Frame::Number value, Direction direction)
             {
                 DJV_PRIVATE_PTR();
@@ -263,6 +345,34 @@ namespace djv
                 return _sequence.getFrameCount() > 1;
             }
 
+            std::shared_ptr<Image::Data> ISequenceRead::_readLayer(const std::string& fileName, size_t)
+            {
+                return _readImage(fileName);
+            }
+
+            std::shared_ptr<Image::Data> ISequenceRead::_readProxy(const std::string& fileName, size_t layer, size_t proxyScale)
+            {
+                return scaleProxy(_readLayer(fileName, layer), proxyScale, _options.dataPool);
+            }
+
+            std::shared_ptr<Image::Data> ISequenceRead::_readROI(const std::string& fileName, size_t layer, const Math::BBox2i&)
+            {
+                return _readLayer(fileName, layer);
+            }
+
+            std::vector<std::shared_ptr<Image::Data> > ISequenceRead::_readLayers(
+                const std::string&         fileName,
+                const std::vector<size_t>& layers,
+                const Math::BBox2i&        roi)
+            {
+                std::vector<std::shared_ptr<Image::Data> > out;
+                for (const auto i : layers)
+                {
+                    out.push_back(roi.isValid() ? _readROI(fileName, i, roi) : _readLayer(fileName, i));
+                }
+                return out;
+            }
+
             void ISequenceRead::_finish()
             {
                 DJV_PRIVATE_PTR();
@@ -272,33 +382,71 @@ namespace djv
                     //! \todo How do we safely detach the thread here so we don't block?
                     p.thread.join();
                 }
+                p.workQueue->finish();
             }
 
-            bool ISequenceRead::_hasWork() const
+            bool ISequenceRead::_hasWork(size_t window) const
             {
-                const bool queue = (_videoQueue.getCount() < _videoQueue.getMax()) && !_videoQueue.isFinished();
-                const bool seek = _p->seek != Math::Frame::invalid;
-                const bool direction = _p->direction != _direction;
-                return queue || seek || direction;
+                DJV_PRIVATE_PTR();
+                const size_t inFlight = p.queueFutures.size();
+                const bool queue =
+                    (_videoQueue.getCount() + inFlight < _videoQueue.getMax()) &&
+                    inFlight < window &&
+                    !p.queueEnd &&
+                    !_videoQueue.isFinished();
+                const bool publish =
+                    inFlight > 0 &&
+                    p.queueFutures.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                const bool seek = p.seek != Math::Frame::invalid;
+                const bool direction = p.direction != _direction;
+                return queue || publish || seek || direction;
             }
 
-            size_t ISequenceRead::_getQueueCount(size_t threadCount) const
+            size_t ISequenceRead::_getQueueCount(size_t window) const
             {
-                const size_t queueMax = _videoQueue.getMax() - _videoQueue.getCount();
-                return std::min(queueMax, threadCount);
+                const size_t inFlight = _p->queueFutures.size();
+                const size_t queueCount = _videoQueue.getCount() + inFlight;
+                const size_t queueMax = _videoQueue.getMax();
+                return (queueCount < queueMax && inFlight < window) ?
+                    std::min(queueMax - queueCount, window - inFlight) :
+                    0;
             }
 
-            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Math::Frame::Number i, std::string fileName)
+            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(
+                Math::Frame::Number i,
+                size_t layer,
+                std::string fileName,
+                bool priority)
             {
-                return std::async(
-                    std::launch::async,
-                    [this, i, fileName]
+                auto promise = std::make_shared<std::promise<Future> >();
+                auto out = promise->get_future();
+                const size_t proxyScale = _p->proxyScale;
+                const Math::BBox2i roi = _p->roi;
+                _p->workQueue->push<void>(
+                    [this, promise, i, layer, proxyScale, roi, fileName]
                     {
                         Future out;
                         out.frame = i;
+                        out.layer = layer;
+                        out.proxyScale = proxyScale;
+                        float decodeTime = 0.F;
                         try
                         {
-                            out.image = _readImage(fileName);
+                            const auto start = std::chrono::steady_clock::now();
+                            if (proxyScale > 1)
+                            {
+                                out.image = _readProxy(fileName, layer, proxyScale);
+                            }
+                            else if (roi.isValid())
+                            {
+                                out.image = _readROI(fileName, layer, roi);
+                            }
+                            else
+                            {
+                                out.image = _readLayer(fileName, layer);
+                            }
+                            const std::chrono::duration<float> delta = std::chrono::steady_clock::now() - start;
+                            decodeTime = delta.count();
                         }
                         catch (const std::exception& e)
                         {
@@ -307,41 +455,110 @@ namespace djv
                                 String::Format("{0}: {1}").arg(fileName).arg(e.what()),
                                 System::LogLevel::Error);
                         }
-                        return out;
-                    });
+                        promise->set_value(out);
+
+                        // Wake up the reader thread so the frame can be published.
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            if (decodeTime > 0.F)
+                            {
+                                _decodeTime = _decodeTime > 0.F ?
+                                    (_decodeTime * (1.F - decodeTimeWeight) + decodeTime * decodeTimeWeight) :
+                                    decodeTime;
+                            }
+                        }
+                        _p->queueCV.notify_one();
+                    },
+                    priority);
+                return out;
             }
 
-            size_t ISequenceRead::_readQueue(size_t count, bool loop, bool cacheEnabled)
+            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(
+                Math::Frame::Number i,
+                std::vector<size_t> layers,
+                std::string fileName)
+            {
+                auto promise = std::make_shared<std::promise<Future> >();
+                auto out = promise->get_future();
+                const size_t proxyScale = _p->proxyScale;
+                const Math::BBox2i roi = _p->roi;
+                _p->workQueue->push<void>(
+                    [this, promise, i, layers, proxyScale, roi, fileName]
+                    {
+                        Future out;
+                        out.frame = i;
+                        out.layer = layers[0];
+                        out.proxyScale = proxyScale;
+                        try
+                        {
+                            std::vector<std::shared_ptr<Image::Data> > images;
+                            if (proxyScale > 1)
+                            {
+                                for (const auto layer : layers)
+                                {
+                                    images.push_back(_readProxy(fileName, layer, proxyScale));
+                                }
+                            }
+                            else
+                            {
+                                images = _readLayers(fileName, layers, roi);
+                            }
+                            out.image = images[0];
+                            for (size_t j = 1; j < layers.size() && j < images.size(); ++j)
+                            {
+                                out.otherLayers.push_back(std::make_pair(layers[j], images[j]));
+                            }
+                        }
+                        catch (const std::exception& e)
+                        {
+                            _logSystem->log(
+                                "djv::AV::ISequenceRead",
+                                String::Format("{0}: {1}").arg(fileName).arg(e.what()),
+                                System::LogLevel::Error);
+                        }
+                        promise->set_value(out);
+
+                        // Wake up the reader thread so the frames can be cached.
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                        }
+                        _p->queueCV.notify_one();
+                    },
+                    false);
+                return out;
+            }
+
+            void ISequenceRead::_readQueue(size_t count, bool loop, bool cacheEnabled)
             {
                 DJV_PRIVATE_PTR();
 
-                // Get frames to be added to the queue.
+                // Start reading frames to fill the window.
                 const size_t sequenceFrameCount = _sequence.getFrameCount();
-                std::vector<std::pair<Math::Frame::Number, std::shared_ptr<Image::Data> > > images;
-                std::vector<std::future<Future> > futures;
-                for (size_t i = 0; i < count; ++i)
+                if (sequenceFrameCount &&
+                    (p.frame < 0 || p.frame >= static_cast<Math::Frame::Number>(sequenceFrameCount)))
+                {
+                    p.queueEnd = true;
+                }
+                for (size_t i = 0; i < count && !p.queueEnd; ++i)
                 {
                     std::shared_ptr<Image::Data> cachedImage;
-                    if (cacheEnabled && _cache.get(p.frame, cachedImage))
+                    if (cacheEnabled && _cache.get(p.frame, cachedImage) && coversROI(cachedImage, p.roi))
                     {
-                        images.push_back(std::make_pair(p.frame, cachedImage));
+                        Future future;
+                        future.frame = p.frame;
+                        future.layer = p.layer;
+                        future.proxyScale = p.proxyScale;
+                        future.image = cachedImage;
+                        std::promise<Future> promise;
+                        promise.set_value(future);
+                        p.queueFutures.push_back(promise.get_future());
                     }
                     else
                     {
-                        if (sequenceFrameCount)
-                        {
-                            if (p.frame >= 0 && p.frame < sequenceFrameCount)
-                            {
-                                const Math::Frame::Number frameNumber = _sequence.getFrame(p.frame);
-                                const std::string fileName = _fileInfo.getFileName(frameNumber);
-                                futures.push_back(_getFuture(p.frame, fileName));
-                            }
-                        }
-                        else
-                        {
-                            const std::string fileName = _fileInfo.getFileName();
-                            futures.push_back(_getFuture(p.frame, fileName));
-                        }
+                        const std::string fileName = sequenceFrameCount ?
+                            _fileInfo.getFileName(_sequence.getFrame(p.frame)) :
+                            _fileInfo.getFileName();
+                        p.queueFutures.push_back(_getFuture(p.frame, p.layer, fileName, true));
                     }
 
                     if (sequenceFrameCount)
@@ -364,58 +581,165 @@ namespace djv
                             break;
                         default: break;
                         }
+                        p.queueEnd = p.frame < 0 || p.frame >= static_cast<Math::Frame::Number>(sequenceFrameCount);
+                    }
+                    else
+                    {
+                        p.queueEnd = true;
                     }
                 }
 
-                // Get the results.
-                for (auto& future : futures)
+                // Publish the finished frames from the head of the window,
+                // frames that finish out of order wait for the frames in
+                // front of them.
+                std::vector<Future> results;
+                while (p.queueFutures.size() &&
+                    p.queueFutures.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                 {
-                    const auto result = future.get();
-                    images.push_back(std::make_pair(result.frame, result.image));
-                    if (cacheEnabled)
+                    results.push_back(p.queueFutures.front().get());
+                    p.queueFutures.pop_front();
+                }
+                if (cacheEnabled)
+                {
+                    for (const auto& i : results)
                     {
-#if defined(DJV_MMAP)
-                        result.image->detach();
-#endif // DJV_MMAP
-                        _cache.add(result.frame, result.image);
+                        _cacheAdd(i);
                     }
                 }
-
-                // Add the frames to the queue.
+                for (const auto& i : results)
                 {
-                    std::lock_guard<std::mutex> lock(_mutex);
-                    for (const auto& i : images)
+                    if (_videoQueue.getCount() >= _videoQueue.getMax())
                     {
-                        if (_videoQueue.getCount() >= _videoQueue.getMax())
-                        {
-                            break;
-                        }
-                        _videoQueue.addFrame(VideoFrame(i.first, i.second));
+                        break;
                     }
+                    _videoQueue.addFrameWait(VideoFrame(i.frame, i.image), p.generation, p.running);
                 }
-
-                if (Math::Frame::invalid == p.frame || p.frame < 0 || p.frame >= static_cast<Math::Frame::Number>(sequenceFrameCount))
+                if (p.queueEnd && p.queueFutures.empty())
                 {
-                    std::lock_guard<std::mutex> lock(_mutex);
                     _videoQueue.setFinished(true);
                 }
+            }
 
-                return futures.size();
+            void ISequenceRead::_layerUpdate(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+
+                // Keep the frames of the previous layer, and use the frames
+                // that were kept for the new layer.
+                Cache cache;
+                auto i = std::find_if(
+                    p.layerCaches.begin(), p.layerCaches.end(),
+                    [value](const std::pair<size_t, Cache>& item)
+                    {
+                        return item.first == value;
+                    });
+                if (i != p.layerCaches.end())
+                {
+                    cache = std::move(i->second);
+                    p.layerCaches.erase(i);
+                }
+                p.layerCaches.insert(p.layerCaches.begin(), std::make_pair(p.layer, std::move(_cache)));
+                _cache = std::move(cache);
+                p.layer = value;
             }
 
-            void ISequenceRead::_readCache(size_t count, const AV::IO::InOutPoints& inOutPoints)
+            void ISequenceRead::_cacheUpdate(
+                size_t dataByteCount,
+                size_t cacheMaxByteCount,
+                const AV::IO::InOutPoints& inOutPoints)
             {
                 DJV_PRIVATE_PTR();
 
-                // Get frames to be added to the cache.
-                Math::Frame::Number frame = Math::Frame::invalid;
+                // The layers that are not being read may use up to half of the
+                // cache. When they need more, the least recently used layers
+                // are shrunk around their current frame and then removed.
+                p.frameByteCount = dataByteCount;
+                p.layerCacheMaxByteCount = cacheMaxByteCount / 2;
+                p.layerCacheByteCount = 0;
+                auto i = p.layerCaches.begin();
+                while (i != p.layerCaches.end())
                 {
-                    std::lock_guard<std::mutex> lock(_mutex);
-                    if (_videoQueue.getCount())
+                    auto& cache = i->second;
+                    cache.setInOutPoints(inOutPoints);
+                    const size_t available = p.layerCacheMaxByteCount - p.layerCacheByteCount;
+                    if (cache.getTotalByteCount() > available)
                     {
-                        frame = _videoQueue.getFrame().frame;
+                        const size_t count = cache.getCount();
+                        const size_t frameByteCount = count > 0 ? (cache.getTotalByteCount() / count) : 0;
+                        const size_t max = frameByteCount > 0 ? (available / frameByteCount) : 0;
+                        if (max > 0 && max < count)
+                        {
+                            cache.setMax(max - 1);
+                        }
+                        else
+                        {
+                            i = p.layerCaches.erase(i);
+                            continue;
+                        }
                     }
+                    p.layerCacheByteCount += cache.getTotalByteCount();
+                    ++i;
                 }
+
+                // The current layer uses the rest of the cache.
+                _cache.setMax(dataByteCount ? ((cacheMaxByteCount - p.layerCacheByteCount) / dataByteCount) : 0);
+            }
+
+            void ISequenceRead::_cacheAdd(const Future& value)
+            {
+                DJV_PRIVATE_PTR();
+                if (value.proxyScale != p.proxyScale)
+                {
+                    return;
+                }
+                std::vector<std::pair<size_t, std::shared_ptr<Image::Data> > > images;
+                images.push_back(std::make_pair(value.layer, value.image));
+                images.insert(images.end(), value.otherLayers.begin(), value.otherLayers.end());
+                for (const auto& image : images)
+                {
+                    if (!image.second)
+                    {
+                        continue;
+                    }
+                    Cache* cache = nullptr;
+                    if (image.first == p.layer)
+                    {
+                        cache = &_cache;
+                    }
+                    else
+                    {
+                        for (auto& i : p.layerCaches)
+                        {
+                            if (image.first == i.first)
+                            {
+                                cache = &i.second;
+                                break;
+                            }
+                        }
+                    }
+                    // Replace cached images that don't cover the region of
+                    // the new image.
+                    std::shared_ptr<Image::Data> cachedImage;
+                    if (cache && !(cache->get(value.frame, cachedImage) && coversROI(cachedImage, image.second->getROI())))
+                    {
+#if defined(DJV_MMAP)
+                        image.second->detach();
+#endif // DJV_MMAP
+                        cache->add(value.frame, image.second);
+                    }
+                }
+            }
+
+            void ISequenceRead::_readCache(
+                size_t count,
+                const AV::IO::InOutPoints& inOutPoints,
+                size_t layerCount,
+                bool prefetch)
+            {
+                DJV_PRIVATE_PTR();
+
+                // Get frames to be added to the cache.
+                Math::Frame::Number frame = _videoQueue.getFrameNumber();
                 if (count > 0 && frame != Math::Frame::invalid)
                 {
                     const size_t sequenceFrameCount = _sequence.getFrameCount();
@@ -438,10 +762,10 @@ namespace djv
                         const size_t max = std::min(_cache.getMax(), sequenceFrameCount);
                         for (size_t i = 0; i < max && p.cacheFutures.size() < count; ++i)
                         {
-                            if (!_cache.contains(frame))
+                            if (!isCached(_cache, frame, p.roi))
                             {
                                 const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                p.cacheFutures.push_back(_getFuture(frame, p.layer, fileName, false));
                             }
                             ++frame;
                             if (frame > range.getMax())
@@ -464,10 +788,10 @@ namespace djv
                         const size_t max = std::min(_cache.getMax(), sequenceFrameCount);
                         for (Math::Frame::Number i = 0; i < max && p.cacheFutures.size() < count; ++i)
                         {
-                            if (!_cache.contains(frame))
+                            if (!isCached(_cache, frame, p.roi))
                             {
                                 const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                p.cacheFutures.push_back(_getFuture(frame, p.layer, fileName, false));
                             }
                             --frame;
                             if (frame < range.getMin())
@@ -481,6 +805,56 @@ namespace djv
                     }
                 }
 
+                // When the current frame is cached, read the other layers of
+                // the current frame so switching layers is immediate. The layers
+                // are read together so formats that store them in the same file
+                // only decode the file once.
+                frame = _videoQueue.getFrameNumber();
+                const size_t layerCacheAvailable = p.layerCacheMaxByteCount > p.layerCacheByteCount ?
+                    (p.layerCacheMaxByteCount - p.layerCacheByteCount) :
+                    0;
+                const size_t prefetchMax = p.frameByteCount > 0 ? (layerCacheAvailable / p.frameByteCount) : 0;
+                if (prefetch &&
+                    layerCount > 1 &&
+                    frame != Math::Frame::invalid &&
+                    p.cacheFutures.empty() &&
+                    isCached(_cache, frame, p.roi) &&
+                    prefetchMax > 0)
+                {
+                    std::vector<size_t> layers;
+                    for (size_t j = 1; j < layerCount && layers.size() < prefetchMax; ++j)
+                    {
+                        const size_t layer = (p.layer + j) % layerCount;
+                        auto i = std::find_if(
+                            p.layerCaches.begin(), p.layerCaches.end(),
+                            [layer](const std::pair<size_t, Cache>& item)
+                            {
+                                return item.first == layer;
+                            });
+                        if (i == p.layerCaches.end())
+                        {
+                            Cache cache;
+                            cache.setMax(0);
+                            cache.setSequenceSize(_sequence.getFrameCount());
+                            cache.setInOutPoints(inOutPoints);
+                            p.layerCaches.push_back(std::make_pair(layer, std::move(cache)));
+                            i = p.layerCaches.end() - 1;
+                        }
+                        i->second.setCurrentFrame(frame);
+                        if (!isCached(i->second, frame, p.roi))
+                        {
+                            layers.push_back(layer);
+                        }
+                    }
+                    if (!layers.empty())
+                    {
+                        const std::string fileName = _sequence.getFrameCount() ?
+                            _fileInfo.getFileName(_sequence.getFrame(frame)) :
+                            _fileInfo.getFileName();
+                        p.cacheFutures.push_back(_getFuture(frame, layers, fileName));
+                    }
+                }
+
                 // Get the results.
                 auto i = p.cacheFutures.begin();
                 while (i != p.cacheFutures.end())
@@ -488,11 +862,7 @@ namespace djv
                     if (i->valid() &&
                         i->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        const auto result = i->get();
-#if defined(DJV_MMAP)
-                        result.image->detach();
-#endif // DJV_MMAP
-                        _cache.add(result.frame, result.image);
+                        _cacheAdd(i->get());
                         i = p.cacheFutures.erase(i);
                     }
                     else
@@ -507,7 +877,8 @@ namespace djv
                 System::File::Info fileInfo;
                 Math::Frame::Number frameNumber = Math::Frame::invalid;
                 GLFWwindow * glfwWindow = nullptr;
-                std::shared_ptr<GL::ImageConvert> convert;
+                std::shared_ptr<GL::ImageConvert> glConvert;
+                std::shared_ptr<Image::Convert> cpuConvert;
                 std::thread thread;
                 std::atomic<bool> running;
             };
@@ -540,26 +911,36 @@ namespace djv
                     }
                 }
 
+                // Images are converted on the CPU if there is no OpenGL
+                // context available, for example on a machine without a
+                // display.
+                p.cpuConvert = Image::Convert::create(options.threadPool);
+                if (GL::GLFW::isInitialized())
+                {
 #if defined(DJV_GL_ES2)
-                glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+                    glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
 #else // DJV_GL_ES2
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-                glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-                glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+                    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+                    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif // DJV_GL_ES2
-                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-                int env = 0;
-                if (OS::getIntEnv("DJV_GL_DEBUG", env) && env != 0)
-                {
-                    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+                    int env = 0;
+                    if (OS::getIntEnv("DJV_GL_DEBUG", env) && env != 0)
+                    {
+                        glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                    }
+                    p.glfwWindow = glfwCreateWindow(100, 100, "djv::IO::ISequenceWrite", NULL, NULL);
                 }
-                p.glfwWindow = glfwCreateWindow(100, 100, "djv::IO::ISequenceWrite", NULL, NULL);
                 if (!p.glfwWindow)
                 {
-                    throw System::File::Error(_textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                    _logSystem->log(
+                        "djv::AV::ISequenceWrite",
+                        _textSystem->getText(DJV_TEXT("error_glfw_window_creation")),
+                        System::LogLevel::Warning);
                 }
 
                 p.running = true;
@@ -569,36 +950,44 @@ namespace djv
                     DJV_PRIVATE_PTR();
                     try
                     {
-                        glfwMakeContextCurrent(p.glfwWindow);
+                        if (p.glfwWindow)
+                        {
+                            try
+                            {
+                                glfwMakeContextCurrent(p.glfwWindow);
 #if defined(DJV_GL_ES2)
-                        if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
+                                if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
 #else // DJV_GL_ES2
-                        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+                                if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
 #endif // DJV_GL_ES2
-                        {
-                            throw System::File::Error(_textSystem->getText(DJV_TEXT("error_glad_init")));
+                                {
+                                    throw System::File::Error(_textSystem->getText(DJV_TEXT("error_glad_init")));
+                                }
+                                p.glConvert = GL::ImageConvert::create(_textSystem, _resourceSystem);
+                            }
+                            catch (const std::exception& e)
+                            {
+                                _logSystem->log("djv::AV::ISequenceWrite", e.what(), System::LogLevel::Warning);
+                            }
                         }
 
-                        p.convert = GL::ImageConvert::create(_textSystem, _resourceSystem);
-
                         const auto timeout = System::getTimerValue(System::TimerValue::VeryFast);
                         while (p.running)
                         {
+                            size_t threadCount = 0;
+                            {
+                                std::lock_guard<std::mutex> lock(_mutex);
+                                threadCount = _threadCount;
+                            }
                             std::vector<std::shared_ptr<Image::Data> > images;
+                            while (!_videoQueue.isEmpty() && images.size() < threadCount)
                             {
-                                std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
-                                if (lock.owns_lock())
-                                {
-                                    while (!_videoQueue.isEmpty() && images.size() < _threadCount)
-                                    {
-                                        auto frame = _videoQueue.popFrame();
-                                        images.push_back(frame.data);
-                                    }
-                                    if (_videoQueue.isEmpty() && _videoQueue.isFinished())
-                                    {
-                                        p.running = false;
-                                    }
-                                }
+                                auto frame = _videoQueue.popFrame();
+                                images.push_back(frame.data);
+                            }
+                            if (_videoQueue.isFinished() && _videoQueue.isEmpty())
+                            {
+                                p.running = false;
                             }
                             if (images.size())
                             {
@@ -622,7 +1011,8 @@ namespace djv
                                         ++p.frameNumber;
                                     }
                                     auto image = images[i];
-                                    const Image::Type imageType = _getImageType(image->getType());
+                                    // YUV images are converted to RGB first.
+                                    const Image::Type imageType = _getImageType(Image::getYUVConvertType(image->getType()));
                                     if (Image::Type::None == imageType)
                                     {
                                         throw System::File::Error(String::Format("{0}: {1}").
@@ -635,7 +1025,44 @@ namespace djv
                                         const Image::Info imageInfo(image->getSize(), imageType, imageLayout);
                                         auto tmp = Image::Data::create(imageInfo);
                                         tmp->setTags(image->getTags());
-                                        p.convert->process(*image, imageInfo, *tmp);
+                                        if (p.glConvert && p.cpuConvert)
+                                        {
+                                            // Time the first conversion with both the
+                                            // GPU and the CPU and keep the faster one.
+                                            // Each is run once before timing so the
+                                            // shader compilation and texture setup of
+                                            // the first OpenGL conversion are not
+                                            // counted.
+                                            p.glConvert->process(*image, imageInfo, *tmp);
+                                            p.cpuConvert->process(*image, imageInfo, *tmp);
+                                            auto t0 = std::chrono::steady_clock::now();
+                                            p.glConvert->process(*image, imageInfo, *tmp);
+                                            auto t1 = std::chrono::steady_clock::now();
+                                            p.cpuConvert->process(*image, imageInfo, *tmp);
+                                            auto t2 = std::chrono::steady_clock::now();
+                                            const bool cpu = (t2 - t1) < (t1 - t0);
+                                            {
+                                                std::stringstream ss;
+                                                ss << "Image conversion: " << (cpu ? "CPU" : "OpenGL");
+                                                _logSystem->log("djv::AV::ISequenceWrite", ss.str());
+                                            }
+                                            if (cpu)
+                                            {
+                                                p.glConvert.reset();
+                                            }
+                                            else
+                                            {
+                                                p.cpuConvert.reset();
+                                            }
+                                        }
+                                        else if (p.glConvert)
+                                        {
+                                            p.glConvert->process(*image, imageInfo, *tmp);
+                                        }
+                                        else
+                                        {
+                                            p.cpuConvert->process(*image, imageInfo, *tmp);
+                                        }
                                         image = tmp;
                                     }
                                     futures.push_back(std::async(
@@ -675,7 +1102,8 @@ namespace djv
                             }
                         }
 
-                        p.convert.reset();
+                        p.glConvert.reset();
+                        p.cpuConvert.reset();
                     }
                     catch (const std::exception& e)
                     {
@@ -31,24 +31,60 @@ namespace djv
 
                 bool isRunning() const override;
                 std::future<Info> getInfo() override;
+                bool hasProxies() const override;
                 void seek(int64_t, Direction) override;
                 bool hasCache() const override;
 
             protected:
                 virtual Info _readInfo(const std::string& fileName) = 0;
                 virtual std::shared_ptr<Image::Data> _readImage(const std::string& fileName) = 0;
+
+                //! Read an image from the given layer. The default implementation
+                //! is for formats with a single layer.
+                virtual std::shared_ptr<Image::Data> _readLayer(const std::string& fileName, size_t layer);
+
+                //! Read an image from the given layer at a reduced resolution.
+                //! The default implementation reads the full resolution image
+                //! and scales it with scaleProxy().
+                virtual std::shared_ptr<Image::Data> _readProxy(
+                    const std::string& fileName,
+                    size_t             layer,
+                    size_t             proxyScale);
+
+                //! Read a region of an image from the given layer. The
+                //! returned image may cover more than the region, for example
+                //! when the format can't decode part of an image. The default
+                //! implementation reads the full image.
+                virtual std::shared_ptr<Image::Data> _readROI(
+                    const std::string&  fileName,
+                    size_t              layer,
+                    const Math::BBox2i& roi);
+
+                //! Read images from a list of layers. When the region is valid
+                //! only the region is read, the same as _readROI(). The default
+                //! implementation reads each layer separately, formats that
+                //! store the layers together can decode them in a single pass.
+                virtual std::vector<std::shared_ptr<Image::Data> > _readLayers(
+                    const std::string&         fileName,
+                    const std::vector<size_t>& layers,
+                    const Math::BBox2i&        roi);
+
                 void _finish();
 
                 Math::IntRational _speed;
                 Math::Frame::Sequence _sequence;
 
             private:
-                bool _hasWork() const;
-                size_t _getQueueCount(size_t threadCount) const;
+                bool _hasWork(size_t window) const;
+                size_t _getQueueCount(size_t window) const;
                 struct Future;
-                std::future<Future> _getFuture(Math::Frame::Number, std::string fileName);
-                size_t _readQueue(size_t count, bool loop, bool cacheEnabled);
-                void _readCache(size_t count, const AV::IO::InOutPoints&);
+                std::future<Future> _getFuture(Math::Frame::Number, size_t layer, std::string fileName, bool priority);
+                std::future<Future> _getFuture(Math::Frame::Number, std::vector<size_t> layers, std::string fileName);
+                void _layerUpdate(size_t);
+                void _cacheUpdate(size_t dataByteCount, size_t cacheMaxByteCount, const AV::IO::InOutPoints&);
+                void _cacheAdd(const Future&);
+                void _readQueue(size_t count, bool loop, bool cacheEnabled);
+                void _readCache(size_t count, const AV::IO::InOutPoints&, size_t layerCount, bool prefetch);
 
                 DJV_PRIVATE();
             };
@@ -68,9 +68,13 @@ namespace djv
                     const std::shared_ptr<System::ResourceSystem>&,
                     const std::shared_ptr<System::LogSystem>&);
 
+                bool hasROI() const override;
+
             protected:
                 IO::Info _readInfo(const std::string& fileName) override;
                 std::shared_ptr<Image::Data> _readImage(const std::string& fileName) override;
+                std::shared_ptr<Image::Data> _readProxy(const std::string& fileName, size_t layer, size_t proxyScale) override;
+                std::shared_ptr<Image::Data> _readROI(const std::string& fileName, size_t layer, const Math::BBox2i&) override;
 
             private:
                 struct File;
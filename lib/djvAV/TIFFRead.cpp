@@ -55,6 +55,11 @@ namespace djv
                 return out;
             }
 
+            bool Read::hasROI() const
+            {
+                return true;
+            }
+
             IO::Info Read::_readInfo(const std::string& fileName)
             {
                 File f;
@@ -66,7 +71,7 @@ namespace djv
                 std::shared_ptr<Image::Data> out;
                 File f;
                 const auto info = _open(fileName, f);
-                out = Image::Data::create(info.video[0]);
+                out = Image::Data::create(info.video[0], _options.dataPool);
                 out->setPluginName(pluginName);
                 for (uint16_t y = 0; y < info.video[0].size.h; ++y)
                 {
@@ -88,6 +93,94 @@ namespace djv
                 return out;
             }
 
+            std::shared_ptr<Image::Data> Read::_readProxy(const std::string& fileName, size_t, size_t proxyScale)
+            {
+                File f;
+                const auto info = _open(fileName, f);
+                const auto& imageInfo = info.video[0];
+                auto proxyInfo = imageInfo;
+                proxyInfo.size = IO::getProxySize(imageInfo.size, proxyScale);
+                auto out = Image::Data::create(proxyInfo, _options.dataPool);
+                out->setPluginName(pluginName);
+
+                // Compressed scanlines can only be read in order, so every
+                // scanline is decoded and every nth one is kept. Uncompressed
+                // scanlines are read directly.
+                const size_t pixelByteCount = imageInfo.getPixelByteCount();
+                std::vector<uint8_t> scanline(imageInfo.getScanlineByteCount());
+                const size_t step = f.compression ? 1 : proxyScale;
+                for (size_t y = 0; y < imageInfo.size.h; y += step)
+                {
+                    if (TIFFReadScanline(f.f, (tdata_t *)scanline.data(), static_cast<uint32>(y)) == -1)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
+                    }
+                    if (y % proxyScale != 0)
+                    {
+                        continue;
+                    }
+                    if (f.palette)
+                    {
+                        readPalette(
+                            scanline.data(),
+                            imageInfo.size.w,
+                            static_cast<int>(Image::getChannelCount(imageInfo.type)),
+                            f.colormap[0], f.colormap[1], f.colormap[2]);
+                    }
+                    const uint8_t* inP = scanline.data();
+                    uint8_t* outP = out->getData(static_cast<uint16_t>(y / proxyScale));
+                    for (uint16_t x = 0; x < proxyInfo.size.w; ++x)
+                    {
+                        memcpy(outP, inP, pixelByteCount);
+                        inP += pixelByteCount * proxyScale;
+                        outP += pixelByteCount;
+                    }
+                }
+                return out;
+            }
+
+            std::shared_ptr<Image::Data> Read::_readROI(const std::string& fileName, size_t, const Math::BBox2i& roi)
+            {
+                File f;
+                const auto info = _open(fileName, f);
+                const auto& imageInfo = info.video[0];
+                auto roiInfo = imageInfo;
+                roiInfo.size = Image::Size(roi.w(), roi.h());
+                auto out = Image::Data::create(roiInfo, _options.dataPool);
+                out->setPluginName(pluginName);
+                out->setROI(roi);
+
+                // Only the strips that contain the scanlines in the region are
+                // read, compressed strips are decoded from their start.
+                const Math::BBox2i dataROI = IO::mirrorROI(roi, imageInfo);
+                const size_t pixelByteCount = imageInfo.getPixelByteCount();
+                std::vector<uint8_t> scanline(imageInfo.getScanlineByteCount());
+                for (uint16_t y = 0; y < roiInfo.size.h; ++y)
+                {
+                    if (TIFFReadScanline(f.f, (tdata_t *)scanline.data(), static_cast<uint32>(dataROI.min.y + y)) == -1)
+                    {
+                        throw System::File::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
+                    }
+                    if (f.palette)
+                    {
+                        readPalette(
+                            scanline.data(),
+                            imageInfo.size.w,
+                            static_cast<int>(Image::getChannelCount(imageInfo.type)),
+                            f.colormap[0], f.colormap[1], f.colormap[2]);
+                    }
+                    memcpy(
+                        out->getData(y),
+                        scanline.data() + dataROI.min.x * pixelByteCount,
+                        roiInfo.size.w * pixelByteCount);
+                }
+                return out;
+            }
+
             IO::Info Read::_open(const std::string& fileName, File& f)
             {
 #if defined(DJV_PLATFORM_WINDOWS)
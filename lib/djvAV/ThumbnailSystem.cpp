@@ -6,6 +6,7 @@
 
 #include <djvAV/IOSystem.h>
 
+#include <djvGL/GLFWSystem.h>
 #include <djvGL/ImageConvert.h>
 
 #include <djvImage/Data.h>
@@ -17,6 +18,7 @@
 #include <djvSystem/Timer.h>
 
 #include <djvCore/Cache.h>
+#include <djvCore/Memory.h>
 #include <djvCore/OS.h>
 #include <djvCore/UID.h>
 
@@ -39,7 +41,7 @@ namespace djv
             const size_t infoProcessMax  = 4;
             const size_t imageProcessMax = 4;
             const size_t infoCacheMax    = 1000;
-            const size_t imageCacheMax   = 1000;
+            const size_t imageCacheMax   = 256 * Memory::megabyte;
 
             struct InfoRequest
             {
@@ -195,29 +197,39 @@ namespace djv
             p.infoCache.setMax(infoCacheMax);
             p.infoCachePercentage = 0.F;
             p.imageCache.setMax(imageCacheMax);
+            p.imageCache.setWeightCallback(
+                [](const std::shared_ptr<Image::Data>& value)
+                {
+                    return value ? value->getDataByteCount() : 0;
+                });
             p.imageCachePercentage = 0.F;
             p.clearCache = false;
 
+            // Without OpenGL the images can't be scaled, so only thumbnails
+            // at the size of the image are available.
+            if (GL::GLFW::isInitialized())
+            {
 #if defined(DJV_GL_ES2)
-            glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+                glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
 #else // DJV_GL_ES2
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+                glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+                glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif // DJV_GL_ES2
-            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-            int env = 0;
-            if (OS::getIntEnv("DJV_GL_DEBUG", env) && env != 0)
-            {
-                glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+                int env = 0;
+                if (OS::getIntEnv("DJV_GL_DEBUG", env) && env != 0)
+                {
+                    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                }
+                p.glfwWindow = glfwCreateWindow(100, 100, context->getName().c_str(), NULL, NULL);
             }
-            p.glfwWindow = glfwCreateWindow(100, 100, context->getName().c_str(), NULL, NULL);
             if (!p.glfwWindow)
             {
-                throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                _log(p.textSystem->getText(DJV_TEXT("error_glfw_window_creation")), System::LogLevel::Warning);
             }
 
             p.statsTimer = System::Timer::create(context);
@@ -244,18 +256,21 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 try
                 {
-                    glfwMakeContextCurrent(p.glfwWindow);
+                    std::shared_ptr<GL::ImageConvert> convert;
+                    if (p.glfwWindow)
+                    {
+                        glfwMakeContextCurrent(p.glfwWindow);
 #if defined(DJV_GL_ES2)
-                    if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
+                        if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
 #else // DJV_GL_ES2
-                    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+                        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
 #endif // DJV_GL_ES2
-                    {
-                        throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glad_init")));
+                        {
+                            throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glad_init")));
+                        }
+                        convert = GL::ImageConvert::create(p.textSystem, resourceSystem);
                     }
 
-                    auto convert = GL::ImageConvert::create(p.textSystem, resourceSystem);
-
                     const auto timeout = System::getTimerValue(System::TimerValue::Medium);
                     while (p.running)
                     {
@@ -547,10 +562,25 @@ namespace djv
                 {
                     try
                     {
-                        i.read = p.io->read(i.fileInfo);
-                        const auto info = i.read->getInfo().get();
+                        // Read a proxy when the thumbnail is smaller than the
+                        // image. If the information is not cached the reader is
+                        // restarted at the proxy scale.
+                        IO::Info info;
+                        IO::ReadOptions options;
+                        if (p.infoCache.get(getInfoCacheKey(i.fileInfo), info) && info.video.size() > 0)
+                        {
+                            options.proxyScale = IO::getProxyScale(info.video[0].size, i.size);
+                        }
+                        i.read = p.io->read(i.fileInfo, options);
+                        info = i.read->getInfo().get();
                         if (info.video.size() > 0)
                         {
+                            const size_t proxyScale = IO::getProxyScale(info.video[0].size, i.size);
+                            if (proxyScale != options.proxyScale && i.read->hasProxies())
+                            {
+                                i.read->setProxyScale(proxyScale);
+                                i.read->seek(0, IO::Direction::Forward);
+                            }
                             p.pendingImageRequests.push_back(std::move(i));
                         }
                         else
@@ -577,18 +607,11 @@ namespace djv
             while (i != p.pendingImageRequests.end())
             {
                 std::shared_ptr<Image::Data> image;
-                bool finished = false;
+                auto& queue = i->read->getVideoQueue();
+                const bool finished = queue.isFinished();
+                if (!queue.isEmpty())
                 {
-                    std::lock_guard<std::mutex> lock(i->read->getMutex());
-                    auto& queue = i->read->getVideoQueue();
-                    if (!queue.isEmpty())
-                    {
-                        image = queue.getFrame().data;
-                    }
-                    if (queue.isFinished())
-                    {
-                        finished = true;
-                    }
+                    image = queue.getFrame().data;
                 }
                 if (image)
                 {
@@ -614,6 +637,10 @@ namespace djv
 #if defined(DJV_GL_ES2)
                             info.type = Image::Type::RGBA_U8;
 #endif // DJV_GL_ES2
+                            if (!convert)
+                            {
+                                throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                            }
                             auto tmp = Image::Data::create(info);
                             tmp->setPluginName(image->getPluginName());
                             tmp->setTags(image->getTags());
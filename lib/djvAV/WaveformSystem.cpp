@@ -0,0 +1,496 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/WaveformSystem.h>
+
+#include <djvAV/IOSystem.h>
+
+#include <djvAudio/Data.h>
+#include <djvAudio/Waveform.h>
+
+#include <djvSystem/Context.h>
+#include <djvSystem/File.h>
+#include <djvSystem/FileIO.h>
+#include <djvSystem/FileInfo.h>
+#include <djvSystem/LogSystem.h>
+#include <djvSystem/ResourceSystem.h>
+#include <djvSystem/Timer.h>
+
+#include <djvCore/Cache.h>
+#include <djvCore/Memory.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t processMax = 2;
+            const size_t cacheMax   = 64 * Memory::megabyte;
+
+            const uint32_t cacheFileMagic   = 0x64777631;
+            const uint32_t cacheFileVersion = 1;
+
+            struct Request
+            {
+                Request() :
+                    uid(createUID())
+                {}
+
+                Request(Request&& other) noexcept :
+                    uid(other.uid),
+                    fileInfo(other.fileInfo),
+                    read(std::move(other.read)),
+                    waveform(std::move(other.waveform)),
+                    promise(std::move(other.promise))
+                {}
+
+                ~Request()
+                {}
+
+                Request& operator = (Request&& other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        uid = other.uid;
+                        fileInfo = other.fileInfo;
+                        read = std::move(other.read);
+                        waveform = std::move(other.waveform);
+                        promise = std::move(other.promise);
+                    }
+                    return *this;
+                }
+
+                UID uid = 0;
+                System::File::Info fileInfo;
+                std::shared_ptr<IO::IRead> read;
+                std::shared_ptr<Audio::Waveform> waveform;
+                std::promise<std::shared_ptr<Audio::Waveform> > promise;
+            };
+
+            size_t getCacheKey(const System::File::Info& fileInfo)
+            {
+                size_t out = 0;
+                Memory::hashCombine(out, fileInfo.getFileName());
+                Memory::hashCombine(out, fileInfo.getTime());
+                return out;
+            }
+
+            std::string getCacheFileName(const System::File::Path& path, size_t key)
+            {
+                std::stringstream ss;
+                ss << std::hex << key << ".djvwf";
+                return System::File::Path(path, ss.str()).get();
+            }
+
+            void writeCacheFile(
+                const std::string& fileName,
+                const System::File::Info& fileInfo,
+                const std::shared_ptr<Audio::Waveform>& waveform)
+            {
+                auto io = System::File::IO::create();
+                io->open(fileName, System::File::Mode::Write);
+                io->writeU32(cacheFileMagic);
+                io->writeU32(cacheFileVersion);
+                const std::string name = fileInfo.getFileName();
+                io->writeU32(static_cast<uint32_t>(name.size()));
+                io->write(name);
+                const uint64_t time = static_cast<uint64_t>(fileInfo.getTime());
+                io->write(&time, 1, sizeof(uint64_t));
+                const auto& info = waveform->getInfo();
+                io->writeU8(info.channelCount);
+                io->writeU32(static_cast<uint32_t>(info.sampleRate));
+                io->writeU32(static_cast<uint32_t>(waveform->getBlockSize()));
+                const uint64_t sampleCount = waveform->getSampleCount();
+                io->write(&sampleCount, 1, sizeof(uint64_t));
+                const auto& peaks = waveform->getLevel(0);
+                io->writeU32(static_cast<uint32_t>(peaks.size()));
+                io->writeF32(reinterpret_cast<const float*>(peaks.data()), peaks.size() * 3);
+            }
+
+            std::shared_ptr<Audio::Waveform> readCacheFile(
+                const std::string& fileName,
+                const System::File::Info& fileInfo)
+            {
+                std::shared_ptr<Audio::Waveform> out;
+                auto io = System::File::IO::create();
+                io->open(fileName, System::File::Mode::Read);
+                uint32_t magic = 0;
+                uint32_t version = 0;
+                io->readU32(&magic);
+                io->readU32(&version);
+                if (cacheFileMagic == magic && cacheFileVersion == version)
+                {
+                    // Check the file name and time in case of a hash collision.
+                    uint32_t nameSize = 0;
+                    io->readU32(&nameSize);
+                    std::string name(nameSize, 0);
+                    io->read(&name[0], nameSize);
+                    uint64_t time = 0;
+                    io->read(&time, 1, sizeof(uint64_t));
+                    if (fileInfo.getFileName() == name &&
+                        static_cast<uint64_t>(fileInfo.getTime()) == time)
+                    {
+                        uint8_t channelCount = 0;
+                        uint32_t sampleRate = 0;
+                        uint32_t blockSize = 0;
+                        uint64_t sampleCount = 0;
+                        uint32_t peakCount = 0;
+                        io->readU8(&channelCount);
+                        io->readU32(&sampleRate);
+                        io->readU32(&blockSize);
+                        io->read(&sampleCount, 1, sizeof(uint64_t));
+                        io->readU32(&peakCount);
+                        std::vector<Audio::WaveformPeak> peaks(peakCount);
+                        io->readF32(reinterpret_cast<float*>(peaks.data()), peaks.size() * 3);
+                        out = Audio::Waveform::create(Audio::Info(channelCount, Audio::Type::F32, sampleRate), blockSize);
+                        out->setPeaks(peaks, sampleCount);
+                    }
+                }
+                return out;
+            }
+
+        } // namespace
+
+        WaveformSystem::WaveformFuture::WaveformFuture()
+        {}
+
+        WaveformSystem::WaveformFuture::WaveformFuture(std::future<std::shared_ptr<Audio::Waveform> >& future, UID uid) :
+            future(std::move(future)),
+            uid(uid)
+        {}
+
+        struct WaveformSystem::Private
+        {
+            std::shared_ptr<IO::IOSystem> io;
+            System::File::Path cachePath;
+
+            std::list<Request> requests;
+            std::condition_variable requestCV;
+            std::mutex requestMutex;
+            std::list<Request> pendingRequests;
+
+            Memory::Cache<size_t, std::shared_ptr<Audio::Waveform> > cache;
+            std::atomic<float> cachePercentage;
+            std::atomic<bool> clearCache;
+
+            std::shared_ptr<System::Timer> statsTimer;
+            std::thread thread;
+            std::atomic<bool> running;
+        };
+
+        void WaveformSystem::_init(const std::shared_ptr<System::Context>& context)
+        {
+            ISystem::_init("djv::AV::WaveformSystem", context);
+
+            DJV_PRIVATE_PTR();
+
+            p.io = context->getSystemT<IO::IOSystem>();
+            addDependency(p.io);
+
+            auto resourceSystem = context->getSystemT<System::ResourceSystem>();
+            p.cachePath = System::File::Path(
+                resourceSystem->getPath(System::File::ResourcePath::Documents),
+                "WaveformCache");
+            try
+            {
+                if (!System::File::Info(p.cachePath).doesExist())
+                {
+                    System::File::mkdir(p.cachePath);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _log(e.what(), System::LogLevel::Error);
+            }
+
+            p.cache.setMax(cacheMax);
+            p.cache.setWeightCallback(
+                [](const std::shared_ptr<Audio::Waveform>& value)
+                {
+                    // The levels above the first add up to about the size of
+                    // the first level.
+                    return value ? (value->getLevel(0).size() * sizeof(Audio::WaveformPeak) * 2) : 0;
+                });
+            p.cachePercentage = 0.F;
+            p.clearCache = false;
+
+            p.statsTimer = System::Timer::create(context);
+            p.statsTimer->setRepeating(true);
+            p.statsTimer->start(
+                System::getTimerDuration(System::TimerValue::VerySlow),
+                [this](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+            {
+                DJV_PRIVATE_PTR();
+                std::stringstream ss;
+                ss << "Cache: " << p.cachePercentage << '%';
+                _log(ss.str());
+            });
+
+            auto logSystem = context->getSystemT<System::LogSystem>();
+            p.running = true;
+            p.thread = std::thread(
+                [this, logSystem]
+            {
+                DJV_PRIVATE_PTR();
+                try
+                {
+                    const auto timeout = System::getTimerValue(System::TimerValue::Medium);
+                    while (p.running)
+                    {
+                        if (p.clearCache)
+                        {
+                            p.clearCache = false;
+                            p.cache.clear();
+                            p.cachePercentage = 0.F;
+                        }
+
+                        bool requests = p.pendingRequests.size();
+                        {
+                            std::unique_lock<std::mutex> lock(p.requestMutex);
+                            if (p.requestCV.wait_for(
+                                lock,
+                                std::chrono::milliseconds(requests ? 0 : timeout),
+                                [this]
+                            {
+                                return _p->requests.size();
+                            }))
+                            {
+                                requests = true;
+                            }
+                        }
+                        if (requests)
+                        {
+                            _handleRequests();
+                        }
+                        if (p.pendingRequests.size())
+                        {
+                            // Give the readers time to decode more audio.
+                            std::this_thread::sleep_for(System::getTimerDuration(System::TimerValue::VeryFast));
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    logSystem->log("djv::AV::WaveformSystem", e.what(), System::LogLevel::Error);
+                }
+            });
+
+            _logInitTime();
+        }
+
+        WaveformSystem::WaveformSystem() :
+            _p(new Private)
+        {}
+
+        WaveformSystem::~WaveformSystem()
+        {
+            DJV_PRIVATE_PTR();
+            p.running = false;
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+        }
+
+        std::shared_ptr<WaveformSystem> WaveformSystem::create(const std::shared_ptr<System::Context>& context)
+        {
+            auto out = context->getSystemT<WaveformSystem>();
+            if (!out)
+            {
+                out = std::shared_ptr<WaveformSystem>(new WaveformSystem);
+                out->_init(context);
+            }
+            return out;
+        }
+
+        WaveformSystem::WaveformFuture WaveformSystem::getWaveform(const System::File::Info& fileInfo)
+        {
+            DJV_PRIVATE_PTR();
+            Request request;
+            request.fileInfo = fileInfo;
+            auto future = request.promise.get_future();
+            const UID uid = request.uid;
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                p.requests.push_back(std::move(request));
+            }
+            p.requestCV.notify_one();
+            return WaveformFuture(future, uid);
+        }
+
+        void WaveformSystem::cancelWaveform(UID uid)
+        {
+            DJV_PRIVATE_PTR();
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                const auto i = std::find_if(
+                    p.requests.rbegin(),
+                    p.requests.rend(),
+                    [uid](const Request& value)
+                {
+                    return value.uid == uid;
+                });
+                if (i != p.requests.rend())
+                {
+                    p.requests.erase(--(i.base()));
+                }
+            }
+        }
+
+        float WaveformSystem::getCachePercentage() const
+        {
+            return _p->cachePercentage;
+        }
+
+        void WaveformSystem::clearCache()
+        {
+            _p->clearCache = true;
+        }
+
+        void WaveformSystem::_handleRequests()
+        {
+            DJV_PRIVATE_PTR();
+
+            // Process new requests.
+            while (p.pendingRequests.size() < processMax)
+            {
+                Request i;
+                {
+                    std::unique_lock<std::mutex> lock(p.requestMutex);
+                    if (p.requests.size())
+                    {
+                        i = std::move(p.requests.front());
+                        p.requests.pop_front();
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+                try
+                {
+                    // Check the memory cache and then the disk cache.
+                    i.fileInfo.stat();
+                    const auto key = getCacheKey(i.fileInfo);
+                    std::shared_ptr<Audio::Waveform> waveform;
+                    if (!p.cache.get(key, waveform))
+                    {
+                        const std::string fileName = getCacheFileName(p.cachePath, key);
+                        if (System::File::Info(fileName).doesExist())
+                        {
+                            try
+                            {
+                                waveform = readCacheFile(fileName, i.fileInfo);
+                                if (waveform)
+                                {
+                                    p.cache.add(key, waveform);
+                                    p.cachePercentage = p.cache.getPercentageUsed();
+                                }
+                            }
+                            catch (const std::exception& e)
+                            {
+                                std::stringstream ss;
+                                ss << fileName << ": " << e.what();
+                                _log(ss.str(), System::LogLevel::Error);
+                            }
+                        }
+                    }
+                    if (waveform)
+                    {
+                        i.promise.set_value(waveform);
+                    }
+                    else
+                    {
+                        // Read the audio with a separate reader.
+                        IO::ReadOptions options;
+                        options.videoQueueSize = 0;
+                        options.audioOnly = true;
+                        i.read = p.io->read(i.fileInfo, options);
+                        const auto info = i.read->getInfo().get();
+                        if (info.audio.channelCount > 0)
+                        {
+                            i.waveform = Audio::Waveform::create(Audio::Info(
+                                info.audio.channelCount,
+                                Audio::Type::F32,
+                                info.audio.sampleRate));
+                            i.read->setPlayback(true);
+                            p.pendingRequests.push_back(std::move(i));
+                        }
+                        else
+                        {
+                            i.promise.set_value(nullptr);
+                        }
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    try
+                    {
+                        i.promise.set_exception(std::current_exception());
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), System::LogLevel::Error);
+                    }
+                }
+            }
+
+            // Process pending requests.
+            auto i = p.pendingRequests.begin();
+            while (i != p.pendingRequests.end())
+            {
+                auto& audioQueue = i->read->getAudioQueue();
+                const bool finished = audioQueue.isFinished();
+                while (!audioQueue.isEmpty())
+                {
+                    auto data = audioQueue.popFrame().data;
+                    if (data && data->getChannelCount() == i->waveform->getInfo().channelCount)
+                    {
+                        if (data->getType() != Audio::Type::F32)
+                        {
+                            data = Audio::convert(data, Audio::Type::F32);
+                        }
+                        i->waveform->add(reinterpret_cast<const Audio::F32_T*>(data->getData()), data->getSampleCount());
+                    }
+                }
+                if (finished)
+                {
+                    i->waveform->finish();
+                    const auto key = getCacheKey(i->fileInfo);
+                    p.cache.add(key, i->waveform);
+                    p.cachePercentage = p.cache.getPercentageUsed();
+                    const std::string fileName = getCacheFileName(p.cachePath, key);
+                    try
+                    {
+                        writeCacheFile(fileName, i->fileInfo, i->waveform);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::stringstream ss;
+                        ss << fileName << ": " << e.what();
+                        _log(ss.str(), System::LogLevel::Error);
+                    }
+                    i->promise.set_value(i->waveform);
+                    i = p.pendingRequests.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvSystem/ISystem.h>
+
+#include <djvCore/UID.h>
+
+#include <future>
+
+namespace djv
+{
+    namespace System
+    {
+        namespace File
+        {
+            class Info;
+
+        } // namespace File
+    } // namespace System
+
+    namespace Audio
+    {
+        class Waveform;
+
+    } // namespace Audio
+
+    namespace AV
+    {
+        //! Audio waveform system.
+        //!
+        //! Waveforms are built in the background by reading the audio with a
+        //! separate reader. They are cached in memory and on disk, where the
+        //! cache is keyed by the file name and modification time.
+        class WaveformSystem : public System::ISystem
+        {
+            DJV_NON_COPYABLE(WaveformSystem);
+
+        protected:
+            void _init(const std::shared_ptr<System::Context>&);
+            WaveformSystem();
+
+        public:
+            ~WaveformSystem() override;
+
+            //! Create a new waveform system.
+            static std::shared_ptr<WaveformSystem> create(const std::shared_ptr<System::Context>&);
+
+            //! Waveform future.
+            struct WaveformFuture
+            {
+                WaveformFuture();
+                WaveformFuture(std::future<std::shared_ptr<Audio::Waveform> >&, Core::UID);
+                std::future<std::shared_ptr<Audio::Waveform> > future;
+                Core::UID uid = 0;
+            };
+
+            //! Get the waveform for a file. The waveform is null if the file
+            //! has no audio.
+            WaveformFuture getWaveform(const System::File::Info&);
+
+            //! Cancel a waveform.
+            void cancelWaveform(Core::UID);
+
+            //! Get the cache percentage used.
+            float getCachePercentage() const;
+
+            //! Clear the memory cache.
+            void clearCache();
+
+        private:
+            void _handleRequests();
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace AV
+} // namespace djv
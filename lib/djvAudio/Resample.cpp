@@ -0,0 +1,471 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAudio/Resample.h>
+
+#include <djvMath/Math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_AUDIO_SSE
+#include <emmintrin.h>
+#endif // __SSE2__
+
+namespace djv
+{
+    namespace Audio
+    {
+        namespace
+        {
+            //! \todo Should these be configurable?
+            const size_t halfTapCountMin = 16;
+            const size_t halfTapCountMax = 128;
+            const size_t phaseCountMax   = 256;
+            const double rolloff         = .94;
+
+            size_t gcd(size_t a, size_t b)
+            {
+                while (b)
+                {
+                    const size_t tmp = a % b;
+                    a = b;
+                    b = tmp;
+                }
+                return a;
+            }
+
+            double sinc(double value)
+            {
+                return value != 0.0 ? (std::sin(Math::pi * value) / (Math::pi * value)) : 1.0;
+            }
+
+            //! Blackman window, the value ranges from -1 to 1.
+            double window(double value)
+            {
+                return
+                    .42 +
+                    .5 * std::cos(Math::pi * value) +
+                    .08 * std::cos(2.0 * Math::pi * value);
+            }
+
+            //! The size must be a multiple of four.
+            inline float dot(const float* a, const float* b, size_t size)
+            {
+#if defined(DJV_AUDIO_SSE)
+                __m128 sum = _mm_setzero_ps();
+                for (size_t i = 0; i < size; i += 4)
+                {
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                }
+                sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+                sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+                return _mm_cvtss_f32(sum);
+#else // DJV_AUDIO_SSE
+                float sum[4] = { 0.F, 0.F, 0.F, 0.F };
+                for (size_t i = 0; i < size; i += 4)
+                {
+                    sum[0] += a[i] * b[i];
+                    sum[1] += a[i + 1] * b[i + 1];
+                    sum[2] += a[i + 2] * b[i + 2];
+                    sum[3] += a[i + 3] * b[i + 3];
+                }
+                return sum[0] + sum[1] + sum[2] + sum[3];
+#endif // DJV_AUDIO_SSE
+            }
+
+#define _TO_F32(t) \
+    { \
+        const t##_T* inP = reinterpret_cast<const t##_T*>(in); \
+        for (size_t i = 0; i < size; ++i) \
+        { \
+            t##ToF32(inP[i], out[i]); \
+        } \
+    }
+
+            void toF32(const uint8_t* in, F32_T* out, size_t size, Type type)
+            {
+                switch (type)
+                {
+                case Type::S8:  _TO_F32(S8);  break;
+                case Type::S16: _TO_F32(S16); break;
+                case Type::S32: _TO_F32(S32); break;
+                case Type::F32: memcpy(out, in, size * sizeof(F32_T)); break;
+                case Type::F64: _TO_F32(F64); break;
+                default: break;
+                }
+            }
+
+#define _FROM_F32(t) \
+    { \
+        t##_T* outP = reinterpret_cast<t##_T*>(out); \
+        for (size_t i = 0; i < size; ++i) \
+        { \
+            F32To##t(in[i], outP[i]); \
+        } \
+    }
+
+            void fromF32(const F32_T* in, uint8_t* out, size_t size, Type type)
+            {
+                switch (type)
+                {
+                case Type::S8:  _FROM_F32(S8);  break;
+                case Type::S16: _FROM_F32(S16); break;
+                case Type::S32: _FROM_F32(S32); break;
+                case Type::F32: memcpy(out, in, size * sizeof(F32_T)); break;
+                case Type::F64: _FROM_F32(F64); break;
+                default: break;
+                }
+            }
+
+        } // namespace
+
+        std::vector<float> getChannelMatrix(uint8_t inChannelCount, uint8_t outChannelCount)
+        {
+            std::vector<float> out(outChannelCount * inChannelCount, 0.F);
+            auto set = [&out, inChannelCount](uint8_t outChannel, uint8_t inChannel, float value)
+            {
+                out[outChannel * inChannelCount + inChannel] = value;
+            };
+            const float c = 1.F / std::sqrt(2.F);
+            if (inChannelCount > 2 && outChannelCount <= 2)
+            {
+                // Mix the surround channels down to stereo.
+                std::vector<float> stereo(2 * inChannelCount, 0.F);
+                stereo[0] = 1.F;
+                stereo[inChannelCount + 1] = 1.F;
+                auto add = [&stereo, inChannelCount](uint8_t inChannel, float left, float right)
+                {
+                    stereo[inChannel] = left;
+                    stereo[inChannelCount + inChannel] = right;
+                };
+                switch (inChannelCount)
+                {
+                case 3: // L R C
+                    add(2, c, c);
+                    break;
+                case 4: // L R BL BR
+                    add(2, c, 0.F);
+                    add(3, 0.F, c);
+                    break;
+                case 5: // L R C BL BR
+                    add(2, c, c);
+                    add(3, c, 0.F);
+                    add(4, 0.F, c);
+                    break;
+                case 6: // L R C LFE BL BR
+                    add(2, c, c);
+                    add(4, c, 0.F);
+                    add(5, 0.F, c);
+                    break;
+                case 7: // L R C LFE BC SL SR
+                    add(2, c, c);
+                    add(4, c * c, c * c);
+                    add(5, c, 0.F);
+                    add(6, 0.F, c);
+                    break;
+                default: // L R C LFE BL BR SL SR
+                    add(2, c, c);
+                    if (inChannelCount >= 8)
+                    {
+                        add(4, c, 0.F);
+                        add(5, 0.F, c);
+                        add(6, c, 0.F);
+                        add(7, 0.F, c);
+                    }
+                    break;
+                }
+
+                // Normalize the rows so the mix does not clip.
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    float sum = 0.F;
+                    for (size_t j = 0; j < inChannelCount; ++j)
+                    {
+                        sum += stereo[i * inChannelCount + j];
+                    }
+                    for (size_t j = 0; j < inChannelCount; ++j)
+                    {
+                        stereo[i * inChannelCount + j] /= sum;
+                    }
+                }
+
+                for (uint8_t j = 0; j < inChannelCount; ++j)
+                {
+                    if (2 == outChannelCount)
+                    {
+                        set(0, j, stereo[j]);
+                        set(1, j, stereo[inChannelCount + j]);
+                    }
+                    else if (1 == outChannelCount)
+                    {
+                        set(0, j, (stereo[j] + stereo[inChannelCount + j]) / 2.F);
+                    }
+                }
+            }
+            else if (2 == inChannelCount && 1 == outChannelCount)
+            {
+                set(0, 0, .5F);
+                set(0, 1, .5F);
+            }
+            else if (1 == inChannelCount && outChannelCount >= 2)
+            {
+                set(0, 0, 1.F);
+                set(1, 0, 1.F);
+            }
+            else
+            {
+                for (uint8_t i = 0; i < std::min(inChannelCount, outChannelCount); ++i)
+                {
+                    set(i, i, 1.F);
+                }
+            }
+            return out;
+        }
+
+        void mixChannels(
+            const F32_T* in,
+            F32_T* out,
+            size_t sampleCount,
+            const float* matrix,
+            uint8_t inChannelCount,
+            uint8_t outChannelCount)
+        {
+            for (size_t i = 0; i < sampleCount; ++i, in += inChannelCount)
+            {
+                const float* m = matrix;
+                for (uint8_t j = 0; j < outChannelCount; ++j, ++out, m += inChannelCount)
+                {
+                    float value = 0.F;
+                    for (uint8_t k = 0; k < inChannelCount; ++k)
+                    {
+                        value += m[k] * in[k];
+                    }
+                    *out = value;
+                }
+            }
+        }
+
+        struct Resampler::Private
+        {
+            Info input;
+            Info output;
+            size_t blockSize = 0;
+            std::vector<float> matrix;
+
+            bool resample = false;
+            size_t upsample = 1;
+            size_t downsample = 1;
+            size_t phaseCount = 1;
+            size_t halfTapCount = 0;
+            size_t tapCount = 0;
+            std::vector<float> filter;
+
+            std::vector<F32_T> inputF32;
+            std::vector<F32_T> mixF32;
+            std::vector<F32_T> history;
+            size_t historyStride = 0;
+            size_t historyCount = 0;
+            size_t position = 0;
+            size_t phase = 0;
+            std::vector<F32_T> outputF32;
+        };
+
+        void Resampler::_init(const Info& input, const Info& output, size_t blockSize)
+        {
+            DJV_PRIVATE_PTR();
+            p.input = input;
+            p.output = output;
+            p.blockSize = std::max(blockSize, static_cast<size_t>(1));
+            p.matrix = getChannelMatrix(input.channelCount, output.channelCount);
+
+            p.resample =
+                input.sampleRate != output.sampleRate &&
+                input.sampleRate > 0 &&
+                output.sampleRate > 0;
+            if (p.resample)
+            {
+                const size_t d = gcd(input.sampleRate, output.sampleRate);
+                p.upsample = output.sampleRate / d;
+                p.downsample = input.sampleRate / d;
+                p.phaseCount = std::min(p.upsample, phaseCountMax);
+
+                // Lower the cutoff frequency and lengthen the filter when
+                // reducing the sample rate.
+                const double ratio = std::min(p.upsample / static_cast<double>(p.downsample), 1.0);
+                const double cutoff = ratio * rolloff;
+                p.halfTapCount = Math::clamp(
+                    static_cast<size_t>(std::ceil(halfTapCountMin / ratio)),
+                    halfTapCountMin,
+                    halfTapCountMax);
+                p.halfTapCount = (p.halfTapCount + 1) / 2 * 2;
+                p.tapCount = p.halfTapCount * 2;
+
+                // Each phase has the filter offset by a fraction of an input
+                // sample. There is one extra phase so phases can be rounded
+                // up when the phases are quantized.
+                p.filter.resize((p.phaseCount + 1) * p.tapCount);
+                for (size_t i = 0; i <= p.phaseCount; ++i)
+                {
+                    const double fraction = i / static_cast<double>(p.phaseCount);
+                    float* f = p.filter.data() + i * p.tapCount;
+                    double sum = 0.0;
+                    for (size_t j = 0; j < p.tapCount; ++j)
+                    {
+                        const double u = fraction + p.halfTapCount - 1.0 - j;
+                        const double value = cutoff * sinc(cutoff * u) * window(u / p.halfTapCount);
+                        f[j] = static_cast<float>(value);
+                        sum += value;
+                    }
+                    for (size_t j = 0; j < p.tapCount; ++j)
+                    {
+                        f[j] = static_cast<float>(f[j] / sum);
+                    }
+                }
+
+                p.historyStride = p.tapCount + p.blockSize;
+                p.history.resize(p.historyStride * output.channelCount);
+            }
+
+            p.inputF32.resize(p.blockSize * input.channelCount);
+            p.mixF32.resize(p.blockSize * output.channelCount);
+            p.outputF32.resize(getOutputSampleCountMax(p.blockSize) * output.channelCount);
+            reset();
+        }
+
+        Resampler::Resampler() :
+            _p(new Private)
+        {}
+
+        Resampler::~Resampler()
+        {}
+
+        std::shared_ptr<Resampler> Resampler::create(
+            const Info& input,
+            const Info& output,
+            size_t blockSize)
+        {
+            auto out = std::shared_ptr<Resampler>(new Resampler);
+            out->_init(input, output, blockSize);
+            return out;
+        }
+
+        const Info& Resampler::getInputInfo() const
+        {
+            return _p->input;
+        }
+
+        const Info& Resampler::getOutputInfo() const
+        {
+            return _p->output;
+        }
+
+        size_t Resampler::getBlockSize() const
+        {
+            return _p->blockSize;
+        }
+
+        size_t Resampler::getOutputSampleCountMax(size_t value) const
+        {
+            DJV_PRIVATE_PTR();
+            return p.resample ?
+                (value * p.upsample / p.downsample + 2) :
+                value;
+        }
+
+        size_t Resampler::process(const uint8_t* in, size_t sampleCount, uint8_t* out)
+        {
+            DJV_PRIVATE_PTR();
+            const size_t inByteCount = p.input.getByteCount();
+            const size_t outByteCount = p.output.getByteCount();
+            size_t outSampleCount = 0;
+            for (size_t i = 0; i < sampleCount; i += p.blockSize)
+            {
+                outSampleCount += _processBlock(
+                    in + i * inByteCount,
+                    std::min(p.blockSize, sampleCount - i),
+                    out + outSampleCount * outByteCount);
+            }
+            return outSampleCount;
+        }
+
+        void Resampler::reset()
+        {
+            DJV_PRIVATE_PTR();
+            std::fill(p.history.begin(), p.history.end(), 0.F);
+            p.historyCount = p.resample ? (p.halfTapCount - 1) : 0;
+            p.position = 0;
+            p.phase = 0;
+        }
+
+        size_t Resampler::_processBlock(const uint8_t* in, size_t sampleCount, uint8_t* out)
+        {
+            DJV_PRIVATE_PTR();
+            const uint8_t inChannelCount = p.input.channelCount;
+            const uint8_t outChannelCount = p.output.channelCount;
+            toF32(in, p.inputF32.data(), sampleCount * inChannelCount, p.input.type);
+            mixChannels(
+                p.inputF32.data(),
+                p.mixF32.data(),
+                sampleCount,
+                p.matrix.data(),
+                inChannelCount,
+                outChannelCount);
+            if (!p.resample)
+            {
+                fromF32(p.mixF32.data(), out, sampleCount * outChannelCount, p.output.type);
+                return sampleCount;
+            }
+
+            // Append the samples to the history, which is stored by channel
+            // so the filter can run on contiguous samples.
+            for (uint8_t c = 0; c < outChannelCount; ++c)
+            {
+                F32_T* h = p.history.data() + c * p.historyStride + p.historyCount;
+                const F32_T* m = p.mixF32.data() + c;
+                for (size_t i = 0; i < sampleCount; ++i, m += outChannelCount)
+                {
+                    h[i] = *m;
+                }
+            }
+            p.historyCount += sampleCount;
+
+            // Filter.
+            size_t outSampleCount = 0;
+            F32_T* outF32 = p.outputF32.data();
+            while (p.position + p.tapCount <= p.historyCount)
+            {
+                const size_t phase = (p.phase * p.phaseCount + p.upsample / 2) / p.upsample;
+                const float* f = p.filter.data() + phase * p.tapCount;
+                for (uint8_t c = 0; c < outChannelCount; ++c, ++outF32)
+                {
+                    *outF32 = dot(f, p.history.data() + c * p.historyStride + p.position, p.tapCount);
+                }
+                ++outSampleCount;
+                p.phase += p.downsample;
+                p.position += p.phase / p.upsample;
+                p.phase %= p.upsample;
+            }
+
+            // Discard the samples that are no longer needed.
+            const size_t discard = std::min(p.position, p.historyCount);
+            if (discard > 0)
+            {
+                for (uint8_t c = 0; c < outChannelCount; ++c)
+                {
+                    F32_T* h = p.history.data() + c * p.historyStride;
+                    memmove(h, h + discard, (p.historyCount - discard) * sizeof(F32_T));
+                }
+                p.historyCount -= discard;
+                p.position -= discard;
+            }
+
+            fromF32(p.outputF32.data(), out, outSampleCount * outChannelCount, p.output.type);
+            return outSampleCount;
+        }
+
+    } // namespace Audio
+} // namespace djv
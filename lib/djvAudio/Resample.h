@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAudio/Info.h>
+
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace Audio
+    {
+        //! \name Channels
+        ///@{
+
+        //! Get a matrix for mixing audio channels. The matrix has a row for
+        //! each output channel and a column for each input channel. Channels
+        //! are expected in the usual order (left, right, center, LFE, back
+        //! left, back right, side left, side right). Surround channels are
+        //! mixed down to stereo and mono, mono is copied to the left and
+        //! right channels, and other combinations copy the channels they
+        //! have in common.
+        std::vector<float> getChannelMatrix(uint8_t inChannelCount, uint8_t outChannelCount);
+
+        //! Mix interleaved audio channels with a matrix.
+        void mixChannels(
+            const F32_T*,
+            F32_T*,
+            size_t sampleCount,
+            const float* matrix,
+            uint8_t inChannelCount,
+            uint8_t outChannelCount);
+
+        ///@}
+
+        //! Streaming sample rate and channel converter.
+        //!
+        //! The input is mixed to the output channels, resampled with a
+        //! windowed sinc polyphase filter, and converted to the output type.
+        //! The filter history is kept between calls so a stream can be
+        //! converted in blocks of any size. Memory is only allocated when
+        //! the resampler is created.
+        class Resampler
+        {
+            DJV_NON_COPYABLE(Resampler);
+
+        protected:
+            void _init(const Info& input, const Info& output, size_t blockSize);
+            Resampler();
+
+        public:
+            ~Resampler();
+
+            //! Create a new resampler. The block size is the number of input
+            //! samples converted at a time.
+            static std::shared_ptr<Resampler> create(
+                const Info& input,
+                const Info& output,
+                size_t blockSize = 1024);
+
+            //! \name Information
+            ///@{
+
+            const Info& getInputInfo() const;
+            const Info& getOutputInfo() const;
+            size_t getBlockSize() const;
+
+            //! Get the maximum number of output samples for the given number
+            //! of input samples.
+            size_t getOutputSampleCountMax(size_t inputSampleCount) const;
+
+            ///@}
+
+            //! \name Conversion
+            ///@{
+
+            //! Convert input samples, returning the number of output samples.
+            //! The output must have room for getOutputSampleCountMax()
+            //! samples.
+            size_t process(const uint8_t*, size_t sampleCount, uint8_t*);
+
+            //! Clear the filter history.
+            void reset();
+
+            ///@}
+
+        private:
+            size_t _processBlock(const uint8_t*, size_t sampleCount, uint8_t*);
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace Audio
+} // namespace djv
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAudio/RingBuffer.h>
+
+#include <djvAudio/Data.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace djv
+{
+    namespace Audio
+    {
+        bool RingBufferStats::operator == (const RingBufferStats& other) const
+        {
+            return
+                readCount == other.readCount &&
+                underrunCount == other.underrunCount &&
+                underrunSampleCount == other.underrunSampleCount;
+        }
+
+        void RingBuffer::_init(const Info& info, size_t sampleCount)
+        {
+            _info = info;
+            _sampleCount = sampleCount;
+            _sampleByteCount = info.getByteCount();
+            _data.resize(_sampleCount * _sampleByteCount);
+        }
+
+        RingBuffer::RingBuffer() :
+            _readPos(0),
+            _writePos(0),
+            _readCount(0),
+            _underrunCount(0),
+            _underrunSampleCount(0)
+        {}
+
+        std::shared_ptr<RingBuffer> RingBuffer::create(const Info& info, size_t sampleCount)
+        {
+            auto out = std::shared_ptr<RingBuffer>(new RingBuffer);
+            out->_init(info, sampleCount);
+            return out;
+        }
+
+        size_t RingBuffer::write(const uint8_t* data, size_t sampleCount)
+        {
+            const size_t writePos = _writePos.load(std::memory_order_relaxed);
+            const size_t readPos = _readPos.load(std::memory_order_acquire);
+            const size_t size = std::min(sampleCount, _sampleCount - (writePos - readPos));
+            if (size > 0)
+            {
+                // Copy the samples in up to two pieces, the second piece
+                // wrapping around to the start of the buffer.
+                const size_t offset = writePos % _sampleCount;
+                const size_t size0 = std::min(size, _sampleCount - offset);
+                memcpy(
+                    _data.data() + offset * _sampleByteCount,
+                    data,
+                    size0 * _sampleByteCount);
+                if (size0 < size)
+                {
+                    memcpy(
+                        _data.data(),
+                        data + size0 * _sampleByteCount,
+                        (size - size0) * _sampleByteCount);
+                }
+                _writePos.store(writePos + size, std::memory_order_release);
+            }
+            return size;
+        }
+
+        size_t RingBuffer::read(uint8_t* data, size_t sampleCount, float volume)
+        {
+            const size_t readPos = _readPos.load(std::memory_order_relaxed);
+            const size_t writePos = _writePos.load(std::memory_order_acquire);
+            const size_t size = std::min(sampleCount, writePos - readPos);
+            if (size > 0)
+            {
+                const size_t offset = readPos % _sampleCount;
+                const size_t size0 = std::min(size, _sampleCount - offset);
+                _copy(_data.data() + offset * _sampleByteCount, data, size0, volume);
+                if (size0 < size)
+                {
+                    _copy(_data.data(), data + size0 * _sampleByteCount, size - size0, volume);
+                }
+                _readPos.store(readPos + size, std::memory_order_release);
+            }
+            return size;
+        }
+
+        size_t RingBuffer::readOutput(uint8_t* data, size_t sampleCount, float volume, bool underrun)
+        {
+            const size_t size = read(data, sampleCount, volume);
+            _readCount.fetch_add(1, std::memory_order_relaxed);
+            if (size < sampleCount)
+            {
+                memset(data + size * _sampleByteCount, 0, (sampleCount - size) * _sampleByteCount);
+                if (underrun)
+                {
+                    _underrunCount.fetch_add(1, std::memory_order_relaxed);
+                    _underrunSampleCount.fetch_add(sampleCount - size, std::memory_order_relaxed);
+                }
+            }
+            return size;
+        }
+
+        void RingBuffer::reset()
+        {
+            _readPos.store(0, std::memory_order_relaxed);
+            _writePos.store(0, std::memory_order_release);
+        }
+
+        RingBufferStats RingBuffer::getStats() const
+        {
+            RingBufferStats out;
+            out.readCount = _readCount.load(std::memory_order_relaxed);
+            out.underrunCount = _underrunCount.load(std::memory_order_relaxed);
+            out.underrunSampleCount = _underrunSampleCount.load(std::memory_order_relaxed);
+            return out;
+        }
+
+        void RingBuffer::_copy(const uint8_t* in, uint8_t* out, size_t sampleCount, float volume) const
+        {
+            if (1.F == volume)
+            {
+                memcpy(out, in, sampleCount * _sampleByteCount);
+            }
+            else
+            {
+                Audio::volume(in, out, volume, sampleCount, _info.channelCount, _info.type);
+            }
+        }
+
+    } // namespace Audio
+} // namespace djv
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAudio/Info.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace Audio
+    {
+        //! Audio ring buffer statistics.
+        struct RingBufferStats
+        {
+            size_t readCount           = 0; //!< The number of output reads
+            size_t underrunCount       = 0; //!< The number of output reads that ran out of samples
+            size_t underrunSampleCount = 0; //!< The number of samples filled with silence by underruns
+
+            bool operator == (const RingBufferStats&) const;
+        };
+
+        //! Ring buffer of interleaved audio samples.
+        //!
+        //! The buffer is allocated when it is created and reading and writing
+        //! are wait-free, so the reader can be a real-time audio callback.
+        //! There may be one writer thread and one reader thread.
+        class RingBuffer
+        {
+            DJV_NON_COPYABLE(RingBuffer);
+
+        protected:
+            void _init(const Info&, size_t sampleCount);
+            RingBuffer();
+
+        public:
+            static std::shared_ptr<RingBuffer> create(const Info&, size_t sampleCount);
+
+            //! \name Information
+            ///@{
+
+            const Info& getInfo() const;
+            size_t getSampleCount() const;
+
+            //! Get the number of samples that can be read.
+            size_t getReadAvailable() const;
+
+            //! Get the number of samples that can be written.
+            size_t getWriteAvailable() const;
+
+            ///@}
+
+            //! \name Writing
+            ///@{
+
+            //! Write samples, returning the number of samples written.
+            size_t write(const uint8_t*, size_t sampleCount);
+
+            ///@}
+
+            //! \name Reading
+            ///@{
+
+            //! Read samples and adjust the volume, returning the number of
+            //! samples read.
+            size_t read(uint8_t*, size_t sampleCount, float volume = 1.F);
+
+            //! Read samples for audio output, filling the remainder with
+            //! silence. If the samples run out and the underrun flag is set
+            //! the underrun is added to the statistics. Returns the number of
+            //! samples read.
+            size_t readOutput(uint8_t*, size_t sampleCount, float volume, bool underrun = true);
+
+            ///@}
+
+            //! Discard the samples in the buffer. This must not be called
+            //! while the buffer is being read or written.
+            void reset();
+
+            //! \name Statistics
+            ///@{
+
+            RingBufferStats getStats() const;
+
+            ///@}
+
+        private:
+            void _copy(const uint8_t*, uint8_t*, size_t sampleCount, float volume) const;
+
+            Info _info;
+            size_t _sampleCount = 0;
+            size_t _sampleByteCount = 0;
+            std::vector<uint8_t> _data;
+            std::atomic<size_t> _readPos;
+            std::atomic<size_t> _writePos;
+            std::atomic<size_t> _readCount;
+            std::atomic<size_t> _underrunCount;
+            std::atomic<size_t> _underrunSampleCount;
+        };
+
+    } // namespace Audio
+} // namespace djv
+
+#include <djvAudio/RingBufferInline.h>
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace Audio
+    {
+        inline const Info& RingBuffer::getInfo() const
+        {
+            return _info;
+        }
+
+        inline size_t RingBuffer::getSampleCount() const
+        {
+            return _sampleCount;
+        }
+
+        inline size_t RingBuffer::getReadAvailable() const
+        {
+            const size_t readPos = _readPos.load(std::memory_order_acquire);
+            const size_t writePos = _writePos.load(std::memory_order_acquire);
+            return writePos - readPos;
+        }
+
+        inline size_t RingBuffer::getWriteAvailable() const
+        {
+            return _sampleCount - getReadAvailable();
+        }
+
+    } // namespace Audio
+} // namespace djv
@@ -0,0 +1,302 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAudio/Waveform.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_AUDIO_SSE
+#include <emmintrin.h>
+#endif // __SSE2__
+
+namespace djv
+{
+    namespace Audio
+    {
+        namespace
+        {
+            //! Get the minimum, maximum, and sum of squares of the values.
+            //! The size must be greater than zero.
+            void getStats(const F32_T* in, size_t size, float& min, float& max, float& sumSquares)
+            {
+                size_t i = 0;
+#if defined(DJV_AUDIO_SSE)
+                if (size >= 4)
+                {
+                    __m128 value = _mm_loadu_ps(in);
+                    __m128 minV = value;
+                    __m128 maxV = value;
+                    __m128 sumV = _mm_mul_ps(value, value);
+                    for (i = 4; i + 4 <= size; i += 4)
+                    {
+                        value = _mm_loadu_ps(in + i);
+                        minV = _mm_min_ps(minV, value);
+                        maxV = _mm_max_ps(maxV, value);
+                        sumV = _mm_add_ps(sumV, _mm_mul_ps(value, value));
+                    }
+                    minV = _mm_min_ps(minV, _mm_movehl_ps(minV, minV));
+                    minV = _mm_min_ss(minV, _mm_shuffle_ps(minV, minV, 1));
+                    maxV = _mm_max_ps(maxV, _mm_movehl_ps(maxV, maxV));
+                    maxV = _mm_max_ss(maxV, _mm_shuffle_ps(maxV, maxV, 1));
+                    sumV = _mm_add_ps(sumV, _mm_movehl_ps(sumV, sumV));
+                    sumV = _mm_add_ss(sumV, _mm_shuffle_ps(sumV, sumV, 1));
+                    min = _mm_cvtss_f32(minV);
+                    max = _mm_cvtss_f32(maxV);
+                    sumSquares = _mm_cvtss_f32(sumV);
+                }
+                else
+#endif // DJV_AUDIO_SSE
+                {
+                    min = in[0];
+                    max = in[0];
+                    sumSquares = in[0] * in[0];
+                    i = 1;
+                }
+                for (; i < size; ++i)
+                {
+                    const float value = in[i];
+                    min = std::min(min, value);
+                    max = std::max(max, value);
+                    sumSquares += value * value;
+                }
+            }
+
+            void combine(WaveformPeak& out, const WaveformPeak& value)
+            {
+                out.min = std::min(out.min, value.min);
+                out.max = std::max(out.max, value.max);
+            }
+
+        } // namespace
+
+        bool WaveformPeak::operator == (const WaveformPeak& other) const
+        {
+            return
+                min == other.min &&
+                max == other.max &&
+                rms == other.rms;
+        }
+
+        WaveformPeak getPeak(const F32_T* in, size_t sampleCount, uint8_t channelCount)
+        {
+            WaveformPeak out;
+            const size_t size = sampleCount * channelCount;
+            if (size > 0)
+            {
+                float sumSquares = 0.F;
+                getStats(in, size, out.min, out.max, sumSquares);
+                out.rms = std::sqrt(sumSquares / size);
+            }
+            return out;
+        }
+
+        struct Waveform::Private
+        {
+            Info info;
+            size_t blockSize = 0;
+            size_t sampleCount = 0;
+            std::vector<std::vector<WaveformPeak> > levels;
+
+            float blockMin = 0.F;
+            float blockMax = 0.F;
+            double blockSumSquares = 0.0;
+            size_t blockSampleCount = 0;
+        };
+
+        void Waveform::_init(const Info& info, size_t blockSize)
+        {
+            DJV_PRIVATE_PTR();
+            p.info = info;
+            p.blockSize = std::max(blockSize, static_cast<size_t>(1));
+            p.levels.resize(1);
+        }
+
+        Waveform::Waveform() :
+            _p(new Private)
+        {}
+
+        Waveform::~Waveform()
+        {}
+
+        std::shared_ptr<Waveform> Waveform::create(const Info& info, size_t blockSize)
+        {
+            auto out = std::shared_ptr<Waveform>(new Waveform);
+            out->_init(info, blockSize);
+            return out;
+        }
+
+        const Info& Waveform::getInfo() const
+        {
+            return _p->info;
+        }
+
+        size_t Waveform::getBlockSize() const
+        {
+            return _p->blockSize;
+        }
+
+        size_t Waveform::getSampleCount() const
+        {
+            return _p->sampleCount;
+        }
+
+        void Waveform::add(const F32_T* in, size_t sampleCount)
+        {
+            DJV_PRIVATE_PTR();
+            const uint8_t channelCount = p.info.channelCount;
+            if (!channelCount)
+            {
+                return;
+            }
+            while (sampleCount > 0)
+            {
+                const size_t size = std::min(sampleCount, p.blockSize - p.blockSampleCount);
+                float min = 0.F;
+                float max = 0.F;
+                float sumSquares = 0.F;
+                getStats(in, size * channelCount, min, max, sumSquares);
+                if (0 == p.blockSampleCount)
+                {
+                    p.blockMin = min;
+                    p.blockMax = max;
+                }
+                else
+                {
+                    p.blockMin = std::min(p.blockMin, min);
+                    p.blockMax = std::max(p.blockMax, max);
+                }
+                p.blockSumSquares += sumSquares;
+                p.blockSampleCount += size;
+                p.sampleCount += size;
+                if (p.blockSize == p.blockSampleCount)
+                {
+                    _addBlock();
+                }
+                in += size * channelCount;
+                sampleCount -= size;
+            }
+        }
+
+        void Waveform::finish()
+        {
+            DJV_PRIVATE_PTR();
+            if (p.blockSampleCount > 0)
+            {
+                _addBlock();
+            }
+
+            // Build the pyramid.
+            p.levels.resize(1);
+            while (p.levels.back().size() > 1)
+            {
+                const auto& level = p.levels.back();
+                const size_t size = level.size();
+                std::vector<WaveformPeak> next((size + 1) / 2);
+                for (size_t i = 0, j = 0; i < size; i += 2, ++j)
+                {
+                    next[j] = level[i];
+                    if (i + 1 < size)
+                    {
+                        combine(next[j], level[i + 1]);
+                        next[j].rms = std::sqrt((level[i].rms * level[i].rms + level[i + 1].rms * level[i + 1].rms) / 2.F);
+                    }
+                }
+                p.levels.push_back(std::move(next));
+            }
+        }
+
+        void Waveform::setPeaks(const std::vector<WaveformPeak>& value, size_t sampleCount)
+        {
+            DJV_PRIVATE_PTR();
+            p.levels.clear();
+            p.levels.push_back(value);
+            p.sampleCount = sampleCount;
+            p.blockSampleCount = 0;
+            p.blockSumSquares = 0.0;
+            finish();
+        }
+
+        size_t Waveform::getLevelCount() const
+        {
+            return _p->levels.size();
+        }
+
+        const std::vector<WaveformPeak>& Waveform::getLevel(size_t value) const
+        {
+            return _p->levels[value];
+        }
+
+        void Waveform::getPeaks(
+            int64_t       start,
+            int64_t       end,
+            size_t        peakCount,
+            WaveformPeak* out) const
+        {
+            DJV_PRIVATE_PTR();
+            if (!peakCount)
+            {
+                return;
+            }
+            const int64_t sampleCount = static_cast<int64_t>(p.sampleCount);
+            if (end <= start || 0 == sampleCount || p.levels[0].empty())
+            {
+                std::fill(out, out + peakCount, WaveformPeak());
+                return;
+            }
+
+            // Use the highest level where a peak covers no more than the
+            // samples for one output peak, so each output peak only combines
+            // a few peaks.
+            const double samplesPerPeak = (end - start) / static_cast<double>(peakCount);
+            size_t level = 0;
+            while (level + 1 < p.levels.size() &&
+                (p.blockSize << (level + 1)) <= samplesPerPeak)
+            {
+                ++level;
+            }
+            const int64_t levelBlockSize = static_cast<int64_t>(p.blockSize << level);
+            const auto& peaks = p.levels[level];
+            const int64_t peaksSize = static_cast<int64_t>(peaks.size());
+
+            for (size_t i = 0; i < peakCount; ++i)
+            {
+                int64_t s0 = start + static_cast<int64_t>(i * samplesPerPeak);
+                int64_t s1 = std::max(start + static_cast<int64_t>((i + 1) * samplesPerPeak), s0 + 1);
+                if (s1 <= 0 || s0 >= sampleCount)
+                {
+                    out[i] = WaveformPeak();
+                    continue;
+                }
+                s0 = std::max(s0, static_cast<int64_t>(0));
+                s1 = std::min(s1, sampleCount);
+                const int64_t b0 = s0 / levelBlockSize;
+                const int64_t b1 = std::min((s1 - 1) / levelBlockSize + 1, peaksSize);
+                WaveformPeak peak = peaks[b0];
+                float sumSquares = peak.rms * peak.rms;
+                for (int64_t b = b0 + 1; b < b1; ++b)
+                {
+                    combine(peak, peaks[b]);
+                    sumSquares += peaks[b].rms * peaks[b].rms;
+                }
+                peak.rms = std::sqrt(sumSquares / (b1 - b0));
+                out[i] = peak;
+            }
+        }
+
+        void Waveform::_addBlock()
+        {
+            DJV_PRIVATE_PTR();
+            WaveformPeak peak;
+            peak.min = p.blockMin;
+            peak.max = p.blockMax;
+            peak.rms = static_cast<float>(std::sqrt(p.blockSumSquares / (p.blockSampleCount * p.info.channelCount)));
+            p.levels[0].push_back(peak);
+            p.blockSumSquares = 0.0;
+            p.blockSampleCount = 0;
+        }
+
+    } // namespace Audio
+} // namespace djv
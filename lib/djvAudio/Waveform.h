@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAudio/Info.h>
+
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace Audio
+    {
+        //! Audio waveform peak.
+        struct WaveformPeak
+        {
+            float min = 0.F;
+            float max = 0.F;
+            float rms = 0.F;
+
+            bool operator == (const WaveformPeak&) const;
+        };
+
+        //! \name Peaks
+        ///@{
+
+        //! Get the peak of interleaved samples. The channels are combined.
+        WaveformPeak getPeak(const F32_T*, size_t sampleCount, uint8_t channelCount);
+
+        ///@}
+
+        //! Audio waveform.
+        //!
+        //! The waveform is a pyramid of peaks. The first level has a peak for
+        //! each block of samples and each following level combines pairs of
+        //! peaks from the level below, so any range of samples can be
+        //! summarized by looking at a few peaks from one level.
+        class Waveform
+        {
+            DJV_NON_COPYABLE(Waveform);
+
+        protected:
+            void _init(const Info&, size_t blockSize);
+            Waveform();
+
+        public:
+            ~Waveform();
+
+            //! Create a new waveform. The block size is the number of samples
+            //! for each peak in the first level.
+            static std::shared_ptr<Waveform> create(const Info&, size_t blockSize = 512);
+
+            //! \name Information
+            ///@{
+
+            const Info& getInfo() const;
+            size_t getBlockSize() const;
+            size_t getSampleCount() const;
+
+            ///@}
+
+            //! \name Building
+            ///@{
+
+            //! Add interleaved samples.
+            void add(const F32_T*, size_t sampleCount);
+
+            //! Finish adding samples and build the pyramid.
+            void finish();
+
+            //! Set the first level of peaks and build the pyramid.
+            void setPeaks(const std::vector<WaveformPeak>&, size_t sampleCount);
+
+            ///@}
+
+            //! \name Levels
+            ///@{
+
+            size_t getLevelCount() const;
+            const std::vector<WaveformPeak>& getLevel(size_t) const;
+
+            ///@}
+
+            //! \name Peaks
+            ///@{
+
+            //! Summarize the samples from start to end (exclusive) into the
+            //! given number of peaks. The cost depends on the number of peaks
+            //! rather than the number of samples.
+            void getPeaks(
+                int64_t       start,
+                int64_t       end,
+                size_t        peakCount,
+                WaveformPeak* out) const;
+
+            ///@}
+
+        private:
+            void _addBlock();
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace Audio
+} // namespace djv
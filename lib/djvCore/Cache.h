@@ -6,9 +6,13 @@
 
 #include <djvCore/Core.h>
 
-#include <map>
+#include <functional>
+#include <list>
+#include <unordered_map>
 #include <vector>
 
+#include <stddef.h>
+
 namespace djv
 {
     namespace Core
@@ -17,8 +21,15 @@ namespace djv
         {
             //! Memory cache.
             //!
+            //! The cache keeps the least recently used items when it is over
+            //! capacity. Lookup, add and eviction are O(1).
+            //!
+            //! By default each item has a weight of one and the maximum is the
+            //! number of items. A weight callback may be given so that the
+            //! maximum represents something else, for example a byte count.
+            //!
             //! \todo Return an iterator from get() instead of a value?
-            template<typename T, typename U>
+            template<typename T, typename U, typename H = std::hash<T> >
             class Cache
             {
             public:
@@ -27,10 +38,14 @@ namespace djv
 
                 size_t getMax() const;
                 size_t getSize() const;
+                size_t getWeight() const;
                 float getPercentageUsed() const;
 
                 void setMax(size_t);
 
+                //! Set the callback used to calculate the weight of an item.
+                void setWeightCallback(const std::function<size_t(const U&)>&);
+
                 ///@}
 
                 //! \name Contents
@@ -43,18 +58,30 @@ namespace djv
                 void remove(const T& key);
                 void clear();
 
+                //! Get the keys, sorted.
                 std::vector<T> getKeys() const;
+
+                //! Get the values, sorted by key.
                 std::vector<U> getValues() const;
 
                 ///@}
 
             private:
+                struct Item
+                {
+                    T      key;
+                    U      value;
+                    size_t weight = 0;
+                };
+                typedef std::list<Item> List;
+
                 void _maxUpdate();
 
                 size_t _max = 10000;
-                std::map<T, U> _map;
-                mutable std::map<T, int64_t> _counts;
-                mutable int64_t _counter = 0;
+                size_t _weight = 0;
+                std::function<size_t(const U&)> _weightCallback;
+                mutable List _list;
+                std::unordered_map<T, typename List::iterator, H> _map;
             };
 
         } // namespace Memory
@@ -10,133 +10,163 @@ namespace djv
     {
         namespace Memory
         {
-            template<typename T, typename U>
-            inline size_t Cache<T, U>::getMax() const
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getMax() const
             {
                 return _max;
             }
 
-            template<typename T, typename U>
-            inline size_t Cache<T, U>::getSize() const
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getSize() const
             {
                 return _map.size();
             }
 
-            template<typename T, typename U>
-            inline float Cache<T, U>::getPercentageUsed() const
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getWeight() const
             {
-                return _map.size() / static_cast<float>(_max) * 100.F;
+                return _weight;
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::setMax(size_t value)
+            template<typename T, typename U, typename H>
+            inline float Cache<T, U, H>::getPercentageUsed() const
+            {
+                return _weight / static_cast<float>(_max) * 100.F;
+            }
+
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::setMax(size_t value)
             {
                 _max = value;
                 _maxUpdate();
             }
 
-            template<typename T, typename U>
-            inline bool Cache<T, U>::contains(const T& key) const
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::setWeightCallback(const std::function<size_t(const U&)>& value)
+            {
+                _weightCallback = value;
+                _weight = 0;
+                for (auto& i : _list)
+                {
+                    i.weight = _weightCallback ? _weightCallback(i.value) : 1;
+                    _weight += i.weight;
+                }
+                _maxUpdate();
+            }
+
+            template<typename T, typename U, typename H>
+            inline bool Cache<T, U, H>::contains(const T& key) const
             {
                 return _map.find(key) != _map.end();
             }
 
-            template<typename T, typename U>
-            inline bool Cache<T, U>::get(const T& key, U& value) const
+            template<typename T, typename U, typename H>
+            inline bool Cache<T, U, H>::get(const T& key, U& value) const
             {
-                auto i = _map.find(key);
+                const auto i = _map.find(key);
                 if (i != _map.end())
                 {
-                    value = i->second;
-                    auto j = _counts.find(key);
-                    if (j != _counts.end())
-                    {
-                        ++_counter;
-                        j->second = _counter;
-                    }
+                    // Move the item to the front of the list.
+                    _list.splice(_list.begin(), _list, i->second);
+                    value = i->second->value;
                     return true;
                 }
-                return i != _map.end();
+                return false;
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::add(const T& key, const U& value)
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::add(const T& key, const U& value)
             {
-                _map[key] = value;
-                ++_counter;
-                _counts[key] = _counter;
+                const size_t weight = _weightCallback ? _weightCallback(value) : 1;
+                const auto i = _map.find(key);
+                if (i != _map.end())
+                {
+                    _list.splice(_list.begin(), _list, i->second);
+                    _weight -= i->second->weight;
+                    i->second->value = value;
+                    i->second->weight = weight;
+                }
+                else
+                {
+                    Item item;
+                    item.key = key;
+                    item.value = value;
+                    item.weight = weight;
+                    _list.push_front(std::move(item));
+                    _map[key] = _list.begin();
+                }
+                _weight += weight;
                 _maxUpdate();
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::remove(const T& key)
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::remove(const T& key)
             {
                 const auto i = _map.find(key);
                 if (i != _map.end())
                 {
+                    _weight -= i->second->weight;
+                    _list.erase(i->second);
                     _map.erase(i);
                 }
-                const auto j = _counts.find(key);
-                if (j != _counts.end())
-                {
-                    _counts.erase(j);
-                }
-                _maxUpdate();
             }
             
-            template<typename T, typename U>
-            inline void Cache<T, U>::clear()
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::clear()
             {
+                _list.clear();
                 _map.clear();
+                _weight = 0;
             }
 
-            template<typename T, typename U>
-            inline std::vector<T> Cache<T, U>::getKeys() const
+            template<typename T, typename U, typename H>
+            inline std::vector<T> Cache<T, U, H>::getKeys() const
             {
                 std::vector<T> out;
-                for (const auto& i : _map)
+                out.reserve(_list.size());
+                for (const auto& i : _list)
                 {
-                    out.push_back(i.first);
+                    out.push_back(i.key);
                 }
+                std::sort(out.begin(), out.end());
                 return out;
             }
 
-            template<typename T, typename U>
-            inline std::vector<U> Cache<T, U>::getValues() const
+            template<typename T, typename U, typename H>
+            inline std::vector<U> Cache<T, U, H>::getValues() const
             {
+                std::vector<const Item*> items;
+                items.reserve(_list.size());
+                for (const auto& i : _list)
+                {
+                    items.push_back(&i);
+                }
+                std::sort(
+                    items.begin(),
+                    items.end(),
+                    [](const Item* a, const Item* b)
+                    {
+                        return a->key < b->key;
+                    });
                 std::vector<U> out;
-                for (const auto& i : _map)
+                out.reserve(items.size());
+                for (const auto& i : items)
                 {
-                    out.push_back(i.second);
+                    out.push_back(i->value);
                 }
                 return out;
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::_maxUpdate()
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::_maxUpdate()
             {
-                if (_map.size() > _max)
+                // Remove the least recently used items.
+                while (_weight > _max && !_list.empty())
                 {
-                    std::map<int64_t, T> sorted;
-                    for (const auto& i : _counts)
-                    {
-                        sorted[i.second] = i.first;
-                    }
-                    while (_map.size() > _max)
-                    {
-                        auto begin = sorted.begin();
-                        auto i = _map.find(begin->second);
-                        if (i != _map.end())
-                        {
-                            _map.erase(i);
-                        }
-                        auto j = _counts.find(begin->second);
-                        if (j != _counts.end())
-                        {
-                            _counts.erase(j);
-                        }
-                        sorted.erase(begin);
-                    }
+                    const auto& item = _list.back();
+                    _weight -= item.weight;
+                    _map.erase(item.key);
+                    _list.pop_back();
                 }
             }
 
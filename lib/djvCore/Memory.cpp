@@ -10,6 +10,12 @@
 
 #include <cstring>
 
+#if defined(DJV_PLATFORM_WINDOWS)
+#include <malloc.h>
+#else // DJV_PLATFORM_WINDOWS
+#include <stdlib.h>
+#endif // DJV_PLATFORM_WINDOWS
+
 namespace djv
 {
     namespace Core
@@ -167,6 +173,29 @@ namespace djv
                 }
             }
 
+            void* alignedAlloc(size_t size, size_t alignment) noexcept
+            {
+#if defined(DJV_PLATFORM_WINDOWS)
+                return _aligned_malloc(size, alignment);
+#else // DJV_PLATFORM_WINDOWS
+                void* out = nullptr;
+                if (posix_memalign(&out, alignment, size) != 0)
+                {
+                    out = nullptr;
+                }
+                return out;
+#endif // DJV_PLATFORM_WINDOWS
+            }
+
+            void alignedFree(void* value) noexcept
+            {
+#if defined(DJV_PLATFORM_WINDOWS)
+                _aligned_free(value);
+#else // DJV_PLATFORM_WINDOWS
+                free(value);
+#endif // DJV_PLATFORM_WINDOWS
+            }
+
             DJV_ENUM_HELPERS_IMPLEMENTATION(Unit);
             DJV_ENUM_HELPERS_IMPLEMENTATION(Endian);
 
@@ -80,6 +80,19 @@ namespace djv
 
             ///@}
 
+            //! \name Allocation
+            ///@{
+
+            //! Allocate memory with the given alignment. The alignment must be
+            //! a power of two and a multiple of sizeof(void*). Returns nullptr
+            //! if the memory cannot be allocated.
+            void* alignedAlloc(size_t size, size_t alignment) noexcept;
+
+            //! Free memory allocated with alignedAlloc().
+            void alignedFree(void*) noexcept;
+
+            ///@}
+
             //! Combine hashes.
             //!
             //! References:
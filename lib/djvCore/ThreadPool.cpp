@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCore/ThreadPool.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Thread
+        {
+            struct WorkQueue::Private
+            {
+                std::shared_ptr<ThreadPool> pool;
+                size_t concurrency = 1;
+                std::deque<std::function<void(void)> > priorityWork;
+                std::deque<std::function<void(void)> > work;
+                size_t running = 0;
+            };
+
+            struct ThreadPool::Private
+            {
+                std::mutex mutex;
+                std::condition_variable workCV;
+                std::condition_variable doneCV;
+                std::vector<WorkQueue::Private*> queues;
+                size_t next = 0;
+                std::vector<std::thread> threads;
+                bool running = true;
+            };
+
+            WorkQueue::WorkQueue(const std::shared_ptr<ThreadPool>& pool, size_t concurrency) :
+                _p(new Private)
+            {
+                DJV_PRIVATE_PTR();
+                p.pool = pool;
+                p.concurrency = std::max(concurrency, static_cast<size_t>(1));
+                std::lock_guard<std::mutex> lock(pool->_p->mutex);
+                pool->_p->queues.push_back(_p.get());
+            }
+
+            WorkQueue::~WorkQueue()
+            {
+                DJV_PRIVATE_PTR();
+                finish();
+                auto& poolP = *p.pool->_p;
+                std::lock_guard<std::mutex> lock(poolP.mutex);
+                const auto i = std::find(poolP.queues.begin(), poolP.queues.end(), _p.get());
+                if (i != poolP.queues.end())
+                {
+                    poolP.queues.erase(i);
+                }
+            }
+
+            size_t WorkQueue::getConcurrency() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.pool->_p->mutex);
+                return p.concurrency;
+            }
+
+            void WorkQueue::setConcurrency(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                auto& poolP = *p.pool->_p;
+                {
+                    std::lock_guard<std::mutex> lock(poolP.mutex);
+                    const size_t concurrency = std::max(value, static_cast<size_t>(1));
+                    if (concurrency == p.concurrency)
+                        return;
+                    p.concurrency = concurrency;
+                }
+                poolP.workCV.notify_all();
+            }
+
+            size_t WorkQueue::getPendingCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.pool->_p->mutex);
+                return p.priorityWork.size() + p.work.size();
+            }
+
+            size_t WorkQueue::getRunningCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.pool->_p->mutex);
+                return p.running;
+            }
+
+            void WorkQueue::clear()
+            {
+                DJV_PRIVATE_PTR();
+                std::deque<std::function<void(void)> > priorityWork;
+                std::deque<std::function<void(void)> > work;
+                {
+                    std::lock_guard<std::mutex> lock(p.pool->_p->mutex);
+                    std::swap(p.priorityWork, priorityWork);
+                    std::swap(p.work, work);
+                }
+            }
+
+            void WorkQueue::finish()
+            {
+                DJV_PRIVATE_PTR();
+                clear();
+                auto& poolP = *p.pool->_p;
+                std::unique_lock<std::mutex> lock(poolP.mutex);
+                poolP.doneCV.wait(
+                    lock,
+                    [this]
+                    {
+                        return 0 == _p->running;
+                    });
+            }
+
+            void WorkQueue::_push(std::function<void(void)>&& value, bool priority)
+            {
+                DJV_PRIVATE_PTR();
+                auto& poolP = *p.pool->_p;
+                {
+                    std::lock_guard<std::mutex> lock(poolP.mutex);
+                    if (priority)
+                    {
+                        p.priorityWork.push_back(std::move(value));
+                    }
+                    else
+                    {
+                        p.work.push_back(std::move(value));
+                    }
+                }
+                poolP.workCV.notify_one();
+            }
+
+            void ThreadPool::_init(size_t threadCount)
+            {
+                DJV_PRIVATE_PTR();
+                if (0 == threadCount)
+                {
+                    threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+                }
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    p.threads.push_back(std::thread(
+                        [this]
+                        {
+                            _run();
+                        }));
+                }
+            }
+
+            ThreadPool::ThreadPool() :
+                _p(new Private)
+            {}
+
+            ThreadPool::~ThreadPool()
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    p.running = false;
+                }
+                p.workCV.notify_all();
+                for (auto& i : p.threads)
+                {
+                    if (i.joinable())
+                    {
+                        i.join();
+                    }
+                }
+            }
+
+            std::shared_ptr<ThreadPool> ThreadPool::create(size_t threadCount)
+            {
+                auto out = std::shared_ptr<ThreadPool>(new ThreadPool);
+                out->_init(threadCount);
+                return out;
+            }
+
+            size_t ThreadPool::getThreadCount() const
+            {
+                return _p->threads.size();
+            }
+
+            std::shared_ptr<WorkQueue> ThreadPool::createQueue(size_t concurrency)
+            {
+                return std::shared_ptr<WorkQueue>(new WorkQueue(shared_from_this(), concurrency));
+            }
+
+            void ThreadPool::_run()
+            {
+                DJV_PRIVATE_PTR();
+                std::unique_lock<std::mutex> lock(p.mutex);
+                while (p.running)
+                {
+                    // Find the next queue that has work and is under its
+                    // concurrency limit.
+                    WorkQueue::Private* queue = nullptr;
+                    std::function<void(void)> work;
+                    const size_t size = p.queues.size();
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        const size_t index = (p.next + i) % size;
+                        auto q = p.queues[index];
+                        if (q->running < q->concurrency)
+                        {
+                            if (!q->priorityWork.empty())
+                            {
+                                work = std::move(q->priorityWork.front());
+                                q->priorityWork.pop_front();
+                            }
+                            else if (!q->work.empty())
+                            {
+                                work = std::move(q->work.front());
+                                q->work.pop_front();
+                            }
+                            if (work)
+                            {
+                                queue = q;
+                                p.next = index + 1;
+                                break;
+                            }
+                        }
+                    }
+
+                    if (queue)
+                    {
+                        ++queue->running;
+                        lock.unlock();
+                        work();
+                        work = nullptr;
+                        lock.lock();
+                        --queue->running;
+                        p.doneCV.notify_all();
+                    }
+                    else
+                    {
+                        p.workCV.wait(lock);
+                    }
+                }
+            }
+
+        } // namespace Thread
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! Threads.
+        namespace Thread
+        {
+            class ThreadPool;
+
+            //! Work queue.
+            //!
+            //! Each client of a thread pool (for example a file reader) has
+            //! its own work queue. The concurrency value is the maximum number
+            //! of work items from this queue that may run at the same time.
+            class WorkQueue
+            {
+                DJV_NON_COPYABLE(WorkQueue);
+
+            protected:
+                WorkQueue(const std::shared_ptr<ThreadPool>&, size_t concurrency);
+
+            public:
+                //! The destructor waits for any running work to finish.
+                ~WorkQueue();
+
+                //! \name Concurrency
+                ///@{
+
+                size_t getConcurrency() const;
+
+                void setConcurrency(size_t);
+
+                ///@}
+
+                //! \name Work
+                ///@{
+
+                size_t getPendingCount() const;
+                size_t getRunningCount() const;
+
+                //! Add work to the queue. Priority work is run before any
+                //! other work in the queue.
+                template<typename T>
+                std::future<T> push(const std::function<T(void)>&, bool priority = false);
+
+                //! Remove any work that has not started running.
+                void clear();
+
+                //! Remove any work that has not started running and wait for
+                //! the running work to finish.
+                void finish();
+
+                ///@}
+
+            private:
+                void _push(std::function<void(void)>&&, bool priority);
+
+                DJV_PRIVATE();
+
+                friend class ThreadPool;
+            };
+
+            //! Thread pool.
+            //!
+            //! The threads in the pool are shared between all of the work
+            //! queues, idle threads take work from the queues in round-robin
+            //! order.
+            class ThreadPool : public std::enable_shared_from_this<ThreadPool>
+            {
+                DJV_NON_COPYABLE(ThreadPool);
+
+            protected:
+                void _init(size_t threadCount);
+                ThreadPool();
+
+            public:
+                ~ThreadPool();
+
+                //! Create a new thread pool. If the thread count is zero the
+                //! hardware concurrency is used.
+                static std::shared_ptr<ThreadPool> create(size_t threadCount = 0);
+
+                size_t getThreadCount() const;
+
+                std::shared_ptr<WorkQueue> createQueue(size_t concurrency);
+
+            private:
+                void _run();
+
+                DJV_PRIVATE();
+
+                friend class WorkQueue;
+            };
+
+        } // namespace Thread
+    } // namespace Core
+} // namespace djv
+
+#include <djvCore/ThreadPoolInline.h>
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Thread
+        {
+            template<typename T>
+            inline std::future<T> WorkQueue::push(const std::function<T(void)>& value, bool priority)
+            {
+                auto task = std::make_shared<std::packaged_task<T(void)> >(value);
+                auto out = task->get_future();
+                _push([task] { (*task)(); }, priority);
+                return out;
+            }
+
+        } // namespace Thread
+    } // namespace Core
+} // namespace djv
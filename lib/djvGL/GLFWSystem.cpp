@@ -16,6 +16,7 @@
 
 #include <glm/vec2.hpp>
 
+#include <atomic>
 #include <sstream>
 
 using namespace djv::Core;
@@ -34,6 +35,8 @@ namespace djv
                 //! \todo Should this be configurable?
                 std::weak_ptr<System::LogSystem> logSystemWeak;
 
+                std::atomic<bool> glfwInitialized(false);
+
                 void glfwErrorCallback(int, const char * description)
                 {
                     if (auto logSystem = logSystemWeak.lock())
@@ -92,9 +95,15 @@ namespace djv
                 std::runtime_error(what)
             {}
 
+            bool isInitialized()
+            {
+                return glfwInitialized;
+            }
+
             struct GLFWSystem::Private
             {
                 std::shared_ptr<System::TextSystem> textSystem;
+                std::string error;
                 GLFWwindow* window = nullptr;
                 std::shared_ptr<Observer::ValueSubject<SwapInterval> > swapInterval;
             };
@@ -124,6 +133,7 @@ namespace djv
                 {
                     throw Error(getErrorMessage(ErrorString::Init, p.textSystem));
                 }
+                glfwInitialized = true;
 
                 // Create a window.
 #if defined(DJV_GL_ES2)
@@ -229,7 +239,11 @@ namespace djv
                     glfwDestroyWindow(p.window);
                     p.window = nullptr;
                 }
-                glfwTerminate();
+                if (glfwInitialized)
+                {
+                    glfwTerminate();
+                    glfwInitialized = false;
+                }
             }
 
             std::shared_ptr<GLFWSystem> GLFWSystem::create(const std::shared_ptr<System::Context>& context)
@@ -238,7 +252,21 @@ namespace djv
                 if (!out)
                 {
                     out = std::shared_ptr<GLFWSystem>(new GLFWSystem);
-                    out->_init(context);
+                    try
+                    {
+                        out->_init(context);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        // The system has already been added to the context,
+                        // remember the error so it is not used later.
+                        out->_p->error = e.what();
+                        throw;
+                    }
+                }
+                else if (!out->_p->error.empty())
+                {
+                    throw Error(out->_p->error);
                 }
                 return out;
             }
@@ -35,6 +35,10 @@ namespace djv
             public:
                 explicit Error(const std::string&);
             };
+
+            //! Get whether GLFW has been initialized. This can be used to
+            //! check whether OpenGL is available before creating windows.
+            bool isInitialized();
         
             //! GLFW system.
             class GLFWSystem : public System::ISystem
@@ -48,7 +52,8 @@ namespace djv
             public:
                 ~GLFWSystem() override;
 
-                //! Create a new GLFW system.
+                //! Create a new GLFW system. If the system failed to
+                //! initialize previously the error is thrown again.
                 //! Throws:
                 //! - Error
                 static std::shared_ptr<GLFWSystem> create(const std::shared_ptr<System::Context>&);
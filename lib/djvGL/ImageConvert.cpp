@@ -82,11 +82,25 @@ namespace djv
             {
                 p.texture = Texture2D::create(data.getInfo());
             }
-            p.texture->bind();
             p.texture->copy(data);
 
             p.shader->bind();
             p.shader->setUniform("textureSampler", 0);
+#if !defined(DJV_GL_ES2)
+            const bool yuv = p.texture->getPlaneCount() > 1;
+            p.shader->setUniform("yuv", yuv);
+            if (yuv)
+            {
+                p.shader->setUniform("yuvMatrix", getYUVMatrix(data.getInfo()));
+                p.shader->setUniform("textureSamplerCb", 1);
+                p.shader->setUniform("textureSamplerCr", 2);
+                for (uint8_t i = 1; i < 3; ++i)
+                {
+                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + i));
+                    glBindTexture(GL_TEXTURE_2D, p.texture->getPlaneID(i));
+                }
+            }
+#endif // DJV_GL_ES2
             
             if (info.size != p.size)
             {
@@ -142,6 +156,7 @@ namespace djv
             glClearColor(0.F, 0.F, 0.F, 0.F);
             glClear(GL_COLOR_BUFFER_BIT);
             glActiveTexture(GL_TEXTURE0);
+            p.texture->bind();
 
             p.vao->draw(GL_TRIANGLES, 0, 6);
 
@@ -4,6 +4,8 @@
 
 #include <djvGL/Texture.h>
 
+#include <djvImage/Convert.h>
+
 #include <array>
 
 //#pragma optimize("", off)
@@ -43,6 +45,16 @@ namespace djv
                 GL_NONE,
                 GL_NONE,
                 GL_NONE,
+                GL_NONE,
+
+                GL_RGB,
+                GL_RGB,
+                GL_RGB,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
                 GL_NONE
 #else // DJV_GL_ES2
                 GL_R8,
@@ -68,52 +80,167 @@ namespace djv
                 GL_RGBA16,
                 GL_RGBA32I,
                 GL_RGBA16F,
-                GL_RGBA32F
+                GL_RGBA32F,
+
+                GL_RGB8,
+                GL_RGB8,
+                GL_RGB8,
+                GL_RGB16,
+                GL_RGB16,
+                GL_RGB16,
+                GL_RGB16,
+                GL_RGB16,
+                GL_RGB16
 #endif // DJV_GL_ES2
             };
             return data[static_cast<size_t>(type)];
         }
 
-        /*GLenum getInternalFormat1D(Image::Type type)
+        namespace
         {
-            //return Image::getGLFormat(type);
-            return GL_RGBA;
-        }*/
+            //! Get whether the YUV planes are stored in separate textures.
+            bool isPlanar(const Image::Info& info)
+            {
+#if defined(DJV_GL_ES2)
+                return false;
+#else // DJV_GL_ES2
+                return Image::isYUVType(info.type);
+#endif // DJV_GL_ES2
+            }
 
-        void Texture2D::_init(const Image::Info& info, GLenum filterMin, GLenum filterMag)
-        {
-            _info = info;
-            _filterMin = filterMin;
-            _filterMag = filterMag;
-            if (_info.isValid())
+            Image::Info getTextureInfo(const Image::Info& info)
             {
-#if defined(DJV_GL_PBO)
-                glGenBuffers(1, &_pbo);
-                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbo);
-                glBufferData(
-                    GL_PIXEL_UNPACK_BUFFER,
-                    info.getDataByteCount(),
-                    0,
-                    GL_STREAM_DRAW);
-#endif // DJV_GL_PBO
+                Image::Info out = info;
+                if (!isPlanar(info))
+                {
+                    out.type = Image::getYUVConvertType(info.type);
+                }
+                return out;
+            }
 
-                glGenTextures(1, &_id);
-                glBindTexture(GL_TEXTURE_2D, _id);
+            void createTexture(
+                GLuint& id,
+                const Image::Size& size,
+                GLenum internalFormat,
+                GLenum format,
+                GLenum type,
+                GLenum filterMin,
+                GLenum filterMag)
+            {
+                glGenTextures(1, &id);
+                glBindTexture(GL_TEXTURE_2D, id);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, _filterMin);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, _filterMag);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filterMin);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filterMag);
                 glTexImage2D(
                     GL_TEXTURE_2D,
                     0,
-                    getInternalFormat2D(_info.type),
-                    _info.size.w,
-                    _info.size.h,
+                    internalFormat,
+                    size.w,
+                    size.h,
                     0,
-                    _info.getGLFormat(),
-                    _info.getGLType(),
+                    format,
+                    type,
                     0);
             }
+
+            void copyTexture(
+                GLuint id,
+                uint16_t x,
+                uint16_t y,
+                const Image::Size& size,
+                GLenum format,
+                GLenum type,
+                const void* data)
+            {
+                glBindTexture(GL_TEXTURE_2D, id);
+                glTexSubImage2D(
+                    GL_TEXTURE_2D,
+                    0,
+                    x,
+                    y,
+                    size.w,
+                    size.h,
+                    format,
+                    type,
+                    data);
+            }
+
+        } // namespace
+
+        glm::mat4x4 getYUVMatrix(const Image::Info& info)
+        {
+            float kr = 0.F;
+            float kb = 0.F;
+            Image::getYUVCoefficients(info.yuvCoefficients, kr, kb);
+            const float kg = 1.F - kr - kb;
+            const float rCr = 2.F * (1.F - kr);
+            const float gCb = -2.F * kb * (1.F - kb) / kg;
+            const float gCr = -2.F * kr * (1.F - kr) / kg;
+            const float bCb = 2.F * (1.F - kb);
+
+            // The texture values are normalized by the maximum value of the
+            // storage word, so the 10-bit types are scaled up.
+            const uint8_t bitDepth = Image::getBitDepth(info.type);
+            const float scale = static_cast<float>(1 << (bitDepth - 8));
+            const float textureMax = 1 == Image::getByteCount(info.type) ? 255.F : 65535.F;
+            float yOffset = 0.F;
+            float yScale = 1.F;
+            float cOffset = 0.F;
+            float cScale = 1.F;
+            switch (info.yuvRange)
+            {
+            case Image::YUVRange::Video:
+                yOffset = 16.F * scale;
+                yScale = 1.F / (219.F * scale);
+                cOffset = 128.F * scale;
+                cScale = 1.F / (224.F * scale);
+                break;
+            case Image::YUVRange::Full:
+            {
+                const float max = static_cast<float>((1 << bitDepth) - 1);
+                yScale = 1.F / max;
+                cOffset = 128.F * scale;
+                cScale = 1.F / max;
+                break;
+            }
+            default: break;
+            }
+            const float yA = textureMax * yScale;
+            const float yB = -yOffset * yScale;
+            const float cA = textureMax * cScale;
+            const float cB = -cOffset * cScale;
+
+            // The matrix is indexed by column and then row.
+            glm::mat4x4 out(1.F);
+            out[0][0] = yA;
+            out[0][1] = yA;
+            out[0][2] = yA;
+            out[1][0] = 0.F;
+            out[1][1] = gCb * cA;
+            out[1][2] = bCb * cA;
+            out[2][0] = rCr * cA;
+            out[2][1] = gCr * cA;
+            out[2][2] = 0.F;
+            out[3][0] = yB + rCr * cB;
+            out[3][1] = yB + (gCb + gCr) * cB;
+            out[3][2] = yB + bCb * cB;
+            return out;
+        }
+
+        /*GLenum getInternalFormat1D(Image::Type type)
+        {
+            //return Image::getGLFormat(type);
+            return GL_RGBA;
+        }*/
+
+        void Texture2D::_init(const Image::Info& info, GLenum filterMin, GLenum filterMag)
+        {
+            _info = info;
+            _filterMin = filterMin;
+            _filterMag = filterMag;
+            _create();
         }
 
         Texture2D::Texture2D()
@@ -121,18 +248,7 @@ namespace djv
 
         Texture2D::~Texture2D()
         {
-            if (_id)
-            {
-                glDeleteTextures(1, &_id);
-                _id = 0;
-            }
-#if defined(DJV_GL_PBO)
-            if (_pbo)
-            {
-                glDeleteBuffers(1, &_pbo);
-                _pbo = 0;
-            }
-#endif // DJV_GL_PBO
+            _delete();
         }
 
         std::shared_ptr<Texture2D> Texture2D::create(const Image::Info& info, GLenum filterMin, GLenum filterMag)
@@ -146,49 +262,19 @@ namespace djv
         {
             if (info == _info)
                 return;
+            _delete();
             _info = info;
-            if (_info.isValid())
-            {
-                if (_id)
-                {
-                    glDeleteTextures(1, &_id);
-                }
-#if defined(DJV_GL_PBO)
-                if (_pbo)
-                {
-                    glDeleteBuffers(1, &_pbo);
-                }
-                glGenBuffers(1, &_pbo);
-                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbo);
-                glBufferData(
-                    GL_PIXEL_UNPACK_BUFFER,
-                    _info.getDataByteCount(),
-                    0,
-                    GL_STREAM_DRAW);
-#endif // DJV_GL_PBO
-
-                glGenTextures(1, &_id);
-                glBindTexture(GL_TEXTURE_2D, _id);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, _filterMin);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, _filterMag);
-                glTexImage2D(
-                    GL_TEXTURE_2D,
-                    0,
-                    getInternalFormat2D(_info.type),
-                    _info.size.w,
-                    _info.size.h,
-                    0,
-                    _info.getGLFormat(),
-                    _info.getGLType(),
-                    0);
-            }
+            _create();
         }
 
         void Texture2D::copy(const Image::Data & data)
         {
             const auto & info = data.getInfo();
+            if (Image::isYUVType(info.type) && !isPlanar(info))
+            {
+                copy(_convertYUV(data));
+                return;
+            }
 #if defined(DJV_GL_ES2)
             glBindTexture(GL_TEXTURE_2D, _id);
             glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
@@ -213,32 +299,59 @@ namespace djv
                 data.getData());
 #endif // DJV_GL_PBO
 
-            glBindTexture(GL_TEXTURE_2D, _id);
             glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
             glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != Memory::getEndian());
             glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
             glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-            glTexSubImage2D(
-                GL_TEXTURE_2D,
-                0,
-                0,
-                0,
-                info.size.w,
-                info.size.h,
-                info.getGLFormat(),
-                info.getGLType(),
+            if (_planeIDs[0])
+            {
+                // Copy each plane into its own texture.
+                for (uint8_t plane = 0; plane < 3; ++plane)
+                {
+                    copyTexture(
+                        getPlaneID(plane),
+                        0,
+                        0,
+                        info.getPlaneSize(plane),
+                        GL_RED,
+                        info.getGLType(),
 #if defined(DJV_GL_PBO)
-                0
+                        reinterpret_cast<const void*>(info.getPlaneOffset(plane))
 #else // DJV_GL_PBO
-                data.getData()
+                        data.getPlaneData(plane)
 #endif // DJV_GL_PBO
-                );
+                        );
+                }
+            }
+            else
+            {
+                copyTexture(
+                    _id,
+                    0,
+                    0,
+                    info.size,
+                    info.getGLFormat(),
+                    info.getGLType(),
+#if defined(DJV_GL_PBO)
+                    0
+#else // DJV_GL_PBO
+                    data.getData()
+#endif // DJV_GL_PBO
+                    );
+            }
             glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 #endif // DJV_GL_ES2
         }
 
         void Texture2D::copy(const Image::Data & data, uint16_t x, uint16_t y)
         {
+            if (Image::isYUVType(data.getType()))
+            {
+                // Sub-images are copied into textures of another type (like
+                // a texture atlas), so the data is converted.
+                copy(_convertYUV(data), x, y);
+                return;
+            }
             const auto & info = data.getInfo();
 
 #if defined(DJV_GL_ES2)
@@ -265,18 +378,15 @@ namespace djv
                 data.getData());
 #endif // DJV_GL_PBO
 
-            glBindTexture(GL_TEXTURE_2D, _id);
             glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
             glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != Memory::getEndian());
             glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
             glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-            glTexSubImage2D(
-                GL_TEXTURE_2D,
-                0,
+            copyTexture(
+                _id,
                 x,
                 y,
-                info.size.w,
-                info.size.h,
+                info.size,
                 info.getGLFormat(),
                 info.getGLType(),
 #if defined(DJV_GL_PBO)
@@ -294,6 +404,100 @@ namespace djv
             glBindTexture(GL_TEXTURE_2D, _id);
         }
 
+        void Texture2D::_create()
+        {
+            if (_info.isValid())
+            {
+#if defined(DJV_GL_PBO)
+                glGenBuffers(1, &_pbo);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbo);
+                glBufferData(
+                    GL_PIXEL_UNPACK_BUFFER,
+                    getTextureInfo(_info).getDataByteCount(),
+                    0,
+                    GL_STREAM_DRAW);
+#endif // DJV_GL_PBO
+
+#if !defined(DJV_GL_ES2)
+                if (isPlanar(_info))
+                {
+                    // The planes are single channel textures.
+                    const GLenum internalFormat = 1 == Image::getByteCount(_info.type) ? GL_R8 : GL_R16;
+                    createTexture(
+                        _id,
+                        _info.size,
+                        internalFormat,
+                        GL_RED,
+                        _info.getGLType(),
+                        _filterMin,
+                        _filterMag);
+                    for (uint8_t plane = 1; plane < 3; ++plane)
+                    {
+                        createTexture(
+                            _planeIDs[plane - 1],
+                            _info.getPlaneSize(plane),
+                            internalFormat,
+                            GL_RED,
+                            _info.getGLType(),
+                            _filterMin,
+                            _filterMag);
+                    }
+                }
+                else
+#endif // DJV_GL_ES2
+                {
+                    const Image::Info textureInfo = getTextureInfo(_info);
+                    createTexture(
+                        _id,
+                        _info.size,
+                        getInternalFormat2D(_info.type),
+                        textureInfo.getGLFormat(),
+                        textureInfo.getGLType(),
+                        _filterMin,
+                        _filterMag);
+                }
+            }
+        }
+
+        void Texture2D::_delete()
+        {
+            if (_id)
+            {
+                glDeleteTextures(1, &_id);
+                _id = 0;
+            }
+            if (_planeIDs[0])
+            {
+                glDeleteTextures(2, _planeIDs);
+                _planeIDs[0] = 0;
+                _planeIDs[1] = 0;
+            }
+#if defined(DJV_GL_PBO)
+            if (_pbo)
+            {
+                glDeleteBuffers(1, &_pbo);
+                _pbo = 0;
+            }
+#endif // DJV_GL_PBO
+        }
+
+        const Image::Data& Texture2D::_convertYUV(const Image::Data& data)
+        {
+            // Keep the mirroring so the converter does not flip the data.
+            Image::Info info(data.getSize(), Image::getYUVConvertType(data.getType()));
+            info.layout.mirror = data.getLayout().mirror;
+            if (!_convertData || _convertData->getInfo() != info)
+            {
+                _convertData = Image::Data::create(info);
+            }
+            if (!_convert)
+            {
+                _convert = Image::Convert::create();
+            }
+            _convert->process(data, info, *_convertData);
+            return *_convertData;
+        }
+
         /*void Texture1D::_init(const Image::Info& info, GLenum filter)
         {
             _info = info;
@@ -8,17 +8,34 @@
 
 #include <djvImage/Data.h>
 
+#include <glm/mat4x4.hpp>
+
 namespace djv
 {
+    namespace Image
+    {
+        class Convert;
+
+    } // namespace Image
+
     namespace GL
     {
         //! Get the OpenGL internal format.
         GLenum getInternalFormat2D(Image::Type);
 
+        //! Get the matrix that converts the normalized Y, Cb, and Cr
+        //! texture values of a planar texture to RGB.
+        glm::mat4x4 getYUVMatrix(const Image::Info&);
+
         //! Get the OpenGL internal format.
         //GLenum getInternalFormat1D(Image::Type);
         
         //! Two-dimensonal OpenGL texture.
+        //!
+        //! YUV data is stored in a separate texture for each plane, and
+        //! converted to RGB by the shader with getYUVMatrix(). With OpenGL
+        //! ES, or when YUV data is copied into part of a texture, it is
+        //! converted to RGB on the CPU instead.
         class Texture2D
         {
             DJV_NON_COPYABLE(Texture2D);
@@ -48,6 +65,13 @@ namespace djv
 
             GLuint getID() const;
 
+            //! Get the number of planes, this is three for planar YUV
+            //! textures and one for all other textures.
+            uint8_t getPlaneCount() const;
+
+            //! Get the texture for a plane. Plane zero is the same as getID().
+            GLuint getPlaneID(uint8_t) const;
+
             void set(const Image::Info&);
             void copy(const Image::Data&);
             void copy(const Image::Data&, uint16_t x, uint16_t y);
@@ -57,13 +81,20 @@ namespace djv
             ///@}
 
         private:
+            void _create();
+            void _delete();
+            const Image::Data& _convertYUV(const Image::Data&);
+
             Image::Info _info;
             GLenum _filterMin = GL_LINEAR;
             GLenum _filterMag = GL_LINEAR;
             GLuint _id = 0;
+            GLuint _planeIDs[2] = { 0, 0 };
 #if defined(DJV_GL_PBO)
             GLuint _pbo = 0;
 #endif // DJV_GL_PBO
+            std::shared_ptr<Image::Convert> _convert;
+            std::shared_ptr<Image::Data> _convertData;
         };
 
         //! One-dimensional OpenGL texture.
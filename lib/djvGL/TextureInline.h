@@ -16,6 +16,16 @@ namespace djv
             return _id;
         }
 
+        inline uint8_t Texture2D::getPlaneCount() const
+        {
+            return _planeIDs[0] ? 3 : 1;
+        }
+
+        inline GLuint Texture2D::getPlaneID(uint8_t plane) const
+        {
+            return plane > 0 ? _planeIDs[plane - 1] : _id;
+        }
+
         /*inline const Image::Info& Texture1D::getInfo() const
         {
             return _info;
@@ -0,0 +1,311 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImage/Convert.h>
+
+#include <djvImage/Data.h>
+
+#include <djvMath/Math.h>
+
+#include <djvCore/ThreadPool.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace djv
+{
+    namespace Image
+    {
+        namespace
+        {
+            //! The minimum number of scanlines in a band.
+            const uint16_t bandHeightMin = 16;
+
+            size_t getWordByteCount(Type type)
+            {
+                // The 10-bit types are packed into 32-bit words.
+                return Type::RGB_U10 == type ? 4 : getByteCount(getDataType(type));
+            }
+
+            //! YUV to RGB conversion coefficients.
+            struct YUVToRGB
+            {
+                explicit YUVToRGB(const Info& info)
+                {
+                    float kr = 0.F;
+                    float kb = 0.F;
+                    getYUVCoefficients(info.yuvCoefficients, kr, kb);
+                    const float kg = 1.F - kr - kb;
+                    rCr = 2.F * (1.F - kr);
+                    gCb = -2.F * kb * (1.F - kb) / kg;
+                    gCr = -2.F * kr * (1.F - kr) / kg;
+                    bCb = 2.F * (1.F - kb);
+
+                    const uint8_t bitDepth = getBitDepth(info.type);
+                    const float scale = static_cast<float>(1 << (bitDepth - 8));
+                    switch (info.yuvRange)
+                    {
+                    case YUVRange::Video:
+                        yOffset = 16.F * scale;
+                        yScale = 1.F / (219.F * scale);
+                        cOffset = 128.F * scale;
+                        cScale = 1.F / (224.F * scale);
+                        break;
+                    case YUVRange::Full:
+                    {
+                        const float max = static_cast<float>((1 << bitDepth) - 1);
+                        yOffset = 0.F;
+                        yScale = 1.F / max;
+                        cOffset = 128.F * scale;
+                        cScale = 1.F / max;
+                        break;
+                    }
+                    default: break;
+                    }
+                }
+
+                float rCr     = 0.F;
+                float gCb     = 0.F;
+                float gCr     = 0.F;
+                float bCb     = 0.F;
+                float yOffset = 0.F;
+                float yScale  = 1.F;
+                float cOffset = 0.F;
+                float cScale  = 1.F;
+            };
+
+            template<typename T, typename U>
+            void convertYUVScanline(
+                const uint8_t* yP,
+                const uint8_t* cbP,
+                const uint8_t* crP,
+                uint16_t w,
+                uint8_t shiftX,
+                const YUVToRGB& m,
+                uint8_t* outP)
+            {
+                const T* y = reinterpret_cast<const T*>(yP);
+                const T* cb = reinterpret_cast<const T*>(cbP);
+                const T* cr = reinterpret_cast<const T*>(crP);
+                U* out = reinterpret_cast<U*>(outP);
+                const float outMax = static_cast<float>(std::numeric_limits<U>::max());
+                for (uint16_t x = 0; x < w; ++x, out += 3)
+                {
+                    const float Y = (y[x] - m.yOffset) * m.yScale;
+                    const float Cb = (cb[x >> shiftX] - m.cOffset) * m.cScale;
+                    const float Cr = (cr[x >> shiftX] - m.cOffset) * m.cScale;
+                    out[0] = static_cast<U>(Math::clamp(Y + m.rCr * Cr, 0.F, 1.F) * outMax + .5F);
+                    out[1] = static_cast<U>(Math::clamp(Y + m.gCb * Cb + m.gCr * Cr, 0.F, 1.F) * outMax + .5F);
+                    out[2] = static_cast<U>(Math::clamp(Y + m.bCb * Cb, 0.F, 1.F) * outMax + .5F);
+                }
+            }
+
+            void mirrorScanline(uint8_t* p, uint16_t w, size_t pixelByteCount, std::vector<uint8_t>& pixel)
+            {
+                uint8_t* a = p;
+                uint8_t* b = p + (w - 1) * pixelByteCount;
+                for (; a < b; a += pixelByteCount, b -= pixelByteCount)
+                {
+                    memcpy(pixel.data(), a, pixelByteCount);
+                    memcpy(a, b, pixelByteCount);
+                    memcpy(b, pixel.data(), pixelByteCount);
+                }
+            }
+
+            //! Copy the planes of YUV data. The chroma scanlines are divided
+            //! between the bands so that each one is only copied once.
+            void copyYUVBand(const Data& in, const Info& info, Data& out, uint16_t y0, uint16_t y1)
+            {
+                const Info& inInfo = in.getInfo();
+                const bool mirrorX = inInfo.layout.mirror.x != info.layout.mirror.x;
+                const bool mirrorY = inInfo.layout.mirror.y != info.layout.mirror.y;
+                const size_t sampleByteCount = info.getPixelByteCount();
+                std::vector<uint8_t> pixel(sampleByteCount);
+                for (uint8_t plane = 0; plane < info.getPlaneCount(); ++plane)
+                {
+                    const Size size = info.getPlaneSize(plane);
+                    const uint8_t shiftY = plane > 0 ? getChromaShiftY(info.type) : 0;
+                    const uint16_t planeY0 = static_cast<uint16_t>((y0 + (1 << shiftY) - 1) >> shiftY);
+                    const uint16_t planeY1 = static_cast<uint16_t>((y1 + (1 << shiftY) - 1) >> shiftY);
+                    for (uint16_t y = planeY0; y < planeY1; ++y)
+                    {
+                        uint8_t* outP = out.getPlaneData(plane, y);
+                        memcpy(outP, in.getPlaneData(plane, mirrorY ? (size.h - 1 - y) : y), size.w * sampleByteCount);
+                        if (mirrorX)
+                        {
+                            mirrorScanline(outP, size.w, sampleByteCount, pixel);
+                        }
+                    }
+                }
+            }
+
+            void convertBand(const Data& in, const Info& info, Data& out, uint16_t y0, uint16_t y1)
+            {
+                const Info& inInfo = in.getInfo();
+                const uint16_t w = info.size.w;
+                const uint16_t h = info.size.h;
+                const bool mirrorX = inInfo.layout.mirror.x != info.layout.mirror.x;
+                const bool mirrorY = inInfo.layout.mirror.y != info.layout.mirror.y;
+                const Core::Memory::Endian endian = Core::Memory::getEndian();
+                const bool inEndian = inInfo.layout.endian != endian;
+                const bool outEndian = info.layout.endian != endian;
+                const size_t inPixelByteCount = inInfo.getPixelByteCount();
+                const size_t outPixelByteCount = info.getPixelByteCount();
+                const size_t inWordByteCount = getWordByteCount(inInfo.type);
+                const size_t outWordByteCount = getWordByteCount(info.type);
+                const bool sameType = inInfo.type == info.type;
+
+                // YUV data is converted to RGB first, and then to the output
+                // type if it is different.
+                const bool yuv = isYUVType(inInfo.type);
+                const Type yuvConvertType = getYUVConvertType(inInfo.type);
+                const uint8_t shiftX = getChromaShiftX(inInfo.type);
+                const uint8_t shiftY = getChromaShiftY(inInfo.type);
+                const YUVToRGB yuvToRGB(inInfo);
+                std::vector<uint8_t> yuvScanline;
+                if (yuv && yuvConvertType != info.type)
+                {
+                    yuvScanline.resize(w * getByteCount(yuvConvertType));
+                }
+
+                std::vector<uint8_t> inScanline;
+                if (!yuv && inEndian && inWordByteCount > 1)
+                {
+                    inScanline.resize(w * inPixelByteCount);
+                }
+                std::vector<uint8_t> pixel(outPixelByteCount);
+                for (uint16_t y = y0; y < y1; ++y)
+                {
+                    const uint16_t inY = mirrorY ? (h - 1 - y) : y;
+                    uint8_t* outP = out.getData(y);
+                    if (yuv)
+                    {
+                        uint8_t* rgbP = yuvScanline.size() ? yuvScanline.data() : outP;
+                        const uint16_t inC = inY >> shiftY;
+                        switch (getDataType(inInfo.type))
+                        {
+                        case DataType::U8:
+                            convertYUVScanline<U8_T, U8_T>(
+                                in.getPlaneData(0, inY), in.getPlaneData(1, inC), in.getPlaneData(2, inC), w, shiftX, yuvToRGB, rgbP);
+                            break;
+                        case DataType::U10:
+                        case DataType::U16:
+                            convertYUVScanline<U16_T, U16_T>(
+                                in.getPlaneData(0, inY), in.getPlaneData(1, inC), in.getPlaneData(2, inC), w, shiftX, yuvToRGB, rgbP);
+                            break;
+                        default: break;
+                        }
+                        if (yuvScanline.size())
+                        {
+                            Image::convert(rgbP, yuvConvertType, outP, info.type, w);
+                        }
+                    }
+                    else
+                    {
+                        const uint8_t* inP = in.getData(inY);
+                        if (inScanline.size())
+                        {
+                            Core::Memory::endian(inP, inScanline.data(), w * inPixelByteCount / inWordByteCount, inWordByteCount);
+                            inP = inScanline.data();
+                        }
+                        if (sameType)
+                        {
+                            memcpy(outP, inP, w * outPixelByteCount);
+                        }
+                        else
+                        {
+                            Image::convert(inP, inInfo.type, outP, info.type, w);
+                        }
+                    }
+                    if (mirrorX)
+                    {
+                        mirrorScanline(outP, w, outPixelByteCount, pixel);
+                    }
+                    if (outEndian && outWordByteCount > 1)
+                    {
+                        Core::Memory::endian(outP, w * outPixelByteCount / outWordByteCount, outWordByteCount);
+                    }
+                }
+            }
+
+        } // namespace
+
+        struct Convert::Private
+        {
+            std::shared_ptr<Core::Thread::WorkQueue> workQueue;
+        };
+
+        void Convert::_init(const std::shared_ptr<Core::Thread::ThreadPool>& threadPool)
+        {
+            DJV_PRIVATE_PTR();
+            if (threadPool)
+            {
+                p.workQueue = threadPool->createQueue(threadPool->getThreadCount());
+            }
+        }
+
+        Convert::Convert() :
+            _p(new Private)
+        {}
+
+        Convert::~Convert()
+        {}
+
+        std::shared_ptr<Convert> Convert::create(const std::shared_ptr<Core::Thread::ThreadPool>& threadPool)
+        {
+            auto out = std::shared_ptr<Convert>(new Convert);
+            out->_init(threadPool);
+            return out;
+        }
+
+        void Convert::process(const Data& data, const Info& info, Data& out)
+        {
+            DJV_PRIVATE_PTR();
+            if (data.getSize() != info.size ||
+                out.getSize() != info.size ||
+                out.getType() != info.type ||
+                out.getLayout() != info.layout ||
+                (isYUVType(info.type) && data.getType() != info.type))
+            {
+                //! \todo How can we translate this?
+                throw std::invalid_argument(DJV_TEXT("error_image_convert"));
+            }
+
+            // YUV output is only supported without a type conversion.
+            const auto band = isYUVType(info.type) ? copyYUVBand : convertBand;
+            const uint16_t h = info.size.h;
+            const size_t bandCount = p.workQueue ?
+                std::min(p.workQueue->getConcurrency(), static_cast<size_t>(std::max(h / bandHeightMin, 1))) :
+                1;
+            if (bandCount > 1)
+            {
+                std::vector<std::future<void> > futures;
+                const Data* dataP = &data;
+                const Info* infoP = &info;
+                Data* outP = &out;
+                for (size_t i = 0; i < bandCount; ++i)
+                {
+                    const uint16_t y0 = static_cast<uint16_t>(h * i / bandCount);
+                    const uint16_t y1 = static_cast<uint16_t>(h * (i + 1) / bandCount);
+                    futures.push_back(p.workQueue->push<void>(
+                        [band, dataP, infoP, outP, y0, y1]
+                        {
+                            band(*dataP, *infoP, *outP, y0, y1);
+                        }));
+                }
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+            }
+            else
+            {
+                band(data, info, out, 0, h);
+            }
+        }
+
+    } // namespace Image
+} // namespace djv
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Thread
+        {
+            class ThreadPool;
+
+        } // namespace Thread
+    } // namespace Core
+
+    namespace Image
+    {
+        class Data;
+        class Info;
+
+        //! Image data conversion on the CPU.
+        //!
+        //! This converts the pixel type, mirroring, and endian of image data
+        //! without requiring an OpenGL context. The image is split into bands
+        //! of scanlines which are converted in parallel on the thread pool.
+        //!
+        //! YUV data is converted to RGB with the coefficients and range from
+        //! the image information. YUV data can only be converted to other
+        //! types, or copied to the same YUV type, and is always in the native
+        //! endian.
+        class Convert
+        {
+            DJV_NON_COPYABLE(Convert);
+
+        protected:
+            void _init(const std::shared_ptr<Core::Thread::ThreadPool>&);
+            Convert();
+
+        public:
+            ~Convert();
+
+            //! Create a new converter. If the thread pool is null the
+            //! conversion is done on the calling thread.
+            static std::shared_ptr<Convert> create(
+                const std::shared_ptr<Core::Thread::ThreadPool>& = nullptr);
+
+            //! Throws:
+            //! - std::invalid_argument
+            void process(const Data&, const Info&, Data&);
+
+        private:
+            DJV_PRIVATE();
+        };
+
+    } // namespace Image
+} // namespace djv
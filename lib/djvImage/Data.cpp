@@ -5,33 +5,73 @@
 #include <djvImage/Data.h>
 
 #include <djvImage/Color.h>
+#include <djvImage/Convert.h>
+#include <djvImage/DataPool.h>
 
+#include <djvSystem/FileIO.h>
+
+#include <djvCore/Memory.h>
 #include <djvCore/UID.h>
 
+#include <new>
+
 namespace djv
 {
     namespace Image
     {
-        void Data::_init(const Info& info)
+        namespace
+        {
+            //! The alignment of allocated data, this is large enough for AVX-512.
+            const size_t alignment = 64;
+
+        } // namespace
+
+        void Data::_init(const Info& info, const std::shared_ptr<DataPool>& pool)
         {
             _uid = Core::createUID();
             _info = info;
             _pixelByteCount = info.getPixelByteCount();
             _scanlineByteCount = info.getScanlineByteCount();
             _dataByteCount = info.getDataByteCount();
+            _pool = pool;
             if (_dataByteCount)
             {
-                _data = new uint8_t[_dataByteCount];
-                _p = _data;
+                _allocate();
             }
         }
 
+#if defined(DJV_MMAP)
+        void Data::_init(const Info& info, const std::shared_ptr<System::File::IO>& io)
+        {
+            _uid = Core::createUID();
+            _info = info;
+            _pixelByteCount = info.getPixelByteCount();
+            _scanlineByteCount = info.getScanlineByteCount();
+            _dataByteCount = info.getDataByteCount();
+            if (_dataByteCount)
+            {
+                // Seeking past the image data checks that it is within the
+                // memory-map.
+                _p = io->mmapP();
+                io->seek(_dataByteCount);
+                _io = io;
+            }
+        }
+#endif // DJV_MMAP
+
         Data::Data()
         {}
 
         Data::~Data()
         {
-            delete[] _data;
+            if (_pool)
+            {
+                _pool->release(_data);
+            }
+            else
+            {
+                Core::Memory::alignedFree(_data);
+            }
         }
 
         std::shared_ptr<Data> Data::create(const Info& info)
@@ -41,6 +81,22 @@ namespace djv
             return out;
         }
 
+        std::shared_ptr<Data> Data::create(const Info& info, const std::shared_ptr<DataPool>& pool)
+        {
+            auto out = std::shared_ptr<Data>(new Data);
+            out->_init(info, pool);
+            return out;
+        }
+
+#if defined(DJV_MMAP)
+        std::shared_ptr<Data> Data::create(const Info& info, const std::shared_ptr<System::File::IO>& io)
+        {
+            auto out = std::shared_ptr<Data>(new Data);
+            out->_init(info, io);
+            return out;
+        }
+#endif // DJV_MMAP
+
         void Data::setPluginName(const std::string& value)
         {
             _pluginName = value;
@@ -51,9 +107,39 @@ namespace djv
             _tags = value;
         }
 
+        void Data::setROI(const Math::BBox2i& value)
+        {
+            _roi = value;
+        }
+
         void Data::zero()
         {
-            memset(_data, 0, _dataByteCount);
+            memset(getData(), 0, _dataByteCount);
+        }
+
+        void Data::_allocate()
+        {
+            if (_pool)
+            {
+                _data = _pool->acquire(_dataByteCount);
+            }
+            else
+            {
+                _data = reinterpret_cast<uint8_t*>(Core::Memory::alignedAlloc(_dataByteCount, alignment));
+                if (!_data)
+                {
+                    throw std::bad_alloc();
+                }
+            }
+            _p = _data;
+        }
+
+        void Data::_detach()
+        {
+            const uint8_t* p = _p;
+            _allocate();
+            memcpy(_data, p, _dataByteCount);
+            _io.reset();
         }
 
         bool Data::operator == (const Data& other) const
@@ -147,6 +233,13 @@ namespace djv
                 const uint16_t w = data->getWidth();
                 const uint16_t h = data->getHeight();
                 const Image::Type type = data->getType();
+                if (isYUVType(type))
+                {
+                    const Info info(data->getSize(), getYUVConvertType(type));
+                    auto rgb = Data::create(info);
+                    Convert::create()->process(*data, info, *rgb);
+                    return getAverageColor(rgb);
+                }
                 const uint8_t c = getChannelCount(type);
                 const uint8_t* p = data->getData();
                 out = Color(type);
@@ -8,21 +8,42 @@
 #include <djvImage/Info.h>
 #include <djvImage/Tags.h>
 
+#include <djvMath/BBox.h>
+
 #include <djvCore/UID.h>
 
 #include <memory>
 
 namespace djv
 {
+    namespace System
+    {
+        namespace File
+        {
+            class IO;
+
+        } // namespace File
+    } // namespace System
+
     namespace Image
     {
+        class DataPool;
+
         //! Image data.
+        //!
+        //! The data is either allocated, optionally from a pool, or it
+        //! references a memory-mapped file. Memory-mapped data is read-only,
+        //! it is copied on the first call to one of the non-const getData()
+        //! functions or detach().
         class Data
         {
             DJV_NON_COPYABLE(Data);
 
         protected:
-            void _init(const Info&);
+            void _init(const Info&, const std::shared_ptr<DataPool>& = nullptr);
+#if defined(DJV_MMAP)
+            void _init(const Info&, const std::shared_ptr<System::File::IO>&);
+#endif // DJV_MMAP
             Data();
 
         public:
@@ -30,6 +51,20 @@ namespace djv
 
             static std::shared_ptr<Data> create(const Info&);
 
+            //! Create new image data with a buffer from the given pool. The
+            //! buffer is returned to the pool when the data is destroyed. If
+            //! the pool is null this is the same as create(const Info&).
+            static std::shared_ptr<Data> create(const Info&, const std::shared_ptr<DataPool>&);
+
+#if defined(DJV_MMAP)
+            //! Create new image data that references the memory-mapped file
+            //! at the current position. The file position is moved past the
+            //! image data.
+            //! Throws:
+            //! - System::File::Error
+            static std::shared_ptr<Data> create(const Info&, const std::shared_ptr<System::File::IO>&);
+#endif // DJV_MMAP
+
             //! \name Information
             ///@{
 
@@ -67,6 +102,21 @@ namespace djv
             uint8_t* getData(uint16_t y);
             uint8_t* getData(uint16_t x, uint16_t y);
 
+            //! Get the data for a plane of the YUV types. Plane zero is the
+            //! same as getData().
+            const uint8_t* getPlaneData(uint8_t plane) const;
+            const uint8_t* getPlaneData(uint8_t plane, uint16_t y) const;
+            uint8_t* getPlaneData(uint8_t plane);
+            uint8_t* getPlaneData(uint8_t plane, uint16_t y);
+
+            //! Get whether the data references a memory-mapped file.
+            bool isMapped() const;
+
+            //! Copy memory-mapped data so that it no longer references the
+            //! file. This should be called before the data is kept for a
+            //! long time, for example in a cache.
+            void detach();
+
             ///@}
 
             //! \name Tags
@@ -78,6 +128,17 @@ namespace djv
 
             ///@}
 
+            //! \name Region of Interest
+            ///@{
+
+            //! Get the region of the full image that the data covers, in
+            //! pixels. An invalid region means the data is the full image.
+            const Math::BBox2i& getROI() const;
+
+            void setROI(const Math::BBox2i&);
+
+            ///@}
+
             //! \name Utility
             ///@{
 
@@ -89,6 +150,9 @@ namespace djv
             bool operator != (const Data&) const;
 
         private:
+            void _allocate();
+            void _detach();
+
             Core::UID _uid = 0;
             Info _info;
             uint8_t _pixelByteCount = 0;
@@ -97,7 +161,10 @@ namespace djv
             std::string _pluginName;
             uint8_t* _data = nullptr;
             const uint8_t* _p = nullptr;
+            std::shared_ptr<DataPool> _pool;
+            std::shared_ptr<System::File::IO> _io;
             Tags _tags;
+            Math::BBox2i _roi;
         };
 
         //! \name Utility
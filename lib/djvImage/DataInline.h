@@ -100,23 +100,66 @@ namespace djv
 
         inline uint8_t* Data::getData()
         {
+            detach();
             return _data;
         }
 
         inline uint8_t* Data::getData(uint16_t y)
         {
+            detach();
             return _data + y * _scanlineByteCount;
         }
 
         inline uint8_t* Data::getData(uint16_t x, uint16_t y)
         {
+            detach();
             return _data + y * _scanlineByteCount + x * static_cast<size_t>(_pixelByteCount);
         }
 
+        inline const uint8_t* Data::getPlaneData(uint8_t plane) const
+        {
+            return _p + _info.getPlaneOffset(plane);
+        }
+
+        inline const uint8_t* Data::getPlaneData(uint8_t plane, uint16_t y) const
+        {
+            return _p + _info.getPlaneOffset(plane) + y * _info.getPlaneScanlineByteCount(plane);
+        }
+
+        inline uint8_t* Data::getPlaneData(uint8_t plane)
+        {
+            detach();
+            return _data + _info.getPlaneOffset(plane);
+        }
+
+        inline uint8_t* Data::getPlaneData(uint8_t plane, uint16_t y)
+        {
+            detach();
+            return _data + _info.getPlaneOffset(plane) + y * _info.getPlaneScanlineByteCount(plane);
+        }
+
+        inline bool Data::isMapped() const
+        {
+            return _io.get() != nullptr;
+        }
+
+        inline void Data::detach()
+        {
+            if (_io)
+            {
+                _detach();
+            }
+        }
+
         inline const Tags& Data::getTags() const
         {
             return _tags;
         }
 
+        inline const Math::BBox2i& Data::getROI() const
+        {
+            return _roi;
+        }
+
     } // namespace Image
 } // namespace djv
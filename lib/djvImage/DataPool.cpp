@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImage/DataPool.h>
+
+#include <djvCore/Memory.h>
+
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#if defined(DJV_PLATFORM_LINUX)
+#include <sys/mman.h>
+#endif // DJV_PLATFORM_LINUX
+
+namespace djv
+{
+    namespace Image
+    {
+        namespace
+        {
+            const size_t pageSize     = 4 * Core::Memory::kilobyte;
+            const size_t hugePageSize = 2 * Core::Memory::megabyte;
+
+        } // namespace
+
+        float DataPoolStats::getHitRate() const
+        {
+            return acquireCount > 0 ?
+                (hitCount / static_cast<float>(acquireCount) * 100.F) :
+                0.F;
+        }
+
+        bool DataPoolStats::operator == (const DataPoolStats& other) const
+        {
+            return
+                acquireCount == other.acquireCount &&
+                hitCount == other.hitCount &&
+                pooledByteCount == other.pooledByteCount &&
+                outstandingByteCount == other.outstandingByteCount;
+        }
+
+        struct DataPool::Private
+        {
+            struct Buffer
+            {
+                uint8_t* p         = nullptr;
+                size_t   sizeClass = 0;
+            };
+
+            size_t maxByteCount = 0;
+            bool hugePages = false;
+
+            //! The pooled buffers in the order they were released, and the
+            //! buffers of each size class.
+            std::list<Buffer> pooled;
+            std::map<size_t, std::deque<std::list<Buffer>::iterator> > sizeClasses;
+
+            std::unordered_map<uint8_t*, size_t> outstanding;
+            DataPoolStats stats;
+            mutable std::mutex mutex;
+        };
+
+        void DataPool::_init(size_t maxByteCount)
+        {
+            _p->maxByteCount = maxByteCount;
+        }
+
+        DataPool::DataPool() :
+            _p(new Private)
+        {}
+
+        DataPool::~DataPool()
+        {
+            clear();
+        }
+
+        std::shared_ptr<DataPool> DataPool::create(size_t maxByteCount)
+        {
+            auto out = std::shared_ptr<DataPool>(new DataPool);
+            out->_init(maxByteCount);
+            return out;
+        }
+
+        size_t DataPool::getMaxByteCount() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->maxByteCount;
+        }
+
+        bool DataPool::hasHugePages() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->hugePages;
+        }
+
+        void DataPool::setMaxByteCount(size_t value)
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<uint8_t*> free;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.maxByteCount = value;
+                free = _maxUpdate();
+            }
+            for (auto i : free)
+            {
+                Core::Memory::alignedFree(i);
+            }
+        }
+
+        void DataPool::setHugePages(bool value)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            _p->hugePages = value;
+        }
+
+        uint8_t* DataPool::acquire(size_t byteCount)
+        {
+            DJV_PRIVATE_PTR();
+            uint8_t* out = nullptr;
+            if (0 == byteCount)
+                return out;
+
+            // Re-use the most recently released buffer of the same size
+            // class.
+            size_t sizeClass = 0;
+            bool hugePages = false;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                sizeClass = _getSizeClass(byteCount);
+                hugePages = p.hugePages && sizeClass >= hugePageSize;
+                ++p.stats.acquireCount;
+                const auto i = p.sizeClasses.find(sizeClass);
+                if (i != p.sizeClasses.end())
+                {
+                    const auto j = i->second.back();
+                    i->second.pop_back();
+                    if (i->second.empty())
+                    {
+                        p.sizeClasses.erase(i);
+                    }
+                    out = j->p;
+                    p.pooled.erase(j);
+                    p.stats.pooledByteCount -= sizeClass;
+                    ++p.stats.hitCount;
+                    p.outstanding[out] = sizeClass;
+                    p.stats.outstandingByteCount += sizeClass;
+                }
+            }
+
+            // Allocate a new buffer.
+            if (!out)
+            {
+                out = reinterpret_cast<uint8_t*>(Core::Memory::alignedAlloc(
+                    sizeClass,
+                    hugePages ? hugePageSize : pageSize));
+                if (!out)
+                {
+                    throw std::bad_alloc();
+                }
+#if defined(DJV_PLATFORM_LINUX) && defined(MADV_HUGEPAGE)
+                if (hugePages)
+                {
+                    madvise(out, sizeClass, MADV_HUGEPAGE);
+                }
+#endif // DJV_PLATFORM_LINUX
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.outstanding[out] = sizeClass;
+                p.stats.outstandingByteCount += sizeClass;
+            }
+
+            return out;
+        }
+
+        void DataPool::release(uint8_t* value)
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<uint8_t*> free;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.outstanding.find(value);
+                if (i != p.outstanding.end())
+                {
+                    Private::Buffer buffer;
+                    buffer.p = value;
+                    buffer.sizeClass = i->second;
+                    p.outstanding.erase(i);
+                    p.stats.outstandingByteCount -= buffer.sizeClass;
+                    p.pooled.push_back(buffer);
+                    p.sizeClasses[buffer.sizeClass].push_back(std::prev(p.pooled.end()));
+                    p.stats.pooledByteCount += buffer.sizeClass;
+                    free = _maxUpdate();
+                }
+            }
+            for (auto i : free)
+            {
+                Core::Memory::alignedFree(i);
+            }
+        }
+
+        void DataPool::clear()
+        {
+            DJV_PRIVATE_PTR();
+            std::list<Private::Buffer> pooled;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                std::swap(p.pooled, pooled);
+                p.sizeClasses.clear();
+                p.stats.pooledByteCount = 0;
+            }
+            for (const auto& i : pooled)
+            {
+                Core::Memory::alignedFree(i.p);
+            }
+        }
+
+        DataPoolStats DataPool::getStats() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->stats;
+        }
+
+        size_t DataPool::_getSizeClass(size_t value) const
+        {
+            const size_t align = _p->hugePages && value >= hugePageSize ? hugePageSize : pageSize;
+            return (value + align - 1) / align * align;
+        }
+
+        std::vector<uint8_t*> DataPool::_maxUpdate()
+        {
+            // Remove the least recently released buffers, they are freed
+            // by the caller outside of the lock. The least recently released
+            // buffer is also the first one of its size class.
+            DJV_PRIVATE_PTR();
+            std::vector<uint8_t*> out;
+            while (p.stats.pooledByteCount > p.maxByteCount && !p.pooled.empty())
+            {
+                const auto& buffer = p.pooled.front();
+                const auto i = p.sizeClasses.find(buffer.sizeClass);
+                i->second.pop_front();
+                if (i->second.empty())
+                {
+                    p.sizeClasses.erase(i);
+                }
+                out.push_back(buffer.p);
+                p.stats.pooledByteCount -= buffer.sizeClass;
+                p.pooled.pop_front();
+            }
+            return out;
+        }
+
+    } // namespace Image
+} // namespace djv
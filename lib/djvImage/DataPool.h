@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace Image
+    {
+        //! Image data pool statistics.
+        struct DataPoolStats
+        {
+            size_t acquireCount         = 0; //!< The number of buffers requested
+            size_t hitCount             = 0; //!< The number of requests that re-used a pooled buffer
+            size_t pooledByteCount      = 0; //!< The size of the buffers waiting to be re-used
+            size_t outstandingByteCount = 0; //!< The size of the buffers in use
+
+            //! Get the percentage of requests that re-used a pooled buffer.
+            float getHitRate() const;
+
+            bool operator == (const DataPoolStats&) const;
+        };
+
+        //! Image data buffer pool.
+        //!
+        //! Image data created with a pool returns its buffer to the pool
+        //! when it is destroyed, and the buffer is re-used by the next image
+        //! of the same size class. Size classes are rounded up to the page
+        //! size, or to the huge page size for large buffers when huge pages
+        //! are enabled. Buffers are page aligned.
+        //!
+        //! When the pooled buffers are over the maximum byte count the least
+        //! recently released buffers are freed.
+        class DataPool
+        {
+            DJV_NON_COPYABLE(DataPool);
+
+        protected:
+            void _init(size_t maxByteCount);
+            DataPool();
+
+        public:
+            ~DataPool();
+
+            static std::shared_ptr<DataPool> create(size_t maxByteCount);
+
+            //! \name Options
+            ///@{
+
+            size_t getMaxByteCount() const;
+            bool hasHugePages() const;
+
+            void setMaxByteCount(size_t);
+
+            //! Set whether large buffers use huge pages. This is only
+            //! supported on Linux, with transparent huge pages.
+            void setHugePages(bool);
+
+            ///@}
+
+            //! \name Buffers
+            ///@{
+
+            //! Get a buffer from the pool, or allocate a new one.
+            //! Throws:
+            //! - std::bad_alloc
+            uint8_t* acquire(size_t byteCount);
+
+            //! Return a buffer to the pool.
+            void release(uint8_t*);
+
+            //! Free the pooled buffers.
+            void clear();
+
+            ///@}
+
+            //! \name Statistics
+            ///@{
+
+            DataPoolStats getStats() const;
+
+            ///@}
+
+        private:
+            size_t _getSizeClass(size_t) const;
+            std::vector<uint8_t*> _maxUpdate();
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace Image
+} // namespace djv
@@ -81,6 +81,14 @@ namespace djv
             Layout      layout;
             std::string codec;
 
+            //! \name YUV
+            ///@{
+
+            YUVCoefficients yuvCoefficients = YUVCoefficients::BT709;
+            YUVRange        yuvRange        = YUVRange::Video;
+
+            ///@}
+
             float getAspectRatio() const noexcept;
             GLenum getGLFormat() const noexcept;
             GLenum getGLType() const noexcept;
@@ -89,6 +97,19 @@ namespace djv
             size_t getScanlineByteCount() const noexcept;
             size_t getDataByteCount() const noexcept;
 
+            //! \name Planes
+            ///@{
+
+            //! The planes are stored one after the other, each scanline
+            //! is aligned. Plane zero is the same as the image scanlines.
+            uint8_t getPlaneCount() const noexcept;
+            Size getPlaneSize(uint8_t) const noexcept;
+            size_t getPlaneScanlineByteCount(uint8_t) const noexcept;
+            size_t getPlaneByteCount(uint8_t) const noexcept;
+            size_t getPlaneOffset(uint8_t) const noexcept;
+
+            ///@}
+
             bool operator == (const Info&) const;
             bool operator != (const Info&) const;
         };
@@ -89,15 +89,53 @@ namespace djv
 
         inline size_t Info::getScanlineByteCount() const noexcept
         {
-            const size_t byteCount = static_cast<size_t>(size.w) * djv::Image::getByteCount(type);
+            return getPlaneScanlineByteCount(0);
+        }
+
+        inline size_t Info::getDataByteCount() const noexcept
+        {
+            return getPlaneOffset(getPlaneCount());
+        }
+
+        inline uint8_t Info::getPlaneCount() const noexcept
+        {
+            return djv::Image::getPlaneCount(type);
+        }
+
+        inline Size Info::getPlaneSize(uint8_t plane) const noexcept
+        {
+            Size out = size;
+            if (plane > 0)
+            {
+                const uint8_t shiftX = getChromaShiftX(type);
+                const uint8_t shiftY = getChromaShiftY(type);
+                out.w = (size.w + (1 << shiftX) - 1) >> shiftX;
+                out.h = (size.h + (1 << shiftY) - 1) >> shiftY;
+            }
+            return out;
+        }
+
+        inline size_t Info::getPlaneScanlineByteCount(uint8_t plane) const noexcept
+        {
+            const size_t byteCount = static_cast<size_t>(getPlaneSize(plane).w) * djv::Image::getByteCount(type);
             const size_t q = byteCount / layout.alignment * layout.alignment;
             const size_t r = byteCount - q;
             return q + (r ? layout.alignment : 0);
         }
 
-        inline size_t Info::getDataByteCount() const noexcept
+        inline size_t Info::getPlaneByteCount(uint8_t plane) const noexcept
+        {
+            return getPlaneSize(plane).h * getPlaneScanlineByteCount(plane);
+        }
+
+        inline size_t Info::getPlaneOffset(uint8_t plane) const noexcept
         {
-            return size.h * getScanlineByteCount();
+            size_t out = 0;
+            for (uint8_t i = 0; i < plane; ++i)
+            {
+                out += getPlaneByteCount(i);
+            }
+            return out;
         }
 
         inline bool Info::operator == (const Info& other) const
@@ -109,7 +147,9 @@ namespace djv
                 pixelAspectRatio == other.pixelAspectRatio &&
                 type == other.type &&
                 layout == other.layout &&
-                codec == other.codec;
+                codec == other.codec &&
+                yuvCoefficients == other.yuvCoefficients &&
+                yuvRange == other.yuvRange;
         }
 
         inline bool Info::operator != (const Info& other) const
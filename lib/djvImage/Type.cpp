@@ -4,10 +4,11 @@
 
 #include <djvImage/Type.h>
 
+#include <djvImage/TypePrivate.h>
+
 #include <algorithm>
 #include <array>
-#include <functional>
-#include <map>
+#include <atomic>
 
 #define CONVERT_L_L(A, B) \
     void convert_L_##A##_L_##B(const void * in, void * out, size_t size) \
@@ -301,7 +302,7 @@
     { \
         const U10_S * inP = reinterpret_cast<const U10_S *>(in); \
         B##_T * outP = reinterpret_cast<B##_T *>(out); \
-        for (size_t i = 0; i < size; ++i, ++inP, outP += 3) \
+        for (size_t i = 0; i < size; ++i, ++inP, outP += 4) \
         { \
             convert_U10_##B(inP->r, outP[0]); \
             convert_U10_##B(inP->g, outP[1]); \
@@ -436,32 +437,30 @@
     CONVERT_RGBA_RGBA(A, F16); \
     CONVERT_RGBA_RGBA(A, F32);
 
-#define CONVERT_MAP(A) \
+#define CONVERT_TABLE(A) \
     { \
-        Type::A, \
-        { \
-            { Type::L_U8,     convert_##A##_L_U8 },     \
-            { Type::L_U16,    convert_##A##_L_U16 },    \
-            { Type::L_U32,    convert_##A##_L_U32 },    \
-            { Type::L_F16,    convert_##A##_L_F16 },    \
-            { Type::L_F32,    convert_##A##_L_F32 },    \
-            { Type::LA_U8,    convert_##A##_LA_U8 },    \
-            { Type::LA_U16,   convert_##A##_LA_U16 },   \
-            { Type::LA_U32,   convert_##A##_LA_U32 },   \
-            { Type::LA_F16,   convert_##A##_LA_F16 },   \
-            { Type::LA_F32,   convert_##A##_LA_F32 },   \
-            { Type::RGB_U8,   convert_##A##_RGB_U8 },   \
-            { Type::RGB_U10,  convert_##A##_RGB_U10 },  \
-            { Type::RGB_U16,  convert_##A##_RGB_U16 },  \
-            { Type::RGB_U32,  convert_##A##_RGB_U32 },  \
-            { Type::RGB_F16,  convert_##A##_RGB_F16 },  \
-            { Type::RGB_F32,  convert_##A##_RGB_F32 },  \
-            { Type::RGBA_U8,  convert_##A##_RGBA_U8 },  \
-            { Type::RGBA_U16, convert_##A##_RGBA_U16 }, \
-            { Type::RGBA_U32, convert_##A##_RGBA_U32 }, \
-            { Type::RGBA_F16, convert_##A##_RGBA_F16 }, \
-            { Type::RGBA_F32, convert_##A##_RGBA_F32 }  \
-        } \
+        nullptr, \
+        convert_##A##_L_U8,    \
+        convert_##A##_L_U16,   \
+        convert_##A##_L_U32,   \
+        convert_##A##_L_F16,   \
+        convert_##A##_L_F32,   \
+        convert_##A##_LA_U8,   \
+        convert_##A##_LA_U16,  \
+        convert_##A##_LA_U32,  \
+        convert_##A##_LA_F16,  \
+        convert_##A##_LA_F32,  \
+        convert_##A##_RGB_U8,  \
+        convert_##A##_RGB_U10, \
+        convert_##A##_RGB_U16, \
+        convert_##A##_RGB_U32, \
+        convert_##A##_RGB_F16, \
+        convert_##A##_RGB_F32, \
+        convert_##A##_RGBA_U8, \
+        convert_##A##_RGBA_U16,\
+        convert_##A##_RGBA_U32,\
+        convert_##A##_RGBA_F16,\
+        convert_##A##_RGBA_F32 \
     }
 
 namespace djv
@@ -497,7 +496,17 @@ namespace djv
                 Channels::RGBA,
                 Channels::RGBA,
                 Channels::RGBA,
-                Channels::RGBA
+                Channels::RGBA,
+
+                Channels::RGB,
+                Channels::RGB,
+                Channels::RGB,
+                Channels::RGB,
+                Channels::RGB,
+                Channels::RGB,
+                Channels::RGB,
+                Channels::RGB,
+                Channels::RGB
             };
             return data[static_cast<size_t>(value)];
         }
@@ -510,7 +519,8 @@ namespace djv
                 1, 1, 1, 1, 1,
                 2, 2, 2, 2, 2,
                 3, 3, 3, 3, 3, 3,
-                4, 4, 4, 4, 4
+                4, 4, 4, 4, 4,
+                3, 3, 3, 3, 3, 3, 3, 3, 3
             };
             return data[static_cast<size_t>(value)];
         }
@@ -544,7 +554,17 @@ namespace djv
                 DataType::U16,
                 DataType::U32,
                 DataType::F16,
-                DataType::F32
+                DataType::F32,
+
+                DataType::U8,
+                DataType::U8,
+                DataType::U8,
+                DataType::U10,
+                DataType::U10,
+                DataType::U10,
+                DataType::U16,
+                DataType::U16,
+                DataType::U16
             };
             return data[static_cast<size_t>(value)];
         }
@@ -557,7 +577,8 @@ namespace djv
                 8, 16, 32, 16, 32,
                 8, 16, 32, 16, 32,
                 8, 10, 16, 32, 16, 32,
-                8, 16, 32, 16, 32
+                8, 16, 32, 16, 32,
+                8, 8, 8, 10, 10, 10, 16, 16, 16
             };
             return data[static_cast<size_t>(value)];
         }
@@ -585,7 +606,8 @@ namespace djv
                 1, 2, 4, 2, 4,
                 2, 4, 8, 4, 8,
                 3, 4, 6, 12, 6, 12,
-                4, 8, 16, 8, 16
+                4, 8, 16, 8, 16,
+                1, 1, 1, 2, 2, 2, 2, 2, 2
             };
             return data[static_cast<size_t>(value)];
         }
@@ -614,6 +636,7 @@ namespace djv
                 true, true, true, false, false,
                 true, true, true, true, false, false,
                 true, true, true, false, false,
+                true, true, true, true, true, true, true, true, true
             };
             return data[static_cast<size_t>(value)];
         }
@@ -626,7 +649,8 @@ namespace djv
                 false, false, false, true, true,
                 false, false, false, true, true,
                 false, false, false, false, true, true,
-                false, false, false, true, true
+                false, false, false, true, true,
+                false, false, false, false, false, false, false, false, false
             };
             return data[static_cast<size_t>(value)];
         }
@@ -661,6 +685,16 @@ namespace djv
                 Math::IntRange(U32Range.getMin(), U32Range.getMax()),
                 Math::IntRange(0, 0),
                 Math::IntRange(0, 0),
+
+                Math::IntRange(U8Range.getMin(), U8Range.getMax()),
+                Math::IntRange(U8Range.getMin(), U8Range.getMax()),
+                Math::IntRange(U8Range.getMin(), U8Range.getMax()),
+                Math::IntRange(U10Range.getMin(), U10Range.getMax()),
+                Math::IntRange(U10Range.getMin(), U10Range.getMax()),
+                Math::IntRange(U10Range.getMin(), U10Range.getMax()),
+                Math::IntRange(U16Range.getMin(), U16Range.getMax()),
+                Math::IntRange(U16Range.getMin(), U16Range.getMax()),
+                Math::IntRange(U16Range.getMin(), U16Range.getMax())
             };
             return data[static_cast<size_t>(value)];
         }
@@ -695,6 +729,16 @@ namespace djv
                 Math::FloatRange(0.F, 0.F),
                 Math::FloatRange(F16Range.getMin(), F16Range.getMax()),
                 Math::FloatRange(F32Range.getMin(), F32Range.getMax()),
+
+                Math::FloatRange(0.F, 0.F),
+                Math::FloatRange(0.F, 0.F),
+                Math::FloatRange(0.F, 0.F),
+                Math::FloatRange(0.F, 0.F),
+                Math::FloatRange(0.F, 0.F),
+                Math::FloatRange(0.F, 0.F),
+                Math::FloatRange(0.F, 0.F),
+                Math::FloatRange(0.F, 0.F),
+                Math::FloatRange(0.F, 0.F)
             };
             return data[static_cast<size_t>(value)];
         }
@@ -816,6 +860,16 @@ namespace djv
                 GL_NONE,
                 GL_NONE,
                 GL_NONE,
+                GL_NONE,
+
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
                 GL_NONE
 #else // DJV_GL_ES2
                 GL_RED,
@@ -841,7 +895,17 @@ namespace djv
                 GL_RGBA,
                 GL_RGBA,
                 GL_RGBA,
-                GL_RGBA
+                GL_RGBA,
+
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE
 #endif // DJV_GL_ES2
             };
             return data[static_cast<size_t>(value)];
@@ -878,6 +942,16 @@ namespace djv
                 GL_NONE,
                 GL_NONE,
                 GL_NONE,
+
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE
 #else // DJV_GL_ES2
                 GL_UNSIGNED_BYTE,
                 GL_UNSIGNED_SHORT,
@@ -902,12 +976,80 @@ namespace djv
                 GL_UNSIGNED_SHORT,
                 GL_UNSIGNED_INT,
                 GL_HALF_FLOAT,
-                GL_FLOAT
+                GL_FLOAT,
+
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE,
+                GL_NONE
 #endif // DJV_GL_ES2
             };
             return data[static_cast<size_t>(value)];
         }
 
+        bool isYUVType(Type value) noexcept
+        {
+            return value >= Type::YUV_420P_U8 && value <= Type::YUV_444P_U16;
+        }
+
+        uint8_t getPlaneCount(Type value) noexcept
+        {
+            return isYUVType(value) ? 3 : 1;
+        }
+
+        uint8_t getChromaShiftX(Type value) noexcept
+        {
+            switch (value)
+            {
+            case Type::YUV_420P_U8:
+            case Type::YUV_422P_U8:
+            case Type::YUV_420P_U10:
+            case Type::YUV_422P_U10:
+            case Type::YUV_420P_U16:
+            case Type::YUV_422P_U16: return 1;
+            default: break;
+            }
+            return 0;
+        }
+
+        uint8_t getChromaShiftY(Type value) noexcept
+        {
+            switch (value)
+            {
+            case Type::YUV_420P_U8:
+            case Type::YUV_420P_U10:
+            case Type::YUV_420P_U16: return 1;
+            default: break;
+            }
+            return 0;
+        }
+
+        Type getYUVConvertType(Type value) noexcept
+        {
+            Type out = value;
+            if (isYUVType(value))
+            {
+                out = DataType::U8 == getDataType(value) ? Type::RGB_U8 : Type::RGB_U16;
+            }
+            return out;
+        }
+
+        void getYUVCoefficients(YUVCoefficients value, float& kr, float& kb) noexcept
+        {
+            switch (value)
+            {
+            case YUVCoefficients::BT601:  kr = .299F;  kb = .114F;  break;
+            case YUVCoefficients::BT709:  kr = .2126F; kb = .0722F; break;
+            case YUVCoefficients::BT2020: kr = .2627F; kb = .0593F; break;
+            default:                      kr = 0.F;    kb = 0.F;    break;
+            }
+        }
+
         namespace
         {
             CONVERT_L(U8);
@@ -933,54 +1075,102 @@ namespace djv
             CONVERT_RGBA(F16);
             CONVERT_RGBA(F32);
 
-        } // namespace
-
-        void convert(const void * in, Type inType, void * out, Type outType, size_t size)
-        {
-            typedef std::function<void(const void *, void *, size_t)> Function;
-            static const std::map<Type, std::map<Type, Function> > functions =
+            // The scalar conversion functions, indexed by the input and
+            // output types.
+            constexpr ConvertFunction scalarConvertTable[static_cast<size_t>(Type::Count)][static_cast<size_t>(Type::Count)] =
             {
-                CONVERT_MAP(L_U8),
-                CONVERT_MAP(L_U16),
-                CONVERT_MAP(L_U32),
-                CONVERT_MAP(L_F16),
-                CONVERT_MAP(L_F32),
-                CONVERT_MAP(LA_U8),
-                CONVERT_MAP(LA_U16),
-                CONVERT_MAP(LA_U32),
-                CONVERT_MAP(LA_F16),
-                CONVERT_MAP(LA_F32),
-                CONVERT_MAP(RGB_U8),
-                CONVERT_MAP(RGB_U10),
-                CONVERT_MAP(RGB_U16),
-                CONVERT_MAP(RGB_U32),
-                CONVERT_MAP(RGB_F16),
-                CONVERT_MAP(RGB_F32),
-                CONVERT_MAP(RGBA_U8),
-                CONVERT_MAP(RGBA_U16),
-                CONVERT_MAP(RGBA_U32),
-                CONVERT_MAP(RGBA_F16),
-                CONVERT_MAP(RGBA_F32)
+                {},
+                CONVERT_TABLE(L_U8),
+                CONVERT_TABLE(L_U16),
+                CONVERT_TABLE(L_U32),
+                CONVERT_TABLE(L_F16),
+                CONVERT_TABLE(L_F32),
+                CONVERT_TABLE(LA_U8),
+                CONVERT_TABLE(LA_U16),
+                CONVERT_TABLE(LA_U32),
+                CONVERT_TABLE(LA_F16),
+                CONVERT_TABLE(LA_F32),
+                CONVERT_TABLE(RGB_U8),
+                CONVERT_TABLE(RGB_U10),
+                CONVERT_TABLE(RGB_U16),
+                CONVERT_TABLE(RGB_U32),
+                CONVERT_TABLE(RGB_F16),
+                CONVERT_TABLE(RGB_F32),
+                CONVERT_TABLE(RGBA_U8),
+                CONVERT_TABLE(RGBA_U16),
+                CONVERT_TABLE(RGBA_U32),
+                CONVERT_TABLE(RGBA_F16),
+                CONVERT_TABLE(RGBA_F32)
             };
-            Function function;
-            const auto i = functions.find(inType);
-            if (i != functions.end())
+
+            // The conversion tables for each instruction set, the entries
+            // without a vectorized version use the scalar functions.
+            struct ConvertTables
             {
-                const auto j = i->second.find(outType);
-                if (j != i->second.end())
+                ConvertTables()
                 {
-                    function = j->second;
+                    max = getCPUConvertISA();
+                    current = static_cast<int>(max);
+                    for (size_t i = 0; i < static_cast<size_t>(ConvertISA::Count); ++i)
+                    {
+                        for (size_t j = 0; j < static_cast<size_t>(Type::Count); ++j)
+                        {
+                            for (size_t k = 0; k < static_cast<size_t>(Type::Count); ++k)
+                            {
+                                tables[i][j][k] = scalarConvertTable[j][k];
+                            }
+                        }
+                        if (i <= static_cast<size_t>(max))
+                        {
+                            initConvertTable(static_cast<ConvertISA>(i), tables[i]);
+                        }
+                    }
                 }
+
+                ConvertTable tables[static_cast<size_t>(ConvertISA::Count)];
+                ConvertISA max = ConvertISA::Scalar;
+                std::atomic<int> current;
+            };
+
+            ConvertTables& getConvertTables()
+            {
+                static ConvertTables tables;
+                return tables;
             }
-            if (function)
+
+        } // namespace
+
+        void convert(const void * in, Type inType, void * out, Type outType, size_t size)
+        {
+            const auto& tables = getConvertTables();
+            const auto& table = tables.tables[tables.current.load(std::memory_order_relaxed)];
+            if (const ConvertFunction function = table[static_cast<size_t>(inType)][static_cast<size_t>(outType)])
             {
                 function(in, out, size);
             }
         }
 
+        ConvertISA getConvertISA() noexcept
+        {
+            return static_cast<ConvertISA>(getConvertTables().current.load());
+        }
+
+        ConvertISA getConvertISAMax() noexcept
+        {
+            return getConvertTables().max;
+        }
+
+        void setConvertISA(ConvertISA value) noexcept
+        {
+            auto& tables = getConvertTables();
+            tables.current = static_cast<int>(std::min(value, tables.max));
+        }
+
         DJV_ENUM_HELPERS_IMPLEMENTATION(Type);
         DJV_ENUM_HELPERS_IMPLEMENTATION(Channels);
         DJV_ENUM_HELPERS_IMPLEMENTATION(DataType);
+        DJV_ENUM_HELPERS_IMPLEMENTATION(YUVCoefficients);
+        DJV_ENUM_HELPERS_IMPLEMENTATION(YUVRange);
 
     } // namespace Image
 
@@ -1008,7 +1198,16 @@ namespace djv
         DJV_TEXT("image_type_rgba_u16"),
         DJV_TEXT("image_type_rgba_u32"),
         DJV_TEXT("image_type_rgba_f16"),
-        DJV_TEXT("image_type_rgba_f32"));
+        DJV_TEXT("image_type_rgba_f32"),
+        DJV_TEXT("image_type_yuv_420p_u8"),
+        DJV_TEXT("image_type_yuv_422p_u8"),
+        DJV_TEXT("image_type_yuv_444p_u8"),
+        DJV_TEXT("image_type_yuv_420p_u10"),
+        DJV_TEXT("image_type_yuv_422p_u10"),
+        DJV_TEXT("image_type_yuv_444p_u10"),
+        DJV_TEXT("image_type_yuv_420p_u16"),
+        DJV_TEXT("image_type_yuv_422p_u16"),
+        DJV_TEXT("image_type_yuv_444p_u16"));
 
     DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
         Image,
@@ -1030,6 +1229,19 @@ namespace djv
         DJV_TEXT("image_data_type_f16"),
         DJV_TEXT("image_data_type_f32"));
 
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        Image,
+        YUVCoefficients,
+        DJV_TEXT("image_yuv_coefficients_bt601"),
+        DJV_TEXT("image_yuv_coefficients_bt709"),
+        DJV_TEXT("image_yuv_coefficients_bt2020"));
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        Image,
+        YUVRange,
+        DJV_TEXT("image_yuv_range_video"),
+        DJV_TEXT("image_yuv_range_full"));
+
     rapidjson::Value toJSON(Image::Type value, rapidjson::Document::AllocatorType& allocator)
     {
         std::stringstream ss;
@@ -59,6 +59,18 @@ namespace djv
             RGBA_F16,
             RGBA_F32,
 
+            //! Planar YUV types, the luma plane is followed by the two
+            //! chroma planes. The 10-bit types are stored in 16-bit words.
+            YUV_420P_U8,
+            YUV_422P_U8,
+            YUV_444P_U8,
+            YUV_420P_U10,
+            YUV_422P_U10,
+            YUV_444P_U10,
+            YUV_420P_U16,
+            YUV_422P_U16,
+            YUV_444P_U16,
+
             Count,
             First = None
         };
@@ -94,6 +106,29 @@ namespace djv
         };
         DJV_ENUM_HELPERS(DataType);
 
+        //! YUV color coefficients.
+        enum class YUVCoefficients
+        {
+            BT601,
+            BT709,
+            BT2020,
+
+            Count,
+            First = BT601
+        };
+        DJV_ENUM_HELPERS(YUVCoefficients);
+
+        //! YUV value range.
+        enum class YUVRange
+        {
+            Video,
+            Full,
+
+            Count,
+            First = Video
+        };
+        DJV_ENUM_HELPERS(YUVRange);
+
         typedef uint8_t   U8_T;
         typedef uint16_t U10_T;
         typedef uint16_t U12_T;
@@ -181,6 +216,30 @@ namespace djv
 
         ///@}
 
+        //! \name YUV
+        ///@{
+
+        bool isYUVType(Type) noexcept;
+
+        //! Get the number of planes, this is three for the YUV types and one
+        //! for all other types.
+        uint8_t getPlaneCount(Type) noexcept;
+
+        //! Get the horizontal chroma subsampling as a power of two.
+        uint8_t getChromaShiftX(Type) noexcept;
+
+        //! Get the vertical chroma subsampling as a power of two.
+        uint8_t getChromaShiftY(Type) noexcept;
+
+        //! Get the RGB type that YUV data is converted to for display. For
+        //! other types this returns the type unchanged.
+        Type getYUVConvertType(Type) noexcept;
+
+        //! Get the red and blue luma coefficients.
+        void getYUVCoefficients(YUVCoefficients, float& kr, float& kb) noexcept;
+
+        ///@}
+
         //! \name Conversion
         ///@{
 
@@ -228,6 +287,28 @@ namespace djv
 
         void convert(const void *, Type, void *, Type, size_t);
 
+        //! CPU instruction sets used by convert().
+        enum class ConvertISA
+        {
+            Scalar,
+            SSE41,
+            AVX2, //!< AVX2 and F16C
+
+            Count,
+            First = Scalar
+        };
+
+        //! Get the instruction set used by convert().
+        ConvertISA getConvertISA() noexcept;
+
+        //! Get the best instruction set supported by the CPU.
+        ConvertISA getConvertISAMax() noexcept;
+
+        //! Set the instruction set used by convert(). The value is clamped
+        //! to what the CPU supports. This is intended for testing and
+        //! benchmarking, the default is the best supported instruction set.
+        void setConvertISA(ConvertISA) noexcept;
+
         ///@}
 
     } // namespace Image
@@ -235,6 +316,8 @@ namespace djv
     DJV_ENUM_SERIALIZE_HELPERS(Image::Type);
     DJV_ENUM_SERIALIZE_HELPERS(Image::Channels);
     DJV_ENUM_SERIALIZE_HELPERS(Image::DataType);
+    DJV_ENUM_SERIALIZE_HELPERS(Image::YUVCoefficients);
+    DJV_ENUM_SERIALIZE_HELPERS(Image::YUVRange);
 
     rapidjson::Value toJSON(Image::Type, rapidjson::Document::AllocatorType&);
 
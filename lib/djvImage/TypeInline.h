@@ -159,25 +159,25 @@ namespace djv
         inline void convert_F16_U8(F16_T in, U8_T& out)
         {
             out = static_cast<U8_T>(Math::clamp(
-                static_cast<uint16_t>(in * U8Range.getMax()),
-                static_cast<uint16_t>(U8Range.getMin()),
-                static_cast<uint16_t>(U8Range.getMax())));
+                static_cast<float>(in) * U8Range.getMax(),
+                static_cast<float>(U8Range.getMin()),
+                static_cast<float>(U8Range.getMax())));
         }
 
         inline void convert_F16_U10(F16_T in, U10_T& out)
         {
             out = static_cast<U10_T>(Math::clamp(
-                static_cast<uint16_t>(in * U10Range.getMax()),
-                static_cast<uint16_t>(U10Range.getMin()),
-                static_cast<uint16_t>(U10Range.getMax())));
+                static_cast<float>(in) * U10Range.getMax(),
+                static_cast<float>(U10Range.getMin()),
+                static_cast<float>(U10Range.getMax())));
         }
 
         inline void convert_F16_U16(F16_T in, U16_T& out)
         {
             out = static_cast<U16_T>(Math::clamp(
-                static_cast<uint32_t>(in * U16Range.getMax()),
-                static_cast<uint32_t>(U16Range.getMin()),
-                static_cast<uint32_t>(U16Range.getMax())));
+                static_cast<float>(in) * U16Range.getMax(),
+                static_cast<float>(U16Range.getMin()),
+                static_cast<float>(U16Range.getMax())));
         }
 
         inline void convert_F16_U32(F16_T in, U32_T& out)
@@ -201,25 +201,25 @@ namespace djv
         inline void convert_F32_U8(F32_T in, U8_T& out)
         {
             out = static_cast<U8_T>(Math::clamp(
-                static_cast<uint16_t>(in * U8Range.getMax()),
-                static_cast<uint16_t>(U8Range.getMin()),
-                static_cast<uint16_t>(U8Range.getMax())));
+                static_cast<float>(in) * U8Range.getMax(),
+                static_cast<float>(U8Range.getMin()),
+                static_cast<float>(U8Range.getMax())));
         }
 
         inline void convert_F32_U10(F32_T in, U10_T& out)
         {
             out = static_cast<U10_T>(Math::clamp(
-                static_cast<uint16_t>(in * U10Range.getMax()),
-                static_cast<uint16_t>(U10Range.getMin()),
-                static_cast<uint16_t>(U10Range.getMax())));
+                static_cast<float>(in) * U10Range.getMax(),
+                static_cast<float>(U10Range.getMin()),
+                static_cast<float>(U10Range.getMax())));
         }
 
         inline void convert_F32_U16(F32_T in, U16_T& out)
         {
             out = static_cast<U16_T>(Math::clamp(
-                static_cast<uint32_t>(in * U16Range.getMax()),
-                static_cast<uint32_t>(U16Range.getMin()),
-                static_cast<uint32_t>(U16Range.getMax())));
+                static_cast<float>(in) * U16Range.getMax(),
+                static_cast<float>(U16Range.getMin()),
+                static_cast<float>(U16Range.getMax())));
         }
 
         inline void convert_F32_U32(F32_T in, U32_T& out)
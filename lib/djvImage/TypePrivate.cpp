@@ -0,0 +1,724 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImage/TypePrivate.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DJV_IMAGE_CONVERT_X86
+#endif // __x86_64__
+
+#if defined(DJV_IMAGE_CONVERT_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else // _MSC_VER
+#include <cpuid.h>
+#endif // _MSC_VER
+#include <immintrin.h>
+#endif // DJV_IMAGE_CONVERT_X86
+
+// The kernels are compiled for their instruction set with function
+// attributes, so the library itself does not need to be built with
+// -msse4.1 or -mavx2. The kernels are only called after checking that the
+// CPU supports them.
+#if defined(__GNUC__) || defined(__clang__)
+#define DJV_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define DJV_TARGET_AVX2  __attribute__((target("avx2,f16c")))
+#else // __GNUC__
+#define DJV_TARGET_SSE41
+#define DJV_TARGET_AVX2
+#endif // __GNUC__
+
+namespace djv
+{
+    namespace Image
+    {
+        namespace
+        {
+#if defined(DJV_IMAGE_CONVERT_X86)
+
+            constexpr size_t index(Type value) noexcept
+            {
+                return static_cast<size_t>(value);
+            }
+
+            void cpuid(unsigned int leaf, unsigned int (&regs)[4])
+            {
+#if defined(_MSC_VER)
+                int tmp[4] = { 0, 0, 0, 0 };
+                __cpuidex(tmp, static_cast<int>(leaf), 0);
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    regs[i] = static_cast<unsigned int>(tmp[i]);
+                }
+#else // _MSC_VER
+                __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif // _MSC_VER
+            }
+
+            uint64_t xgetbv()
+            {
+#if defined(_MSC_VER)
+                return _xgetbv(0);
+#else // _MSC_VER
+                uint32_t eax = 0;
+                uint32_t edx = 0;
+                __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+                return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif // _MSC_VER
+            }
+
+            // Convert the channels of any layout, the size is multiplied by
+            // the channel count.
+            template<size_t C, ConvertFunction F>
+            void convertChannels(const void * in, void * out, size_t size)
+            {
+                F(in, out, size * C);
+            }
+
+            //! \name SSE4.1 Kernels
+            ///@{
+
+            DJV_TARGET_SSE41 void convert_U8_F32_SSE41(const void * in, void * out, size_t size)
+            {
+                const U8_T * inP = reinterpret_cast<const U8_T *>(in);
+                F32_T * outP = reinterpret_cast<F32_T *>(out);
+                const __m128 max = _mm_set1_ps(static_cast<float>(U8Range.getMax()));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i));
+                    _mm_storeu_ps(outP + i,      _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(v)), max));
+                    _mm_storeu_ps(outP + i + 4,  _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 4))), max));
+                    _mm_storeu_ps(outP + i + 8,  _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 8))), max));
+                    _mm_storeu_ps(outP + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 12))), max));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_U8_F32(inP[i], outP[i]);
+                }
+            }
+
+            DJV_TARGET_SSE41 void convert_U16_F32_SSE41(const void * in, void * out, size_t size)
+            {
+                const U16_T * inP = reinterpret_cast<const U16_T *>(in);
+                F32_T * outP = reinterpret_cast<F32_T *>(out);
+                const __m128 max = _mm_set1_ps(static_cast<float>(U16Range.getMax()));
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i));
+                    _mm_storeu_ps(outP + i,     _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(v)), max));
+                    _mm_storeu_ps(outP + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_srli_si128(v, 8))), max));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_U16_F32(inP[i], outP[i]);
+                }
+            }
+
+            // Scale and clamp floating point values to an integer range.
+            DJV_TARGET_SSE41 inline __m128i scaleClamp(__m128 value, __m128 max)
+            {
+                return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(value, max), _mm_setzero_ps()), max));
+            }
+
+            DJV_TARGET_SSE41 void convert_F32_U8_SSE41(const void * in, void * out, size_t size)
+            {
+                const F32_T * inP = reinterpret_cast<const F32_T *>(in);
+                U8_T * outP = reinterpret_cast<U8_T *>(out);
+                const __m128 max = _mm_set1_ps(static_cast<float>(U8Range.getMax()));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16)
+                {
+                    const __m128i a = _mm_packus_epi32(
+                        scaleClamp(_mm_loadu_ps(inP + i), max),
+                        scaleClamp(_mm_loadu_ps(inP + i + 4), max));
+                    const __m128i b = _mm_packus_epi32(
+                        scaleClamp(_mm_loadu_ps(inP + i + 8), max),
+                        scaleClamp(_mm_loadu_ps(inP + i + 12), max));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(outP + i), _mm_packus_epi16(a, b));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_F32_U8(inP[i], outP[i]);
+                }
+            }
+
+            DJV_TARGET_SSE41 void convert_F32_U16_SSE41(const void * in, void * out, size_t size)
+            {
+                const F32_T * inP = reinterpret_cast<const F32_T *>(in);
+                U16_T * outP = reinterpret_cast<U16_T *>(out);
+                const __m128 max = _mm_set1_ps(static_cast<float>(U16Range.getMax()));
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i *>(outP + i),
+                        _mm_packus_epi32(
+                            scaleClamp(_mm_loadu_ps(inP + i), max),
+                            scaleClamp(_mm_loadu_ps(inP + i + 4), max)));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_F32_U16(inP[i], outP[i]);
+                }
+            }
+
+#if !defined(DJV_ENDIAN_MSB)
+            // Unpack four 10-bit pixels into 32-bit lanes.
+            DJV_TARGET_SSE41 inline void unpackU10(const U10_S * in, __m128i & r, __m128i & g, __m128i & b)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+                const __m128i mask = _mm_set1_epi32(U10Range.getMax());
+                r = _mm_srli_epi32(v, 22);
+                g = _mm_and_si128(_mm_srli_epi32(v, 12), mask);
+                b = _mm_and_si128(_mm_srli_epi32(v, 2), mask);
+            }
+
+            // Store four RGBA pixels with 16-bit channels. The channel
+            // values are in the low half of the 32-bit lanes.
+            DJV_TARGET_SSE41 inline void storeRGBA16(void * out, __m128i r, __m128i g, __m128i b, __m128i a)
+            {
+                const __m128i rg = _mm_or_si128(r, _mm_slli_epi32(g, 16));
+                const __m128i ba = _mm_or_si128(b, _mm_slli_epi32(a, 16));
+                __m128i * outP = reinterpret_cast<__m128i *>(out);
+                _mm_storeu_si128(outP, _mm_unpacklo_epi32(rg, ba));
+                _mm_storeu_si128(outP + 1, _mm_unpackhi_epi32(rg, ba));
+            }
+
+            // Store four RGB pixels with 16-bit channels.
+            DJV_TARGET_SSE41 inline void storeRGB16(void * out, __m128i r, __m128i g, __m128i b)
+            {
+                const __m128i rg = _mm_or_si128(r, _mm_slli_epi32(g, 16));
+                const __m128i mask = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, -128, -128, -128, -128);
+                const __m128i p01 = _mm_shuffle_epi8(_mm_unpacklo_epi32(rg, b), mask);
+                const __m128i p23 = _mm_shuffle_epi8(_mm_unpackhi_epi32(rg, b), mask);
+                __m128i * outP = reinterpret_cast<__m128i *>(out);
+                _mm_storeu_si128(outP, _mm_or_si128(p01, _mm_slli_si128(p23, 12)));
+                _mm_storel_epi64(outP + 1, _mm_srli_si128(p23, 4));
+            }
+
+            DJV_TARGET_SSE41 void convert_RGB_U10_RGB_U16_SSE41(const void * in, void * out, size_t size)
+            {
+                const U10_S * inP = reinterpret_cast<const U10_S *>(in);
+                U16_T * outP = reinterpret_cast<U16_T *>(out);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    __m128i r;
+                    __m128i g;
+                    __m128i b;
+                    unpackU10(inP + i, r, g, b);
+                    storeRGB16(outP + i * 3, _mm_slli_epi32(r, 6), _mm_slli_epi32(g, 6), _mm_slli_epi32(b, 6));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_U10_U16(inP[i].r, outP[i * 3]);
+                    convert_U10_U16(inP[i].g, outP[i * 3 + 1]);
+                    convert_U10_U16(inP[i].b, outP[i * 3 + 2]);
+                }
+            }
+
+            DJV_TARGET_SSE41 void convert_RGB_U10_RGBA_U16_SSE41(const void * in, void * out, size_t size)
+            {
+                const U10_S * inP = reinterpret_cast<const U10_S *>(in);
+                U16_T * outP = reinterpret_cast<U16_T *>(out);
+                const __m128i a = _mm_set1_epi32(U16Range.getMax());
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    __m128i r;
+                    __m128i g;
+                    __m128i b;
+                    unpackU10(inP + i, r, g, b);
+                    storeRGBA16(outP + i * 4, _mm_slli_epi32(r, 6), _mm_slli_epi32(g, 6), _mm_slli_epi32(b, 6), a);
+                }
+                for (; i < size; ++i)
+                {
+                    convert_U10_U16(inP[i].r, outP[i * 4]);
+                    convert_U10_U16(inP[i].g, outP[i * 4 + 1]);
+                    convert_U10_U16(inP[i].b, outP[i * 4 + 2]);
+                    outP[i * 4 + 3] = U16Range.getMax();
+                }
+            }
+#endif // DJV_ENDIAN_MSB
+
+            // RGB to RGBA and back again for 8-bit channels. The loops
+            // stop early enough that the 16 byte loads and stores stay in
+            // bounds, the stores may overlap the next pixels which are
+            // then overwritten.
+            DJV_TARGET_SSE41 void convert_RGB_8_RGBA_8_SSE41(const void * in, void * out, size_t size)
+            {
+                const uint8_t * inP = reinterpret_cast<const uint8_t *>(in);
+                uint8_t * outP = reinterpret_cast<uint8_t *>(out);
+                const __m128i mask = _mm_setr_epi8(0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128);
+                const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+                size_t i = 0;
+                for (; i + 6 <= size; i += 4)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i * 3));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(outP + i * 4), _mm_or_si128(_mm_shuffle_epi8(v, mask), alpha));
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i * 4]     = inP[i * 3];
+                    outP[i * 4 + 1] = inP[i * 3 + 1];
+                    outP[i * 4 + 2] = inP[i * 3 + 2];
+                    outP[i * 4 + 3] = U8Range.getMax();
+                }
+            }
+
+            DJV_TARGET_SSE41 void convert_RGBA_8_RGB_8_SSE41(const void * in, void * out, size_t size)
+            {
+                const uint8_t * inP = reinterpret_cast<const uint8_t *>(in);
+                uint8_t * outP = reinterpret_cast<uint8_t *>(out);
+                const __m128i mask = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -128, -128, -128, -128);
+                size_t i = 0;
+                for (; i + 6 <= size; i += 4)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i * 4));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(outP + i * 3), _mm_shuffle_epi8(v, mask));
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i * 3]     = inP[i * 4];
+                    outP[i * 3 + 1] = inP[i * 4 + 1];
+                    outP[i * 3 + 2] = inP[i * 4 + 2];
+                }
+            }
+
+            // RGB to RGBA and back again for 16-bit channels, the alpha
+            // value is given as bits so this also works for half floats.
+            template<uint16_t ALPHA>
+            DJV_TARGET_SSE41 void convert_RGB_16_RGBA_16_SSE41(const void * in, void * out, size_t size)
+            {
+                const uint16_t * inP = reinterpret_cast<const uint16_t *>(in);
+                uint16_t * outP = reinterpret_cast<uint16_t *>(out);
+                const __m128i mask = _mm_setr_epi8(0, 1, 2, 3, 4, 5, -128, -128, 6, 7, 8, 9, 10, 11, -128, -128);
+                const __m128i alpha = _mm_setr_epi16(0, 0, 0, static_cast<short>(ALPHA), 0, 0, 0, static_cast<short>(ALPHA));
+                size_t i = 0;
+                for (; i + 3 <= size; i += 2)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i * 3));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(outP + i * 4), _mm_or_si128(_mm_shuffle_epi8(v, mask), alpha));
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i * 4]     = inP[i * 3];
+                    outP[i * 4 + 1] = inP[i * 3 + 1];
+                    outP[i * 4 + 2] = inP[i * 3 + 2];
+                    outP[i * 4 + 3] = ALPHA;
+                }
+            }
+
+            DJV_TARGET_SSE41 void convert_RGBA_16_RGB_16_SSE41(const void * in, void * out, size_t size)
+            {
+                const uint16_t * inP = reinterpret_cast<const uint16_t *>(in);
+                uint16_t * outP = reinterpret_cast<uint16_t *>(out);
+                const __m128i mask = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, -128, -128, -128, -128);
+                size_t i = 0;
+                for (; i + 3 <= size; i += 2)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i * 4));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(outP + i * 3), _mm_shuffle_epi8(v, mask));
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i * 3]     = inP[i * 4];
+                    outP[i * 3 + 1] = inP[i * 4 + 1];
+                    outP[i * 3 + 2] = inP[i * 4 + 2];
+                }
+            }
+
+            // RGB to RGBA and back again for 32-bit channels, the alpha
+            // value is given as bits so this also works for floats.
+            template<uint32_t ALPHA>
+            DJV_TARGET_SSE41 void convert_RGB_32_RGBA_32_SSE41(const void * in, void * out, size_t size)
+            {
+                const uint32_t * inP = reinterpret_cast<const uint32_t *>(in);
+                uint32_t * outP = reinterpret_cast<uint32_t *>(out);
+                const __m128i alpha = _mm_set1_epi32(static_cast<int>(ALPHA));
+                size_t i = 0;
+                for (; i + 2 <= size; ++i)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i * 3));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(outP + i * 4), _mm_blend_epi16(v, alpha, 0xc0));
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i * 4]     = inP[i * 3];
+                    outP[i * 4 + 1] = inP[i * 3 + 1];
+                    outP[i * 4 + 2] = inP[i * 3 + 2];
+                    outP[i * 4 + 3] = ALPHA;
+                }
+            }
+
+            DJV_TARGET_SSE41 void convert_RGBA_32_RGB_32_SSE41(const void * in, void * out, size_t size)
+            {
+                const uint32_t * inP = reinterpret_cast<const uint32_t *>(in);
+                uint32_t * outP = reinterpret_cast<uint32_t *>(out);
+                size_t i = 0;
+                for (; i + 2 <= size; ++i)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i * 4));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(outP + i * 3), v);
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i * 3]     = inP[i * 4];
+                    outP[i * 3 + 1] = inP[i * 4 + 1];
+                    outP[i * 3 + 2] = inP[i * 4 + 2];
+                }
+            }
+
+            ///@}
+
+            //! \name AVX2 Kernels
+            ///@{
+
+            DJV_TARGET_AVX2 void convert_U8_F32_AVX2(const void * in, void * out, size_t size)
+            {
+                const U8_T * inP = reinterpret_cast<const U8_T *>(in);
+                F32_T * outP = reinterpret_cast<F32_T *>(out);
+                const __m256 max = _mm256_set1_ps(static_cast<float>(U8Range.getMax()));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i));
+                    _mm256_storeu_ps(outP + i,     _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)), max));
+                    _mm256_storeu_ps(outP + i + 8, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(v, 8))), max));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_U8_F32(inP[i], outP[i]);
+                }
+            }
+
+            DJV_TARGET_AVX2 void convert_U16_F32_AVX2(const void * in, void * out, size_t size)
+            {
+                const U16_T * inP = reinterpret_cast<const U16_T *>(in);
+                F32_T * outP = reinterpret_cast<F32_T *>(out);
+                const __m256 max = _mm256_set1_ps(static_cast<float>(U16Range.getMax()));
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i));
+                    _mm256_storeu_ps(outP + i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(v)), max));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_U16_F32(inP[i], outP[i]);
+                }
+            }
+
+            // Scale and clamp floating point values to an integer range,
+            // the result is packed to eight unsigned 16-bit values.
+            DJV_TARGET_AVX2 inline __m128i scaleClampPack(__m256 value, __m256 max)
+            {
+                const __m256i v = _mm256_cvttps_epi32(
+                    _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(value, max), _mm256_setzero_ps()), max));
+                return _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+            }
+
+            DJV_TARGET_AVX2 void convert_F32_U8_AVX2(const void * in, void * out, size_t size)
+            {
+                const F32_T * inP = reinterpret_cast<const F32_T *>(in);
+                U8_T * outP = reinterpret_cast<U8_T *>(out);
+                const __m256 max = _mm256_set1_ps(static_cast<float>(U8Range.getMax()));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16)
+                {
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i *>(outP + i),
+                        _mm_packus_epi16(
+                            scaleClampPack(_mm256_loadu_ps(inP + i), max),
+                            scaleClampPack(_mm256_loadu_ps(inP + i + 8), max)));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_F32_U8(inP[i], outP[i]);
+                }
+            }
+
+            DJV_TARGET_AVX2 void convert_F32_U16_AVX2(const void * in, void * out, size_t size)
+            {
+                const F32_T * inP = reinterpret_cast<const F32_T *>(in);
+                U16_T * outP = reinterpret_cast<U16_T *>(out);
+                const __m256 max = _mm256_set1_ps(static_cast<float>(U16Range.getMax()));
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i *>(outP + i),
+                        scaleClampPack(_mm256_loadu_ps(inP + i), max));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_F32_U16(inP[i], outP[i]);
+                }
+            }
+
+            // The half float conversions use the F16C instructions, they
+            // round to nearest even the same as the half class.
+            DJV_TARGET_AVX2 void convert_U8_F16_AVX2(const void * in, void * out, size_t size)
+            {
+                const U8_T * inP = reinterpret_cast<const U8_T *>(in);
+                F16_T * outP = reinterpret_cast<F16_T *>(out);
+                const __m256 max = _mm256_set1_ps(static_cast<float>(U8Range.getMax()));
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(inP + i));
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i *>(outP + i),
+                        _mm256_cvtps_ph(_mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)), max), _MM_FROUND_TO_NEAREST_INT));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_U8_F16(inP[i], outP[i]);
+                }
+            }
+
+            DJV_TARGET_AVX2 void convert_U16_F16_AVX2(const void * in, void * out, size_t size)
+            {
+                const U16_T * inP = reinterpret_cast<const U16_T *>(in);
+                F16_T * outP = reinterpret_cast<F16_T *>(out);
+                const __m256 max = _mm256_set1_ps(static_cast<float>(U16Range.getMax()));
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i));
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i *>(outP + i),
+                        _mm256_cvtps_ph(_mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(v)), max), _MM_FROUND_TO_NEAREST_INT));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_U16_F16(inP[i], outP[i]);
+                }
+            }
+
+            DJV_TARGET_AVX2 void convert_F16_U8_AVX2(const void * in, void * out, size_t size)
+            {
+                const F16_T * inP = reinterpret_cast<const F16_T *>(in);
+                U8_T * outP = reinterpret_cast<U8_T *>(out);
+                const __m256 max = _mm256_set1_ps(static_cast<float>(U8Range.getMax()));
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16)
+                {
+                    const __m128i * inV = reinterpret_cast<const __m128i *>(inP + i);
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i *>(outP + i),
+                        _mm_packus_epi16(
+                            scaleClampPack(_mm256_cvtph_ps(_mm_loadu_si128(inV)), max),
+                            scaleClampPack(_mm256_cvtph_ps(_mm_loadu_si128(inV + 1)), max)));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_F16_U8(inP[i], outP[i]);
+                }
+            }
+
+            DJV_TARGET_AVX2 void convert_F16_U16_AVX2(const void * in, void * out, size_t size)
+            {
+                const F16_T * inP = reinterpret_cast<const F16_T *>(in);
+                U16_T * outP = reinterpret_cast<U16_T *>(out);
+                const __m256 max = _mm256_set1_ps(static_cast<float>(U16Range.getMax()));
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i *>(outP + i),
+                        scaleClampPack(_mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i))), max));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_F16_U16(inP[i], outP[i]);
+                }
+            }
+
+            DJV_TARGET_AVX2 void convert_F16_F32_AVX2(const void * in, void * out, size_t size)
+            {
+                const F16_T * inP = reinterpret_cast<const F16_T *>(in);
+                F32_T * outP = reinterpret_cast<F32_T *>(out);
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    _mm256_storeu_ps(outP + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(inP + i))));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_F16_F32(inP[i], outP[i]);
+                }
+            }
+
+            DJV_TARGET_AVX2 void convert_F32_F16_AVX2(const void * in, void * out, size_t size)
+            {
+                const F32_T * inP = reinterpret_cast<const F32_T *>(in);
+                F16_T * outP = reinterpret_cast<F16_T *>(out);
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i *>(outP + i),
+                        _mm256_cvtps_ph(_mm256_loadu_ps(inP + i), _MM_FROUND_TO_NEAREST_INT));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_F32_F16(inP[i], outP[i]);
+                }
+            }
+
+#if !defined(DJV_ENDIAN_MSB)
+            // Convert 10-bit values in 32-bit lanes to half floats in the
+            // low half of the lanes.
+            DJV_TARGET_AVX2 inline __m128i convertU10F16(__m128i value, __m128 max)
+            {
+                return _mm_cvtepu16_epi32(_mm_cvtps_ph(_mm_div_ps(_mm_cvtepi32_ps(value), max), _MM_FROUND_TO_NEAREST_INT));
+            }
+
+            DJV_TARGET_AVX2 void convert_RGB_U10_RGB_F16_AVX2(const void * in, void * out, size_t size)
+            {
+                const U10_S * inP = reinterpret_cast<const U10_S *>(in);
+                F16_T * outP = reinterpret_cast<F16_T *>(out);
+                const __m128 max = _mm_set1_ps(static_cast<float>(U10Range.getMax()));
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    __m128i r;
+                    __m128i g;
+                    __m128i b;
+                    unpackU10(inP + i, r, g, b);
+                    storeRGB16(outP + i * 3, convertU10F16(r, max), convertU10F16(g, max), convertU10F16(b, max));
+                }
+                for (; i < size; ++i)
+                {
+                    convert_U10_F16(inP[i].r, outP[i * 3]);
+                    convert_U10_F16(inP[i].g, outP[i * 3 + 1]);
+                    convert_U10_F16(inP[i].b, outP[i * 3 + 2]);
+                }
+            }
+
+            DJV_TARGET_AVX2 void convert_RGB_U10_RGBA_F16_AVX2(const void * in, void * out, size_t size)
+            {
+                const U10_S * inP = reinterpret_cast<const U10_S *>(in);
+                F16_T * outP = reinterpret_cast<F16_T *>(out);
+                const __m128 max = _mm_set1_ps(static_cast<float>(U10Range.getMax()));
+                const __m128i a = _mm_set1_epi32(F16Range.getMax().bits());
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    __m128i r;
+                    __m128i g;
+                    __m128i b;
+                    unpackU10(inP + i, r, g, b);
+                    storeRGBA16(outP + i * 4, convertU10F16(r, max), convertU10F16(g, max), convertU10F16(b, max), a);
+                }
+                for (; i < size; ++i)
+                {
+                    convert_U10_F16(inP[i].r, outP[i * 4]);
+                    convert_U10_F16(inP[i].g, outP[i * 4 + 1]);
+                    convert_U10_F16(inP[i].b, outP[i * 4 + 2]);
+                    outP[i * 4 + 3] = F16Range.getMax();
+                }
+            }
+#endif // DJV_ENDIAN_MSB
+
+            ///@}
+
+#endif // DJV_IMAGE_CONVERT_X86
+
+        } // namespace
+
+// Set the entries for a channel conversion for all of the layouts.
+#define CONVERT_TABLE_CHANNELS(A, B, FUNCTION) \
+    table[index(Type::L_##A)][index(Type::L_##B)]       = convertChannels<1, FUNCTION>; \
+    table[index(Type::LA_##A)][index(Type::LA_##B)]     = convertChannels<2, FUNCTION>; \
+    table[index(Type::RGB_##A)][index(Type::RGB_##B)]   = convertChannels<3, FUNCTION>; \
+    table[index(Type::RGBA_##A)][index(Type::RGBA_##B)] = convertChannels<4, FUNCTION>
+
+        ConvertISA getCPUConvertISA() noexcept
+        {
+            ConvertISA out = ConvertISA::Scalar;
+#if defined(DJV_IMAGE_CONVERT_X86)
+            unsigned int regs[4] = { 0, 0, 0, 0 };
+            cpuid(0, regs);
+            const unsigned int maxLeaf = regs[0];
+            if (maxLeaf >= 1)
+            {
+                cpuid(1, regs);
+                const bool sse41   = regs[2] & (1U << 19);
+                const bool osxsave = regs[2] & (1U << 27);
+                const bool avx     = regs[2] & (1U << 28);
+                const bool f16c    = regs[2] & (1U << 29);
+                if (sse41)
+                {
+                    out = ConvertISA::SSE41;
+                }
+                // Check that the OS saves the AVX registers.
+                if (sse41 && osxsave && avx && f16c && maxLeaf >= 7 && (xgetbv() & 0x6) == 0x6)
+                {
+                    cpuid(7, regs);
+                    if (regs[1] & (1U << 5))
+                    {
+                        out = ConvertISA::AVX2;
+                    }
+                }
+            }
+#endif // DJV_IMAGE_CONVERT_X86
+            return out;
+        }
+
+        void initConvertTable(ConvertISA isa, ConvertTable& table)
+        {
+#if defined(DJV_IMAGE_CONVERT_X86)
+            if (isa >= ConvertISA::SSE41)
+            {
+                CONVERT_TABLE_CHANNELS(U8, F32, convert_U8_F32_SSE41);
+                CONVERT_TABLE_CHANNELS(U16, F32, convert_U16_F32_SSE41);
+                CONVERT_TABLE_CHANNELS(F32, U8, convert_F32_U8_SSE41);
+                CONVERT_TABLE_CHANNELS(F32, U16, convert_F32_U16_SSE41);
+
+#if !defined(DJV_ENDIAN_MSB)
+                table[index(Type::RGB_U10)][index(Type::RGB_U16)]  = convert_RGB_U10_RGB_U16_SSE41;
+                table[index(Type::RGB_U10)][index(Type::RGBA_U16)] = convert_RGB_U10_RGBA_U16_SSE41;
+#endif // DJV_ENDIAN_MSB
+
+                table[index(Type::RGB_U8)][index(Type::RGBA_U8)]   = convert_RGB_8_RGBA_8_SSE41;
+                table[index(Type::RGBA_U8)][index(Type::RGB_U8)]   = convert_RGBA_8_RGB_8_SSE41;
+                table[index(Type::RGB_U16)][index(Type::RGBA_U16)] = convert_RGB_16_RGBA_16_SSE41<0xffff>;
+                table[index(Type::RGBA_U16)][index(Type::RGB_U16)] = convert_RGBA_16_RGB_16_SSE41;
+                table[index(Type::RGB_F16)][index(Type::RGBA_F16)] = convert_RGB_16_RGBA_16_SSE41<0x3c00>;
+                table[index(Type::RGBA_F16)][index(Type::RGB_F16)] = convert_RGBA_16_RGB_16_SSE41;
+                table[index(Type::RGB_U32)][index(Type::RGBA_U32)] = convert_RGB_32_RGBA_32_SSE41<0xffffffff>;
+                table[index(Type::RGBA_U32)][index(Type::RGB_U32)] = convert_RGBA_32_RGB_32_SSE41;
+                table[index(Type::RGB_F32)][index(Type::RGBA_F32)] = convert_RGB_32_RGBA_32_SSE41<0x3f800000>;
+                table[index(Type::RGBA_F32)][index(Type::RGB_F32)] = convert_RGBA_32_RGB_32_SSE41;
+            }
+            if (isa >= ConvertISA::AVX2)
+            {
+                CONVERT_TABLE_CHANNELS(U8, F32, convert_U8_F32_AVX2);
+                CONVERT_TABLE_CHANNELS(U16, F32, convert_U16_F32_AVX2);
+                CONVERT_TABLE_CHANNELS(F32, U8, convert_F32_U8_AVX2);
+                CONVERT_TABLE_CHANNELS(F32, U16, convert_F32_U16_AVX2);
+                CONVERT_TABLE_CHANNELS(U8, F16, convert_U8_F16_AVX2);
+                CONVERT_TABLE_CHANNELS(U16, F16, convert_U16_F16_AVX2);
+                CONVERT_TABLE_CHANNELS(F16, U8, convert_F16_U8_AVX2);
+                CONVERT_TABLE_CHANNELS(F16, U16, convert_F16_U16_AVX2);
+                CONVERT_TABLE_CHANNELS(F16, F32, convert_F16_F32_AVX2);
+                CONVERT_TABLE_CHANNELS(F32, F16, convert_F32_F16_AVX2);
+
+#if !defined(DJV_ENDIAN_MSB)
+                table[index(Type::RGB_U10)][index(Type::RGB_F16)]  = convert_RGB_U10_RGB_F16_AVX2;
+                table[index(Type::RGB_U10)][index(Type::RGBA_F16)] = convert_RGB_U10_RGBA_F16_AVX2;
+#endif // DJV_ENDIAN_MSB
+            }
+#else // DJV_IMAGE_CONVERT_X86
+            (void)isa;
+            (void)table;
+#endif // DJV_IMAGE_CONVERT_X86
+        }
+
+    } // namespace Image
+} // namespace djv
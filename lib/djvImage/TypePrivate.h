@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvImage/Type.h>
+
+#include <array>
+
+namespace djv
+{
+    namespace Image
+    {
+        //! Conversion function, the size is the number of pixels.
+        typedef void (*ConvertFunction)(const void *, void *, size_t);
+
+        //! Conversion functions indexed by the input and output types.
+        typedef std::array<
+            std::array<ConvertFunction, static_cast<size_t>(Type::Count)>,
+            static_cast<size_t>(Type::Count)> ConvertTable;
+
+        //! Get the best instruction set supported by the CPU.
+        ConvertISA getCPUConvertISA() noexcept;
+
+        //! Replace the entries in the table that have vectorized versions
+        //! for the given instruction set. Entries without a vectorized
+        //! version are left unchanged.
+        void initConvertTable(ConvertISA, ConvertTable&);
+
+    } // namespace Image
+} // namespace djv
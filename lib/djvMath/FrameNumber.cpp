@@ -16,29 +16,40 @@ namespace djv
     {
         namespace Frame
         {
+            namespace
+            {
+                inline Index getSize(const Range& value) noexcept
+                {
+                    return value.getMax() - value.getMin() + 1;
+                }
+
+            } // namespace
+
             Sequence::Sequence()
             {}
        
             Sequence::Sequence(Number number)
             {
-                _ranges.push_back(Range(number));
+                add(Range(number));
             }
        
             Sequence::Sequence(Number min, Number max, size_t pad) :
                 _pad(pad)
             {
-                _ranges.push_back(Range(min, max));
+                add(Range(min, max));
             }
 
             Sequence::Sequence(const Range& range, size_t pad) :
                 _pad(pad)
             {
-                _ranges.push_back(range);
+                add(range);
             }
 
             Sequence::Sequence(const std::vector<Range>& ranges, size_t pad) :
                 _pad(pad)
             {
+                _ranges.reserve(ranges.size());
+                _indices.reserve(ranges.size());
                 for (const auto& i : ranges)
                 {
                     add(i);
@@ -47,72 +58,66 @@ namespace djv
             
             void Sequence::add(const Range& value)
             {
-                Range newRange(value);
-                auto i = _ranges.begin();
-                while (i != _ranges.end())
+                // Ranges added in order can be appended, or merged with the
+                // last range.
+                if (_ranges.empty() || value.getMin() > _ranges.back().getMax() + 1)
                 {
-                    if (newRange.intersects(*i))
-                    {
-                        newRange.expand(*i);
-                        i = _ranges.erase(i);
-                    }
-                    else if (newRange.getMin() == i->getMax() + 1)
-                    {
-                        newRange = Range(i->getMin(), newRange.getMax());
-                        i = _ranges.erase(i);
-                    }
-                    else if (newRange.getMax() == i->getMin() - 1)
+                    _indices.push_back(_ranges.empty() ? 0 : (_indices.back() + getSize(_ranges.back())));
+                    _ranges.push_back(value);
+                    return;
+                }
+                Range& last = _ranges.back();
+                if (value.getMin() >= last.getMin())
+                {
+                    last = Range(last.getMin(), std::max(last.getMax(), value.getMax()));
+                    return;
+                }
+
+                // Find the ranges that intersect or touch the new range and
+                // replace them with a single range.
+                auto first = std::lower_bound(
+                    _ranges.begin(), _ranges.end(), value.getMin(),
+                    [](const Range& a, Number b)
                     {
-                        newRange = Range(newRange.getMin(), i->getMax());
-                        i = _ranges.erase(i);
-                    }
-                    else
+                        return a.getMax() + 1 < b;
+                    });
+                const auto end = std::upper_bound(
+                    first, _ranges.end(), value.getMax(),
+                    [](Number a, const Range& b)
                     {
-                        ++i;
-                    }
+                        return a + 1 < b.getMin();
+                    });
+                Range newRange(value);
+                if (first != end)
+                {
+                    newRange = Range(
+                        std::min(value.getMin(), first->getMin()),
+                        std::max(value.getMax(), (end - 1)->getMax()));
                 }
-                i = _ranges.begin();
-                for (; i != _ranges.end() && *i < newRange; ++i)
-                    ;
-                _ranges.insert(i, newRange);
+                const size_t index = first - _ranges.begin();
+                first = _ranges.erase(first, end);
+                _ranges.insert(first, newRange);
+                _indices.resize(_ranges.size());
+                _indicesUpdate(index);
             }
 
             bool Sequence::contains(Index value) const noexcept
             {
-                bool out = false;
-                for (const auto& i : _ranges)
-                {
-                    if (i.contains(value))
-                    {
-                        out = true;
-                        break;
-                    }
-                }
-                return out;
+                return _findRange(value) < _ranges.size();
             }
 
             size_t Sequence::getFrameCount() const noexcept
             {
-                size_t out = 0;
-                for (const auto& i : _ranges)
-                {
-                    out += i.getMax() - i.getMin() + 1;
-                }
-                return out;
+                return !_ranges.empty() ? static_cast<size_t>(_indices.back() + getSize(_ranges.back())) : 0;
             }
 
             Number Sequence::getFrame(Index value) const noexcept
             {
                 Number out = invalid;
-                for (const auto& j : _ranges)
+                if (value >= 0 && value < static_cast<Index>(getFrameCount()))
                 {
-                    const size_t size = j.getMax() - j.getMin() + 1;
-                    if (value < size)
-                    {
-                        out = j.getMin() + value;
-                        break;
-                    }
-                    value -= size;
+                    const size_t i = std::upper_bound(_indices.begin(), _indices.end(), value) - _indices.begin() - 1;
+                    out = _ranges[i].getMin() + value - _indices[i];
                 }
                 return out;
             }
@@ -120,32 +125,48 @@ namespace djv
             Index Sequence::getIndex(Number value) const noexcept
             {
                 Index out = invalidIndex;
-                Index tmp = 0;
-                for (const auto& j : _ranges)
+                const size_t i = _findRange(value);
+                if (i < _ranges.size())
                 {
-                    if (j.contains(value))
-                    {
-                        out = tmp + value - j.getMin();
-                        break;
-                    }
-                    tmp += j.getMax() - j.getMin() + 1;
+                    out = _indices[i] + value - _ranges[i].getMin();
                 }
                 return out;
             }
 
             Index Sequence::getLastIndex() const noexcept
             {
-                Index tmp = 0;
-                for (const auto& i : _ranges)
+                return !_ranges.empty() ? (static_cast<Index>(getFrameCount()) - 1) : invalidIndex;
+            }
+
+            size_t Sequence::_findRange(Number value) const noexcept
+            {
+                size_t out = _ranges.size();
+                const auto i = std::upper_bound(
+                    _ranges.begin(), _ranges.end(), value,
+                    [](Number a, const Range& b)
+                    {
+                        return a < b.getMin();
+                    });
+                if (i != _ranges.begin() && value <= (i - 1)->getMax())
                 {
-                    tmp += i.getMax() - i.getMin() + 1;
+                    out = i - 1 - _ranges.begin();
+                }
+                return out;
+            }
+
+            void Sequence::_indicesUpdate(size_t index)
+            {
+                const size_t size = _ranges.size();
+                for (size_t i = index; i < size; ++i)
+                {
+                    _indices[i] = i > 0 ? (_indices[i - 1] + getSize(_ranges[i - 1])) : 0;
                 }
-                return _ranges.size() ? (tmp - 1) : invalidIndex;
             }
 
             std::vector<Number> toFrames(const Range& value)
             {
                 std::vector<Number> out;
+                out.reserve(getSize(value));
                 for (auto i = value.getMin(); i <= value.getMax(); ++i)
                 {
                     out.push_back(i);
@@ -156,9 +177,10 @@ namespace djv
             std::vector<Number> toFrames(const Sequence& value)
             {
                 std::vector<Number> out;
+                out.reserve(value.getFrameCount());
                 for (const auto& range : value.getRanges())
                 {
-                    for (const auto& i : toFrames(range))
+                    for (auto i = range.getMin(); i <= range.getMax(); ++i)
                     {
                         out.push_back(i);
                     }
@@ -166,31 +188,36 @@ namespace djv
                 return out;
             }
             
-            Sequence fromFrames(const std::vector<Number> & frames)
+            Sequence fromFrames(const std::vector<Number>& value)
             {
+                // Sort the frames if needed so the ranges can be built in a
+                // single pass.
+                std::vector<Number> sorted;
+                const std::vector<Number>* frames = &value;
+                if (!std::is_sorted(value.begin(), value.end()))
+                {
+                    sorted = value;
+                    std::sort(sorted.begin(), sorted.end());
+                    frames = &sorted;
+                }
+
                 Sequence out;
-                const size_t size = frames.size();
+                const size_t size = frames->size();
                 if (size)
                 {
-                    Frame::Number rangeStart = frames[0];
-                    Frame::Number prevFrame = frames[0];
-                    size_t i = 1;
-                    for (; i < size; prevFrame = frames[i], ++i)
+                    Number rangeStart = (*frames)[0];
+                    Number prevFrame = (*frames)[0];
+                    for (size_t i = 1; i < size; ++i)
                     {
-                        if (frames[i] != prevFrame + 1)
+                        const Number frame = (*frames)[i];
+                        if (frame > prevFrame + 1)
                         {
                             out.add(Range(rangeStart, prevFrame));
-                            rangeStart = frames[i];
+                            rangeStart = frame;
                         }
+                        prevFrame = frame;
                     }
-                    if (size > 1)
-                    {
-                        out.add(Range(rangeStart, prevFrame));
-                    }
-                    else
-                    {
-                        out.add(Range(rangeStart));
-                    }
+                    out.add(Range(rangeStart, prevFrame));
                 }
                 return out;
             }
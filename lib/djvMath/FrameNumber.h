@@ -35,6 +35,9 @@ namespace djv
             //! Sequence of frame numbers.
             //!
             //! A sequence is composed of multiple frame number ranges (e.g., 1-10,20-30).
+            //! The ranges are kept sorted along with the index of the first frame
+            //! in each range, so converting between frame numbers and indices is
+            //! a binary search.
             class Sequence
             {
             public:
@@ -49,6 +52,7 @@ namespace djv
 
                 const std::vector<Range>& getRanges() const noexcept;
                 
+                //! Add a range. Ranges added in order take constant time.
                 void add(const Range&);
 
                 bool isValid() const noexcept;
@@ -81,7 +85,11 @@ namespace djv
                 bool operator != (const Sequence&) const;
 
             private:
+                size_t _findRange(Number) const noexcept;
+                void _indicesUpdate(size_t);
+
                 std::vector<Range>  _ranges;
+                std::vector<Index>  _indices;
                 size_t              _pad    = 0;
             };
 
@@ -98,6 +106,8 @@ namespace djv
             std::vector<Number> toFrames(const Range&);
             std::vector<Number> toFrames(const Sequence&);
 
+            //! Create a sequence from a list of frames. The frames do not
+            //! need to be sorted.
             Sequence fromFrames(const std::vector<Number>&);
 
             std::string toString(Number, size_t pad = 0);
@@ -54,6 +54,7 @@ namespace djv
                 FaceID   getFace() const noexcept;
                 uint16_t getSize() const noexcept;
                 uint16_t getDPI() const noexcept;
+                size_t   getHash() const noexcept;
 
                 bool operator == (const FontInfo&) const noexcept;
                 bool operator < (const FontInfo&) const noexcept;
@@ -228,4 +229,20 @@ namespace djv
     } // namespace Render2D
 } // namespace djv
 
+namespace std
+{
+    template<>
+    struct hash<djv::Render2D::Font::FontInfo>
+    {
+        std::size_t operator() (const djv::Render2D::Font::FontInfo&) const noexcept;
+    };
+
+    template<>
+    struct hash<djv::Render2D::Font::GlyphInfo>
+    {
+        std::size_t operator() (const djv::Render2D::Font::GlyphInfo&) const noexcept;
+    };
+
+} // namespace std
+
 #include <djvRender2D/FontSystemInline.h>
@@ -210,6 +210,10 @@ namespace djv
 #if !defined(DJV_GL_ES2)
                 p.primitiveData.colorSpaceLoc = glGetUniformLocation(program, "colorSpace");
                 p.primitiveData.colorSpaceSamplerLoc = glGetUniformLocation(program, "colorSpaceSampler");
+                p.primitiveData.yuvLoc = glGetUniformLocation(program, "yuv");
+                p.primitiveData.yuvMatrixLoc = glGetUniformLocation(program, "yuvMatrix");
+                p.primitiveData.textureSamplerCbLoc = glGetUniformLocation(program, "textureSamplerCb");
+                p.primitiveData.textureSamplerCrLoc = glGetUniformLocation(program, "textureSamplerCr");
 #endif // DJV_GL_ES2
                 p.primitiveData.imageChannelsDisplayLoc = glGetUniformLocation(program, "imageChannelsDisplay");
                 p.primitiveData.colorMatrixLoc = glGetUniformLocation(program, "colorMatrix");
@@ -1157,11 +1161,13 @@ namespace djv
                         powf(2.F, 3.5F) - primitive->exposureK);
                 }
                 primitive->softClip = options.softClipEnabled ? options.softClip : 0.F;
-                primitive->imageCache = options.cache;
+                // YUV images are not added to the texture atlas, the planes
+                // are converted by the shader.
+                primitive->imageCache = Image::isYUVType(info.type) ? ImageCache::Dynamic : options.cache;
                 float textureU[2] = { 0.F, 0.F };
                 float textureV[2] = { 0.F, 0.F };
                 const UID uid = image->getUID();
-                switch (options.cache)
+                switch (primitive->imageCache)
                 {
                 case ImageCache::Atlas:
                 {
@@ -1201,14 +1207,14 @@ namespace djv
                 }
                 case ImageCache::Dynamic:
                 {
+                    std::shared_ptr<GL::Texture2D> texture;
                     const auto i = dynamicTextureCache.find(uid);
                     if (i != dynamicTextureCache.end())
                     {
-                        primitive->textureID = i->second->getID();
+                        texture = i->second;
                     }
                     else
                     {
-                        std::shared_ptr<GL::Texture2D> texture;
                         if (dynamicTextures.size())
                         {
                             texture = dynamicTextures.back();
@@ -1221,8 +1227,17 @@ namespace djv
                         }
                         texture->copy(*image);
                         dynamicTextureCache[uid] = texture;
-                        primitive->textureID = texture->getID();
                     }
+                    primitive->textureID = texture->getID();
+#if !defined(DJV_GL_ES2)
+                    if (texture->getPlaneCount() > 1)
+                    {
+                        primitive->yuv = true;
+                        primitive->yuvMatrix = GL::getYUVMatrix(info);
+                        primitive->yuvTextureIDs[0] = texture->getPlaneID(1);
+                        primitive->yuvTextureIDs[1] = texture->getPlaneID(2);
+                    }
+#endif // DJV_GL_ES2
                     if (info.layout.mirror.x)
                     {
                         textureU[0] = 1.F;
@@ -80,6 +80,20 @@ namespace djv
                 break;
             default: break;
             }
+#if !defined(DJV_GL_ES2)
+            shader->setUniform(data.yuvLoc, yuv);
+            if (yuv)
+            {
+                shader->setUniform(data.yuvMatrixLoc, yuvMatrix);
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    const int unit = static_cast<int>(data.textureAtlasCount + 2 + i);
+                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + unit));
+                    glBindTexture(GL_TEXTURE_2D, yuvTextureIDs[i]);
+                    shader->setUniform(0 == i ? data.textureSamplerCbLoc : data.textureSamplerCrLoc, unit);
+                }
+            }
+#endif // DJV_GL_ES2
         }
 
         void ShadowPrimitive::bind(const PrimitiveData& data, const std::shared_ptr<GL::Shader>& shader)
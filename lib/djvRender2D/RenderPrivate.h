@@ -44,7 +44,9 @@ namespace djv
         //! Primitive render data.
         struct PrimitiveData
         {
-            // Used as an offset to find textures.
+            // Used as an offset to find textures. The texture units after the
+            // texture atlas are used for dynamic textures, color space
+            // lookup tables, and the YUV chroma planes.
             uint8_t textureAtlasCount       = 0;
 
             // Shader uniform variable locations.
@@ -54,6 +56,10 @@ namespace djv
 #if !defined(DJV_GL_ES2)
             GLint colorSpaceLoc             = 0;
             GLint colorSpaceSamplerLoc      = 0;
+            GLint yuvLoc                    = 0;
+            GLint yuvMatrixLoc              = 0;
+            GLint textureSamplerCbLoc       = 0;
+            GLint textureSamplerCrLoc       = 0;
 #endif // DJV_GL_ES2
             GLint colorMatrixLoc            = 0;
             GLint colorMatrixEnabledLoc     = 0;
@@ -109,6 +115,9 @@ namespace djv
 #if !defined(DJV_GL_ES2)
             uint8_t              colorSpace           = 0;
             GLuint               colorSpaceTextureID  = 0;
+            bool                 yuv                  = false;
+            glm::mat4x4          yuvMatrix;
+            GLuint               yuvTextureIDs[2]     = { 0, 0 };
 #endif // DJV_GL_ES2
             glm::mat4x4          colorMatrix;
             bool                 colorMatrixEnabled   = false;
@@ -8,18 +8,31 @@
 #include <djvSystem/Context.h>
 #include <djvSystem/Timer.h>
 
+#include <djvCore/ThreadPool.h>
+
+#include <sstream>
+
 namespace djv
 {
     namespace System
     {
         struct CoreSystem::Private
         {
+            std::shared_ptr<Core::Thread::ThreadPool> threadPool;
         };
 
         void CoreSystem::_init(const std::string&, const std::shared_ptr<Context>& context)
         {
             ISystem::_init("djv::System::CoreSystem", context);
 
+            DJV_PRIVATE_PTR();
+            p.threadPool = Core::Thread::ThreadPool::create();
+            {
+                std::stringstream ss;
+                ss << "Thread pool size: " << p.threadPool->getThreadCount();
+                _log(ss.str());
+            }
+
             auto animationSystem = Animation::AnimationSystem::create(context);
             addDependency(animationSystem);
 
@@ -44,6 +57,11 @@ namespace djv
             return out;
         }
 
+        const std::shared_ptr<Core::Thread::ThreadPool>& CoreSystem::getThreadPool() const
+        {
+            return _p->threadPool;
+        }
+
     } // namespace System
 } // namespace djv
 
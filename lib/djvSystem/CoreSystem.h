@@ -8,6 +8,15 @@
 
 namespace djv
 {
+    namespace Core
+    {
+        namespace Thread
+        {
+            class ThreadPool;
+
+        } // namespace Thread
+    } // namespace Core
+
     namespace System
     {
         //! Core systems.
@@ -24,6 +33,15 @@ namespace djv
 
             static std::shared_ptr<CoreSystem> create(const std::string& argv0, const std::shared_ptr<Context>&);
 
+            //! \name Threads
+            ///@{
+
+            //! Get the thread pool that is shared by the systems in the
+            //! context. Each client should use its own work queue.
+            const std::shared_ptr<Core::Thread::ThreadPool>& getThreadPool() const;
+
+            ///@}
+
         private:
             DJV_PRIVATE();
         };
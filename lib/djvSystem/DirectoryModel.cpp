@@ -4,12 +4,21 @@
 
 #include <djvSystem/DirectoryModel.h>
 
+#include <djvSystem/Context.h>
+#include <djvSystem/CoreSystem.h>
 #include <djvSystem/DirectoryWatcher.h>
+#include <djvSystem/FileInfoPrivate.h>
 #include <djvSystem/Timer.h>
 
 #include <djvCore/OS.h>
+#include <djvCore/ThreadPool.h>
 
+#include <algorithm>
+#include <atomic>
 #include <future>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 
 using namespace djv::Core;
 
@@ -19,11 +28,261 @@ namespace djv
     {
         namespace File
         {
+            namespace
+            {
+                //! The number of items to get information from the file system
+                //! for before the results are updated.
+                const size_t statChunkSize = 1000;
+
+                //! The results of a directory listing, shared with the listing
+                //! thread.
+                struct Listing
+                {
+                    std::mutex mutex;
+                    std::vector<Info> info;
+                    std::vector<std::string> fileNames;
+                    std::vector<DirectoryChange> changes;
+                    bool changed = false;
+                    bool finished = false;
+                    std::atomic<bool> cancel;
+                };
+
+                std::vector<std::string> getFileNames(const std::vector<Info>& value)
+                {
+                    std::vector<std::string> out;
+                    out.reserve(value.size());
+                    for (const auto& info : value)
+                    {
+                        out.push_back(info.getFileName(Math::Frame::invalid, false));
+                    }
+                    return out;
+                }
+
+                //! The frames of sequences that have been seen through directory
+                //! changes, used to subtract their size when they are removed.
+                typedef std::unordered_map<std::string, Info> FrameCache;
+
+                //! Apply directory changes to a directory listing.
+                void applyChanges(
+                    const Path& path,
+                    const DirectoryListOptions& options,
+                    const std::set<std::string>& fileNames,
+                    std::vector<Info>& info,
+                    FrameCache& frameCache,
+                    std::vector<DirectoryChange>& changes)
+                {
+                    // Index the items by file name, and the sequences (and the
+                    // files that can become sequences) by sequence key.
+                    std::unordered_map<std::string, size_t> fileIndex;
+                    std::unordered_map<std::string, size_t> sequenceIndex;
+                    Math::Frame::Number frame = Math::Frame::invalid;
+                    size_t pad = 0;
+                    for (size_t i = 0; i < info.size(); ++i)
+                    {
+                        const Path& itemPath = info[i].getPath();
+                        if (Type::Sequence == info[i].getType())
+                        {
+                            sequenceIndex[getSequenceKey(itemPath)] = i;
+                        }
+                        else
+                        {
+                            fileIndex[itemPath.getFileName()] = i;
+                            if (Type::File == info[i].getType() && getSequenceFrame(itemPath, options, frame, pad))
+                            {
+                                sequenceIndex[getSequenceKey(itemPath)] = i;
+                            }
+                        }
+                    }
+
+                    std::set<size_t> added;
+                    std::set<size_t> removed;
+                    std::set<size_t> modified;
+                    std::set<size_t> restat;
+                    std::unordered_map<size_t, std::string> originalNames;
+                    auto addItem = [&info, &fileIndex, &added](const Info& value)
+                    {
+                        const size_t index = info.size();
+                        info.push_back(value);
+                        fileIndex[value.getPath().getFileName()] = index;
+                        added.insert(index);
+                        return index;
+                    };
+                    for (const auto& fileName : fileNames)
+                    {
+                        if (isFileNameFiltered(fileName, options))
+                            continue;
+
+                        // Get the current state of the item from the file system,
+                        // the change type may be stale by now.
+                        const Info fileInfo(Path(path, fileName));
+                        const bool exists = fileInfo.doesExist();
+                        if (exists && fileInfo.getType() != Type::Directory && !isExtensionMatch(fileInfo.getPath(), options))
+                            continue;
+
+                        if (fileInfo.getType() != Type::Directory &&
+                            getSequenceFrame(fileInfo.getPath(), options, frame, pad))
+                        {
+                            const std::string key = getSequenceKey(fileInfo.getPath());
+                            const auto i = sequenceIndex.find(key);
+                            if (i != sequenceIndex.end() && !removed.count(i->second))
+                            {
+                                Info& item = info[i->second];
+                                originalNames.emplace(i->second, item.getFileName(Math::Frame::invalid, false));
+                                if (Type::Sequence == item.getType())
+                                {
+                                    if (item.getSequence().contains(frame))
+                                    {
+                                        const auto j = frameCache.find(fileName);
+                                        if (j != frameCache.end())
+                                        {
+                                            item.removeFromSequence(j->second);
+                                        }
+                                        else
+                                        {
+                                            // The size of the frame is not known,
+                                            // get it again for the whole sequence.
+                                            item.removeFromSequence(Info(fileInfo.getPath(), false));
+                                            restat.insert(i->second);
+                                        }
+                                    }
+                                    if (exists)
+                                    {
+                                        item.addToSequence(fileInfo);
+                                        frameCache[fileName] = fileInfo;
+                                    }
+                                    else
+                                    {
+                                        frameCache.erase(fileName);
+                                    }
+                                    modified.insert(i->second);
+                                }
+                                else if (item.getPath().getFileName() == fileName)
+                                {
+                                    if (exists)
+                                    {
+                                        item = fileInfo;
+                                        modified.insert(i->second);
+                                    }
+                                    else
+                                    {
+                                        removed.insert(i->second);
+                                    }
+                                }
+                                else if (exists)
+                                {
+                                    // A single file becomes a sequence.
+                                    frameCache[item.getPath().getFileName()] = item;
+                                    frameCache[fileName] = fileInfo;
+                                    item.addToSequence(fileInfo);
+                                    modified.insert(i->second);
+                                }
+                            }
+                            else if (exists)
+                            {
+                                sequenceIndex[key] = addItem(fileInfo);
+                            }
+                            continue;
+                        }
+
+                        const auto i = fileIndex.find(fileName);
+                        if (i != fileIndex.end() && !removed.count(i->second))
+                        {
+                            originalNames.emplace(i->second, fileName);
+                            if (exists)
+                            {
+                                info[i->second] = fileInfo;
+                                modified.insert(i->second);
+                            }
+                            else
+                            {
+                                removed.insert(i->second);
+                            }
+                        }
+                        else if (exists)
+                        {
+                            addItem(fileInfo);
+                        }
+                    }
+
+                    // Sequences with a single frame left become files again.
+                    for (const auto i : modified)
+                    {
+                        Info& item = info[i];
+                        if (Type::Sequence == item.getType())
+                        {
+                            const auto& sequence = item.getSequence();
+                            const size_t frameCount = sequence.getFrameCount();
+                            if (0 == frameCount)
+                            {
+                                removed.insert(i);
+                            }
+                            else if (1 == frameCount)
+                            {
+                                const std::string fileName = item.getFileName(sequence.getFrame(0), false);
+                                const auto j = frameCache.find(fileName);
+                                item = j != frameCache.end() ? j->second : Info(Path(path, fileName));
+                            }
+                            else if (restat.count(i) && options.stat)
+                            {
+                                item.stat();
+                            }
+                        }
+                    }
+
+                    for (const auto i : added)
+                    {
+                        if (!removed.count(i))
+                        {
+                            DirectoryChange change;
+                            change.type = DirectoryChangeType::Added;
+                            change.fileName = info[i].getFileName(Math::Frame::invalid, false);
+                            changes.push_back(change);
+                        }
+                    }
+                    for (const auto i : modified)
+                    {
+                        if (!added.count(i) && !removed.count(i))
+                        {
+                            DirectoryChange change;
+                            change.type = DirectoryChangeType::Modified;
+                            change.fileName = info[i].getFileName(Math::Frame::invalid, false);
+                            changes.push_back(change);
+                        }
+                    }
+                    for (const auto i : removed)
+                    {
+                        if (!added.count(i))
+                        {
+                            DirectoryChange change;
+                            change.type = DirectoryChangeType::Removed;
+                            change.fileName = originalNames[i];
+                            changes.push_back(change);
+                        }
+                    }
+                    if (!removed.empty())
+                    {
+                        std::vector<Info> tmp;
+                        tmp.reserve(info.size() - removed.size());
+                        for (size_t i = 0; i < info.size(); ++i)
+                        {
+                            if (!removed.count(i))
+                            {
+                                tmp.push_back(std::move(info[i]));
+                            }
+                        }
+                        info = std::move(tmp);
+                    }
+                    sort(options, info);
+                }
+
+            } // namespace
+
             struct DirectoryModel::Private
             {
                 std::shared_ptr<Observer::ValueSubject<Path> > path;
                 std::shared_ptr<Observer::ListSubject<Info> > info;
                 std::shared_ptr<Observer::ListSubject<std::string> > fileNames;
+                std::shared_ptr<Observer::ListSubject<DirectoryChange> > changes;
                 std::shared_ptr<Observer::ListSubject<Path> > history;
                 std::shared_ptr<Observer::ValueSubject<size_t> > historyIndex;
                 size_t historyMax = 10;
@@ -31,9 +290,14 @@ namespace djv
                 std::shared_ptr<Observer::ValueSubject<bool> > hasBack;
                 std::shared_ptr<Observer::ValueSubject<bool> > hasForward;
                 std::shared_ptr<Observer::ValueSubject<DirectoryListOptions> > options;
-                std::future<std::pair<std::vector<Info>, std::vector<std::string> > > future;
+                std::shared_ptr<Core::Thread::ThreadPool> threadPool;
+                std::shared_ptr<Listing> listing;
+                std::future<void> future;
                 std::shared_ptr<Timer> futureTimer;
                 std::shared_ptr<DirectoryWatcher> directoryWatcher;
+                std::vector<DirectoryChange> pendingChanges;
+                std::shared_ptr<Timer> changesTimer;
+                std::shared_ptr<FrameCache> frameCache;
             };
 
             void DirectoryModel::_init(const std::shared_ptr<Context>& context)
@@ -42,6 +306,7 @@ namespace djv
                 p.path = Observer::ValueSubject<Path>::create();
                 p.info = Observer::ListSubject<Info>::create();
                 p.fileNames = Observer::ListSubject<std::string>::create();
+                p.changes = Observer::ListSubject<DirectoryChange>::create();
                 p.history = Observer::ListSubject<Path>::create();
                 p.historyIndex = Observer::ValueSubject<size_t>::create(0);
                 p.hasUp = Observer::ValueSubject<bool>::create(false);
@@ -49,9 +314,15 @@ namespace djv
                 p.hasForward = Observer::ValueSubject<bool>::create(false);
                 p.options = Observer::ValueSubject<DirectoryListOptions>::create();
 
+                p.threadPool = context->getSystemT<CoreSystem>()->getThreadPool();
+
                 p.futureTimer = Timer::create(context);
                 p.futureTimer->setRepeating(true);
 
+                p.changesTimer = Timer::create(context);
+
+                p.frameCache = std::make_shared<FrameCache>();
+
                 p.directoryWatcher = DirectoryWatcher::create(context);
 
                 auto weak = std::weak_ptr<DirectoryModel>(shared_from_this());
@@ -63,6 +334,16 @@ namespace djv
                         model->reload();
                     }
                 });
+                p.directoryWatcher->setChangesCallback(
+                    [weak](const std::vector<DirectoryChange>& value)
+                {
+                    if (auto model = weak.lock())
+                    {
+                        auto& pendingChanges = model->_p->pendingChanges;
+                        pendingChanges.insert(pendingChanges.end(), value.begin(), value.end());
+                        model->_changesTimerStart();
+                    }
+                });
             }
 
             DirectoryModel::DirectoryModel() :
@@ -70,7 +351,13 @@ namespace djv
             {}
 
             DirectoryModel::~DirectoryModel()
-            {}
+            {
+                DJV_PRIVATE_PTR();
+                if (p.listing)
+                {
+                    p.listing->cancel = true;
+                }
+            }
 
             std::shared_ptr<DirectoryModel> DirectoryModel::create(const std::shared_ptr<Context>& context)
             {
@@ -116,6 +403,16 @@ namespace djv
                 return _p->fileNames;
             }
 
+            std::shared_ptr<Observer::IListSubject<DirectoryChange> > DirectoryModel::observeChanges() const
+            {
+                return _p->changes;
+            }
+
+            void DirectoryModel::setChangesMax(size_t value)
+            {
+                _p->directoryWatcher->setChangesMax(value);
+            }
+
             void DirectoryModel::reload()
             {
                 _pathUpdate();
@@ -237,36 +534,179 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 const Path path = p.path->get();
                 const auto options = p.options->get();
+                if (p.listing)
+                {
+                    p.listing->cancel = true;
+                }
+                auto listing = std::make_shared<Listing>();
+                listing->cancel = false;
+                p.listing = listing;
+
+                // The listing includes any pending changes.
+                p.pendingChanges.clear();
+                p.changesTimer->stop();
+
+                auto threadPool = p.threadPool;
+                auto frameCache = p.frameCache;
                 p.future = std::async(
                     std::launch::async,
-                    [path, options]
+                    [path, options, listing, threadPool, frameCache]
                 {
-                    std::pair<std::vector<Info>, std::vector<std::string> > out;
-                    out.first = directoryList(path, options);
-                    for (const auto& info : out.first)
+                    frameCache->clear();
+
+                    // List the directory without getting information from the
+                    // file system so the items can be shown immediately.
+                    const bool stat = isStatNeeded(options);
+                    DirectoryListOptions listOptions = options;
+                    listOptions.stat = false;
+                    if (stat)
                     {
-                        out.second.push_back(info.getFileName(-1, false));
+                        listOptions.sort = DirectoryListSort::Name;
                     }
-                    return out;
+                    std::vector<Info> info = directoryList(path, listOptions);
+                    {
+                        std::lock_guard<std::mutex> lock(listing->mutex);
+                        listing->info = info;
+                        listing->fileNames = getFileNames(info);
+                        listing->changed = true;
+                    }
+
+                    // Get information from the file system in chunks, in
+                    // the order the items are shown.
+                    if (stat)
+                    {
+                        const size_t size = info.size();
+                        for (size_t i = 0; i < size && !listing->cancel; i += statChunkSize)
+                        {
+                            const size_t chunkSize = std::min(statChunkSize, size - i);
+                            std::vector<Info> chunk(info.begin() + i, info.begin() + i + chunkSize);
+                            File::stat(chunk, threadPool);
+                            std::lock_guard<std::mutex> lock(listing->mutex);
+                            std::copy(chunk.begin(), chunk.end(), listing->info.begin() + i);
+                            listing->changed = true;
+                        }
+                        if (!listing->cancel && listOptions.sort != options.sort)
+                        {
+                            std::lock_guard<std::mutex> lock(listing->mutex);
+                            sort(options, listing->info);
+                            listing->fileNames = getFileNames(listing->info);
+                            listing->changed = true;
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lock(listing->mutex);
+                    listing->finished = true;
                 });
 
+                _futureTimerStart();
+
+                p.directoryWatcher->setPath(p.path->get());
+            }
+
+            void DirectoryModel::_changesTimerStart()
+            {
+                DJV_PRIVATE_PTR();
+                // Collect the changes for a moment so that bursts of changes
+                // are applied together.
+                if (!p.changesTimer->isActive())
+                {
+                    p.changesTimer->start(
+                        getTimerDuration(TimerValue::Slow),
+                        [this](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                    {
+                        _changesUpdate();
+                    });
+                }
+            }
+
+            void DirectoryModel::_changesUpdate()
+            {
+                DJV_PRIVATE_PTR();
+                if (p.futureTimer->isActive() || p.pendingChanges.empty())
+                    return;
+
+                std::set<std::string> fileNames;
+                for (const auto& i : p.pendingChanges)
+                {
+                    fileNames.insert(i.fileName);
+                }
+                p.pendingChanges.clear();
+
+                auto listing = std::make_shared<Listing>();
+                listing->cancel = false;
+                p.listing = listing;
+                const Path path = p.path->get();
+                const auto options = p.options->get();
+                auto info = p.info->get();
+                auto frameCache = p.frameCache;
+                p.future = std::async(
+                    std::launch::async,
+                    [path, options, fileNames, info, listing, frameCache]
+                {
+                    std::vector<Info> tmp = info;
+                    std::vector<DirectoryChange> changes;
+                    applyChanges(path, options, fileNames, tmp, *frameCache, changes);
+                    std::lock_guard<std::mutex> lock(listing->mutex);
+                    if (!changes.empty())
+                    {
+                        listing->info = std::move(tmp);
+                        listing->fileNames = getFileNames(listing->info);
+                        listing->changes = std::move(changes);
+                        listing->changed = true;
+                    }
+                    listing->finished = true;
+                });
+
+                _futureTimerStart();
+            }
+
+            void DirectoryModel::_futureTimerStart()
+            {
+                DJV_PRIVATE_PTR();
                 p.futureTimer->start(
                     getTimerDuration(TimerValue::Medium),
                     [this](const std::chrono::steady_clock::time_point&, const Time::Duration&)
                 {
                     DJV_PRIVATE_PTR();
-                    if (p.future.valid() &&
-                        p.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    bool changed = false;
+                    bool finished = false;
+                    std::vector<Info> info;
+                    std::vector<std::string> fileNames;
+                    std::vector<DirectoryChange> changes;
+                    {
+                        std::lock_guard<std::mutex> lock(p.listing->mutex);
+                        if (p.listing->changed)
+                        {
+                            info = p.listing->info;
+                            fileNames = p.listing->fileNames;
+                            changes = std::move(p.listing->changes);
+                            p.listing->changes.clear();
+                            p.listing->changed = false;
+                            changed = true;
+                        }
+                        finished = p.listing->finished;
+                    }
+                    if (changed)
+                    {
+                        p.info->setIfChanged(info);
+                        p.fileNames->setIfChanged(fileNames);
+                        if (!changes.empty())
+                        {
+                            p.changes->setAlways(changes);
+                        }
+                    }
+                    if (finished)
                     {
                         p.futureTimer->stop();
 
-                        const auto& out = p.future.get();
-                        p.info->setIfChanged(out.first);
-                        p.fileNames->setIfChanged(out.second);
+                        // Apply the changes that arrived while the listing was
+                        // running.
+                        if (!p.pendingChanges.empty())
+                        {
+                            _changesTimerStart();
+                        }
                     }
                 });
-
-                p.directoryWatcher->setPath(p.path->get());
             }
 
         } // namespace File
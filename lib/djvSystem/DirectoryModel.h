@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <djvSystem/DirectoryWatcher.h>
 #include <djvSystem/FileInfo.h>
 
 #include <djvCore/ListObserver.h>
@@ -46,6 +47,14 @@ namespace djv
                 std::shared_ptr<Core::Observer::IListSubject<File::Info> > observeInfo() const;
                 std::shared_ptr<Core::Observer::IListSubject<std::string> > observeFileNames() const;
 
+                //! Observe the items changed by the last update from the
+                //! directory watcher.
+                std::shared_ptr<Core::Observer::IListSubject<DirectoryChange> > observeChanges() const;
+
+                //! Set the maximum number of individual changes applied at
+                //! once, when there are more the directory is listed again.
+                void setChangesMax(size_t);
+
                 void reload();
 
                 ///@}
@@ -85,6 +94,9 @@ namespace djv
 
             private:
                 void _pathUpdate();
+                void _changesTimerStart();
+                void _changesUpdate();
+                void _futureTimerStart();
 
                 DJV_PRIVATE();
             };
@@ -8,6 +8,8 @@
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace djv
 {
@@ -19,6 +21,23 @@ namespace djv
         {
             class Path;
 
+            //! Directory change types.
+            enum class DirectoryChangeType
+            {
+                Added,
+                Removed,
+                Modified
+            };
+
+            //! Directory change.
+            struct DirectoryChange
+            {
+                DirectoryChangeType type = DirectoryChangeType::Modified;
+                std::string         fileName;
+
+                bool operator == (const DirectoryChange&) const;
+            };
+
             //! Directory watcher.
             //!
             //! \bug What do we do about changes to the directory path (like deletion or moving)?
@@ -45,8 +64,20 @@ namespace djv
                 //! \name Callback
                 ///@{
 
+                //! Set the callback for when the directory has changed.
                 void setCallback(const std::function<void(void)>&);
 
+                //! Set the callback for changes to individual files. When the
+                //! individual changes are not known (the platform does not
+                //! report them, or the event queue overflowed) the callback
+                //! from setCallback() is used instead.
+                void setChangesCallback(const std::function<void(const std::vector<DirectoryChange>&)>&);
+
+                //! Set the maximum number of individual changes. When there
+                //! are more changes the callback from setCallback() is used
+                //! instead.
+                void setChangesMax(size_t);
+
                 ///!@}
 
             private:
@@ -57,3 +88,4 @@ namespace djv
     } // namespace System
 } // namespace djv
 
+#include <djvSystem/DirectoryWatcherInline.h>
@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace System
+    {
+        namespace File
+        {
+            inline bool DirectoryChange::operator == (const DirectoryChange& other) const
+            {
+                return type == other.type && fileName == other.fileName;
+            }
+
+        } // namespace File
+    } // namespace System
+} // namespace djv
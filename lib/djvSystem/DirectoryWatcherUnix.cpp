@@ -66,7 +66,9 @@ namespace djv
                         }
                     }
                                         
-                    ::time_t poll()
+                    //! The events don't say which files changed, so only the
+                    //! reload flag is set.
+                    void poll(std::vector<DirectoryChange>&, bool& reload)
                     {
                         struct kevent eventData[1];
                         timespec _timeout;
@@ -75,9 +77,8 @@ namespace djv
                         int eventCount = ::kevent(_kq, _eventsToMonitor, 1, eventData, 1, &_timeout);
                         if (eventCount)
                         {
-                            _lastModified = time(nullptr);
+                            reload = true;
                         }
-                        return _lastModified;
                     }
                     
                 private:
@@ -85,7 +86,6 @@ namespace djv
                     int _kq = 0;
                     int _fd = 0;
                     struct kevent _eventsToMonitor[1];
-                    ::time_t _lastModified = 0;
                 };
 
 #else // DJV_PLATFORM_MACOS
@@ -99,17 +99,13 @@ namespace djv
                         _fd = ::inotify_init1(IN_NONBLOCK);
                         if (_fd)
                         {
-                            _wd = ::inotify_add_watch(_fd, _path.get().c_str(), IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB);
+                            _wd = ::inotify_add_watch(
+                                _fd,
+                                _path.get().c_str(),
+                                IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO);
                         }
                     }
 
-                    Notify(Notify&& other) noexcept :
-                        _path(other._path),
-                        _fd(other._fd),
-                        _wd(other._wd),
-                        _lastModified(other._lastModified)
-                    {}
-                    
                     ~Notify()
                     {
                         if (_fd && _wd)
@@ -124,50 +120,49 @@ namespace djv
                         }
                     }
 
-                    Notify& operator = (Notify&& other) noexcept
-                    {
-                        if (this != &other)
-                        {
-                            _path = other._path;
-                            _fd = other._fd;
-                            _wd = other._wd;
-                            _lastModified = other._lastModified;
-                        }
-                        return *this;
-                    }
-                                        
-                    ::time_t poll()
+                    //! Read the pending events. If the event queue overflowed
+                    //! the reload flag is set.
+                    void poll(std::vector<DirectoryChange>& changes, bool& reload)
                     {
                         if (_fd && _wd)
                         {
                             static const size_t bufferSize = 1024 * (sizeof(::inotify_event) + 16);
                             char buffer[bufferSize];
-                            const int length = ::read(_fd, buffer, bufferSize);
-                            int i = 0;
-                            while (i < length)
+                            int length = 0;
+                            while ((length = ::read(_fd, buffer, bufferSize)) > 0)
                             {
-                                ::inotify_event* event = (::inotify_event*)&buffer[i];
-                                if (event->len)
+                                int i = 0;
+                                while (i < length)
                                 {
-                                    if (event->mask & IN_CREATE ||
-                                        event->mask & IN_DELETE ||
-                                        event->mask & IN_MODIFY)
+                                    const ::inotify_event* event = reinterpret_cast<const ::inotify_event*>(&buffer[i]);
+                                    if (event->mask & IN_Q_OVERFLOW)
+                                    {
+                                        reload = true;
+                                    }
+                                    else if (event->len)
                                     {
-                                        _lastModified = time(nullptr);
-                                        break;
+                                        DirectoryChange change;
+                                        change.fileName = event->name;
+                                        if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                                        {
+                                            change.type = DirectoryChangeType::Added;
+                                        }
+                                        else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                                        {
+                                            change.type = DirectoryChangeType::Removed;
+                                        }
+                                        changes.push_back(change);
                                     }
+                                    i += sizeof(::inotify_event) + event->len;
                                 }
-                                i += sizeof(::inotify_event) + event->len;
                             }
                         }
-                        return _lastModified;
                     }
                     
                 private:
                     Path _path;
                     int _fd = 0;
                     int _wd = 0;
-                    ::time_t _lastModified = 0;
                 };
 #endif // DJV_PLATFORM_MACOS
 
@@ -179,10 +174,12 @@ namespace djv
                 bool running = false;
                 std::thread thread;
                 std::timed_mutex mutex;
-                ::time_t lastModified = 0;
-                ::time_t threadModified = 0;
+                std::vector<DirectoryChange> changes;
+                bool reload = false;
+                size_t changesMax = 10000;
                 std::shared_ptr<Timer> timer;
                 std::function<void(void)> callback;
+                std::function<void(const std::vector<DirectoryChange>&)> changesCallback;
             };
 
             void DirectoryWatcher::_init(const std::shared_ptr<Context>& context)
@@ -197,7 +194,8 @@ namespace djv
                     Path path;
                     bool pathInit = false;
                     std::unique_ptr<Notify> notify;
-                    ::time_t lastModified = 0;                    
+                    std::vector<DirectoryChange> changes;
+                    bool reload = false;
                     bool running = true;
                     while (running)
                     {
@@ -206,14 +204,21 @@ namespace djv
                             auto & p = *watcher->_p;
                             if (p.mutex.try_lock_for(timeout))
                             {
-                                // Synchronize with the main thread.
+                                // Synchronize with the main thread. Changes
+                                // for a previous path are dropped.
                                 running = p.running;
-                                if (path != p.path)
+                                if (path == p.path)
+                                {
+                                    p.changes.insert(p.changes.end(), changes.begin(), changes.end());
+                                    p.reload |= reload;
+                                }
+                                else
                                 {
                                     path = p.path;
                                     pathInit = true;
                                 }
-                                p.threadModified = lastModified;                                                        
+                                changes.clear();
+                                reload = false;
                                 p.mutex.unlock();
                             }
                         }
@@ -233,7 +238,7 @@ namespace djv
                         if (notify)
                         {
                             // Poll for events.
-                            lastModified = notify->poll();
+                            notify->poll(changes, reload);
                         }
                         
                         std::this_thread::sleep_for(timeout);
@@ -249,19 +254,34 @@ namespace djv
                     if (auto watcher = weak.lock())
                     {
                         auto & p = *watcher->_p;
+                        std::vector<DirectoryChange> changes;
+                        bool reload = false;
                         if (p.mutex.try_lock_for(timeout))
                         {
-                            if (p.threadModified != p.lastModified)
-                            {                            
-                                p.lastModified = p.threadModified;
-                                
-                                if (p.callback)
-                                {
-                                    p.callback();
-                                }
-                            }
+                            std::swap(changes, p.changes);
+                            reload = p.reload;
+                            p.reload = false;
                             p.mutex.unlock();
                         }
+
+                        // Reload when the individual changes are not known
+                        // or there are too many of them.
+                        if (!p.changesCallback || changes.size() > p.changesMax)
+                        {
+                            reload |= !changes.empty();
+                            changes.clear();
+                        }
+                        if (reload)
+                        {
+                            if (p.callback)
+                            {
+                                p.callback();
+                            }
+                        }
+                        else if (!changes.empty())
+                        {
+                            p.changesCallback(changes);
+                        }
                     }
                 });
             }
@@ -293,7 +313,12 @@ namespace djv
 
             void DirectoryWatcher::setPath(const Path& value)
             {
+                std::lock_guard<std::timed_mutex> lock(_p->mutex);
+                if (value == _p->path)
+                    return;
                 _p->path = value;
+                _p->changes.clear();
+                _p->reload = false;
             }
 
             void DirectoryWatcher::setCallback(const std::function<void(void)>& value)
@@ -301,6 +326,16 @@ namespace djv
                 _p->callback = value;
             }
 
+            void DirectoryWatcher::setChangesCallback(const std::function<void(const std::vector<DirectoryChange>&)>& value)
+            {
+                _p->changesCallback = value;
+            }
+
+            void DirectoryWatcher::setChangesMax(size_t value)
+            {
+                _p->changesMax = value;
+            }
+
         } // namespace File
     } // namespace System
 } // namespace djv
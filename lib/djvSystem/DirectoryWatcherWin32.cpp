@@ -43,6 +43,7 @@ namespace djv
                 std::thread thread;
                 std::atomic<bool> running = true;
                 std::function<void(void)> callback;
+                std::function<void(const std::vector<DirectoryChange>&)> changesCallback;
                 std::shared_ptr<Timer> timer;
             };
 
@@ -214,6 +215,18 @@ namespace djv
                 _p->callback = value;
             }
 
+            void DirectoryWatcher::setChangesCallback(const std::function<void(const std::vector<DirectoryChange>&)>& value)
+            {
+                //! \todo Change notifications don't report the individual
+                //! files, ReadDirectoryChangesW() would.
+                _p->changesCallback = value;
+            }
+
+            void DirectoryWatcher::setChangesMax(size_t)
+            {
+                // The individual changes are not reported.
+            }
+
         } // namespace File
     } // namespace System
 } // namespace djv
@@ -6,6 +6,9 @@
 
 #include <djvMath/FrameNumber.h>
 
+#include <djvCore/String.h>
+#include <djvCore/ThreadPool.h>
+
 #include <algorithm>
 #include <array>
 
@@ -155,6 +158,33 @@ namespace djv
                 return false;
             }
             
+            bool Info::removeFromSequence(const Info& value)
+            {
+                if (Type::Sequence == _type && isCompatible(value))
+                {
+                    std::vector<Math::Frame::Number> frames = Math::Frame::toFrames(_sequence);
+                    const size_t size = frames.size();
+                    for (const auto frame : Math::Frame::toFrames(_parseSequence(value.getPath().getNumber())))
+                    {
+                        const auto i = std::lower_bound(frames.begin(), frames.end(), frame);
+                        if (i != frames.end() && frame == *i)
+                        {
+                            frames.erase(i);
+                        }
+                    }
+                    if (frames.size() != size)
+                    {
+                        const size_t pad = _sequence.getPad();
+                        _sequence = Math::Frame::fromFrames(frames);
+                        _sequence.setPad(pad);
+                        _path.setNumber(Math::Frame::toString(_sequence));
+                        _size -= std::min(_size, value._size);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
             Math::Frame::Sequence Info::_parseSequence(const std::string& number)
             {
                 Math::Frame::Sequence out;
@@ -210,90 +240,226 @@ namespace djv
                 return data[in];
             }
 
-            void sequence(Info& info, const DirectoryListOptions& options, std::vector<Info>& out)
+            DirectoryListSequences::DirectoryListSequences(const DirectoryListOptions& options) :
+                _options(options)
+            {}
+
+            void DirectoryListSequences::add(const Info& info, std::vector<Info>& out)
+            {
+                const Path& path = info.getPath();
+                Math::Frame::Number frame = Math::Frame::invalid;
+                size_t pad = 0;
+                if (!getSequenceFrame(path, _options, frame, pad))
+                {
+                    out.push_back(info);
+                    return;
+                }
+
+                const std::string key = getSequenceKey(path);
+                const auto i = _groupIndex.find(key);
+                Group* group = nullptr;
+                if (i == _groupIndex.end())
+                {
+                    _groupIndex[key] = _groups.size();
+                    _groups.push_back(Group());
+                    group = &_groups.back();
+                    group->index = out.size();
+                    out.push_back(info);
+                }
+                else
+                {
+                    group = &_groups[i->second];
+                }
+                group->frames.push_back(frame);
+                group->pad = std::max(group->pad, pad);
+                group->size += info.getSize();
+                group->user = std::max(group->user, info.getUser());
+                group->time = std::max(group->time, info.getTime());
+            }
+
+            void DirectoryListSequences::finish(std::vector<Info>& out)
             {
-                std::string extension = info.getPath().getExtension();
+                for (auto& group : _groups)
+                {
+                    if (group.frames.size() > 1)
+                    {
+                        std::sort(group.frames.begin(), group.frames.end());
+                        group.frames.erase(
+                            std::unique(group.frames.begin(), group.frames.end()),
+                            group.frames.end());
+                        auto sequence = Math::Frame::fromFrames(group.frames);
+                        sequence.setPad(group.pad);
+                        Info& info = out[group.index];
+                        Path path = info.getPath();
+                        path.setNumber(Math::Frame::toString(sequence));
+                        const bool exists = info._exists;
+                        const int permissions = info._permissions;
+                        info.setPath(path, Type::Sequence, sequence, false);
+                        info._exists = exists;
+                        info._size = group.size;
+                        info._user = group.user;
+                        info._permissions = permissions;
+                        info._time = group.time;
+                    }
+                }
+                _groupIndex.clear();
+                _groups.clear();
+            }
+
+            bool isFileNameFiltered(const std::string& fileName, const DirectoryListOptions& options)
+            {
+                if (fileName.empty())
+                    return true;
+
+                // Filter hidden items.
+                if ('.' == fileName[0] && !options.showHidden)
+                    return true;
+
+                // Filter "." and ".." items.
+                if ("." == fileName || ".." == fileName)
+                    return true;
+
+                // Filter string matches.
+                return options.filter.size() && !String::match(fileName, options.filter);
+            }
+
+            bool getSequenceFrame(
+                const Path& path,
+                const DirectoryListOptions& options,
+                Math::Frame::Number& frame,
+                size_t& pad)
+            {
+                const std::string& number = path.getNumber();
+                if (!options.sequences || number.empty())
+                    return false;
+                std::string extension = path.getExtension();
                 std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
-                const auto i = std::find(
-                    options.sequenceExtensions.begin(),
-                    options.sequenceExtensions.end(),
-                    extension);
-                if (options.sequences && i != options.sequenceExtensions.end())
+                if (!options.sequenceExtensions.count(extension))
+                    return false;
+                Math::Frame::Range range;
+                try
+                {
+                    Math::Frame::fromString(number, range, pad);
+                }
+                catch (const std::exception&)
                 {
-                    const size_t size = out.size();
-                    size_t j = 0;
-                    for (; j < size; ++j)
+                    return false;
+                }
+                if (range.getMin() != range.getMax())
+                    return false;
+                frame = range.getMin();
+                return true;
+            }
+
+            std::string getSequenceKey(const Path& path)
+            {
+                return path.getBaseName() + '/' + path.getExtension();
+            }
+
+            bool isExtensionMatch(const Path& path, const DirectoryListOptions& options)
+            {
+                return options.extensions.empty() || options.extensions.count(path.getExtension()) > 0;
+            }
+
+            bool isStatNeeded(const DirectoryListOptions& options)
+            {
+                return
+                    options.stat ||
+                    DirectoryListSort::Size == options.sort ||
+                    DirectoryListSort::Time == options.sort;
+            }
+
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t bandSizeMin = 64;
+
+            } // namespace
+
+            void forEachBand(
+                size_t size,
+                const std::function<void(size_t, size_t)>& callback,
+                const std::shared_ptr<Core::Thread::ThreadPool>& threadPool)
+            {
+                const size_t bandCount = threadPool ?
+                    std::min(threadPool->getThreadCount(), std::max(size / bandSizeMin, static_cast<size_t>(1))) :
+                    1;
+                if (bandCount > 1)
+                {
+                    auto workQueue = threadPool->createQueue(bandCount);
+                    std::vector<std::future<void> > futures;
+                    for (size_t i = 0; i < bandCount; ++i)
                     {
-                        if (out[j].addToSequence(info))
-                        {
-                            break;
-                        }
+                        const size_t begin = size * i / bandCount;
+                        const size_t end = size * (i + 1) / bandCount;
+                        futures.push_back(workQueue->push<void>(
+                            [callback, begin, end]
+                            {
+                                callback(begin, end);
+                            }));
                     }
-                    if (size == j)
+                    for (auto& i : futures)
                     {
-                        out.push_back(info);
+                        i.get();
                     }
                 }
-                else
+                else if (size > 0)
                 {
-                    out.push_back(info);
+                    callback(0, size);
                 }
             }
 
             void sort(const DirectoryListOptions& options, std::vector<Info>& out)
             {
-                for (auto& i : out)
+                // Get the sort keys once instead of for every comparison.
+                const size_t size = out.size();
+                std::vector<std::string> names;
+                if (DirectoryListSort::Name == options.sort)
                 {
-                    if (Type::Sequence == i.getType())
+                    names.reserve(size);
+                    for (const auto& i : out)
                     {
-                        const auto sequence = i.getSequence();
-                        std::stringstream s;
-                        s << sequence;
-                        Path path = i.getPath();
-                        path.setNumber(s.str());
-                        i.setPath(path, Type::Sequence, sequence, false);
+                        names.push_back(i.getFileName(Math::Frame::invalid, false));
                     }
                 }
-
-                switch (options.sort)
+                std::vector<size_t> order(size);
+                for (size_t i = 0; i < size; ++i)
                 {
-                case DirectoryListSort::Name:
-                    std::sort(
-                        out.begin(), out.end(),
-                        [&options](const Info& a, const Info& b)
+                    order[i] = i;
+                }
+                std::sort(
+                    order.begin(), order.end(),
+                    [&options, &out, &names](size_t a, size_t b)
+                    {
+                        if (options.sortDirectoriesFirst)
                         {
-                            return options.reverseSort ?
-                                (a.getFileName(Math::Frame::invalid, false) > b.getFileName(Math::Frame::invalid, false)) :
-                                (a.getFileName(Math::Frame::invalid, false) < b.getFileName(Math::Frame::invalid, false));
-                        });
-                    break;
-                case DirectoryListSort::Size:
-                    std::sort(
-                        out.begin(), out.end(),
-                        [&options](const Info& a, const Info& b)
+                            const bool aDir = Type::Directory == out[a].getType();
+                            const bool bDir = Type::Directory == out[b].getType();
+                            if (aDir != bDir)
+                            {
+                                return aDir;
+                            }
+                        }
+                        if (options.reverseSort)
                         {
-                            return options.reverseSort ? (a.getSize() > b.getSize()) : (a.getSize() < b.getSize());
-                        });
-                    break;
-                case DirectoryListSort::Time:
-                    std::sort(
-                        out.begin(), out.end(),
-                        [&options](const Info& a, const Info& b)
+                            std::swap(a, b);
+                        }
+                        switch (options.sort)
                         {
-                            return options.reverseSort ? (a.getTime() > b.getTime()) : (a.getTime() < b.getTime());
-                        });
-                    break;
-                default: break;
-                }
-                if (options.sortDirectoriesFirst)
+                        case DirectoryListSort::Name: return names[a] < names[b];
+                        case DirectoryListSort::Size: return out[a].getSize() < out[b].getSize();
+                        case DirectoryListSort::Time: return out[a].getTime() < out[b].getTime();
+                        default: break;
+                        }
+                        return false;
+                    });
+                std::vector<Info> tmp;
+                tmp.reserve(size);
+                for (const auto i : order)
                 {
-                    std::stable_sort(
-                        out.begin(), out.end(),
-                        [](const Info& a, const Info& b)
-                        {
-                            return Type::Directory == a.getType() && b.getType() != Type::Directory;
-                        });
+                    tmp.push_back(std::move(out[i]));
                 }
+                out = std::move(tmp);
             }
 
         } // namespace File
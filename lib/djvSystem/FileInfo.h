@@ -11,6 +11,7 @@
 #include <djvCore/Enum.h>
 #include <djvCore/RapidJSON.h>
 
+#include <memory>
 #include <set>
 #include <sstream>
 
@@ -22,6 +23,15 @@ typedef int uid_t;
 
 namespace djv
 {
+    namespace Core
+    {
+        namespace Thread
+        {
+            class ThreadPool;
+
+        } // namespace Thread
+    } // namespace Core
+
     namespace System
     {
         namespace File
@@ -70,6 +80,11 @@ namespace djv
                 bool                        sortDirectoriesFirst    = true;
                 std::string                 filter;
 
+                //! Get information from the file system (size, time, and
+                //! permissions) for each item. This is always done when
+                //! sorting by size or time.
+                bool                        stat                    = true;
+
                 bool operator == (const DirectoryListOptions&) const;
             };
 
@@ -138,6 +153,10 @@ namespace djv
                 
                 void setSequence(const Math::Frame::Sequence&);
                 bool addToSequence(const Info&);
+
+                //! Remove the frames of the given file from the sequence, and
+                //! subtract its size.
+                bool removeFromSequence(const Info&);
                 
                 ///@}
 
@@ -149,6 +168,9 @@ namespace djv
 
             private:
                 static Math::Frame::Sequence _parseSequence(const std::string&);
+
+                friend class DirectoryListSequences;
+                friend void stat(std::vector<Info>&, const std::shared_ptr<Core::Thread::ThreadPool>&);
                 
                 Path                  _path;
                 bool                  _exists      = false;
@@ -166,6 +188,11 @@ namespace djv
             //! Get the contents of the given directory.
             std::vector<Info> directoryList(const Path& path, const DirectoryListOptions& options = DirectoryListOptions());
 
+            //! Get information from the file system for a list of items. The
+            //! items are divided between the threads of the pool if one is
+            //! given.
+            void stat(std::vector<Info>&, const std::shared_ptr<Core::Thread::ThreadPool>& = nullptr);
+
             ///@}
 
             //! \name Sequences
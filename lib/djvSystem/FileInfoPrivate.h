@@ -6,16 +6,77 @@
 
 #include <djvSystem/FileInfo.h>
 
+#include <functional>
+#include <unordered_map>
+
 namespace djv
 {
     namespace System
     {
         namespace File
         {
-            void sequence(Info&, const DirectoryListOptions&, std::vector<Info>&);
+            //! Group the items of a directory listing into sequences.
+            //!
+            //! Files are grouped by their base name and extension with a hash
+            //! map, collecting only the frame numbers. The sequences are built
+            //! and formatted once when the listing is finished.
+            class DirectoryListSequences
+            {
+            public:
+                explicit DirectoryListSequences(const DirectoryListOptions&);
+
+                //! Add an item to the listing.
+                void add(const Info&, std::vector<Info>&);
+
+                //! Finish the sequences in the listing.
+                void finish(std::vector<Info>&);
+
+            private:
+                struct Group
+                {
+                    size_t                           index = 0;
+                    std::vector<Math::Frame::Number> frames;
+                    size_t                           pad   = 0;
+                    uint64_t                         size  = 0;
+                    uid_t                            user  = 0;
+                    time_t                           time  = 0;
+                };
+
+                const DirectoryListOptions&             _options;
+                std::unordered_map<std::string, size_t> _groupIndex;
+                std::vector<Group>                      _groups;
+            };
+
+            //! Get whether the file name is filtered from the directory listing.
+            bool isFileNameFiltered(const std::string&, const DirectoryListOptions&);
+
+            //! Get the frame number if the item can be part of a sequence in the
+            //! directory listing.
+            bool getSequenceFrame(
+                const Path&,
+                const DirectoryListOptions&,
+                Math::Frame::Number&,
+                size_t& pad);
+
+            //! Get the key that groups the items of a sequence.
+            std::string getSequenceKey(const Path&);
+
+            //! Get whether the item passes the directory listing extensions.
+            bool isExtensionMatch(const Path&, const DirectoryListOptions&);
+
+            //! Get whether the directory listing needs information from the
+            //! file system.
+            bool isStatNeeded(const DirectoryListOptions&);
+
+            //! Call the function for bands of the items, divided between the
+            //! threads of the pool if one is given.
+            void forEachBand(
+                size_t size,
+                const std::function<void(size_t, size_t)>&,
+                const std::shared_ptr<Core::Thread::ThreadPool>&);
+
             void sort(const DirectoryListOptions&, std::vector<Info>&);
 
         } // namespace File
     } // namespace System
 } // namespace djv
-
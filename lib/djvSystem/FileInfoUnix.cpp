@@ -11,17 +11,20 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <dirent.h>
+#include <fcntl.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
 //#pragma optimize("", off)
 
 #if defined(DJV_PLATFORM_MACOS) || defined(DJV_PLATFORM_IOS)
 //! \bug OS X doesn't have stat64?
 #define _STAT struct ::stat
-#define _STAT_FNC    ::stat
+#define _STATAT_FNC  ::fstatat
 #elif defined(DJV_PLATFORM_LINUX)
 #define _STAT struct ::stat64
-#define _STAT_FNC    ::stat64
+#define _STATAT_FNC  ::fstatat64
 #endif // DJV_PLATFORM_MACOS
 
 using namespace djv::Core;
@@ -32,138 +35,198 @@ namespace djv
     {
         namespace File
         {
-            bool Info::stat(std::string*)
+            namespace
             {
-                _exists      = false;
-                _size        = 0;
-                _user        = 0;
-                _permissions = 0;
-                _time        = 0;
-                if (Type::Sequence == _type)
+                //! Information from the file system.
+                struct StatData
                 {
                     bool     exists      = false;
+                    bool     directory   = false;
                     uint64_t size        = 0;
                     uid_t    user        = 0;
                     int      permissions = 0;
                     time_t   time        = 0;
-                    for (auto i : Math::Frame::toFrames(_sequence))
+                };
+
+                bool statAt(int dirFd, const std::string& fileName, _STAT& out)
+                {
+                    memset(&out, 0, sizeof(_STAT));
+                    return _STATAT_FNC(dirFd, fileName.c_str(), &out, 0) == 0;
+                }
+
+                int getPermissions(const _STAT& value)
+                {
+                    int out = 0;
+                    out |= (value.st_mode & S_IRUSR) ? static_cast<int>(Permissions::Read)  : 0;
+                    out |= (value.st_mode & S_IWUSR) ? static_cast<int>(Permissions::Write) : 0;
+                    out |= (value.st_mode & S_IXUSR) ? static_cast<int>(Permissions::Exec)  : 0;
+                    return out;
+                }
+
+                //! Get information for an item. If the directory is AT_FDCWD
+                //! the full path is used, otherwise the file name is relative
+                //! to the directory.
+                bool statInfo(int dirFd, const Info& info, StatData& out)
+                {
+                    const bool path = AT_FDCWD == dirFd;
+                    _STAT data;
+                    if (Type::Sequence == info.getType())
+                    {
+                        StatData tmp;
+                        for (auto i : Math::Frame::toFrames(info.getSequence()))
+                        {
+                            if (!statAt(dirFd, info.getFileName(i, path), data))
+                            {
+                                return false;
+                            }
+                            tmp.user         = tmp.exists ? std::min(tmp.user, static_cast<uid_t>(data.st_uid)) : data.st_uid;
+                            tmp.exists       = true;
+                            tmp.size        += data.st_size;
+                            tmp.permissions |= getPermissions(data);
+                            tmp.time         = std::max(tmp.time, data.st_mtime);
+                        }
+                        out = tmp;
+                    }
+                    else
                     {
-                        _STAT info;
-                        memset(&info, 0, sizeof(_STAT));
-                        const std::string fileName = getFileName(i);
-                        if (_STAT_FNC(fileName.c_str(), &info) != 0)
+                        if (!statAt(dirFd, path ? info.getPath().get() : info.getPath().getFileName(), data))
                         {
                             return false;
                         }
-                        exists       = true;
-                        size        += info.st_size;
-                        user         = std::min(_user, static_cast<uid_t>(info.st_uid));
-                        permissions |= (info.st_mode & S_IRUSR) ? static_cast<int>(Permissions::Read)  : 0;
-                        permissions |= (info.st_mode & S_IWUSR) ? static_cast<int>(Permissions::Write) : 0;
-                        permissions |= (info.st_mode & S_IXUSR) ? static_cast<int>(Permissions::Exec)  : 0;
-                        time         = std::max(_time, info.st_mtime);
+                        out.exists      = true;
+                        out.directory   = S_ISDIR(data.st_mode);
+                        out.size        = data.st_size;
+                        out.user        = data.st_uid;
+                        out.permissions = getPermissions(data);
+                        out.time        = data.st_mtime;
                     }
-                    _exists      = exists;
-                    _size        = size;
-                    _user        = user;
-                    _permissions = permissions;
-                    _time        = time;
+                    return true;
                 }
-                else
+
+            } // namespace
+
+            bool Info::stat(std::string*)
+            {
+                _exists      = false;
+                _size        = 0;
+                _user        = 0;
+                _permissions = 0;
+                _time        = 0;
+                StatData data;
+                if (!statInfo(AT_FDCWD, *this, data))
                 {
-                    _STAT info;
-                    memset(&info, 0, sizeof(_STAT));
-                    if (_STAT_FNC(_path.get().c_str(), &info) != 0)
-                    {
-                        return false;
-                    }
-                    _exists		  = true;
-                    if (S_ISDIR(info.st_mode))
-                    {
-                        _type     = Type::Directory;
-                    }
-                    _size         = info.st_size;
-                    _user         = info.st_uid;
-                    _permissions |= (info.st_mode & S_IRUSR) ? static_cast<int>(Permissions::Read)  : 0;
-                    _permissions |= (info.st_mode & S_IWUSR) ? static_cast<int>(Permissions::Write) : 0;
-                    _permissions |= (info.st_mode & S_IXUSR) ? static_cast<int>(Permissions::Exec)  : 0;
-                    _time         = info.st_mtime;
+                    return false;
+                }
+                _exists      = data.exists;
+                if (data.directory)
+                {
+                    _type    = Type::Directory;
                 }
+                _size        = data.size;
+                _user        = data.user;
+                _permissions = data.permissions;
+                _time        = data.time;
                 return true;
             }
 
+            void stat(std::vector<Info>& value, const std::shared_ptr<Core::Thread::ThreadPool>& threadPool)
+            {
+                Info* items = value.data();
+                forEachBand(
+                    value.size(),
+                    [items](size_t begin, size_t end)
+                    {
+                        // Items in the same directory are found relative to
+                        // an open directory to avoid looking up the full path
+                        // for each one.
+                        std::string dirName;
+                        int dirFd = -1;
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            Info& info = items[i];
+                            const std::string& infoDirName = info.getPath().getDirectoryName();
+                            if (-1 == dirFd || infoDirName != dirName)
+                            {
+                                if (dirFd != -1)
+                                {
+                                    close(dirFd);
+                                }
+                                dirName = infoDirName;
+                                dirFd = open(dirName.empty() ? "." : dirName.c_str(), O_RDONLY | O_DIRECTORY);
+                            }
+                            StatData data;
+                            const bool valid = statInfo(dirFd != -1 ? dirFd : AT_FDCWD, info, data);
+                            info._exists      = valid && data.exists;
+                            if (data.directory)
+                            {
+                                info._type    = Type::Directory;
+                            }
+                            info._size        = data.size;
+                            info._user        = data.user;
+                            info._permissions = data.permissions;
+                            info._time        = data.time;
+                        }
+                        if (dirFd != -1)
+                        {
+                            close(dirFd);
+                        }
+                    },
+                    threadPool);
+            }
+
             std::vector<Info> directoryList(const Path& value, const DirectoryListOptions& options)
             {
                 std::vector<Info> out;
+                DirectoryListSequences sequences(options);
                 
                 // List the directory contents.
                 if (auto dir = opendir(value.get().c_str()))
                 {
+                    const int dirFd = dirfd(dir);
                     dirent* de = nullptr;
                     while ((de = readdir(dir)))
                     {
-                        Info info(Path(value, de->d_name));
-                        
-                        const std::string fileName = info.getFileName(-1, false);
-                        
-                        bool filter = false;
-                        
-                        // Filter hidden items.
-                        if (!filter && fileName.size() > 0 &&
-                            '.' == fileName[0])
+                        const char* fileName = de->d_name;
+                        if (isFileNameFiltered(fileName, options))
                         {
-                            filter = !options.showHidden;
+                            continue;
                         }
-                        
-                        // Filter "." and ".." items.
-                        if (!filter &&
-                            fileName.size() == 1 &&
-                            '.' == fileName[0])
+
+                        // Get the type from the directory entry, only links
+                        // and file systems without types need a stat.
+                        bool directory = false;
+                        switch (de->d_type)
                         {
-                            filter = true;
-                        }
-                        if (!filter &&
-                            fileName.size() == 2 &&
-                            '.' == fileName[0] &&
-                            '.' == fileName[1])
+                        case DT_DIR: directory = true; break;
+                        case DT_LNK:
+                        case DT_UNKNOWN:
                         {
-                            filter = true;
+                            _STAT data;
+                            directory = statAt(dirFd, fileName, data) && S_ISDIR(data.st_mode);
+                            break;
                         }
-                        
-                        // Filter string matches.
-                        if (!filter &&
-                            options.filter.size() &&
-                            !String::match(fileName, options.filter))
-                        {
-                            filter = true;
+                        default: break;
                         }
+                        const Path path(value, fileName);
                         
                         // Filter file extensions.
-                        if (!filter &&
-                            info.getType() != System::File::Type::Directory &&
-                            options.extensions.size())
+                        if (!directory && !isExtensionMatch(path, options))
                         {
-                            bool match = false;
-                            for (const auto& i : options.extensions)
-                            {
-                                if (String::match(fileName, '\\' + i + '$'))
-                                {
-                                    match = true;
-                                    break;
-                                }
-                            }
-                            if (!match)
-                            {
-                                filter = true;
-                            }
+                            continue;
                         }
 
-                        if (!filter)
-                        {
-                            sequence(info, options, out);
-                        }
+                        sequences.add(
+                            Info(path, directory ? Type::Directory : Type::File, Math::Frame::Sequence(), false),
+                            out);
                     }
                     closedir(dir);
+                    sequences.finish(out);
+                }
+
+                // Get information from the file system.
+                if (isStatNeeded(options))
+                {
+                    stat(out);
                 }
                     
                 // Sort the items.
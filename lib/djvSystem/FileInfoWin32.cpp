@@ -111,6 +111,21 @@ namespace djv
                 return true;
             }
 
+            void stat(std::vector<Info>& value, const std::shared_ptr<Core::Thread::ThreadPool>& threadPool)
+            {
+                Info* items = value.data();
+                forEachBand(
+                    value.size(),
+                    [items](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            items[i].stat();
+                        }
+                    },
+                    threadPool);
+            }
+
             namespace
             {
                 class NetOpenEnum
@@ -203,6 +218,7 @@ namespace djv
             std::vector<Info> directoryList(const Path& value, const DirectoryListOptions& options)
             {
                 std::vector<Info> out;
+                DirectoryListSequences sequences(options);
                 if (!value.isEmpty())
                 {
                     // Prepare the path.
@@ -241,27 +257,18 @@ namespace djv
                                 {
                                     filter = true;
                                 }
-                                if (!filter && !(ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && options.extensions.size())
+                                const bool directory = (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+                                const Path fileNamePath(value, fileName);
+                                if (!filter && !directory && !isExtensionMatch(fileNamePath, options))
                                 {
-                                    bool match = false;
-                                    for (const auto& i : options.extensions)
-                                    {
-                                        if (String::match(fileName, '\\' + i + '$'))
-                                        {
-                                            match = true;
-                                            break;
-                                        }
-                                    }
-                                    if (!match)
-                                    {
-                                        filter = true;
-                                    }
+                                    filter = true;
                                 }
 
                                 if (!filter)
                                 {
-                                    Info info(Path(value, fileName));
-                                    sequence(info, options, out);
+                                    sequences.add(
+                                        Info(fileNamePath, directory ? Type::Directory : Type::File, Math::Frame::Sequence(), false),
+                                        out);
                                 }
                             } while (FindNextFileW(hFind, &ffd) != 0);
                         }
@@ -270,6 +277,7 @@ namespace djv
                             //! \bug How should we handle this error?
                         }
                         FindClose(hFind);
+                        sequences.finish(out);
                     }
                     else if (value.isServer())
                     {
@@ -289,6 +297,12 @@ namespace djv
                             out.push_back(i);
                         }
                     }
+
+                    // Get information from the file system.
+                    if (isStatNeeded(options))
+                    {
+                        stat(out);
+                    }
                     
                     // Sort the items.
                     sort(options, out);
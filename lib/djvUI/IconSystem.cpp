@@ -274,18 +274,11 @@ namespace djv
             while (i != p.pendingImageRequests.end())
             {
                 std::shared_ptr<Image::Data> image;
-                bool finished = false;
+                auto& queue = i->read->getVideoQueue();
+                const bool finished = queue.isFinished();
+                if (!queue.isEmpty())
                 {
-                    std::lock_guard<std::mutex> lock(i->read->getMutex());
-                    auto& queue = i->read->getVideoQueue();
-                    if (!queue.isEmpty())
-                    {
-                        image = queue.getFrame().data;
-                    }
-                    else if (queue.isFinished())
-                    {
-                        finished = true;
-                    }
+                    image = queue.getFrame().data;
                 }
                 if (image)
                 {
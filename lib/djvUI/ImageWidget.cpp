@@ -166,13 +166,21 @@ namespace djv
             UI::ImageRotate rotate,
             const glm::vec2& zoom,
             UI::ImageAspectRatio imageAspectRatio)
+        {
+            return getXForm(image->getInfo(), rotate, zoom, imageAspectRatio);
+        }
+
+        glm::mat3x3 ImageWidget::getXForm(
+            const Image::Info& info,
+            UI::ImageRotate rotate,
+            const glm::vec2& zoom,
+            UI::ImageAspectRatio imageAspectRatio)
         {
             glm::mat3x3 m(1.F);
             m = glm::rotate(m, Math::deg2rad(UI::getImageRotate(rotate)));
-            const auto& info = image->getInfo();
             m = glm::scale(m, glm::vec2(
                 zoom.x * UI::getPixelAspectRatio(imageAspectRatio, info.pixelAspectRatio),
-                zoom.y * UI::getAspectRatioScale(imageAspectRatio, image->getAspectRatio())));
+                zoom.y * UI::getAspectRatioScale(imageAspectRatio, info.getAspectRatio())));
             switch (rotate)
             {
             case ImageRotate::_90:
@@ -189,6 +197,39 @@ namespace djv
             return m;
         }
 
+        glm::mat3x3 ImageWidget::getLayerXForm(
+            const std::shared_ptr<Image::Data>& image,
+            const Image::Info& layerInfo,
+            const Image::Mirror& mirror)
+        {
+            Math::BBox2i region = image->getROI();
+            if (region.isValid())
+            {
+                if (mirror.x)
+                {
+                    region = Math::BBox2i(
+                        layerInfo.size.w - region.max.x - 1, region.min.y,
+                        region.w(), region.h());
+                }
+                if (mirror.y)
+                {
+                    region = Math::BBox2i(
+                        region.min.x, layerInfo.size.h - region.max.y - 1,
+                        region.w(), region.h());
+                }
+            }
+            else
+            {
+                region = Math::BBox2i(0, 0, layerInfo.size.w, layerInfo.size.h);
+            }
+            glm::mat3x3 m(1.F);
+            m = glm::translate(m, glm::vec2(region.min.x, region.min.y));
+            m = glm::scale(m, glm::vec2(
+                region.w() / static_cast<float>(image->getWidth()),
+                region.h() / static_cast<float>(image->getHeight())));
+            return m;
+        }
+
         void ImageWidget::_preLayoutEvent(System::Event::PreLayout& event)
         {
             DJV_PRIVATE_PTR();
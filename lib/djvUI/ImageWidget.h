@@ -13,6 +13,8 @@ namespace djv
     namespace Image
     {
         class Data;
+        class Info;
+        class Mirror;
 
     } // namespace Image
 
@@ -73,6 +75,18 @@ namespace djv
                 UI::ImageRotate,
                 const glm::vec2& zoom,
                 UI::ImageAspectRatio);
+            static glm::mat3x3 getXForm(
+                const Image::Info&,
+                UI::ImageRotate,
+                const glm::vec2& zoom,
+                UI::ImageAspectRatio);
+
+            //! Get the transform that scales a proxy image or a region of
+            //! interest to the size of the full resolution layer.
+            static glm::mat3x3 getLayerXForm(
+                const std::shared_ptr<Image::Data>&,
+                const Image::Info& layerInfo,
+                const Image::Mirror&);
 
             ///@}
 
@@ -45,8 +45,17 @@ namespace djv
                 bool wordWrap = true;
 
                 typedef std::pair<Render2D::Font::FontInfo, float> TextCacheKey;
+                struct TextCacheKeyHash
+                {
+                    size_t operator() (const TextCacheKey& value) const noexcept
+                    {
+                        size_t hash = value.first.getHash();
+                        Memory::hashCombine(hash, value.second);
+                        return hash;
+                    }
+                };
                 typedef std::pair<std::vector<Render2D::Font::TextLine>, glm::vec2> TextCacheValue;
-                Memory::Cache<TextCacheKey, TextCacheValue> textCache;
+                Memory::Cache<TextCacheKey, TextCacheValue, TextCacheKeyHash> textCache;
 
                 Math::BBox2f clipRect;
 
@@ -4,6 +4,7 @@
 
 #include <djvUIComponents/FFmpegSettingsWidget.h>
 
+#include <djvUI/ComboBox.h>
 #include <djvUI/FormLayout.h>
 #include <djvUI/GroupBox.h>
 #include <djvUI/IntSlider.h>
@@ -24,6 +25,7 @@ namespace djv
             struct FFmpegWidget::Private
             {
                 std::shared_ptr<UI::Numeric::IntSlider> threadCountSlider;
+                std::shared_ptr<UI::ComboBox> videoOutputComboBox;
                 std::shared_ptr<UI::FormLayout> layout;
             };
 
@@ -37,8 +39,11 @@ namespace djv
                 p.threadCountSlider = UI::Numeric::IntSlider::create(context);
                 p.threadCountSlider->setRange(Math::IntRange(1, 16));
 
+                p.videoOutputComboBox = UI::ComboBox::create(context);
+
                 p.layout = UI::FormLayout::create(context);
                 p.layout->addChild(p.threadCountSlider);
+                p.layout->addChild(p.videoOutputComboBox);
                 addChild(p.layout);
 
                 _widgetUpdate();
@@ -62,6 +67,21 @@ namespace djv
                             }
                         }
                     });
+
+                p.videoOutputComboBox->setCallback(
+                    [contextWeak](int value)
+                    {
+                        if (auto context = contextWeak.lock())
+                        {
+                            auto io = context->getSystemT<AV::IO::IOSystem>();
+                            AV::FFmpeg::Options options;
+                            rapidjson::Document document;
+                            auto& allocator = document.GetAllocator();
+                            fromJSON(io->getOptions(AV::FFmpeg::pluginName, allocator), options);
+                            options.videoOutput = static_cast<AV::FFmpeg::VideoOutput>(value);
+                            io->setOptions(AV::FFmpeg::pluginName, toJSON(options, allocator));
+                        }
+                    });
             }
 
             FFmpegWidget::FFmpegWidget() :
@@ -97,6 +117,8 @@ namespace djv
                 if (event.getData().text)
                 {
                     p.layout->setText(p.threadCountSlider, _getText(DJV_TEXT("settings_io_ffmpeg_thread_count")) + ":");
+                    p.layout->setText(p.videoOutputComboBox, _getText(DJV_TEXT("settings_io_ffmpeg_video_output")) + ":");
+                    _widgetUpdate();
                 }
             }
 
@@ -111,6 +133,15 @@ namespace djv
                     auto& allocator = document.GetAllocator();
                     fromJSON(io->getOptions(AV::FFmpeg::pluginName, allocator), options);
                     p.threadCountSlider->setValue(options.threadCount);
+                    std::vector<std::string> items;
+                    for (auto i : AV::FFmpeg::getVideoOutputEnums())
+                    {
+                        std::stringstream ss;
+                        ss << i;
+                        items.push_back(_getText(ss.str()));
+                    }
+                    p.videoOutputComboBox->setItems(items);
+                    p.videoOutputComboBox->setCurrentItem(static_cast<int>(options.videoOutput));
                 }
             }
 
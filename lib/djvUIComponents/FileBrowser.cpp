@@ -661,6 +661,10 @@ namespace djv
                         widget->_p->viewTypeActionGroup->setChecked(static_cast<int>(value));
                         widget->_p->listViewHeader->setVisible(UI::ViewType::List == value);
                         widget->_p->itemView->setViewType(value);
+
+                        // Only the list view shows the sizes and times.
+                        widget->_p->options.stat = UI::ViewType::List == value;
+                        widget->_optionsUpdate();
                     }
                 });
 
@@ -28,6 +28,8 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <unordered_map>
+
 using namespace djv::Core;
 
 namespace djv
@@ -169,15 +171,104 @@ namespace djv
 
             void ItemView::setItems(const std::vector<System::File::Info>& value)
             {
-                _p->items.clear();
+                DJV_PRIVATE_PTR();
+
+                // When the directory listing only adds information from the
+                // file system, keep the thumbnails and the selection.
                 const size_t size = value.size();
-                _p->items.resize(size);
+                bool statUpdate = size == p.items.size();
+                for (size_t i = 0; statUpdate && i < size; ++i)
+                {
+                    const auto& info = p.items[i].info;
+                    statUpdate =
+                        value[i] == info ||
+                        (value[i].getPath() == info.getPath() &&
+                            value[i].getType() == info.getType() &&
+                            value[i].doesExist() &&
+                            !info.doesExist());
+                }
+                if (statUpdate)
+                {
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        auto& item = p.items[i];
+                        if (value[i] != item.info)
+                        {
+                            item.info = value[i];
+                            item.sizeGlyphsInit = true;
+                            item.sizeGlyphs.clear();
+                            item.timeGlyphsInit = true;
+                            item.timeGlyphs.clear();
+                            p.sizeGlyphsFutures.erase(i);
+                            p.timeGlyphsFutures.erase(i);
+                        }
+                    }
+                    _redraw();
+                    return;
+                }
+
+                // When items are added or removed by the directory watcher,
+                // keep the state of the items that have not changed.
+                std::unordered_map<std::string, size_t> oldIndex;
+                for (size_t i = 0; i < p.items.size(); ++i)
+                {
+                    oldIndex[p.items[i].info.getPath().get()] = i;
+                }
+                std::vector<Item> items(size);
+                bool carryOver = false;
                 for (size_t i = 0; i < size; ++i)
                 {
-                    _p->items[i].info = value[i];
+                    auto& item = items[i];
+                    const auto j = oldIndex.find(value[i].getPath().get());
+                    if (j != oldIndex.end() && value[i] == p.items[j->second].info)
+                    {
+                        // The requests in progress are stored by index, so
+                        // they need to be made again.
+                        const size_t k = j->second;
+                        item = std::move(p.items[k]);
+                        item.nameLinesInit |= p.nameLinesFutures.count(k) > 0;
+                        item.ioInfoInit |= p.ioInfoFutures.count(k) > 0;
+                        item.thumbnailInit |= p.thumbnailFutures.count(k) > 0;
+                        item.nameGlyphsInit |= p.nameGlyphsFutures.count(k) > 0;
+                        item.sizeGlyphsInit |= p.sizeGlyphsFutures.count(k) > 0;
+                        item.timeGlyphsInit |= p.timeGlyphsFutures.count(k) > 0;
+                        carryOver = true;
+                    }
+                    else
+                    {
+                        item.info = value[i];
+                    }
                 }
-                _p->selectionModel->setCount(value.size());
-                _itemsUpdate();
+                if (!carryOver)
+                {
+                    p.items = std::move(items);
+                    p.selectionModel->setCount(value.size());
+                    _itemsUpdate();
+                    return;
+                }
+
+                if (auto context = getContext().lock())
+                {
+                    auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
+                    for (const auto& i : p.ioInfoFutures)
+                    {
+                        thumbnailSystem->cancelInfo(i.second.uid);
+                    }
+                    for (const auto& i : p.thumbnailFutures)
+                    {
+                        thumbnailSystem->cancelImage(i.second.uid);
+                    }
+                }
+                p.nameLinesFutures.clear();
+                p.ioInfoFutures.clear();
+                p.thumbnailFutures.clear();
+                p.thumbnailTimers.clear();
+                p.nameGlyphsFutures.clear();
+                p.sizeGlyphsFutures.clear();
+                p.timeGlyphsFutures.clear();
+                p.items = std::move(items);
+                p.selectionModel->setCount(value.size());
+                _resize();
             }
 
             std::set<size_t> ItemView::getSelected() const
@@ -1097,8 +1188,17 @@ namespace djv
                 return out;
             }
 
-            std::string ItemView::_getTooltip(const System::File::Info& fileInfo) const
+            std::string ItemView::_getTooltip(const System::File::Info& value) const
             {
+                // The directory listing may not have information from the
+                // file system. Sequences are skipped since every frame needs
+                // a stat.
+                System::File::Info fileInfo = value;
+                if (!fileInfo.doesExist() && fileInfo.getType() != System::File::Type::Sequence)
+                {
+                    fileInfo.stat();
+                }
+
                 std::stringstream ss;
                 ss << fileInfo << '\n';
                 ss << '\n';
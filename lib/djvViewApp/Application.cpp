@@ -216,19 +216,12 @@ namespace djv
                     auto i = p.read.begin();
                     while (i != p.read.end())
                     {
-                        bool erase = false;
+                        auto& queue = (*i)->getVideoQueue();
+                        bool erase = queue.isFinished();
+                        if (!queue.isEmpty())
                         {
-                            std::unique_lock<std::mutex> lock((*i)->getMutex());
-                            auto& queue = (*i)->getVideoQueue();
-                            if (!queue.isEmpty())
-                            {
-                                erase = true;
-                                p.icons.push_back(queue.popFrame().data);
-                            }
-                            else if (queue.isFinished())
-                            {
-                                erase = true;
-                            }
+                            erase = true;
+                            p.icons.push_back(queue.popFrame().data);
                         }
                         if (erase)
                         {
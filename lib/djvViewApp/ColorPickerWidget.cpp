@@ -72,6 +72,7 @@ namespace djv
         {
             Image::Color color = Image::Color(0.F, 0.F, 0.F);
             std::shared_ptr<Image::Data> image;
+            std::weak_ptr<ViewWidget> viewWidget;
             glm::vec2 imagePos = glm::vec2(0.F, 0.F);
             float imageZoom = 1.F;
             glm::vec2 pickerPos = glm::vec2(0.F, 0.F);
@@ -352,6 +353,7 @@ namespace djv
                     {
                         if (auto widget = weak.lock())
                         {
+                            widget->_p->viewWidget = value ? value->getViewWidget() : nullptr;
                             if (value)
                             {
                                 widget->_p->imageObserver = Observer::Value<std::shared_ptr<Image::Data> >::create(
@@ -488,12 +490,15 @@ namespace djv
                     const float z = p.data.sampleSize / 2.F;
                     m = glm::translate(m, glm::vec2(z, z));
                     m = glm::translate(m, p.imagePos / p.imageZoom);
+                    const auto viewWidget = p.viewWidget.lock();
+                    const Image::Info layerInfo = viewWidget ? viewWidget->getLayerInfo(p.image) : p.image->getInfo();
                     m *= UI::ImageWidget::getXForm(
-                        p.image,
+                        layerInfo,
                         p.imageData.rotate,
                         glm::vec2(1.F, 1.F),
                         p.imageData.aspectRatio);
                     pixelPos = glm::inverse(glm::translate(m, glm::vec2(-.5F, -.5F))) * pixelPos;
+                    m *= UI::ImageWidget::getLayerXForm(p.image, layerInfo, p.imageData.mirror);
 
                     const size_t sampleSize = std::max(p.data.sampleSize, bufferSizeMin);
                     const Image::Size size(sampleSize, sampleSize);
@@ -471,6 +471,9 @@ namespace djv
                 size_t _videoQueueCount = 0;
                 size_t _audioQueueMax = 0;
                 size_t _audioQueueCount = 0;
+                size_t _audioBufferMax = 0;
+                size_t _audioBufferCount = 0;
+                size_t _audioUnderrunCount = 0;
                 std::map<std::string, std::shared_ptr<UI::Text::Block> > _textBlocks;
                 std::map<std::string, std::shared_ptr<UIComponents::LineGraphWidget> > _lineGraphs;
                 std::shared_ptr<UI::VerticalLayout> _layout;
@@ -481,6 +484,9 @@ namespace djv
                 std::shared_ptr<Observer::Value<size_t> > _videoQueueCountObserver;
                 std::shared_ptr<Observer::Value<size_t> > _audioQueueMaxObserver;
                 std::shared_ptr<Observer::Value<size_t> > _audioQueueCountObserver;
+                std::shared_ptr<Observer::Value<size_t> > _audioBufferMaxObserver;
+                std::shared_ptr<Observer::Value<size_t> > _audioBufferCountObserver;
+                std::shared_ptr<Observer::Value<size_t> > _audioUnderrunCountObserver;
             };
 
             void MediaDebugWidget::_init(const std::shared_ptr<System::Context>& context)
@@ -499,6 +505,10 @@ namespace djv
                 _lineGraphs["AudioQueue"] = UIComponents::LineGraphWidget::create(context);
                 _lineGraphs["AudioQueue"]->setPrecision(0);
 
+                _textBlocks["AudioBuffer"] = UI::Text::Block::create(context);
+                _lineGraphs["AudioBuffer"] = UIComponents::LineGraphWidget::create(context);
+                _lineGraphs["AudioBuffer"]->setPrecision(0);
+
                 for (auto& i : _textBlocks)
                 {
                     i.second->setFontFamily(Render2D::Font::familyMono);
@@ -511,6 +521,8 @@ namespace djv
                 _layout->addChild(_lineGraphs["VideoQueue"]);
                 _layout->addChild(_textBlocks["AudioQueue"]);
                 _layout->addChild(_lineGraphs["AudioQueue"]);
+                _layout->addChild(_textBlocks["AudioBuffer"]);
+                _layout->addChild(_lineGraphs["AudioBuffer"]);
                 addChild(_layout);
 
                 auto weak = std::weak_ptr<MediaDebugWidget>(std::dynamic_pointer_cast<MediaDebugWidget>(shared_from_this()));
@@ -591,6 +603,37 @@ namespace djv
                                         widget->_widgetUpdate();
                                     }
                                 });
+                                widget->_audioBufferMaxObserver = Observer::Value<size_t>::create(
+                                    value->observeAudioBufferMax(),
+                                    [weak](size_t value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_audioBufferMax = value;
+                                        widget->_widgetUpdate();
+                                    }
+                                });
+                                widget->_audioBufferCountObserver = Observer::Value<size_t>::create(
+                                    value->observeAudioBufferCount(),
+                                    [weak](size_t value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_audioBufferCount = value;
+                                        widget->_lineGraphs["AudioBuffer"]->addSample(value);
+                                        widget->_widgetUpdate();
+                                    }
+                                });
+                                widget->_audioUnderrunCountObserver = Observer::Value<size_t>::create(
+                                    value->observeAudioUnderrunCount(),
+                                    [weak](size_t value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_audioUnderrunCount = value;
+                                        widget->_widgetUpdate();
+                                    }
+                                });
                             }
                             else
                             {
@@ -600,12 +643,18 @@ namespace djv
                                 widget->_videoQueueCount = 0;
                                 widget->_audioQueueMax = 0;
                                 widget->_audioQueueCount = 0;
+                                widget->_audioBufferMax = 0;
+                                widget->_audioBufferCount = 0;
+                                widget->_audioUnderrunCount = 0;
                                 widget->_sequenceObserver.reset();
                                 widget->_currentFrameObserver.reset();
                                 widget->_videoQueueMaxObserver.reset();
                                 widget->_videoQueueCountObserver.reset();
                                 widget->_audioQueueMaxObserver.reset();
                                 widget->_audioQueueCountObserver.reset();
+                                widget->_audioBufferMaxObserver.reset();
+                                widget->_audioBufferCountObserver.reset();
+                                widget->_audioUnderrunCountObserver.reset();
                                 widget->_widgetUpdate();
                             }
                         }
@@ -659,6 +708,14 @@ namespace djv
                     ss << _currentFrame << " / " << _sequence.getFrameCount();
                     _textBlocks["CurrentFrame"]->setText(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_media_audio_buffer")) << ": ";
+                    ss << _audioBufferCount << " / " << _audioBufferMax << ", ";
+                    ss << _getText(DJV_TEXT("debug_media_audio_underruns")) << ": ";
+                    ss << _audioUnderrunCount;
+                    _textBlocks["AudioBuffer"]->setText(ss.str());
+                }
             }
 
         } // namespace
@@ -38,12 +38,22 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+
 using namespace djv::Core;
 
 namespace djv
 {
     namespace ViewApp
     {
+        bool CacheOccupancy::operator == (const CacheOccupancy& other) const
+        {
+            return !media.owner_before(other.media) &&
+                !other.media.owner_before(media) &&
+                byteCount == other.byteCount &&
+                maxByteCount == other.maxByteCount;
+        }
+
         struct FileSystem::Private
         {
             Private(FileSystem& p) :
@@ -58,6 +68,8 @@ namespace djv
             std::shared_ptr<Observer::ListSubject<std::shared_ptr<Media> > > media;
             std::shared_ptr<Observer::ValueSubject<std::shared_ptr<Media> > > currentMedia;
             std::shared_ptr<Observer::ValueSubject<float> > cachePercentage;
+            std::shared_ptr<Observer::ListSubject<CacheOccupancy> > cacheOccupancy;
+            std::vector<std::weak_ptr<Media> > recentMedia;
             std::map<std::string, std::shared_ptr<UI::Action> > actions;
             std::shared_ptr<UI::Menu> menu;
             std::shared_ptr<UIComponents::FileBrowser::Dialog> fileBrowserDialog;
@@ -93,6 +105,7 @@ namespace djv
             p.media = Observer::ListSubject<std::shared_ptr<Media> >::create();
             p.currentMedia = Observer::ValueSubject<std::shared_ptr<Media> >::create();
             p.cachePercentage = Observer::ValueSubject<float>::create();
+            p.cacheOccupancy = Observer::ListSubject<CacheOccupancy>::create();
 
             p.actions["Open"] = UI::Action::create();
             p.actions["Open"]->setIcon("djvIconFileOpen");
@@ -353,20 +366,32 @@ namespace djv
                 {
                     if (auto system = weak.lock())
                     {
-                        size_t cacheMaxByteCount  = 0;
+                        // The size of the frames may not be known until they
+                        // are read, so re-balance the cache periodically.
+                        system->_cacheUpdate();
+
+                        const size_t cacheMaxByteCount = system->_p->settings->observeCacheEnabled()->get() ?
+                            (system->_p->settings->observeCacheSize()->get() * Memory::gigabyte) :
+                            0;
                         size_t cacheByteCount = 0;
+                        std::vector<CacheOccupancy> occupancy;
                         for (const auto& i : system->_p->media->get())
                         {
                             if (i->hasCache())
                             {
-                                cacheMaxByteCount  += i->getCacheMaxByteCount();
-                                cacheByteCount += i->getCacheByteCount();
+                                CacheOccupancy item;
+                                item.media = i;
+                                item.byteCount = i->getCacheByteCount();
+                                item.maxByteCount = i->getCacheMaxByteCount();
+                                cacheByteCount += item.byteCount;
+                                occupancy.push_back(item);
                             }
                         }
                         const float percentage = cacheMaxByteCount ?
                             (cacheByteCount / static_cast<float>(cacheMaxByteCount) * 100.F) :
                             0.F;
                         system->_p->cachePercentage->setIfChanged(percentage);
+                        system->_p->cacheOccupancy->setIfChanged(occupancy);
                     }
                 });
 
@@ -493,6 +518,7 @@ namespace djv
                 {
                     media->setPlayEveryFrame(playbackSettings->observePlayEveryFrame()->get());
                     media->setPlaybackMode(playbackSettings->observePlaybackMode()->get());
+                    media->setProxyAuto(playbackSettings->observeProxyAuto()->get());
                     if (playbackSettings->observeStartPlayback()->get())
                     {
                         media->setPlayback(Playback::Forward);
@@ -575,7 +601,25 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.currentMedia->setIfChanged(media))
             {
+                auto i = p.recentMedia.begin();
+                while (i != p.recentMedia.end())
+                {
+                    auto recent = i->lock();
+                    if (!recent || recent == media)
+                    {
+                        i = p.recentMedia.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                if (media)
+                {
+                    p.recentMedia.insert(p.recentMedia.begin(), media);
+                }
                 _actionsUpdate();
+                _cacheUpdate();
             }
         }
 
@@ -584,6 +628,11 @@ namespace djv
             return _p->cachePercentage;
         }
 
+        std::shared_ptr<Observer::IListSubject<CacheOccupancy> > FileSystem::observeCacheOccupancy() const
+        {
+            return _p->cacheOccupancy;
+        }
+
         int FileSystem::getSortKey() const
         {
             return 1;
@@ -664,22 +713,48 @@ namespace djv
         void FileSystem::_cacheUpdate()
         {
             DJV_PRIVATE_PTR();
-            size_t cacheCount = 0;
+
+            // The cache budget is shared by all of the media. The current
+            // media is given as much of the budget as it can use, then the
+            // recently viewed media, then the remaining media in the order
+            // they were opened.
             const auto& media = p.media->get();
+            std::vector<std::shared_ptr<Media> > order;
+            if (auto current = p.currentMedia->get())
+            {
+                order.push_back(current);
+            }
+            for (const auto& i : p.recentMedia)
+            {
+                auto recent = i.lock();
+                if (recent && p.media->contains(recent))
+                {
+                    if (std::find(order.begin(), order.end(), recent) == order.end())
+                    {
+                        order.push_back(recent);
+                    }
+                }
+            }
             for (const auto& i : media)
             {
-                if (i->hasCache())
+                if (std::find(order.begin(), order.end(), i) == order.end())
                 {
-                    ++cacheCount;
+                    order.push_back(i);
                 }
             }
+
             const bool cacheEnabled = p.settings->observeCacheEnabled()->get();
-            const size_t cacheMaxByteCount = p.settings->observeCacheSize()->get() * Memory::gigabyte;
-            const size_t mediaCacheSizeByteCount = cacheCount > 0 ? (cacheMaxByteCount / cacheCount) : 0;
-            for (const auto& i : media)
+            size_t cacheByteCount = p.settings->observeCacheSize()->get() * Memory::gigabyte;
+            for (const auto& i : order)
             {
+                size_t byteCount = 0;
+                if (cacheEnabled && i->hasCache())
+                {
+                    byteCount = std::min(i->getCacheRequiredByteCount(), cacheByteCount);
+                    cacheByteCount -= byteCount;
+                }
                 i->setCacheEnabled(cacheEnabled);
-                i->setCacheMaxByteCount(mediaCacheSizeByteCount);
+                i->setCacheMaxByteCount(byteCount);
             }
         }
 
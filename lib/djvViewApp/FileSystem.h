@@ -39,6 +39,17 @@ namespace djv
             std::shared_ptr<std::string>        frame;
         };
 
+        //! Cache occupancy for a media. The media is not kept open by the
+        //! occupancy.
+        struct CacheOccupancy
+        {
+            std::weak_ptr<Media> media;
+            size_t               byteCount    = 0;
+            size_t               maxByteCount = 0;
+
+            bool operator == (const CacheOccupancy&) const;
+        };
+
         //! File system.
         class FileSystem : public IViewAppSystem
         {
@@ -75,6 +86,9 @@ namespace djv
 
             std::shared_ptr<Core::Observer::IValueSubject<float> > observeCachePercentage() const;
 
+            //! Observe how much of the cache is used by each media.
+            std::shared_ptr<Core::Observer::IListSubject<CacheOccupancy> > observeCacheOccupancy() const;
+
             ///@}
 
             int getSortKey() const override;
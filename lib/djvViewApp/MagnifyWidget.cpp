@@ -63,6 +63,7 @@ namespace djv
 
             private:
                 std::shared_ptr<Image::Data> _image;
+                std::weak_ptr<ViewWidget> _viewWidget;
                 glm::vec2 _imagePos = glm::vec2(0.F, 0.F);
                 float _imageZoom = 0.F;
                 ImageData _imageData;
@@ -96,6 +97,7 @@ namespace djv
                         {
                             if (auto widget = weak.lock())
                             {
+                                widget->_viewWidget = value ? value->getViewWidget() : nullptr;
                                 if (value)
                                 {
                                     widget->_imageObserver = Observer::Value<std::shared_ptr<Image::Data> >::create(
@@ -272,7 +274,10 @@ namespace djv
                     glm::mat3x3 m(1.F);
                     m = glm::translate(m, glm::vec2(g.w() / 2.F, g.h() / 2.F) - glm::vec2(_magnifyPos.x * magnify, _magnifyPos.y * magnify));
                     m = glm::translate(m, g.min + glm::vec2(_imagePos.x * magnify, _imagePos.y * magnify));
-                    m *= UI::ImageWidget::getXForm(_image, _imageData.rotate, glm::vec2(_imageZoom * magnify, _imageZoom * magnify), _imageData.aspectRatio);
+                    const auto viewWidget = _viewWidget.lock();
+                    const Image::Info layerInfo = viewWidget ? viewWidget->getLayerInfo(_image) : _image->getInfo();
+                    m *= UI::ImageWidget::getXForm(layerInfo, _imageData.rotate, glm::vec2(_imageZoom * magnify, _imageZoom * magnify), _imageData.aspectRatio);
+                    m *= UI::ImageWidget::getLayerXForm(_image, layerInfo, _imageData.mirror);
                     render->pushTransform(m);
                     Render2D::ImageOptions options;
                     options.channelsDisplay = _imageData.channelsDisplay;
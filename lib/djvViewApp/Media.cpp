@@ -13,6 +13,8 @@
 
 #include <djvAudio/AudioSystem.h>
 #include <djvAudio/Data.h>
+#include <djvAudio/Resample.h>
+#include <djvAudio/RingBuffer.h>
 
 #include <djvSystem/Context.h>
 #include <djvSystem/LogSystem.h>
@@ -25,6 +27,12 @@
 #include <djvCore/String.h>
 #include <djvCore/UndoStack.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 using namespace djv::Core;
 
 namespace djv
@@ -34,9 +42,38 @@ namespace djv
         namespace
         {
             //! \todo Should this be configurable?
-            const size_t audioBufferFrameCount = 256;
-            const size_t videoQueueSize        = 10;
-            const size_t realSpeedFrameCount   = 30;
+            const size_t audioBufferFrameCount  = 256;
+            const size_t audioRingBufferDivisor = 4;
+            const size_t videoQueueSize         = 10;
+            const size_t realSpeedFrameCount    = 30;
+            const size_t proxyScaleMax          = 8;
+            const std::chrono::milliseconds audioFeederTimeout(5);
+
+            //! Get the audio format for the output device. The sample rate
+            //! and channel count of the media are used when the device
+            //! supports them, otherwise the audio is converted to the
+            //! preferred sample rate and the output channels of the device.
+            Audio::Info getAudioDeviceInfo(const Audio::Info& info, const RtAudio::DeviceInfo& rtInfo)
+            {
+                Audio::Info out = info;
+                if (rtInfo.outputChannels > 0)
+                {
+                    out.channelCount = 1 == info.channelCount && rtInfo.outputChannels >= 2 ?
+                        2 :
+                        static_cast<uint8_t>(std::min(static_cast<unsigned int>(info.channelCount), rtInfo.outputChannels));
+                }
+                const auto& sampleRates = rtInfo.sampleRates;
+                if (!sampleRates.empty() &&
+                    std::find(sampleRates.begin(), sampleRates.end(), info.sampleRate) == sampleRates.end())
+                {
+                    out.sampleRate = rtInfo.preferredSampleRate ? rtInfo.preferredSampleRate : sampleRates.back();
+                }
+                if (out.channelCount != info.channelCount || out.sampleRate != info.sampleRate)
+                {
+                    out.type = Audio::Type::F32;
+                }
+                return out;
+            }
             
         } // namespace
 
@@ -48,6 +85,7 @@ namespace djv
             System::File::Info fileInfo;
             std::shared_ptr<Observer::ValueSubject<AV::IO::Info> > info;
             Audio::Info audioInfo;
+            Audio::Info audioDeviceInfo;
             std::shared_ptr<Observer::ValueSubject<bool> > reload;
             std::shared_ptr<Observer::ValueSubject<std::pair<std::vector<Image::Info>, int> > > layers;
             std::shared_ptr<Observer::ValueSubject<Math::IntRational> > speed;
@@ -71,6 +109,9 @@ namespace djv
             std::shared_ptr<Observer::ValueSubject<Math::Frame::Sequence> > cachedFrames;
             bool cacheEnabled = false;
             size_t cacheMaxByteCount = 0;
+            bool proxyAuto = false;
+            size_t proxyScale = 1;
+            Math::BBox2i roi;
             std::shared_ptr<Observer::ListSubject<std::shared_ptr<AnnotatePrimitive> > > annotations;
             std::shared_ptr<Command::UndoStack> undoStack;
 
@@ -78,13 +119,37 @@ namespace djv
             std::shared_ptr<Observer::ValueSubject<size_t> > videoQueueCount;
             std::shared_ptr<Observer::ValueSubject<size_t> > audioQueueMax;
             std::shared_ptr<Observer::ValueSubject<size_t> > audioQueueCount;
+            std::shared_ptr<Observer::ValueSubject<size_t> > audioBufferMax;
+            std::shared_ptr<Observer::ValueSubject<size_t> > audioBufferCount;
+            std::shared_ptr<Observer::ValueSubject<size_t> > audioUnderrunCount;
             std::shared_ptr<AV::IO::IRead> read;
 
             AV::IO::Direction ioDirection = AV::IO::Direction::Forward;
             std::unique_ptr<RtAudio> rtAudio;
-            std::shared_ptr<Audio::Data> audioData;
-            size_t audioDataSamplesOffset = 0;
-            size_t audioDataSamplesCount = 0;
+
+            // The audio callback only reads from the ring buffer, which is
+            // filled from the read queue by the feeder thread. The feeder
+            // mutex is never locked by the audio callback. The feeder is
+            // enabled while the audio stream is running; the flag is only
+            // changed on the main thread. When the device format differs
+            // from the media the feeder also converts the audio.
+            std::shared_ptr<Audio::Resampler> audioResampler;
+            std::vector<uint8_t> audioResampled;
+            std::shared_ptr<Audio::RingBuffer> audioBuffer;
+            std::atomic<float> audioVolume;
+            std::atomic<size_t> audioSamplesCount;
+            std::atomic<bool> audioEnd;
+            std::thread audioFeederThread;
+            std::mutex audioFeederMutex;
+            std::condition_variable audioFeederCV;
+            bool audioFeederRunning = true;
+            bool audioFeederEnabled = false;
+            std::shared_ptr<Audio::Data> audioFeederData;
+            size_t audioFeederOffset = 0;
+            const uint8_t* audioFeederOutput = nullptr;
+            size_t audioFeederOutputCount = 0;
+            size_t audioFeederOutputOffset = 0;
+
             Math::Frame::Index frameOffset = 0;
             Time::Duration currentTime = Time::Duration::zero();
             std::chrono::steady_clock::time_point playbackTime;
@@ -135,6 +200,9 @@ namespace djv
             p.audioQueueMax = Observer::ValueSubject<size_t>::create();
             p.videoQueueCount = Observer::ValueSubject<size_t>::create();
             p.audioQueueCount = Observer::ValueSubject<size_t>::create();
+            p.audioBufferMax = Observer::ValueSubject<size_t>::create();
+            p.audioBufferCount = Observer::ValueSubject<size_t>::create();
+            p.audioUnderrunCount = Observer::ValueSubject<size_t>::create();
 
             p.playbackTimer = System::Timer::create(context);
             p.playbackTimer->setRepeating(true);
@@ -150,6 +218,7 @@ namespace djv
                 if (auto media = weak.lock())
                 {
                     media->_p->realSpeedSubject->setIfChanged(media->_p->realSpeed);
+                    media->_proxyUpdate();
                 }
             });
             p.cacheTimer = System::Timer::create(context);
@@ -173,6 +242,21 @@ namespace djv
                 logSystem->log("djv::ViewApp::Media", String::join(messages, ' '), System::LogLevel::Error);
             }
 
+            p.audioFeederThread = std::thread(
+                [this]
+                {
+                    DJV_PRIVATE_PTR();
+                    std::unique_lock<std::mutex> lock(p.audioFeederMutex);
+                    while (p.audioFeederRunning)
+                    {
+                        if (p.audioFeederEnabled)
+                        {
+                            _audioFeed();
+                        }
+                        p.audioFeederCV.wait_for(lock, audioFeederTimeout);
+                    }
+                });
+
             _open();
 
             p.queueTimer->start(
@@ -188,12 +272,26 @@ namespace djv
 
         Media::Media() :
             _p(new Private)
-        {}
+        {
+            DJV_PRIVATE_PTR();
+            p.audioVolume = 1.F;
+            p.audioSamplesCount = 0;
+            p.audioEnd = false;
+        }
 
         Media::~Media()
         {
             DJV_PRIVATE_PTR();
             p.rtAudio.reset();
+            {
+                std::unique_lock<std::mutex> lock(p.audioFeederMutex);
+                p.audioFeederRunning = false;
+            }
+            p.audioFeederCV.notify_one();
+            if (p.audioFeederThread.joinable())
+            {
+                p.audioFeederThread.join();
+            }
         }
 
         std::shared_ptr<Media> Media::create(
@@ -240,7 +338,15 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.layers->setIfChanged(std::make_pair(p.info->get().video, value)))
             {
-                _open();
+                if (p.read)
+                {
+                    p.read->setLayer(static_cast<size_t>(std::max(value, 0)));
+                    _seek(p.currentFrame->get());
+                }
+                else
+                {
+                    _open();
+                }
             }
         }
 
@@ -605,12 +711,16 @@ namespace djv
 
         void Media::setVolume(float value)
         {
-            _p->volume->setIfChanged(Math::clamp(value, 0.F, 1.F));
+            DJV_PRIVATE_PTR();
+            p.volume->setIfChanged(Math::clamp(value, 0.F, 1.F));
+            p.audioVolume = !p.mute->get() ? p.volume->get() : 0.F;
         }
 
         void Media::setMute(bool value)
         {
-            _p->mute->setIfChanged(value);
+            DJV_PRIVATE_PTR();
+            p.mute->setIfChanged(value);
+            p.audioVolume = !p.mute->get() ? p.volume->get() : 0.F;
         }
 
         std::shared_ptr<Observer::IValueSubject<size_t> > Media::observeThreadCount() const
@@ -630,6 +740,46 @@ namespace djv
             }
         }
 
+        void Media::setProxyAuto(bool value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value == p.proxyAuto)
+                return;
+            p.proxyAuto = value;
+            if (!p.proxyAuto && p.proxyScale > 1)
+            {
+                p.proxyScale = 1;
+                if (p.read)
+                {
+                    p.read->setProxyScale(p.proxyScale);
+                    _seek(p.currentFrame->get());
+                }
+            }
+        }
+
+        void Media::setROI(const Math::BBox2i& value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value == p.roi)
+                return;
+            p.roi = value;
+            if (p.read)
+            {
+                p.read->setROI(p.roi);
+
+                // When playback is stopped read the current frame again if it
+                // doesn't cover the new region. During playback the following
+                // frames are read with the new region.
+                const auto& layers = p.layers->get();
+                if (Playback::Stop == p.playback->get() &&
+                    layers.second >= 0 && layers.second < static_cast<int>(layers.first.size()) &&
+                    !AV::IO::coversROI(p.currentImage->get(), AV::IO::getROITiles(p.roi, layers.first[layers.second].size)))
+                {
+                    _seek(p.currentFrame->get());
+                }
+            }
+        }
+
         bool Media::hasCache() const
         {
             DJV_PRIVATE_PTR();
@@ -647,6 +797,34 @@ namespace djv
             return p.read ? p.read->getCacheByteCount() : 0;
         }
 
+        size_t Media::getCacheRequiredByteCount() const
+        {
+            DJV_PRIVATE_PTR();
+            size_t out = 0;
+            if (p.read && p.read->hasCache())
+            {
+                // Use the size of the frames that have already been cached,
+                // otherwise estimate it from the image information.
+                size_t frameByteCount = 0;
+                const size_t cachedFrameCount = p.read->getCachedFrames().getFrameCount();
+                if (cachedFrameCount > 0)
+                {
+                    frameByteCount = p.read->getCacheByteCount() / cachedFrameCount;
+                }
+                else
+                {
+                    const auto& layers = p.layers->get();
+                    if (layers.second >= 0 && layers.second < static_cast<int>(layers.first.size()))
+                    {
+                        frameByteCount = layers.first[layers.second].getDataByteCount();
+                    }
+                }
+                const auto range = p.inOutPoints->get().getRange(p.sequence->get().getFrameCount());
+                out = static_cast<size_t>(range.getMax() - range.getMin() + 1) * frameByteCount;
+            }
+            return out;
+        }
+
         std::shared_ptr<Core::Observer::IValueSubject<Math::Frame::Sequence> > Media::observeCacheSequence() const
         {
             return _p->cacheSequence;
@@ -746,6 +924,21 @@ namespace djv
             return _p->audioQueueCount;
         }
 
+        std::shared_ptr<Observer::IValueSubject<size_t> > Media::observeAudioBufferMax() const
+        {
+            return _p->audioBufferMax;
+        }
+
+        std::shared_ptr<Observer::IValueSubject<size_t> > Media::observeAudioBufferCount() const
+        {
+            return _p->audioBufferCount;
+        }
+
+        std::shared_ptr<Observer::IValueSubject<size_t> > Media::observeAudioUnderrunCount() const
+        {
+            return _p->audioUnderrunCount;
+        }
+
         bool Media::_hasAudio() const
         {
             DJV_PRIVATE_PTR();
@@ -775,16 +968,21 @@ namespace djv
                 try
                 {
                     p.valid = false;
+                    _stopAudioStream();
+                    p.audioBuffer.reset();
+                    p.audioResampler.reset();
 
                     AV::IO::ReadOptions options;
                     options.layer = p.layers->get().second;
                     options.videoQueueSize = videoQueueSize;
+                    p.proxyScale = 1;
                     auto io = context->getSystemT<AV::IO::IOSystem>();
                     p.read = io->read(p.fileInfo, options);
                     p.read->setThreadCount(p.threadCount->get());
                     p.read->setLoop(true);
                     p.read->setCacheEnabled(p.cacheEnabled);
                     p.read->setCacheMaxByteCount(p.cacheMaxByteCount);
+                    p.read->setROI(p.roi);
 
                     const auto info = p.read->getInfo().get();
                     p.info->setIfChanged(info);
@@ -824,15 +1022,37 @@ namespace djv
                         RtAudio::StreamParameters rtParameters;
                         auto audioSystem = context->getSystemT<Audio::AudioSystem>();
                         rtParameters.deviceId = audioSystem->getDefaultOutputDevice();
-                        rtParameters.nChannels = p.audioInfo.channelCount;
                         unsigned int rtBufferFrames = audioBufferFrameCount;
                         try
                         {
+                            p.audioDeviceInfo = getAudioDeviceInfo(
+                                p.audioInfo,
+                                p.rtAudio->getDeviceInfo(rtParameters.deviceId));
+                            if (p.audioDeviceInfo.channelCount != p.audioInfo.channelCount ||
+                                p.audioDeviceInfo.sampleRate != p.audioInfo.sampleRate)
+                            {
+                                p.audioResampler = Audio::Resampler::create(p.audioInfo, p.audioDeviceInfo);
+                                p.audioResampled.resize(
+                                    p.audioResampler->getOutputSampleCountMax(p.audioResampler->getBlockSize()) *
+                                    p.audioDeviceInfo.getByteCount());
+                                std::stringstream ss;
+                                ss << "Audio conversion: " <<
+                                    static_cast<int>(p.audioInfo.channelCount) << " channels, " <<
+                                    p.audioInfo.sampleRate << " Hz -> " <<
+                                    static_cast<int>(p.audioDeviceInfo.channelCount) << " channels, " <<
+                                    p.audioDeviceInfo.sampleRate << " Hz";
+                                auto logSystem = context->getSystemT<System::LogSystem>();
+                                logSystem->log("djv::ViewApp::Media", ss.str());
+                            }
+                            p.audioBuffer = Audio::RingBuffer::create(
+                                p.audioDeviceInfo,
+                                std::max(p.audioDeviceInfo.sampleRate / audioRingBufferDivisor, audioBufferFrameCount * 4));
+                            rtParameters.nChannels = p.audioDeviceInfo.channelCount;
                             p.rtAudio->openStream(
                                 &rtParameters,
                                 nullptr,
-                                Audio::toRtAudio(p.audioInfo.type),
-                                p.audioInfo.sampleRate,
+                                Audio::toRtAudio(p.audioDeviceInfo.type),
+                                p.audioDeviceInfo.sampleRate,
                                 &rtBufferFrames,
                                 _rtAudioCallback,
                                 this,
@@ -878,31 +1098,18 @@ namespace djv
                             {
                                 if (media->_p->read)
                                 {
-                                    bool valid = false;
-                                    size_t videoQueueMax   = 0;
-                                    size_t videoQueueCount = 0;
-                                    size_t audioQueueMax   = 0;
-                                    size_t audioQueueCount = 0;
-                                    {
-                                        std::unique_lock<std::mutex> lock(media->_p->read->getMutex());
-                                        if (lock.owns_lock())
-                                        {
-                                            valid = true;
-                                            const auto& videoQueue = media->_p->read->getVideoQueue();
-                                            const auto& audioQueue = media->_p->read->getAudioQueue();
-                                            videoQueueMax   = videoQueue.getMax();
-                                            videoQueueCount = videoQueue.getCount();
-                                            audioQueueMax   = audioQueue.getMax();
-                                            audioQueueCount = audioQueue.getCount();
-                                        }
-                                    }
-                                    if (valid)
-                                    {
-                                        media->_p->videoQueueMax->setAlways(videoQueueMax);
-                                        media->_p->videoQueueCount->setAlways(videoQueueCount);
-                                        media->_p->audioQueueMax->setAlways(audioQueueMax);
-                                        media->_p->audioQueueCount->setAlways(audioQueueCount);
-                                    }
+                                    const auto& videoQueue = media->_p->read->getVideoQueue();
+                                    const auto& audioQueue = media->_p->read->getAudioQueue();
+                                    media->_p->videoQueueMax->setAlways(videoQueue.getMax());
+                                    media->_p->videoQueueCount->setAlways(videoQueue.getCount());
+                                    media->_p->audioQueueMax->setAlways(audioQueue.getMax());
+                                    media->_p->audioQueueCount->setAlways(audioQueue.getCount());
+                                }
+                                if (const auto& audioBuffer = media->_p->audioBuffer)
+                                {
+                                    media->_p->audioBufferMax->setAlways(audioBuffer->getSampleCount());
+                                    media->_p->audioBufferCount->setAlways(audioBuffer->getReadAvailable());
+                                    media->_p->audioUnderrunCount->setIfChanged(audioBuffer->getStats().underrunCount);
                                 }
                             }
                         });
@@ -1006,19 +1213,17 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (auto context = p.context.lock())
             {
+                _stopAudioStream();
                 if (p.read)
                 {
                     p.read->seek(value, p.ioDirection);
                 }
-                p.audioData.reset();
-                p.audioDataSamplesOffset = 0;
-                p.audioDataSamplesCount = 0;
+                _resetAudio();
                 p.frameOffset = p.currentFrame->get();
                 p.currentTime = Time::Duration::zero();
                 p.realSpeedTime = std::chrono::steady_clock::now();
                 p.realSpeedFrameCount = 0;
                 p.playEveryFrameTime = Time::Duration::zero();
-                _stopAudioStream();
             }
         }
 
@@ -1034,6 +1239,11 @@ namespace djv
                     if (p.read)
                     {
                         p.read->setPlayback(false);
+                        if (p.proxyScale > 1)
+                        {
+                            p.proxyScale = 1;
+                            p.read->setProxyScale(p.proxyScale);
+                        }
                     }
                     _stopAudioStream();
                     p.playbackTimer->stop();
@@ -1049,9 +1259,6 @@ namespace djv
                     }
                     p.ioDirection = forward ? AV::IO::Direction::Forward : AV::IO::Direction::Reverse;
                     _seek(p.currentFrame->get());
-                    p.audioData.reset();
-                    p.audioDataSamplesOffset = 0;
-                    p.audioDataSamplesCount = 0;
                     p.frameOffset = p.currentFrame->get();
                     p.currentTime = Time::Duration::zero();
                     p.playbackTime = std::chrono::steady_clock::now();
@@ -1096,12 +1303,13 @@ namespace djv
                 const auto& speed = p.speed->get();
                 if (_hasAudioSyncPlayback())
                 {
-                    if (p.audioDataSamplesCount)
+                    const size_t audioSamplesCount = p.audioSamplesCount;
+                    if (audioSamplesCount)
                     {
                         Math::Frame::Index frame = p.frameOffset +
                             AV::Time::scale(
-                                p.audioDataSamplesCount,
-                                Math::IntRational(1, static_cast<int>(p.audioInfo.sampleRate)),
+                                audioSamplesCount,
+                                Math::IntRational(1, static_cast<int>(p.audioDeviceInfo.sampleRate)),
                                 speed.swap());
                         _setCurrentFrame(frame);
                     }
@@ -1127,11 +1335,40 @@ namespace djv
             }
         }
 
+        void Media::_proxyUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            if (p.proxyAuto &&
+                p.read &&
+                p.read->hasProxies() &&
+                p.playback->get() != Playback::Stop &&
+                p.proxyScale < proxyScaleMax)
+            {
+                // The reader decodes frames in parallel, so compare the decode
+                // time divided by the threads in use against the frame time.
+                const float speed = p.speed->get().toFloat();
+                const float frameTime = speed > 0.F ? (1.F / speed) : 0.F;
+                const size_t threadCount = std::max(p.threadCount->get() / 2, static_cast<size_t>(1));
+                const float decodeTime = p.read->getDecodeTime() / threadCount;
+                if (frameTime > 0.F && decodeTime > frameTime)
+                {
+                    p.proxyScale *= 2;
+                    p.read->setProxyScale(p.proxyScale);
+                    _seek(p.currentFrame->get());
+                }
+            }
+        }
+
         void Media::_startAudioStream()
         {
             DJV_PRIVATE_PTR();
             if (auto context = p.context.lock())
             {
+                {
+                    std::unique_lock<std::mutex> lock(p.audioFeederMutex);
+                    p.audioFeederEnabled = true;
+                }
+                p.audioFeederCV.notify_one();
                 try
                 {
                     p.rtAudio->startStream();
@@ -1155,6 +1392,10 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (auto context = p.context.lock())
             {
+                {
+                    std::unique_lock<std::mutex> lock(p.audioFeederMutex);
+                    p.audioFeederEnabled = false;
+                }
                 if (_hasAudio() && p.rtAudio->isStreamRunning())
                 {
                     try
@@ -1191,37 +1432,34 @@ namespace djv
                 const Math::Frame::Index currentFrame = p.currentFrame->get();
                 AV::IO::VideoFrame frame;
                 bool gotFrame = false;
+                auto& videoQueue = p.read->getVideoQueue();
+                if (p.playEveryFrame->get())
                 {
-                    std::lock_guard<std::mutex> lock(p.read->getMutex());
-                    auto& queue = p.read->getVideoQueue();
-                    if (p.playEveryFrame->get())
-                    {
-                        if (playback != Playback::Stop && !queue.isEmpty() && playEveryFrameAdvance)
-                        {
-                            frame = queue.popFrame();
-                            gotFrame = true;
-                            p.realSpeedFrameCount = p.realSpeedFrameCount + 1;
-                            p.playEveryFrameTime = p.playEveryFrameTime - std::chrono::duration_cast<Time::Duration>(frameTime);
-                        }
-                    }
-                    else
+                    if (playback != Playback::Stop && !videoQueue.isEmpty() && playEveryFrameAdvance)
                     {
-                        while (!queue.isEmpty() &&
-                            (AV::IO::Direction::Forward == p.ioDirection ?
-                                (queue.getFrame().frame < currentFrame) :
-                                (queue.getFrame().frame > currentFrame)))
-                        {
-                            frame = queue.popFrame();
-                            gotFrame = true;
-                            p.realSpeedFrameCount = p.realSpeedFrameCount + 1;
-                        }
+                        frame = videoQueue.popFrame();
+                        gotFrame = true;
+                        p.realSpeedFrameCount = p.realSpeedFrameCount + 1;
+                        p.playEveryFrameTime = p.playEveryFrameTime - std::chrono::duration_cast<Time::Duration>(frameTime);
                     }
-                    if (!gotFrame && !queue.isEmpty())
+                }
+                else
+                {
+                    while (!videoQueue.isEmpty() &&
+                        (AV::IO::Direction::Forward == p.ioDirection ?
+                            (videoQueue.getFrame().frame < currentFrame) :
+                            (videoQueue.getFrame().frame > currentFrame)))
                     {
-                        frame = queue.getFrame();
+                        frame = videoQueue.popFrame();
                         gotFrame = true;
+                        p.realSpeedFrameCount = p.realSpeedFrameCount + 1;
                     }
                 }
+                if (!gotFrame && !videoQueue.isEmpty())
+                {
+                    frame = videoQueue.getFrame();
+                    gotFrame = true;
+                }
                 if (gotFrame)
                 {
                     if (p.realSpeedFrameCount >= realSpeedFrameCount)
@@ -1239,10 +1477,10 @@ namespace djv
                     }
                 }
 
-                // Update the audio queue.
-                if (_hasAudio() && !_hasAudioSyncPlayback())
+                // Update the audio queue. When the feeder thread is enabled
+                // it is the only reader of the audio queue.
+                if (_hasAudio() && !p.audioFeederEnabled)
                 {
-                    std::lock_guard<std::mutex> lock(p.read->getMutex());
                     auto& queue = p.read->getAudioQueue();
                     while (queue.getCount() > queue.getMax())
                     {
@@ -1252,99 +1490,108 @@ namespace djv
             }
         }
         
-        int Media::_rtAudioCallback(
-            void* outputBuffer,
-            void* inputBuffer,
-            unsigned int nFrames,
-            double streamTime,
-            RtAudioStreamStatus status,
-            void* userData)
+        void Media::_resetAudio()
         {
-            Media* media = reinterpret_cast<Media*>(userData);
-            const auto& info = media->_p->audioInfo;
-
-            size_t outputSampleCount = static_cast<size_t>(nFrames);
-            size_t sampleCount = 0;
-            const size_t sampleByteCount = info.channelCount * Audio::getByteCount(info.type);
-            const float volume = !media->_p->mute->get() ? media->_p->volume->get() : 0.F;
-
-            if (media->_p->audioData)
+            DJV_PRIVATE_PTR();
+            std::unique_lock<std::mutex> lock(p.audioFeederMutex);
+            if (p.audioResampler)
             {
-                sampleCount += media->_p->audioData->getSampleCount() - media->_p->audioDataSamplesOffset;
+                p.audioResampler->reset();
             }
-
-            // Get audio frames from the read queue.
-            std::vector<AV::IO::AudioFrame> frames;
+            if (p.audioBuffer)
             {
-                std::lock_guard<std::mutex> lock(media->_p->read->getMutex());
-                auto& queue = media->_p->read->getAudioQueue();
-                while (!queue.isEmpty() && sampleCount < outputSampleCount)
-                {
-                    auto frame = queue.getFrame();
-                    frames.push_back(frame);
-                    queue.popFrame();
-                    sampleCount += frame.data->getSampleCount();
-                }
+                p.audioBuffer->reset();
             }
+            p.audioFeederData.reset();
+            p.audioFeederOffset = 0;
+            p.audioFeederOutput = nullptr;
+            p.audioFeederOutputCount = 0;
+            p.audioFeederOutputOffset = 0;
+            p.audioSamplesCount = 0;
+            p.audioEnd = false;
+        }
 
-            // Use the remaining data from the frame.
-            uint8_t* p = reinterpret_cast<uint8_t*>(outputBuffer);
-            if (media->_p->audioData)
+        void Media::_audioFeed()
+        {
+            DJV_PRIVATE_PTR();
+            if (!p.read || !p.audioBuffer)
+            {
+                return;
+            }
+            auto& queue = p.read->getAudioQueue();
+            const size_t inputByteCount = p.audioInfo.getByteCount();
+            const size_t outputByteCount = p.audioDeviceInfo.getByteCount();
+            while (p.audioBuffer->getWriteAvailable() > 0)
             {
-                const size_t size = std::min(
-                    media->_p->audioData->getSampleCount() - media->_p->audioDataSamplesOffset,
-                    outputSampleCount);
-                //memcpy(
-                //    p,
-                //    media->_p->audioData->getData() + media->_p->audioDataSamplesOffset * sampleByteCount,
-                //    size * sampleByteCount);
-                Audio::volume(
-                    media->_p->audioData->getData() + media->_p->audioDataSamplesOffset * sampleByteCount,
-                    p,
-                    volume,
-                    size,
-                    info.channelCount,
-                    info.type);
-                p += size * sampleByteCount;
-                media->_p->audioDataSamplesOffset += size;
-                media->_p->audioDataSamplesCount += size;
-                outputSampleCount -= size;
-                if (media->_p->audioDataSamplesOffset >= media->_p->audioData->getSampleCount())
+                // Write the converted samples.
+                if (p.audioFeederOutputOffset < p.audioFeederOutputCount)
                 {
-                    media->_p->audioData.reset();
-                    media->_p->audioDataSamplesOffset = 0;
+                    p.audioFeederOutputOffset += p.audioBuffer->write(
+                        p.audioFeederOutput + p.audioFeederOutputOffset * outputByteCount,
+                        p.audioFeederOutputCount - p.audioFeederOutputOffset);
+                    continue;
                 }
-            }
 
-            // Process the frames.
-            for (const auto& i : frames)
-            {
-                media->_p->audioData = i.data;
-                size_t size = std::min(i.data->getSampleCount(), outputSampleCount);
-                //memcpy(
-                //    p,
-                //    i.audio->getData(),
-                //    size * sampleByteCount);
-                Audio::volume(
-                    i.data->getData(),
-                    p,
-                    volume,
-                    size,
-                    info.channelCount,
-                    info.type);
-                p += size * sampleByteCount;
-                media->_p->audioDataSamplesOffset = size;
-                media->_p->audioDataSamplesCount += size;
-                outputSampleCount -= size;
-            }
+                // Get the next frame from the queue.
+                if (p.audioFeederData && p.audioFeederOffset >= p.audioFeederData->getSampleCount())
+                {
+                    p.audioFeederData.reset();
+                    p.audioFeederOffset = 0;
+                }
+                if (!p.audioFeederData)
+                {
+                    const bool finished = queue.isFinished();
+                    if (queue.isEmpty())
+                    {
+                        // All of the remaining samples are in the ring buffer
+                        // so running out is no longer an underrun.
+                        p.audioEnd = finished;
+                        break;
+                    }
+                    p.audioFeederData = queue.popFrame().data;
+                    p.audioFeederOffset = 0;
+                    if (!p.audioFeederData)
+                    {
+                        continue;
+                    }
+                }
 
-            const size_t zero = (nFrames * sampleByteCount) - (p - reinterpret_cast<uint8_t*>(outputBuffer));
-            if (zero)
-            {
-                //! \todo Is this the correct way to clear the audio data?
-                memset(p, 0, zero);
+                // Convert the samples a block at a time.
+                const uint8_t* data = p.audioFeederData->getData() + p.audioFeederOffset * inputByteCount;
+                const size_t sampleCount = p.audioFeederData->getSampleCount() - p.audioFeederOffset;
+                if (p.audioResampler)
+                {
+                    const size_t size = std::min(sampleCount, p.audioResampler->getBlockSize());
+                    p.audioFeederOutput = p.audioResampled.data();
+                    p.audioFeederOutputCount = p.audioResampler->process(data, size, p.audioResampled.data());
+                    p.audioFeederOffset += size;
+                }
+                else
+                {
+                    p.audioFeederOutput = data;
+                    p.audioFeederOutputCount = sampleCount;
+                    p.audioFeederOffset += sampleCount;
+                }
+                p.audioFeederOutputOffset = 0;
             }
+        }
 
+        int Media::_rtAudioCallback(
+            void* outputBuffer,
+            void* inputBuffer,
+            unsigned int nFrames,
+            double streamTime,
+            RtAudioStreamStatus status,
+            void* userData)
+        {
+            // This runs on the audio thread and must not lock or allocate.
+            Media* media = reinterpret_cast<Media*>(userData);
+            auto& p = *media->_p;
+            p.audioSamplesCount += p.audioBuffer->readOutput(
+                reinterpret_cast<uint8_t*>(outputBuffer),
+                static_cast<size_t>(nFrames),
+                p.audioVolume,
+                !p.audioEnd);
             return 0;
         }
 
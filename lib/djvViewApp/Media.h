@@ -150,6 +150,16 @@ namespace djv
 
             void setThreadCount(size_t);
 
+            //! Set whether playback switches to proxies when the frames can't
+            //! be decoded fast enough. Stopping playback returns to full
+            //! resolution.
+            void setProxyAuto(bool);
+
+            //! Set the region of the image that is visible, in pixels. Readers
+            //! that support it only decode the tiles that cover the region. An
+            //! invalid region reads the full image.
+            void setROI(const Math::BBox2i&);
+
             ///@}
 
             //! \name Cache
@@ -159,6 +169,10 @@ namespace djv
             size_t getCacheMaxByteCount() const;
             size_t getCacheByteCount() const;
 
+            //! Get the number of bytes needed to cache every frame between
+            //! the in and out points.
+            size_t getCacheRequiredByteCount() const;
+
             std::shared_ptr<Core::Observer::IValueSubject<Math::Frame::Sequence> > observeCacheSequence() const;
             std::shared_ptr<Core::Observer::IValueSubject<Math::Frame::Sequence> > observeCachedFrames() const;
 
@@ -197,6 +211,9 @@ namespace djv
             std::shared_ptr<Core::Observer::IValueSubject<size_t> > observeAudioQueueMax() const;
             std::shared_ptr<Core::Observer::IValueSubject<size_t> > observeVideoQueueCount() const;
             std::shared_ptr<Core::Observer::IValueSubject<size_t> > observeAudioQueueCount() const;
+            std::shared_ptr<Core::Observer::IValueSubject<size_t> > observeAudioBufferMax() const;
+            std::shared_ptr<Core::Observer::IValueSubject<size_t> > observeAudioBufferCount() const;
+            std::shared_ptr<Core::Observer::IValueSubject<size_t> > observeAudioUnderrunCount() const;
 
             ///@}
 
@@ -210,9 +227,12 @@ namespace djv
             void _seek(Math::Frame::Index);
             void _playbackUpdate();
             void _playbackTick();
+            void _proxyUpdate();
             void _startAudioStream();
             void _stopAudioStream();
             void _queueUpdate();
+            void _resetAudio();
+            void _audioFeed();
 
             static int _rtAudioCallback(
                 void* outputBuffer,
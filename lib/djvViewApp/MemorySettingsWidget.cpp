@@ -5,6 +5,8 @@
 #include <djvViewApp/MemorySettingsWidget.h>
 
 #include <djvViewApp/FileSettings.h>
+#include <djvViewApp/FileSystem.h>
+#include <djvViewApp/Media.h>
 
 #include <djvUI/CheckBox.h>
 #include <djvUI/IntSlider.h>
@@ -13,8 +15,10 @@
 #include <djvUI/LayoutUtil.h>
 #include <djvUI/RowLayout.h>
 #include <djvUI/SettingsSystem.h>
+#include <djvUI/TextBlock.h>
 
 #include <djvSystem/Context.h>
+#include <djvSystem/FileInfo.h>
 
 #include <djvCore/OS.h>
 
@@ -200,10 +204,103 @@ namespace djv
             }
         }
 
+        struct MemoryCacheOccupancyWidget::Private
+        {
+            std::vector<CacheOccupancy> occupancy;
+            std::shared_ptr<UI::Text::Block> textBlock;
+
+            std::shared_ptr<Observer::List<CacheOccupancy> > occupancyObserver;
+        };
+
+        void MemoryCacheOccupancyWidget::_init(const std::shared_ptr<System::Context>& context)
+        {
+            Widget::_init(context);
+            DJV_PRIVATE_PTR();
+            setClassName("djv::ViewApp::MemoryCacheOccupancyWidget");
+
+            p.textBlock = UI::Text::Block::create(context);
+            addChild(p.textBlock);
+
+            auto weak = std::weak_ptr<MemoryCacheOccupancyWidget>(
+                std::dynamic_pointer_cast<MemoryCacheOccupancyWidget>(shared_from_this()));
+            if (auto fileSystem = context->getSystemT<FileSystem>())
+            {
+                p.occupancyObserver = Observer::List<CacheOccupancy>::create(
+                    fileSystem->observeCacheOccupancy(),
+                    [weak](const std::vector<CacheOccupancy>& value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->occupancy = value;
+                            widget->_widgetUpdate();
+                        }
+                    });
+            }
+        }
+
+        MemoryCacheOccupancyWidget::MemoryCacheOccupancyWidget() :
+            _p(new Private)
+        {}
+
+        MemoryCacheOccupancyWidget::~MemoryCacheOccupancyWidget()
+        {}
+
+        std::shared_ptr<MemoryCacheOccupancyWidget> MemoryCacheOccupancyWidget::create(const std::shared_ptr<System::Context>& context)
+        {
+            auto out = std::shared_ptr<MemoryCacheOccupancyWidget>(new MemoryCacheOccupancyWidget);
+            out->_init(context);
+            return out;
+        }
+
+        void MemoryCacheOccupancyWidget::_preLayoutEvent(System::Event::PreLayout&)
+        {
+            const auto& style = _getStyle();
+            _setMinimumSize(_p->textBlock->getMinimumSize() + getMargin().getSize(style));
+        }
+
+        void MemoryCacheOccupancyWidget::_layoutEvent(System::Event::Layout&)
+        {
+            const auto& style = _getStyle();
+            _p->textBlock->setGeometry(getMargin().bbox(getGeometry(), style));
+        }
+
+        void MemoryCacheOccupancyWidget::_initEvent(System::Event::Init& event)
+        {
+            if (event.getData().text)
+            {
+                _widgetUpdate();
+            }
+        }
+
+        void MemoryCacheOccupancyWidget::_widgetUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            std::stringstream ss;
+            for (const auto& i : p.occupancy)
+            {
+                if (auto media = i.media.lock())
+                {
+                    std::stringstream ss2;
+                    ss2 << Memory::getUnitLabel(i.byteCount);
+                    std::stringstream ss3;
+                    ss3 << Memory::getUnitLabel(i.maxByteCount);
+                    ss << media->getFileInfo().getFileName(Math::Frame::invalid, false) << ": " <<
+                        Memory::getSizeLabel(i.byteCount) << _getText(ss2.str()) << " / " <<
+                        Memory::getSizeLabel(i.maxByteCount) << _getText(ss3.str()) << '\n';
+                }
+            }
+            if (p.occupancy.empty())
+            {
+                ss << _getText(DJV_TEXT("settings_memory_cache_occupancy_none"));
+            }
+            p.textBlock->setText(ss.str());
+        }
+
         struct MemorySettingsWidget::Private
         {
             std::shared_ptr<MemoryCacheEnabledWidget> enabledWidget;
             std::shared_ptr<MemoryCacheSizeWidget> sizeWidget;
+            std::shared_ptr<MemoryCacheOccupancyWidget> occupancyWidget;
             std::shared_ptr<UI::FormLayout> layout;
         };
 
@@ -216,11 +313,13 @@ namespace djv
 
             p.enabledWidget = MemoryCacheEnabledWidget::create(context);
             p.sizeWidget = MemoryCacheSizeWidget::create(context);
+            p.occupancyWidget = MemoryCacheOccupancyWidget::create(context);
 
             p.layout = UI::FormLayout::create(context);
             p.layout->setSpacing(UI::MetricsRole::None);
             p.layout->addChild(p.enabledWidget);
             p.layout->addChild(p.sizeWidget);
+            p.layout->addChild(p.occupancyWidget);
             addChild(p.layout);
         }
 
@@ -253,6 +352,7 @@ namespace djv
             {
                 p.layout->setText(p.enabledWidget, _getText(DJV_TEXT("settings_memory_cache_enabled")) + ":");
                 p.layout->setText(p.sizeWidget, _getText(DJV_TEXT("settings_memory_cache_size")) + ":");
+                p.layout->setText(p.occupancyWidget, _getText(DJV_TEXT("settings_memory_cache_occupancy")) + ":");
             }
         }
 
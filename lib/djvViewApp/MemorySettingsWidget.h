@@ -56,6 +56,32 @@ namespace djv
             DJV_PRIVATE();
         };
 
+        //! Memory cache occupancy widget.
+        class MemoryCacheOccupancyWidget : public UI::Widget
+        {
+            DJV_NON_COPYABLE(MemoryCacheOccupancyWidget);
+
+        protected:
+            void _init(const std::shared_ptr<System::Context>&);
+            MemoryCacheOccupancyWidget();
+
+        public:
+            ~MemoryCacheOccupancyWidget() override;
+
+            static std::shared_ptr<MemoryCacheOccupancyWidget> create(const std::shared_ptr<System::Context>&);
+
+        protected:
+            void _preLayoutEvent(System::Event::PreLayout&) override;
+            void _layoutEvent(System::Event::Layout&) override;
+
+            void _initEvent(System::Event::Init&) override;
+
+        private:
+            void _widgetUpdate();
+
+            DJV_PRIVATE();
+        };
+
         //! Memory settings widget.
         class MemorySettingsWidget : public UIComponents::Settings::IWidget
         {
@@ -118,19 +118,12 @@ namespace djv
                         auto i = widget->_read.begin();
                         while (i != widget->_read.end())
                         {
-                            bool erase = false;
+                            auto& queue = (*i)->getVideoQueue();
+                            bool erase = queue.isFinished();
+                            if (!queue.isEmpty())
                             {
-                                std::unique_lock<std::mutex> lock((*i)->getMutex());
-                                auto& queue = (*i)->getVideoQueue();
-                                if (!queue.isEmpty())
-                                {
-                                    erase = true;
-                                    widget->_images.push_back(queue.popFrame().data);
-                                }
-                                else if (queue.isFinished())
-                                {
-                                    erase = true;
-                                }
+                                erase = true;
+                                widget->_images.push_back(queue.popFrame().data);
                             }
                             if (erase)
                             {
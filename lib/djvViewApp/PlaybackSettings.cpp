@@ -26,6 +26,7 @@ namespace djv
             std::shared_ptr<Observer::ValueSubject<Math::IntRational> > customSpeed;
             std::shared_ptr<Observer::ValueSubject<bool> > playEveryFrame;
             std::shared_ptr<Observer::ValueSubject<bool> > pipEnabled;
+            std::shared_ptr<Observer::ValueSubject<bool> > proxyAuto;
         };
 
         void PlaybackSettings::_init(const std::shared_ptr<System::Context>& context)
@@ -39,6 +40,7 @@ namespace djv
             p.playEveryFrame = Observer::ValueSubject<bool>::create(false);
             p.playbackMode = Observer::ValueSubject<PlaybackMode>::create(PlaybackMode::Loop);
             p.pipEnabled = Observer::ValueSubject<bool>::create(true);
+            p.proxyAuto = Observer::ValueSubject<bool>::create(false);
             _load();
         }
 
@@ -108,11 +110,21 @@ namespace djv
             return _p->pipEnabled;
         }
 
+        std::shared_ptr<Observer::IValueSubject<bool> > PlaybackSettings::observeProxyAuto() const
+        {
+            return _p->proxyAuto;
+        }
+
         void PlaybackSettings::setPIPEnabled(bool value)
         {
             _p->pipEnabled->setIfChanged(value);
         }
 
+        void PlaybackSettings::setProxyAuto(bool value)
+        {
+            _p->proxyAuto->setIfChanged(value);
+        }
+
         void PlaybackSettings::load(const rapidjson::Value & value)
         {
             if (value.IsObject())
@@ -124,6 +136,7 @@ namespace djv
                 UI::Settings::read("PlayEveryFrame", value, p.playEveryFrame);
                 UI::Settings::read("PlaybackMode", value, p.playbackMode);
                 UI::Settings::read("PIPEnabled", value, p.pipEnabled);
+                UI::Settings::read("ProxyAuto", value, p.proxyAuto);
             }
         }
 
@@ -137,6 +150,7 @@ namespace djv
             UI::Settings::write("PlayEveryFrame", p.playEveryFrame->get(), out, allocator);
             UI::Settings::write("PlaybackMode", p.playbackMode->get(), out, allocator);
             UI::Settings::write("PIPEnabled", p.pipEnabled->get(), out, allocator);
+            UI::Settings::write("ProxyAuto", p.proxyAuto->get(), out, allocator);
             return out;
         }
 
@@ -57,9 +57,14 @@ namespace djv
             ///@{
 
             std::shared_ptr<Core::Observer::IValueSubject<bool> > observePIPEnabled() const;
+            std::shared_ptr<Core::Observer::IValueSubject<bool> > observeProxyAuto() const;
 
             void setPIPEnabled(bool);
 
+            //! Set whether playback switches to proxies automatically when
+            //! the images can't be decoded fast enough.
+            void setProxyAuto(bool);
+
             ///@}
 
             void load(const rapidjson::Value &) override;
@@ -24,8 +24,10 @@ namespace djv
         struct PlaybackSettingsWidget::Private
         {
             std::shared_ptr<UI::CheckBox> startPlaybackCheckBox;
+            std::shared_ptr<UI::CheckBox> proxyAutoCheckBox;
             std::shared_ptr<UI::FormLayout> layout;
             std::shared_ptr<Observer::Value<bool> > startPlaybackObserver;
+            std::shared_ptr<Observer::Value<bool> > proxyAutoObserver;
         };
 
         void PlaybackSettingsWidget::_init(const std::shared_ptr<System::Context>& context)
@@ -36,9 +38,11 @@ namespace djv
             setClassName("djv::ViewApp::PlaybackSettingsWidget");
 
             p.startPlaybackCheckBox = UI::CheckBox::create(context);
+            p.proxyAutoCheckBox = UI::CheckBox::create(context);
 
             p.layout = UI::FormLayout::create(context);
             p.layout->addChild(p.startPlaybackCheckBox);
+            p.layout->addChild(p.proxyAutoCheckBox);
             addChild(p.layout);
 
             auto weak = std::weak_ptr<PlaybackSettingsWidget>(std::dynamic_pointer_cast<PlaybackSettingsWidget>(shared_from_this()));
@@ -59,6 +63,22 @@ namespace djv
                     }
                 });
 
+            p.proxyAutoCheckBox->setCheckedCallback(
+                [weak, contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            auto settingsSystem = context->getSystemT<UI::Settings::SettingsSystem>();
+                            if (auto playbackSettings = settingsSystem->getSettingsT<PlaybackSettings>())
+                            {
+                                playbackSettings->setProxyAuto(value);
+                            }
+                        }
+                    }
+                });
+
             auto settingsSystem = context->getSystemT<UI::Settings::SettingsSystem>();
             if (auto playbackSettings = settingsSystem->getSettingsT<PlaybackSettings>())
             {
@@ -71,6 +91,16 @@ namespace djv
                             widget->_p->startPlaybackCheckBox->setChecked(value);
                         }
                     });
+
+                p.proxyAutoObserver = Observer::Value<bool>::create(
+                    playbackSettings->observeProxyAuto(),
+                    [weak](bool value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->proxyAutoCheckBox->setChecked(value);
+                        }
+                    });
             }
         }
 
@@ -102,6 +132,7 @@ namespace djv
             if (event.getData().text)
             {
                 p.layout->setText(p.startPlaybackCheckBox, _getText(DJV_TEXT("settings_playback_start_playback")) + ":");
+                p.layout->setText(p.proxyAutoCheckBox, _getText(DJV_TEXT("settings_playback_proxy_auto")) + ":");
             }
         }
 
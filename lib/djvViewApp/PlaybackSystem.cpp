@@ -57,6 +57,7 @@ namespace djv
             std::shared_ptr<Observer::Value<Playback> > playbackObserver;
             std::shared_ptr<Observer::Value<PlaybackMode> > playbackModeObserver;
             std::shared_ptr<Observer::Value<AV::IO::InOutPoints> > inOutPointsObserver;
+            std::shared_ptr<Observer::Value<bool> > proxyAutoObserver;
             std::shared_ptr<Observer::Value<std::shared_ptr<MediaWidget> > > activeWidgetObserver;
             std::shared_ptr<Observer::Value<PointerData> > hoverObserver;
             std::shared_ptr<Observer::Value<PointerData> > dragObserver;
@@ -545,6 +546,25 @@ namespace djv
                         }
                     }
                 });
+
+                p.proxyAutoObserver = Observer::Value<bool>::create(
+                    p.settings->observeProxyAuto(),
+                    [weak](bool value)
+                    {
+                        if (auto system = weak.lock())
+                        {
+                            if (auto context = system->getContext().lock())
+                            {
+                                if (auto fileSystem = context->getSystemT<FileSystem>())
+                                {
+                                    for (const auto& i : fileSystem->observeMedia()->get())
+                                    {
+                                        i->setProxyAuto(value);
+                                    }
+                                }
+                            }
+                        }
+                    });
             }
 
             if (auto windowSystem = context->getSystemT<WindowSystem>())
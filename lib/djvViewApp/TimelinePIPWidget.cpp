@@ -98,13 +98,10 @@ namespace djv
                         if (widget->_p->read)
                         {
                             AV::IO::VideoFrame frame;
+                            const auto& videoQueue = widget->_p->read->getVideoQueue();
+                            if (!videoQueue.isEmpty())
                             {
-                                std::lock_guard<std::mutex> lock(widget->_p->read->getMutex());
-                                const auto& videoQueue = widget->_p->read->getVideoQueue();
-                                if (!videoQueue.isEmpty())
-                                {
-                                    frame = videoQueue.getFrame();
-                                }
+                                frame = videoQueue.getFrame();
                             }
                             if (frame.data)
                             {
@@ -202,6 +199,18 @@ namespace djv
                         const auto info = p.read->getInfo().get();
                         p.speed = info.videoSpeed;
                         p.sequence = info.videoSequence;
+
+                        // The preview is only as wide as a text column, so read
+                        // a proxy of the images.
+                        if (info.video.size() > 0 && info.video[0].size.w > 0)
+                        {
+                            const auto& imageSize = info.video[0].size;
+                            const float w = _getStyle()->getMetric(UI::MetricsRole::TextColumn);
+                            const float h = w * imageSize.h / static_cast<float>(imageSize.w);
+                            p.read->setProxyScale(AV::IO::getProxyScale(
+                                imageSize,
+                                Image::Size(static_cast<uint16_t>(w), static_cast<uint16_t>(std::max(h, 1.F)))));
+                        }
                     }
                     catch (const std::exception& e)
                     {
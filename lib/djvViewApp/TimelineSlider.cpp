@@ -22,6 +22,9 @@
 #include <djvAV/AVSystem.h>
 #include <djvAV/IOSystem.h>
 #include <djvAV/Time.h>
+#include <djvAV/WaveformSystem.h>
+
+#include <djvAudio/Waveform.h>
 
 #include <djvSystem/Context.h>
 #include <djvSystem/Timer.h>
@@ -47,6 +50,10 @@ namespace djv
             bool cacheEnabled = false;
             Math::Frame::Sequence cacheSequence;
             Math::Frame::Sequence cachedFrames;
+            std::shared_ptr<AV::WaveformSystem> waveformSystem;
+            AV::WaveformSystem::WaveformFuture waveformFuture;
+            std::shared_ptr<Audio::Waveform> waveform;
+            std::vector<Audio::WaveformPeak> waveformPeaks;
             Render2D::Font::FontInfo fontInfo;
             Render2D::Font::Metrics fontMetrics;
             std::future<Render2D::Font::Metrics> fontMetricsFuture;
@@ -93,6 +100,7 @@ namespace djv
             setBackgroundColorRole(UI::ColorRole::Trough);
 
             p.fontSystem = context->getSystemT<Render2D::Font::FontSystem>();
+            p.waveformSystem = context->getSystemT<AV::WaveformSystem>();
 
             p.pipWidget = TimelinePIPWidget::create(context);
             p.pipOverlay = UI::Layout::Overlay::create(context);
@@ -151,6 +159,13 @@ namespace djv
             if (value == p.media)
                 return;
             p.media = value;
+            if (p.waveformFuture.future.valid())
+            {
+                p.waveformSystem->cancelWaveform(p.waveformFuture.uid);
+                p.waveformFuture = AV::WaveformSystem::WaveformFuture();
+            }
+            p.waveform.reset();
+            p.waveformPeaks.clear();
             if (p.media)
             {
                 auto weak = std::weak_ptr<TimelineSlider>(std::dynamic_pointer_cast<TimelineSlider>(shared_from_this()));
@@ -161,6 +176,13 @@ namespace djv
                     if (auto widget = weak.lock())
                     {
                         widget->_p->speed = value.videoSpeed;
+                        if (value.audio.channelCount > 0 &&
+                            !widget->_p->waveform &&
+                            !widget->_p->waveformFuture.future.valid())
+                        {
+                            widget->_p->waveformFuture = widget->_p->waveformSystem->getWaveform(
+                                widget->_p->media->getFileInfo());
+                        }
                         widget->_textUpdate();
                         widget->_currentFrameUpdate();
                     }
@@ -352,6 +374,7 @@ namespace djv
                     }
                     p.timeTicks.resize(timeTicksCount);
                 }
+                _waveformUpdate();
             }
         }
 
@@ -367,12 +390,38 @@ namespace djv
                 const float b = style->getMetric(UI::MetricsRole::Border);
                 const Math::BBox2f& hg = _getHandleGeometry();
 
+                // Draw the audio waveform.
+                const auto& render = _getRender();
+                std::vector<Math::BBox2f> rects;
+                if (p.waveformPeaks.size())
+                {
+                    const float h = g.h() / 2.F;
+                    const float y = g.min.y + h;
+                    auto color = style->getColor(UI::ColorRole::Foreground);
+                    color.setF32(color.getF32(3) * .2F, 3);
+                    render->setFillColor(color);
+                    for (size_t i = 0; i < p.waveformPeaks.size(); ++i)
+                    {
+                        const auto& peak = p.waveformPeaks[i];
+                        const float y0 = floorf(y - Math::clamp(peak.max, -1.F, 1.F) * h);
+                        const float y1 = ceilf(y - Math::clamp(peak.min, -1.F, 1.F) * h);
+                        rects.emplace_back(Math::BBox2f(g.min.x + i, y0, 1.F, std::max(y1 - y0, 1.F)));
+                    }
+                    render->drawRects(rects);
+                    rects.clear();
+                    for (size_t i = 0; i < p.waveformPeaks.size(); ++i)
+                    {
+                        const float rms = std::min(p.waveformPeaks[i].rms, 1.F) * h;
+                        rects.emplace_back(Math::BBox2f(g.min.x + i, floorf(y - rms), 1.F, ceilf(rms * 2.F)));
+                    }
+                    render->drawRects(rects);
+                    rects.clear();
+                }
+
                 // Draw the time ticks.
                 auto color = style->getColor(UI::ColorRole::Foreground);
                 color.setF32(color.getF32(3) * .4F, 3);
-                const auto& render = _getRender();
                 render->setFillColor(color);
-                std::vector<Math::BBox2f> rects;
                 for (const auto& tick : p.timeTicks)
                 {
                     rects.emplace_back(Math::BBox2f(
@@ -577,6 +626,21 @@ namespace djv
         void TimelineSlider::_updateEvent(System::Event::Update & event)
         {
             DJV_PRIVATE_PTR();
+            if (p.waveformFuture.future.valid() &&
+                p.waveformFuture.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                try
+                {
+                    p.waveform = p.waveformFuture.future.get();
+                    p.sizePrev = glm::vec2(0.F, 0.F);
+                    _resize();
+                }
+                catch (const std::exception & e)
+                {
+                    _log(e.what(), System::LogLevel::Error);
+                }
+                p.waveformFuture = AV::WaveformSystem::WaveformFuture();
+            }
             if (p.fontMetricsFuture.valid() &&
                 p.fontMetricsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
             {
@@ -776,6 +840,25 @@ namespace djv
             }
         }
 
+        void TimelineSlider::_waveformUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            p.waveformPeaks.clear();
+            const size_t sequenceFrameCount = p.sequence.getFrameCount();
+            const float speedF = p.speed.toFloat();
+            if (p.waveform && sequenceFrameCount > 0 && speedF > 0.F)
+            {
+                // Get a peak for each pixel.
+                const auto& style = _getStyle();
+                const Math::BBox2f g = getMargin().bbox(getGeometry(), style);
+                const size_t w = static_cast<size_t>(std::max(ceilf(g.w()), 0.F));
+                const int64_t sampleCount = static_cast<int64_t>(
+                    sequenceFrameCount / static_cast<double>(speedF) * p.waveform->getInfo().sampleRate);
+                p.waveformPeaks.resize(w);
+                p.waveform->getPeaks(0, sampleCount, w, p.waveformPeaks.data());
+            }
+        }
+
         void TimelineSlider::_showPIP(bool value)
         {
             DJV_PRIVATE_PTR();
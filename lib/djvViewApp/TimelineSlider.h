@@ -89,6 +89,7 @@ namespace djv
             Math::BBox2f _getHandleGeometry() const;
             void _textUpdate();
             void _currentFrameUpdate();
+            void _waveformUpdate();
             void _showPIP(bool);
 
             void _doCurrentFrameCallback();
@@ -183,6 +183,7 @@ namespace djv
                     if (auto widget = weak.lock())
                     {
                         widget->_p->imageData = value;
+                        widget->_roiUpdate();
                         widget->_redraw();
                     }
                 });
@@ -212,6 +213,7 @@ namespace djv
                     if (auto widget = weak.lock())
                     {
                         widget->_hudUpdate();
+                        widget->_roiUpdate();
                     }
                 });
             p.speedObserver = Observer::Value<Math::IntRational>::create(
@@ -296,9 +298,26 @@ namespace djv
             if (p.image->setIfChanged(value))
             {
                 _gridUpdate();
+                _roiUpdate();
             }
         }
 
+        Image::Info ViewWidget::getLayerInfo(const std::shared_ptr<Image::Data>& image) const
+        {
+            DJV_PRIVATE_PTR();
+            Image::Info out = image->getInfo();
+            const auto& layers = p.media->observeLayers()->get();
+            if (layers.second >= 0 && layers.second < static_cast<int>(layers.first.size()))
+            {
+                const Image::Size& layerSize = layers.first[layers.second].size;
+                if (layerSize.w > 0 && layerSize.h > 0)
+                {
+                    out.size = layerSize;
+                }
+            }
+            return out;
+        }
+
         std::shared_ptr<Observer::IValueSubject<glm::vec2> > ViewWidget::observeImagePos() const
         {
             return _p->imagePos;
@@ -424,6 +443,7 @@ namespace djv
             const Math::BBox2f& g = getGeometry();
             p.layout->setGeometry(g);
             p.gridOverlay->setImageBBox(getImageBBox());
+            _roiUpdate();
         }
 
         void ViewWidget::_paintEvent(System::Event::Paint &)
@@ -468,9 +488,13 @@ namespace djv
             // Draw the image.
             if (image)
             {
+                // Proxy images are scaled to the size of the full resolution
+                // layer, and regions of interest are drawn where they sit in it.
+                const Image::Info layerInfo = getLayerInfo(image);
                 glm::mat3x3 m(1.F);
                 m = glm::translate(m, g.min + p.imagePos->get());
-                m *= UI::ImageWidget::getXForm(image, p.imageData.rotate, glm::vec2(zoom, zoom), p.imageData.aspectRatio);
+                m *= UI::ImageWidget::getXForm(layerInfo, p.imageData.rotate, glm::vec2(zoom, zoom), p.imageData.aspectRatio);
+                m *= UI::ImageWidget::getLayerXForm(image, layerInfo, p.imageData.mirror);
                 render->pushTransform(m);
                 render->setFillColor(Image::Color(1.F, 1.F, 1.F));
                 Render2D::ImageOptions options;
@@ -526,7 +550,8 @@ namespace djv
             std::vector<glm::vec3> out;
             if (auto image = p.image->get())
             {
-                const Image::Size& size = image->getSize();
+                const Image::Info layerInfo = getLayerInfo(image);
+                const Image::Size& size = layerInfo.size;
                 out.resize(4);
                 out[0].x = 0.F;
                 out[0].y = 0.F;
@@ -549,9 +574,9 @@ namespace djv
                 }
                 const float zoom = p.imageZoom->get();
                 m *= UI::ImageWidget::getXForm(
-                    image,
+                    layerInfo,
                     p.imageData.rotate,
-                    posAndZoom ? glm::vec2(zoom, zoom) : glm::vec2(1.F, 1.F),
+                    glm::vec2(posAndZoom ? zoom : 1.F),
                     p.imageData.aspectRatio);
                 for (auto& i : out)
                 {
@@ -637,6 +662,7 @@ namespace djv
             }
             p.gridOverlay->setImagePosAndZoom(p.imagePos->get(), p.imageZoom->get());
             p.gridOverlay->setImageBBox(getImageBBox());
+            _roiUpdate();
         }
 
         void ViewWidget::_gridUpdate()
@@ -675,6 +701,47 @@ namespace djv
             p.hudOverlay->setHUDData(data);
         }
 
+        void ViewWidget::_roiUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            // Only the visible region of the image is read when it is not
+            // rotated, mirrored, or scaled to a fixed aspect ratio.
+            Math::BBox2i roi;
+            auto image = p.image->get();
+            const float zoom = p.imageZoom->get();
+            if (image &&
+                zoom > 0.F &&
+                UI::ImageRotate::_0 == p.imageData.rotate &&
+                (UI::ImageAspectRatio::Unscaled == p.imageData.aspectRatio ||
+                 UI::ImageAspectRatio::FromSource == p.imageData.aspectRatio) &&
+                !p.imageData.mirror.x &&
+                !p.imageData.mirror.y)
+            {
+                const auto& style = _getStyle();
+                const Math::BBox2f& g = getMargin().bbox(getGeometry(), style);
+                if (g.w() <= 0.F || g.h() <= 0.F)
+                {
+                    p.media->setROI(roi);
+                    return;
+                }
+                glm::mat3x3 m(1.F);
+                m = glm::translate(m, g.min + p.imagePos->get());
+                m *= UI::ImageWidget::getXForm(
+                    getLayerInfo(image),
+                    p.imageData.rotate,
+                    glm::vec2(zoom, zoom),
+                    p.imageData.aspectRatio);
+                const glm::mat3x3 inverse = glm::inverse(m);
+                const glm::vec3 min = inverse * glm::vec3(g.min.x, g.min.y, 1.F);
+                const glm::vec3 max = inverse * glm::vec3(g.max.x, g.max.y, 1.F);
+                roi.min.x = static_cast<int>(floorf(min.x));
+                roi.min.y = static_cast<int>(floorf(min.y));
+                roi.max.x = static_cast<int>(ceilf(max.x));
+                roi.max.y = static_cast<int>(ceilf(max.y));
+            }
+            p.media->setROI(roi);
+        }
+
     } // namespace ViewApp
 } // namespace djv
 
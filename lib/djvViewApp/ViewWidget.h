@@ -13,6 +13,7 @@ namespace djv
     namespace Image
     {
         class Data;
+        class Info;
 
     } // namespace Image
 
@@ -45,6 +46,10 @@ namespace djv
 
             void setImage(const std::shared_ptr<Image::Data>&);
 
+            //! Get the information for the full resolution layer of an image.
+            //! Proxy images and regions of interest are smaller than the layer.
+            Image::Info getLayerInfo(const std::shared_ptr<Image::Data>&) const;
+
             ///@}
 
             //! \name Zoom and Position
@@ -81,6 +86,7 @@ namespace djv
 
             void _gridUpdate();
             void _hudUpdate();
+            void _roiUpdate();
 
             DJV_PRIVATE();
         };
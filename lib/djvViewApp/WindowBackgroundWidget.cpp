@@ -88,13 +88,10 @@ namespace djv
                                                 if (auto widget = weak.lock())
                                                 {
                                                     std::shared_ptr<Image::Data> image;
+                                                    auto& queue = widget->_p->read->getVideoQueue();
+                                                    if (!queue.isEmpty())
                                                     {
-                                                        std::unique_lock<std::mutex> lock(widget->_p->read->getMutex());
-                                                        auto& queue = widget->_p->read->getVideoQueue();
-                                                        if (!queue.isEmpty())
-                                                        {
-                                                            image = queue.popFrame().data;
-                                                        }
+                                                        image = queue.popFrame().data;
                                                     }
                                                     if (image)
                                                     {
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCore/Cache.h>
+#include <djvCore/Error.h>
+#include <djvCore/Random.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+
+using namespace djv;
+
+namespace
+{
+    //! The previous cache implementation, a pair of maps with a usage
+    //! counter. The maps are sorted when the cache is over capacity.
+    template<typename T, typename U>
+    class MapCache
+    {
+    public:
+        void setMax(size_t value)
+        {
+            _max = value;
+            _maxUpdate();
+        }
+
+        bool get(const T& key, U& value) const
+        {
+            auto i = _map.find(key);
+            if (i != _map.end())
+            {
+                value = i->second;
+                auto j = _counts.find(key);
+                if (j != _counts.end())
+                {
+                    ++_counter;
+                    j->second = _counter;
+                }
+                return true;
+            }
+            return false;
+        }
+
+        void add(const T& key, const U& value)
+        {
+            _map[key] = value;
+            ++_counter;
+            _counts[key] = _counter;
+            _maxUpdate();
+        }
+
+    private:
+        void _maxUpdate()
+        {
+            if (_map.size() > _max)
+            {
+                std::map<int64_t, T> sorted;
+                for (const auto& i : _counts)
+                {
+                    sorted[i.second] = i.first;
+                }
+                while (_map.size() > _max)
+                {
+                    auto begin = sorted.begin();
+                    _map.erase(begin->second);
+                    _counts.erase(begin->second);
+                    sorted.erase(begin);
+                }
+            }
+        }
+
+        size_t _max = 10000;
+        std::map<T, U> _map;
+        mutable std::map<T, int64_t> _counts;
+        mutable int64_t _counter = 0;
+    };
+
+    void benchmark(const std::string& name, size_t count, const std::function<void(void)>& callback)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        callback();
+        const auto end = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> delta = end - start;
+        std::cout << "    " << name << ": " << (delta.count() / static_cast<double>(count) * 1000000000.0) <<
+            " nanoseconds per operation" << std::endl;
+    }
+
+    // Time filling the cache, looking up random entries, and adding new
+    // entries that evict the least recently used ones.
+    template<typename C>
+    void benchmarkCache(const std::string& name, size_t size, size_t evictCount)
+    {
+        std::cout << name << " (" << size << " entries):" << std::endl;
+        C cache;
+        cache.setMax(size);
+        benchmark(
+            "Add",
+            size,
+            [&cache, size]
+            {
+                for (size_t i = 0; i < size; ++i)
+                {
+                    cache.add(i, i);
+                }
+            });
+        benchmark(
+            "Get",
+            size,
+            [&cache, size]
+            {
+                size_t value = 0;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    cache.get(Core::Random::getRandom(static_cast<int>(size) - 1), value);
+                }
+            });
+        benchmark(
+            "Evict",
+            evictCount,
+            [&cache, size, evictCount]
+            {
+                for (size_t i = 0; i < evictCount; ++i)
+                {
+                    cache.add(size + i, i);
+                }
+            });
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        for (const size_t size : { 1000, 100000, 1000000 })
+        {
+            benchmarkCache<Core::Memory::Cache<size_t, size_t> >("Cache", size, size);
+
+            // Each eviction in the previous implementation sorts every
+            // entry, so only time a few of them.
+            benchmarkCache<MapCache<size_t, size_t> >("Previous cache", size, std::min(size, static_cast<size_t>(10)));
+        }
+        r = 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvSystem/FileInfoPrivate.h>
+
+#include <djvMath/FrameNumber.h>
+
+#include <djvCore/Error.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+using namespace djv;
+
+namespace
+{
+    //! The number of sequences in the synthetic listings.
+    const size_t shotCount = 100;
+
+    void benchmark(const std::string& name, size_t count, const std::function<void(void)>& callback)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        callback();
+        const auto end = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> delta = end - start;
+        std::cout << "    " << name << ": " << delta.count() << " seconds, " <<
+            (delta.count() / static_cast<double>(count) * 1000000000.0) << " nanoseconds per entry" << std::endl;
+    }
+
+    // Create a synthetic listing of interleaved sequences with gaps, as
+    // returned by readdir() for a render directory.
+    std::vector<System::File::Info> createListing(size_t size)
+    {
+        std::vector<System::File::Info> out;
+        out.reserve(size);
+        const System::File::Path dir("/tmp/DirectoryListBenchmark");
+        for (size_t i = 0; i < size; ++i)
+        {
+            const size_t shot = i % shotCount;
+            const size_t frame = (i / shotCount) * 2 + shot % 2;
+            std::stringstream ss;
+            ss << "shot" << shot << "." << Math::Frame::toString(static_cast<Math::Frame::Number>(frame), 7) << ".exr";
+            out.push_back(System::File::Info(System::File::Path(dir, ss.str()), false));
+        }
+        return out;
+    }
+
+    //! The previous implementation, which searches the listing for a
+    //! compatible item and adds each file to its sequence.
+    void previousSequences(const std::vector<System::File::Info>& listing, std::vector<System::File::Info>& out)
+    {
+        for (const auto& info : listing)
+        {
+            const size_t size = out.size();
+            size_t j = 0;
+            for (; j < size; ++j)
+            {
+                if (out[j].addToSequence(info))
+                {
+                    break;
+                }
+            }
+            if (size == j)
+            {
+                out.push_back(info);
+            }
+        }
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        System::File::DirectoryListOptions options;
+        options.sequences = true;
+        options.sequenceExtensions = { ".exr" };
+        for (const size_t size : { 10000, 100000, 1000000 })
+        {
+            std::cout << "Listing (" << size << " entries):" << std::endl;
+            const auto listing = createListing(size);
+            benchmark(
+                "Sequences",
+                size,
+                [&listing, &options]
+                {
+                    std::vector<System::File::Info> out;
+                    System::File::DirectoryListSequences sequences(options);
+                    for (const auto& info : listing)
+                    {
+                        sequences.add(info, out);
+                    }
+                    sequences.finish(out);
+                });
+
+            // The previous implementation re-formats the sequence for
+            // every file, so only time the smaller listings.
+            if (size <= 100000)
+            {
+                benchmark(
+                    "Previous sequences",
+                    size,
+                    [&listing]
+                    {
+                        std::vector<System::File::Info> out;
+                        previousSequences(listing, out);
+                    });
+            }
+        }
+        r = 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvMath/FrameNumber.h>
+
+#include <djvCore/Error.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+using namespace djv;
+
+namespace
+{
+    void benchmark(const std::string& name, size_t count, const std::function<void(void)>& callback)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        callback();
+        const auto end = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> delta = end - start;
+        std::cout << "    " << name << ": " << delta.count() << " seconds, " <<
+            (delta.count() / static_cast<double>(count) * 1000000000.0) << " nanoseconds per frame" << std::endl;
+    }
+
+    // Create the frames of a dense sequence (e.g., 1-100000) or a sparse
+    // sequence where every other frame is missing (e.g., 1,3,5,...).
+    std::vector<Math::Frame::Number> createFrames(size_t size, bool sparse)
+    {
+        std::vector<Math::Frame::Number> out;
+        out.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            out.push_back(static_cast<Math::Frame::Number>(sparse ? (i * 2 + 1) : (i + 1)));
+        }
+        return out;
+    }
+
+    //! The previous implementation, which searches the ranges linearly.
+    Math::Frame::Index previousGetIndex(const Math::Frame::Sequence& sequence, Math::Frame::Number value)
+    {
+        Math::Frame::Index out = Math::Frame::invalidIndex;
+        Math::Frame::Index tmp = 0;
+        for (const auto& j : sequence.getRanges())
+        {
+            if (j.contains(value))
+            {
+                out = tmp + value - j.getMin();
+                break;
+            }
+            tmp += j.getMax() - j.getMin() + 1;
+        }
+        return out;
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        for (const bool sparse : { false, true })
+        {
+            for (const size_t size : { 1000, 100000, 1000000 })
+            {
+                std::cout << (sparse ? "Sparse" : "Dense") << " sequence (" << size << " frames):" << std::endl;
+                const auto frames = createFrames(size, sparse);
+                Math::Frame::Sequence sequence;
+                benchmark(
+                    "fromFrames",
+                    size,
+                    [&frames, &sequence]
+                    {
+                        sequence = Math::Frame::fromFrames(frames);
+                    });
+                benchmark(
+                    "add",
+                    size,
+                    [&frames]
+                    {
+                        Math::Frame::Sequence tmp;
+                        for (const auto i : frames)
+                        {
+                            tmp.add(Math::Frame::Range(i));
+                        }
+                    });
+                Math::Frame::Number frameSum = 0;
+                benchmark(
+                    "getFrame",
+                    size,
+                    [size, &sequence, &frameSum]
+                    {
+                        for (size_t i = 0; i < size; ++i)
+                        {
+                            frameSum += sequence.getFrame(i);
+                        }
+                    });
+                Math::Frame::Index indexSum = 0;
+                benchmark(
+                    "getIndex",
+                    size,
+                    [&frames, &sequence, &indexSum]
+                    {
+                        for (const auto i : frames)
+                        {
+                            indexSum += sequence.getIndex(i);
+                        }
+                    });
+
+                // The previous implementation is quadratic for sparse
+                // sequences, so only time the smaller ones.
+                if (!sparse || size <= 100000)
+                {
+                    Math::Frame::Index previousIndexSum = 0;
+                    benchmark(
+                        "Previous getIndex",
+                        size,
+                        [&frames, &sequence, &previousIndexSum]
+                        {
+                            for (const auto i : frames)
+                            {
+                                previousIndexSum += previousGetIndex(sequence, i);
+                            }
+                        });
+                    if (previousIndexSum != indexSum)
+                    {
+                        throw std::runtime_error("Index mismatch");
+                    }
+                }
+            }
+        }
+        r = 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/IO.h>
+
+#include <djvCore/Error.h>
+#include <djvCore/Random.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+using namespace djv;
+
+const size_t sequenceSize = 100000;
+const size_t cacheSize = 10000;
+const size_t scrubCount = 10000;
+
+void benchmark(const std::string& name, size_t count, const std::function<void(void)>& callback)
+{
+    const auto start = std::chrono::steady_clock::now();
+    callback();
+    const auto end = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> delta = end - start;
+    std::cout << name << ": " << delta.count() << " seconds, " <<
+        (delta.count() / static_cast<double>(count) * 1000000000.0) << " nanoseconds per frame" << std::endl;
+}
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        auto image = Image::Data::create(Image::Info(1, 1, Image::Type::L_U8));
+
+        AV::IO::Cache cache;
+        cache.setSequenceSize(sequenceSize);
+        cache.setMax(cacheSize);
+
+        // Play forward through the sequence, filling the cache ahead of the
+        // current frame.
+        benchmark(
+            "Playback forward",
+            sequenceSize,
+            [&cache, image]
+            {
+                for (Math::Frame::Index i = 0; i < static_cast<Math::Frame::Index>(sequenceSize); ++i)
+                {
+                    cache.setCurrentFrame(i);
+                    cache.add(i, image);
+                    cache.add((i + cacheSize / 2) % sequenceSize, image);
+                }
+            });
+
+        // Play in reverse through the sequence.
+        cache.setDirection(AV::IO::Direction::Reverse);
+        benchmark(
+            "Playback reverse",
+            sequenceSize,
+            [&cache, image]
+            {
+                for (Math::Frame::Index i = static_cast<Math::Frame::Index>(sequenceSize) - 1; i >= 0; --i)
+                {
+                    cache.setCurrentFrame(i);
+                    cache.add(i, image);
+                }
+            });
+
+        // Scrub back and forth across the sequence in small steps.
+        cache.setDirection(AV::IO::Direction::Forward);
+        benchmark(
+            "Scrub",
+            scrubCount,
+            [&cache, image]
+            {
+                Math::Frame::Index frame = sequenceSize / 2;
+                for (size_t i = 0; i < scrubCount; ++i)
+                {
+                    frame = std::max(
+                        static_cast<Math::Frame::Index>(0),
+                        std::min(
+                            frame + Core::Random::getRandom(-100, 100),
+                            static_cast<Math::Frame::Index>(sequenceSize - 1)));
+                    cache.setCurrentFrame(frame);
+                    std::shared_ptr<Image::Data> data;
+                    if (!cache.get(frame, data))
+                    {
+                        cache.add(frame, image);
+                    }
+                }
+            });
+
+        // Jump to random frames across the whole sequence.
+        benchmark(
+            "Random jumps",
+            scrubCount,
+            [&cache, image]
+            {
+                for (size_t i = 0; i < scrubCount; ++i)
+                {
+                    const Math::Frame::Index frame = Core::Random::getRandom(static_cast<int>(sequenceSize) - 1);
+                    cache.setCurrentFrame(frame);
+                    cache.add(frame, image);
+                }
+            });
+
+        benchmark(
+            "Cached frames",
+            1,
+            [&cache]
+            {
+                cache.getFrames();
+            });
+
+        r = 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
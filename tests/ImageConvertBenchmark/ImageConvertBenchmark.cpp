@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImage/Type.h>
+
+#include <djvCore/Error.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace djv;
+
+namespace
+{
+    const size_t pixelCount = 1920 * 1080;
+    const size_t iterations = 20;
+
+    std::string getLabel(Image::ConvertISA value)
+    {
+        std::string out;
+        switch (value)
+        {
+        case Image::ConvertISA::Scalar: out = "Scalar"; break;
+        case Image::ConvertISA::SSE41:  out = "SSE4.1"; break;
+        case Image::ConvertISA::AVX2:   out = "AVX2";   break;
+        default: break;
+        }
+        return out;
+    }
+
+    // Time converting an HD image, the throughput counts both the bytes
+    // read and the bytes written.
+    void benchmark(Image::Type inType, Image::Type outType)
+    {
+        std::vector<uint8_t> in(Image::getByteCount(inType) * pixelCount, 0);
+        std::vector<uint8_t> out(Image::getByteCount(outType) * pixelCount, 0);
+        std::cout << inType << " -> " << outType << ":" << std::endl;
+        const size_t max = static_cast<size_t>(Image::getConvertISAMax());
+        for (size_t i = 0; i <= max; ++i)
+        {
+            const auto isa = static_cast<Image::ConvertISA>(i);
+            Image::setConvertISA(isa);
+            Image::convert(in.data(), inType, out.data(), outType, pixelCount);
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t j = 0; j < iterations; ++j)
+            {
+                Image::convert(in.data(), inType, out.data(), outType, pixelCount);
+            }
+            const auto end = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> delta = end - start;
+            const double bytes = static_cast<double>((in.size() + out.size()) * iterations);
+            std::cout << "    " << std::setw(6) << std::left << getLabel(isa) << ": " <<
+                std::fixed << std::setprecision(2) << (bytes / delta.count() / 1000000000.0) <<
+                " GB/s" << std::endl;
+        }
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        const std::vector<std::pair<Image::Type, Image::Type> > pairs =
+        {
+            { Image::Type::RGBA_U8,  Image::Type::RGBA_F32 },
+            { Image::Type::RGBA_F32, Image::Type::RGBA_U8 },
+            { Image::Type::RGBA_U8,  Image::Type::RGBA_F16 },
+            { Image::Type::RGBA_F16, Image::Type::RGBA_U8 },
+            { Image::Type::RGBA_U16, Image::Type::RGBA_F32 },
+            { Image::Type::RGBA_F32, Image::Type::RGBA_U16 },
+            { Image::Type::RGBA_U16, Image::Type::RGBA_F16 },
+            { Image::Type::RGBA_F16, Image::Type::RGBA_U16 },
+            { Image::Type::RGBA_F16, Image::Type::RGBA_F32 },
+            { Image::Type::RGBA_F32, Image::Type::RGBA_F16 },
+            { Image::Type::RGB_U10,  Image::Type::RGB_U16 },
+            { Image::Type::RGB_U10,  Image::Type::RGBA_U16 },
+            { Image::Type::RGB_U10,  Image::Type::RGB_F16 },
+            { Image::Type::RGB_U10,  Image::Type::RGBA_F16 },
+            { Image::Type::RGB_U8,   Image::Type::RGBA_U8 },
+            { Image::Type::RGBA_U8,  Image::Type::RGB_U8 },
+            { Image::Type::RGB_U16,  Image::Type::RGBA_U16 },
+            { Image::Type::RGBA_U16, Image::Type::RGB_U16 },
+            { Image::Type::RGB_F32,  Image::Type::RGBA_F32 },
+            { Image::Type::RGBA_F32, Image::Type::RGB_F32 }
+        };
+        for (const auto& i : pairs)
+        {
+            benchmark(i.first, i.second);
+        }
+        r = 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/OpenEXR.h>
+
+#include <djvCore/Error.h>
+
+#include <ImfCompression.h>
+#include <ImfOutputFile.h>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+using namespace djv;
+
+const int width = 1920;
+const int height = 1080;
+const size_t layerCount = 8;
+const size_t iterations = 4;
+
+void benchmark(const std::string& name, size_t count, const std::function<void(void)>& callback)
+{
+    const auto start = std::chrono::steady_clock::now();
+    callback();
+    const auto end = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> delta = end - start;
+    std::cout << name << ": " << delta.count() << " seconds, " <<
+        (delta.count() / static_cast<double>(count) * 1000.0) << " milliseconds per file" << std::endl;
+}
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        // Write a file with RGBA layers.
+        const std::string fileName = "OpenEXRBenchmark.exr";
+        {
+            Imf::Header header(width, height);
+            header.compression() = Imf::ZIP_COMPRESSION;
+            std::vector<std::string> channels;
+            for (size_t i = 0; i < layerCount; ++i)
+            {
+                for (const auto& j : { "R", "G", "B", "A" })
+                {
+                    std::stringstream ss;
+                    ss << "layer" << i << "." << j;
+                    channels.push_back(ss.str());
+                    header.channels().insert(channels.back(), Imf::Channel(Imf::HALF));
+                }
+            }
+            std::vector<half> buf(width * height);
+            for (size_t i = 0; i < buf.size(); ++i)
+            {
+                buf[i] = static_cast<float>(i % width) / static_cast<float>(width);
+            }
+            Imf::FrameBuffer frameBuffer;
+            for (const auto& i : channels)
+            {
+                frameBuffer.insert(
+                    i,
+                    Imf::Slice(
+                        Imf::HALF,
+                        reinterpret_cast<char*>(buf.data()),
+                        sizeof(half),
+                        sizeof(half) * width));
+            }
+            Imf::OutputFile f(fileName.c_str(), header);
+            f.setFrameBuffer(frameBuffer);
+            f.writePixels(height);
+        }
+
+        for (size_t count = 1; count <= layerCount; count *= 2)
+        {
+            std::vector<size_t> layers;
+            for (size_t i = 0; i < count; ++i)
+            {
+                layers.push_back(i);
+            }
+
+            // Open the file and read one layer at a time.
+            std::stringstream ss;
+            ss << count << " layers, separate reads";
+            benchmark(
+                ss.str(),
+                iterations,
+                [fileName, layers]
+                {
+                    for (size_t i = 0; i < iterations; ++i)
+                    {
+                        for (const auto j : layers)
+                        {
+                            AV::OpenEXR::InputFile f(fileName, AV::OpenEXR::Channels::Known);
+                            f.read({ j });
+                        }
+                    }
+                });
+
+            // Open the file once and read all of the layers in a single pass.
+            ss.str(std::string());
+            ss << count << " layers, single pass";
+            benchmark(
+                ss.str(),
+                iterations,
+                [fileName, layers]
+                {
+                    for (size_t i = 0; i < iterations; ++i)
+                    {
+                        AV::OpenEXR::InputFile f(fileName, AV::OpenEXR::Channels::Known);
+                        f.read(layers);
+                    }
+                });
+        }
+
+        std::remove(fileName.c_str());
+
+        r = 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
@@ -151,14 +151,11 @@ void Application::_init(std::list<std::string>& args)
                 i));
             while (1)
             {
+                auto& queue = read->getVideoQueue();
+                if (!queue.isEmpty())
                 {
-                    std::lock_guard<std::mutex> lock(read->getMutex());
-                    auto& queue = read->getVideoQueue();
-                    if (!queue.isEmpty())
-                    {
-                        _images.push_back(queue.getFrame().data);
-                        break;
-                    }
+                    _images.push_back(queue.getFrame().data);
+                    break;
                 }
                 std::this_thread::sleep_for(std::chrono::milliseconds(10));
             }
@@ -27,6 +27,8 @@ namespace djv
         void FFmpegTest::run()
         {
             _convert();
+            _gopIndex();
+            _packetQueue();
             _serialize();
         }
         
@@ -97,12 +99,156 @@ namespace djv
             {
                 _print("Error: " + FFmpeg::getErrorString(i));
             }
+
+            DJV_ASSERT(AV_PIX_FMT_YUV420P == FFmpeg::getOutputFormat(AV_PIX_FMT_YUV420P, FFmpeg::VideoOutput::Native));
+            DJV_ASSERT(AV_PIX_FMT_YUV422P10 == FFmpeg::getOutputFormat(AV_PIX_FMT_YUV422P10, FFmpeg::VideoOutput::Native));
+            DJV_ASSERT(AV_PIX_FMT_YUV444P16 == FFmpeg::getOutputFormat(AV_PIX_FMT_YUV444P12, FFmpeg::VideoOutput::Native));
+            DJV_ASSERT(AV_PIX_FMT_RGBA == FFmpeg::getOutputFormat(AV_PIX_FMT_NV12, FFmpeg::VideoOutput::Native));
+            DJV_ASSERT(AV_PIX_FMT_RGBA == FFmpeg::getOutputFormat(AV_PIX_FMT_YUV420P, FFmpeg::VideoOutput::RGBA_U8));
+            DJV_ASSERT(AV_PIX_FMT_RGB48 == FFmpeg::getOutputFormat(AV_PIX_FMT_YUV420P10, FFmpeg::VideoOutput::RGB_U16));
+            for (const auto i : FFmpeg::getVideoOutputEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                for (const auto j : {
+                    AV_PIX_FMT_YUV420P,
+                    AV_PIX_FMT_YUVJ422P,
+                    AV_PIX_FMT_YUV444P10,
+                    AV_PIX_FMT_YUV420P12,
+                    AV_PIX_FMT_YUV422P16,
+                    AV_PIX_FMT_NV12 })
+                {
+                    const Image::Type type = FFmpeg::toImageType(FFmpeg::getOutputFormat(j, i));
+                    DJV_ASSERT(type != Image::Type::None);
+                    std::stringstream ss2;
+                    ss2 << type;
+                    _print(_getText(ss.str()) + ": " + _getText(ss2.str()));
+                }
+            }
+
+            DJV_ASSERT(Image::YUVCoefficients::BT601 == FFmpeg::toYUVCoefficients(AVCOL_SPC_SMPTE170M, 1080));
+            DJV_ASSERT(Image::YUVCoefficients::BT709 == FFmpeg::toYUVCoefficients(AVCOL_SPC_BT709, 480));
+            DJV_ASSERT(Image::YUVCoefficients::BT2020 == FFmpeg::toYUVCoefficients(AVCOL_SPC_BT2020_NCL, 2160));
+            DJV_ASSERT(Image::YUVCoefficients::BT601 == FFmpeg::toYUVCoefficients(AVCOL_SPC_UNSPECIFIED, 480));
+            DJV_ASSERT(Image::YUVCoefficients::BT709 == FFmpeg::toYUVCoefficients(AVCOL_SPC_UNSPECIFIED, 1080));
+            DJV_ASSERT(Image::YUVRange::Full == FFmpeg::toYUVRange(AV_PIX_FMT_YUVJ420P, AVCOL_RANGE_UNSPECIFIED));
+            DJV_ASSERT(Image::YUVRange::Full == FFmpeg::toYUVRange(AV_PIX_FMT_YUV420P, AVCOL_RANGE_JPEG));
+            DJV_ASSERT(Image::YUVRange::Video == FFmpeg::toYUVRange(AV_PIX_FMT_YUV420P, AVCOL_RANGE_MPEG));
         }
         
+        void FFmpegTest::_gopIndex()
+        {
+            {
+                FFmpeg::GOPIndex index;
+                DJV_ASSERT(0 == index.getCount());
+                DJV_ASSERT(!index.isComplete());
+                Math::Frame::Number keyFrame = Math::Frame::invalid;
+                int64_t pts = 0;
+                DJV_ASSERT(!index.getKeyFrame(0, keyFrame, pts));
+            }
+
+            {
+                FFmpeg::GOPIndex index;
+                index.add(0, 0);
+                index.add(24, 2400);
+                index.add(12, 1200);
+                DJV_ASSERT(3 == index.getCount());
+                Math::Frame::Number keyFrame = Math::Frame::invalid;
+                int64_t pts = 0;
+                DJV_ASSERT(index.getKeyFrame(0, keyFrame, pts));
+                DJV_ASSERT(0 == keyFrame);
+                DJV_ASSERT(0 == pts);
+                DJV_ASSERT(index.getKeyFrame(11, keyFrame, pts));
+                DJV_ASSERT(0 == keyFrame);
+                DJV_ASSERT(index.getKeyFrame(12, keyFrame, pts));
+                DJV_ASSERT(12 == keyFrame);
+                DJV_ASSERT(1200 == pts);
+                DJV_ASSERT(index.getKeyFrame(23, keyFrame, pts));
+                DJV_ASSERT(12 == keyFrame);
+                DJV_ASSERT(!index.getKeyFrame(-1, keyFrame, pts));
+
+                // Frames after the last key frame are only covered when the
+                // index is complete.
+                DJV_ASSERT(!index.getKeyFrame(24, keyFrame, pts));
+                DJV_ASSERT(!index.getKeyFrame(30, keyFrame, pts));
+                index.setComplete(true);
+                DJV_ASSERT(index.isComplete());
+                DJV_ASSERT(index.getKeyFrame(30, keyFrame, pts));
+                DJV_ASSERT(24 == keyFrame);
+                DJV_ASSERT(2400 == pts);
+            }
+        }
+
+        void FFmpegTest::_packetQueue()
+        {
+            {
+                FFmpeg::PacketQueue queue(2);
+                DJV_ASSERT(2 == queue.getMax());
+                DJV_ASSERT(0 == queue.getCount());
+                DJV_ASSERT(0 == queue.getGeneration());
+
+                bool seek = false;
+                int stream = -1;
+                int64_t t = 0;
+                uint64_t generation = 0;
+                DJV_ASSERT(queue.waitForDemux(seek, stream, t, generation));
+                DJV_ASSERT(!seek);
+                for (int i = 0; i < 2; ++i)
+                {
+                    AVPacket* packet = av_packet_alloc();
+                    packet->stream_index = i;
+                    queue.push(packet, generation);
+                }
+                DJV_ASSERT(2 == queue.getCount());
+                queue.setEnd(AVERROR_EOF, generation);
+
+                AVPacket* packet = nullptr;
+                DJV_ASSERT(0 == queue.pop(&packet));
+                DJV_ASSERT(0 == packet->stream_index);
+                av_packet_free(&packet);
+                DJV_ASSERT(0 == queue.pop(&packet));
+                DJV_ASSERT(1 == packet->stream_index);
+                av_packet_free(&packet);
+                DJV_ASSERT(AVERROR_EOF == queue.pop(&packet));
+            }
+
+            {
+                FFmpeg::PacketQueue queue(2);
+                bool seek = false;
+                int stream = -1;
+                int64_t t = 0;
+                uint64_t generation = 0;
+                DJV_ASSERT(queue.waitForDemux(seek, stream, t, generation));
+                queue.push(av_packet_alloc(), generation);
+
+                // Packets from before the seek are discarded.
+                queue.seek(1, 100);
+                DJV_ASSERT(0 == queue.getCount());
+                DJV_ASSERT(1 == queue.getGeneration());
+                queue.push(av_packet_alloc(), generation);
+                queue.setEnd(AVERROR_EOF, generation);
+                DJV_ASSERT(0 == queue.getCount());
+
+                DJV_ASSERT(queue.waitForDemux(seek, stream, t, generation));
+                DJV_ASSERT(seek);
+                DJV_ASSERT(1 == stream);
+                DJV_ASSERT(100 == t);
+                DJV_ASSERT(1 == generation);
+                queue.setEnd(AVERROR_EOF, generation);
+                AVPacket* packet = nullptr;
+                DJV_ASSERT(AVERROR_EOF == queue.pop(&packet));
+
+                queue.stop();
+                DJV_ASSERT(!queue.waitForDemux(seek, stream, t, generation));
+                DJV_ASSERT(AVERROR_EXIT == queue.pop(&packet));
+            }
+        }
+
         void FFmpegTest::_serialize()
         {
             {
                 FFmpeg::Options options;
+                options.videoOutput = FFmpeg::VideoOutput::RGB_U16;
                 rapidjson::Document document;
                 auto& allocator = document.GetAllocator();
                 auto json = toJSON(options, allocator);
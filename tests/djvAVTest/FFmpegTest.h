@@ -19,6 +19,8 @@ namespace djv
         
         private:
             void _convert();
+            void _gopIndex();
+            void _packetQueue();
             void _serialize();
         };
         
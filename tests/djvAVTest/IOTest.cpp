@@ -19,6 +19,8 @@
 #include <djvCore/Error.h>
 #include <djvCore/String.h>
 
+#include <thread>
+
 using namespace djv::Core;
 using namespace djv::AV;
 using namespace djv::AV::IO;
@@ -45,6 +47,8 @@ namespace djv
             _audioQueue();
             _inOutPoints();
             _cache();
+            _proxy();
+            _roi();
             _plugin();
             _io();
             _system();
@@ -95,6 +99,7 @@ namespace djv
                 DJV_ASSERT(queue.isEmpty());
                 DJV_ASSERT(0 == queue.getCount());
                 DJV_ASSERT(VideoFrame() == queue.getFrame());
+                DJV_ASSERT(Math::Frame::invalid == queue.getFrameNumber());
                 DJV_ASSERT(!queue.isFinished());
             }
             
@@ -115,6 +120,128 @@ namespace djv
                 queue.setFinished(true);
                 DJV_ASSERT(queue.isFinished());
             }
+
+            {
+                VideoQueue queue;
+                queue.setMax(1);
+                DJV_ASSERT(queue.getCapacity() > queue.getMax());
+                const uint64_t generation = queue.getGeneration();
+                queue.addFrame(VideoFrame(1, nullptr), generation);
+                DJV_ASSERT(1 == queue.getCount());
+
+                // Frames from before the queue was cleared are skipped.
+                const uint64_t generation2 = queue.clearFrames();
+                DJV_ASSERT(generation2 == queue.getGeneration());
+                DJV_ASSERT(generation2 != generation);
+                queue.addFrame(VideoFrame(2, nullptr), generation);
+                DJV_ASSERT(queue.isEmpty());
+                queue.addFrame(VideoFrame(3, nullptr), generation2);
+                DJV_ASSERT(1 == queue.getCount());
+                DJV_ASSERT(3 == queue.getFrame().frame);
+                DJV_ASSERT(3 == queue.popFrame().frame);
+                DJV_ASSERT(queue.isEmpty());
+                DJV_ASSERT(VideoFrame() == queue.popFrame());
+
+                // The ring buffer is bounded.
+                size_t count = 0;
+                while (queue.addFrame(VideoFrame(count, nullptr)))
+                {
+                    ++count;
+                }
+                DJV_ASSERT(queue.getCapacity() == count);
+                DJV_ASSERT(0 == queue.popFrame().frame);
+                DJV_ASSERT(queue.addFrame(VideoFrame(count, nullptr)));
+            }
+
+            {
+                // Clearing the queue repeatedly without popping frames does
+                // not fill the ring buffer, the consumer releases the frames
+                // from the older generations.
+                VideoQueue queue;
+                queue.setMax(10);
+                auto image = Image::Data::create(Image::Info(1, 1, Image::Type::L_U8));
+                for (size_t i = 0; i < queue.getCapacity(); ++i)
+                {
+                    const uint64_t generation = queue.clearFrames();
+                    for (size_t j = 0; j < queue.getMax(); ++j)
+                    {
+                        DJV_ASSERT(queue.addFrame(VideoFrame(i + j, image), generation));
+                    }
+                    DJV_ASSERT(!queue.isEmpty());
+                    DJV_ASSERT(queue.getMax() == queue.getCount());
+                    DJV_ASSERT(static_cast<Math::Frame::Number>(i) == queue.getFrame().frame);
+                    DJV_ASSERT(static_cast<Math::Frame::Number>(i) == queue.getFrameNumber());
+                }
+                queue.clearFrames();
+                DJV_ASSERT(queue.isEmpty());
+                DJV_ASSERT(1 == image.use_count());
+            }
+
+            {
+                // Frames from an older generation are not added.
+                VideoQueue queue;
+                queue.setMax(1);
+                const uint64_t generation = queue.getGeneration();
+                queue.clearFrames();
+                for (size_t i = 0; i < queue.getCapacity() * 2; ++i)
+                {
+                    DJV_ASSERT(queue.addFrame(VideoFrame(i, nullptr), generation));
+                }
+                DJV_ASSERT(0 == queue.getCount());
+                DJV_ASSERT(queue.addFrame(VideoFrame(1, nullptr)));
+                DJV_ASSERT(1 == queue.getFrameNumber());
+            }
+
+            {
+                VideoQueue queue;
+                queue.setMax(1);
+                std::atomic<bool> running(true);
+                size_t count = 0;
+                while (queue.addFrame(VideoFrame(count, nullptr)))
+                {
+                    ++count;
+                }
+                running = false;
+                DJV_ASSERT(!queue.addFrameWait(VideoFrame(count, nullptr), queue.getGeneration(), running));
+                running = true;
+                std::thread thread(
+                    [&queue]
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                        queue.popFrame();
+                    });
+                DJV_ASSERT(queue.addFrameWait(VideoFrame(count, nullptr), queue.getGeneration(), running));
+                thread.join();
+            }
+
+            {
+                VideoQueue queue;
+                queue.setMax(10);
+                const Math::Frame::Number frameCount = 10000;
+                std::thread thread(
+                    [&queue, frameCount]
+                    {
+                        for (Math::Frame::Number i = 0; i < frameCount; ++i)
+                        {
+                            while (!queue.addFrame(VideoFrame(i, nullptr)))
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                        queue.setFinished(true);
+                    });
+                Math::Frame::Number frame = 0;
+                while (!queue.isFinished() || !queue.isEmpty())
+                {
+                    if (!queue.isEmpty())
+                    {
+                        DJV_ASSERT(frame == queue.popFrame().frame);
+                        ++frame;
+                    }
+                }
+                thread.join();
+                DJV_ASSERT(frameCount == frame);
+            }
         }
         
         void IOTest::_audioFrame()
@@ -186,6 +313,100 @@ namespace djv
             }
         }
         
+        void IOTest::_proxy()
+        {
+            {
+                DJV_ASSERT(Image::Size(100, 50) == getProxySize(Image::Size(100, 50), 1));
+                DJV_ASSERT(Image::Size(50, 25) == getProxySize(Image::Size(100, 50), 2));
+                DJV_ASSERT(Image::Size(25, 13) == getProxySize(Image::Size(100, 50), 4));
+                DJV_ASSERT(Image::Size(13, 7) == getProxySize(Image::Size(100, 50), 8));
+            }
+
+            {
+                DJV_ASSERT(1 == getProxyScale(Image::Size(100, 50), Image::Size(100, 50)));
+                DJV_ASSERT(2 == getProxyScale(Image::Size(100, 50), Image::Size(50, 25)));
+                DJV_ASSERT(4 == getProxyScale(Image::Size(1000, 500), Image::Size(200, 100)));
+                DJV_ASSERT(8 == getProxyScale(Image::Size(1000, 500), Image::Size(10, 5)));
+                DJV_ASSERT(1 == getProxyScale(Image::Size(100, 50), Image::Size(200, 100)));
+            }
+
+            {
+                auto data = Image::Data::create(Image::Info(4, 2, Image::Type::L_U8));
+                const uint8_t values[] = { 0, 2, 10, 20, 4, 6, 30, 41 };
+                memcpy(data->getData(), values, 8);
+                DJV_ASSERT(data == scaleProxy(data, 1));
+                auto proxy = scaleProxy(data, 2);
+                DJV_ASSERT(Image::Size(2, 1) == proxy->getSize());
+                DJV_ASSERT(3 == proxy->getData()[0]);
+                DJV_ASSERT(25 == proxy->getData()[1]);
+            }
+
+            {
+                auto data = Image::Data::create(Image::Info(4, 4, Image::Type::L_F32));
+                auto p = reinterpret_cast<Image::F32_T*>(data->getData());
+                for (size_t i = 0; i < 16; ++i)
+                {
+                    p[i] = i < 8 ? 0.F : 1.F;
+                }
+                auto proxy = scaleProxy(data, 4);
+                DJV_ASSERT(Image::Size(1, 1) == proxy->getSize());
+                DJV_ASSERT(fuzzyCompare(.5F, reinterpret_cast<const Image::F32_T*>(proxy->getData())[0]));
+            }
+
+            {
+                auto data = Image::Data::create(Image::Info(4, 4, Image::Type::RGB_U10));
+                auto p = reinterpret_cast<Image::U10_S*>(data->getData());
+                for (size_t i = 0; i < 16; ++i)
+                {
+                    p[i].r = p[i].g = p[i].b = static_cast<uint16_t>(i);
+                }
+                auto proxy = scaleProxy(data, 2);
+                DJV_ASSERT(Image::Size(2, 2) == proxy->getSize());
+                auto proxyP = reinterpret_cast<const Image::U10_S*>(proxy->getData());
+                DJV_ASSERT(0 == proxyP[0].r);
+                DJV_ASSERT(2 == proxyP[1].r);
+                DJV_ASSERT(8 == proxyP[2].r);
+                DJV_ASSERT(10 == proxyP[3].r);
+            }
+        }
+
+        void IOTest::_roi()
+        {
+            {
+                const Image::Size size(1000, 600);
+                DJV_ASSERT(!getROITiles(Math::BBox2i(), size).isValid());
+                DJV_ASSERT(!getROITiles(Math::BBox2i(0, 0, 1000, 600), size).isValid());
+                DJV_ASSERT(!getROITiles(Math::BBox2i(-100, -100, 2000, 2000), size).isValid());
+                DJV_ASSERT(!getROITiles(Math::BBox2i(2000, 2000, 100, 100), size).isValid());
+                DJV_ASSERT(Math::BBox2i(0, 0, 256, 256) == getROITiles(Math::BBox2i(10, 10, 100, 100), size));
+                DJV_ASSERT(Math::BBox2i(256, 256, 512, 344) == getROITiles(Math::BBox2i(300, 300, 300, 1000), size));
+                DJV_ASSERT(Math::BBox2i(768, 0, 232, 256) == getROITiles(Math::BBox2i(900, -50, 200, 100), size));
+            }
+
+            {
+                DJV_ASSERT(!coversROI(nullptr, Math::BBox2i()));
+                auto data = Image::Data::create(Image::Info(256, 256, Image::Type::L_U8));
+                DJV_ASSERT(coversROI(data, Math::BBox2i()));
+                DJV_ASSERT(coversROI(data, Math::BBox2i(0, 0, 100, 100)));
+                data->setROI(Math::BBox2i(256, 0, 256, 256));
+                DJV_ASSERT(!coversROI(data, Math::BBox2i()));
+                DJV_ASSERT(coversROI(data, Math::BBox2i(256, 0, 256, 256)));
+                DJV_ASSERT(!coversROI(data, Math::BBox2i(0, 0, 256, 256)));
+                DJV_ASSERT(!coversROI(data, Math::BBox2i(256, 0, 256, 512)));
+            }
+
+            {
+                Image::Info info(100, 50, Image::Type::L_U8);
+                const Math::BBox2i roi(10, 5, 30, 10);
+                DJV_ASSERT(roi == mirrorROI(roi, info));
+                info.layout.mirror.x = true;
+                DJV_ASSERT(Math::BBox2i(60, 5, 30, 10) == mirrorROI(roi, info));
+                info.layout.mirror.x = false;
+                info.layout.mirror.y = true;
+                DJV_ASSERT(Math::BBox2i(10, 35, 30, 10) == mirrorROI(roi, info));
+            }
+        }
+
         void IOTest::_cache()
         {
             {
@@ -237,6 +458,109 @@ namespace djv
                     _print(ss.str());
                 }
             }
+
+            {
+                // The read behind is limited to half of the window so the
+                // current frame is still cached.
+                Cache cache;
+                cache.setMax(0);
+                cache.setSequenceSize(100);
+                cache.setCurrentFrame(50);
+                DJV_ASSERT(0 == cache.getReadBehind());
+                cache.add(50, Image::Data::create(Image::Info(1, 2, Image::Type::RGB_U8)));
+                DJV_ASSERT(cache.contains(50));
+                cache.setMax(9);
+                DJV_ASSERT(5 == cache.getReadBehind());
+                DJV_ASSERT(cache.contains(50));
+                DJV_ASSERT(Math::Frame::Sequence(Math::Frame::Range(45, 54)) == cache.getSequence());
+            }
+
+            {
+                // The window wraps around the end of the sequence.
+                const auto data = Image::Data::create(Image::Info(1, 2, Image::Type::RGB_U8));
+                auto addFrames = [data](Cache& cache, Math::Frame::Index min, Math::Frame::Index max)
+                {
+                    for (Math::Frame::Index i = min; i <= max; ++i)
+                    {
+                        cache.add(i, data);
+                    }
+                };
+                auto containsFrames = [](const Cache& cache, Math::Frame::Index min, Math::Frame::Index max)
+                {
+                    bool out = true;
+                    for (Math::Frame::Index i = min; i <= max; ++i)
+                    {
+                        out &= cache.contains(i);
+                    }
+                    return out;
+                };
+                Cache cache;
+                cache.setMax(19);
+                cache.setSequenceSize(100);
+                cache.setCurrentFrame(5);
+                const Math::Frame::Sequence wrapped(std::vector<Math::Frame::Range>({
+                    Math::Frame::Range(0, 14),
+                    Math::Frame::Range(95, 99) }));
+                DJV_ASSERT(wrapped == cache.getSequence());
+                addFrames(cache, 95, 99);
+                addFrames(cache, 0, 14);
+                cache.add(50, data);
+                DJV_ASSERT(20 == cache.getCount());
+                DJV_ASSERT(20 * data->getDataByteCount() == cache.getTotalByteCount());
+                DJV_ASSERT(containsFrames(cache, 95, 99));
+                DJV_ASSERT(containsFrames(cache, 0, 14));
+                DJV_ASSERT(!cache.contains(50));
+                DJV_ASSERT(wrapped == cache.getFrames());
+
+                // Shift the window forward, across the end of the sequence.
+                cache.setCurrentFrame(6);
+                DJV_ASSERT(19 == cache.getCount());
+                DJV_ASSERT(!cache.contains(95));
+                DJV_ASSERT(containsFrames(cache, 96, 99));
+                DJV_ASSERT(!cache.contains(15));
+                cache.setCurrentFrame(15);
+                DJV_ASSERT(10 == cache.getCount());
+                DJV_ASSERT(!containsFrames(cache, 96, 99));
+                DJV_ASSERT(!cache.contains(4));
+                DJV_ASSERT(containsFrames(cache, 5, 14));
+                DJV_ASSERT(Math::Frame::Sequence(Math::Frame::Range(5, 24)) == cache.getSequence());
+
+                // Shift the window in reverse.
+                cache.setDirection(Direction::Reverse);
+                DJV_ASSERT(Math::Frame::Sequence(Math::Frame::Range(6, 25)) == cache.getSequence());
+                DJV_ASSERT(9 == cache.getCount());
+                DJV_ASSERT(!cache.contains(5));
+                cache.setCurrentFrame(10);
+                DJV_ASSERT(Math::Frame::Sequence(Math::Frame::Range(1, 20)) == cache.getSequence());
+                DJV_ASSERT(9 == cache.getCount());
+                DJV_ASSERT(containsFrames(cache, 6, 14));
+                addFrames(cache, 1, 20);
+                DJV_ASSERT(20 == cache.getCount());
+                DJV_ASSERT(Math::Frame::Sequence(Math::Frame::Range(1, 20)) == cache.getFrames());
+
+                // Shrink the window, the frames that are still in the window
+                // are kept.
+                cache.setMax(9);
+                DJV_ASSERT(Math::Frame::Sequence(Math::Frame::Range(6, 15)) == cache.getSequence());
+                DJV_ASSERT(10 == cache.getCount());
+                DJV_ASSERT(10 * data->getDataByteCount() == cache.getTotalByteCount());
+                DJV_ASSERT(containsFrames(cache, 6, 15));
+                DJV_ASSERT(!cache.contains(5));
+                DJV_ASSERT(!cache.contains(16));
+
+                // Grow the window.
+                cache.setMax(19);
+                DJV_ASSERT(Math::Frame::Sequence(Math::Frame::Range(1, 20)) == cache.getSequence());
+                DJV_ASSERT(10 == cache.getCount());
+                DJV_ASSERT(containsFrames(cache, 6, 15));
+                DJV_ASSERT(Math::Frame::Sequence(Math::Frame::Range(6, 15)) == cache.getFrames());
+
+                // Jump past the window.
+                cache.setCurrentFrame(60);
+                DJV_ASSERT(0 == cache.getCount());
+                DJV_ASSERT(0 == cache.getTotalByteCount());
+                DJV_ASSERT(Math::Frame::Sequence() == cache.getFrames());
+            }
         }
         
         void IOTest::_plugin()
@@ -269,6 +593,9 @@ namespace djv
                 read->setPlayback(true);
                 read->setLoop(true);
                 read->setInOutPoints(InOutPoints(true, 1, 2));
+                DJV_ASSERT(0 == read->getLayer());
+                read->setLayer(1);
+                DJV_ASSERT(1 == read->getLayer());
             }
 
             if (auto context = getContext().lock())
@@ -392,12 +719,9 @@ namespace djv
                     Info info;
                     info.video.push_back(imageInfo);
                     auto write = io->write(System::File::Info(path), info);
-                    {
-                        std::lock_guard<std::mutex> lock(write->getMutex());
-                        auto& writeQueue = write->getVideoQueue();
-                        writeQueue.addFrame(VideoFrame(0, image));
-                        writeQueue.setFinished(true);
-                    }
+                    auto& writeQueue = write->getVideoQueue();
+                    writeQueue.addFrame(VideoFrame(0, image));
+                    writeQueue.setFinished(true);
                     while (write->isRunning())
                     {}
                 }
@@ -408,28 +732,19 @@ namespace djv
                     while (running)
                     {
                         bool sleep = false;
+                        auto& readQueue = read->getVideoQueue();
+                        const bool finished = readQueue.isFinished();
+                        if (!readQueue.isEmpty())
                         {
-                            std::unique_lock<std::mutex> lock(read->getMutex(), std::try_to_lock);
-                            if (lock.owns_lock())
-                            {
-                                auto& readQueue = read->getVideoQueue();
-                                if (!readQueue.isEmpty())
-                                {
-                                    auto frame = readQueue.popFrame();
-                                }
-                                else if (readQueue.isFinished())
-                                {
-                                    running = false;
-                                }
-                                else
-                                {
-                                    sleep = true;
-                                }
-                            }
-                            else
-                            {
-                                sleep = true;
-                            }
+                            auto frame = readQueue.popFrame();
+                        }
+                        else if (finished)
+                        {
+                            running = false;
+                        }
+                        else
+                        {
+                            sleep = true;
                         }
                         if (sleep)
                         {
@@ -27,6 +27,8 @@ namespace djv
             void _audioQueue();
             void _inOutPoints();
             void _cache();
+            void _proxy();
+            void _roi();
             void _plugin();
             void _io();
             void _io(
@@ -6,8 +6,14 @@
 
 #include <djvAV/OpenEXR.h>
 
+#include <djvSystem/Path.h>
+
 #include <djvCore/Error.h>
 
+#include <ImfMultiPartOutputFile.h>
+#include <ImfOutputFile.h>
+#include <ImfOutputPart.h>
+#include <ImfPartType.h>
 #include <ImfStandardAttributes.h>
 
 using namespace djv::Core;
@@ -28,6 +34,7 @@ namespace djv
         {
             _enum();
             _data();
+            _io();
             _serialize();
         }
 
@@ -279,6 +286,144 @@ namespace djv
             }
         }
         
+        void OpenEXRTest::_io()
+        {
+            try
+            {
+                // Write a multipart file, the first part has two layers.
+                const std::string fileName = System::File::Path(getTempPath(), "multipart.exr").get();
+                const int width = 4;
+                const int height = 2;
+                const std::vector<std::pair<std::string, std::vector<std::string> > > parts =
+                {
+                    { "beauty", { "R", "G", "B", "specular.R", "specular.G", "specular.B" } },
+                    { "diffuse", { "R", "G", "B" } }
+                };
+                {
+                    std::vector<Imf::Header> headers;
+                    for (const auto& i : parts)
+                    {
+                        Imf::Header header(width, height);
+                        header.setName(i.first);
+                        header.setType(Imf::SCANLINEIMAGE);
+                        for (const auto& j : i.second)
+                        {
+                            header.channels().insert(j, Imf::Channel(Imf::HALF));
+                        }
+                        headers.push_back(header);
+                    }
+                    Imf::MultiPartOutputFile f(fileName.c_str(), headers.data(), static_cast<int>(headers.size()));
+                    for (size_t i = 0; i < parts.size(); ++i)
+                    {
+                        Imf::OutputPart part(f, static_cast<int>(i));
+                        Imf::FrameBuffer frameBuffer;
+                        std::vector<std::vector<half> > buffers;
+                        for (size_t j = 0; j < parts[i].second.size(); ++j)
+                        {
+                            buffers.push_back(std::vector<half>(width * height, static_cast<float>(i * 10 + j)));
+                        }
+                        for (size_t j = 0; j < parts[i].second.size(); ++j)
+                        {
+                            frameBuffer.insert(
+                                parts[i].second[j],
+                                Imf::Slice(
+                                    Imf::HALF,
+                                    reinterpret_cast<char*>(buffers[j].data()),
+                                    sizeof(half),
+                                    sizeof(half) * width));
+                        }
+                        part.setFrameBuffer(frameBuffer);
+                        part.writePixels(height);
+                    }
+                }
+
+                // Read the layers from both parts at once.
+                OpenEXR::InputFile f(fileName, OpenEXR::Channels::Known);
+                DJV_ASSERT(2 == f.getPartCount());
+                const auto& layers = f.getLayers();
+                DJV_ASSERT(3 == layers.size());
+                DJV_ASSERT("beauty.B,G,R" == layers[0].name);
+                DJV_ASSERT("beauty.specular.B,G,R" == layers[1].name);
+                DJV_ASSERT("diffuse.B,G,R" == layers[2].name);
+                const auto images = f.read({ 2, 0, 1, 0 });
+                DJV_ASSERT(4 == images.size());
+                DJV_ASSERT(images[1] == images[3]);
+                const std::vector<std::vector<float> > values = { { 10.F, 11.F, 12.F }, { 0.F, 1.F, 2.F }, { 3.F, 4.F, 5.F } };
+                for (size_t i = 0; i < values.size(); ++i)
+                {
+                    DJV_ASSERT(Image::Type::RGB_F16 == images[i]->getType());
+                    DJV_ASSERT(Image::Size(width, height) == images[i]->getSize());
+                    const Image::F16_T* p = reinterpret_cast<const Image::F16_T*>(images[i]->getData());
+                    for (int j = 0; j < width * height; ++j, p += 3)
+                    {
+                        DJV_ASSERT(values[i][0] == static_cast<float>(p[0]));
+                        DJV_ASSERT(values[i][1] == static_cast<float>(p[1]));
+                        DJV_ASSERT(values[i][2] == static_cast<float>(p[2]));
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _print(Error::format(e.what()));
+                DJV_ASSERT(false);
+            }
+
+            // Read files where the data window is cropped and where it extends
+            // past the display window.
+            for (const auto& dataWindow :
+                {
+                    IMATH_NAMESPACE::Box2i(IMATH_NAMESPACE::V2i(2, 1), IMATH_NAMESPACE::V2i(5, 2)),
+                    IMATH_NAMESPACE::Box2i(IMATH_NAMESPACE::V2i(-2, -1), IMATH_NAMESPACE::V2i(9, 5))
+                })
+            {
+                try
+                {
+                    const std::string fileName = System::File::Path(getTempPath(), "dataWindow.exr").get();
+                    const int width = 8;
+                    const int height = 4;
+                    {
+                        Imf::Header header(width, height);
+                        header.dataWindow() = dataWindow;
+                        header.channels().insert("Y", Imf::Channel(Imf::FLOAT));
+                        const int dataWidth = dataWindow.max.x - dataWindow.min.x + 1;
+                        const int dataHeight = dataWindow.max.y - dataWindow.min.y + 1;
+                        std::vector<float> buf(dataWidth * dataHeight, 1.F);
+                        Imf::FrameBuffer frameBuffer;
+                        frameBuffer.insert(
+                            "Y",
+                            Imf::Slice(
+                                Imf::FLOAT,
+                                reinterpret_cast<char*>(buf.data() - dataWindow.min.x - dataWindow.min.y * dataWidth),
+                                sizeof(float),
+                                sizeof(float) * dataWidth));
+                        Imf::OutputFile f(fileName.c_str(), header);
+                        f.setFrameBuffer(frameBuffer);
+                        f.writePixels(dataHeight);
+                    }
+
+                    OpenEXR::InputFile f(fileName, OpenEXR::Channels::Known);
+                    const auto images = f.read({ 0 });
+                    DJV_ASSERT(Image::Size(width, height) == images[0]->getSize());
+                    const float* p = reinterpret_cast<const float*>(images[0]->getData());
+                    for (int y = 0; y < height; ++y)
+                    {
+                        for (int x = 0; x < width; ++x, ++p)
+                        {
+                            const bool inside =
+                                x >= dataWindow.min.x && x <= dataWindow.max.x &&
+                                y >= dataWindow.min.y && y <= dataWindow.max.y;
+                            DJV_ASSERT((inside ? 1.F : 0.F) == *p);
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    _print(Error::format(e.what()));
+                    DJV_ASSERT(false);
+                }
+            }
+        }
+
         void OpenEXRTest::_serialize()
         {
             {
@@ -20,6 +20,7 @@ namespace djv
         private:
             void _enum();
             void _data();
+            void _io();
             void _serialize();
         };
         
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/WaveformSystemTest.h>
+
+#include <djvAV/WaveformSystem.h>
+
+#include <djvAudio/Waveform.h>
+
+#include <djvSystem/Context.h>
+#include <djvSystem/FileInfo.h>
+#include <djvSystem/ResourceSystem.h>
+#include <djvSystem/Timer.h>
+
+#include <djvCore/Error.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        WaveformSystemTest::WaveformSystemTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITickTest("djv::AVTest::WaveformSystemTest", tempPath, context)
+        {}
+        
+        void WaveformSystemTest::run()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto resourceSystem = context->getSystemT<System::ResourceSystem>();
+                auto system = context->getSystemT<WaveformSystem>();
+                
+                // Request a waveform for a file without audio.
+                std::vector<WaveformSystem::WaveformFuture> futures;
+                const System::File::Info fileInfo(System::File::Path(
+                    resourceSystem->getPath(System::File::ResourcePath::Icons),
+                    "96DPI/djvIconFile.png"));
+                futures.push_back(system->getWaveform(fileInfo));
+                
+                // Request a missing waveform.
+                futures.push_back(system->getWaveform(System::File::Info()));
+
+                // Request and cancel a waveform.
+                auto cancelFuture = system->getWaveform(fileInfo);
+                system->cancelWaveform(cancelFuture.uid);
+
+                // Wait for and collect the waveforms.
+                while (!futures.empty())
+                {
+                    _tickFor(System::getTimerDuration(System::TimerValue::Fast));
+                    auto i = futures.begin();
+                    while (i != futures.end())
+                    {
+                        if (i->future.valid() &&
+                            i->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        {
+                            try
+                            {
+                                const auto waveform = i->future.get();
+                                DJV_ASSERT(!waveform);
+                            }
+                            catch (const std::exception& e)
+                            {
+                                _print(Error::format(e.what()));
+                            }
+                            i = futures.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                }
+                
+                {
+                    std::stringstream ss;
+                    ss << "Cache percentage: " << system->getCachePercentage();
+                    _print(ss.str());
+                }
+                
+                system->clearCache();
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/TickTest.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class WaveformSystemTest : public Test::ITickTest
+        {
+        public:
+            WaveformSystemTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+        };
+        
+    } // namespace AVTest
+} // namespace djv
+
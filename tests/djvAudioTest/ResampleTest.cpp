@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAudioTest/ResampleTest.h>
+
+#include <djvAudio/Resample.h>
+
+#include <djvMath/Math.h>
+
+#include <cmath>
+#include <sstream>
+
+using namespace djv::Core;
+using namespace djv::Audio;
+
+namespace djv
+{
+    namespace AudioTest
+    {
+        namespace
+        {
+            std::vector<F32_T> getSine(size_t sampleCount, uint8_t channelCount, float frequency, size_t sampleRate)
+            {
+                std::vector<F32_T> out(sampleCount * channelCount);
+                for (size_t i = 0; i < sampleCount; ++i)
+                {
+                    const F32_T value = std::sin(Math::pi2 * frequency * i / static_cast<float>(sampleRate));
+                    for (uint8_t c = 0; c < channelCount; ++c)
+                    {
+                        out[i * channelCount + c] = value;
+                    }
+                }
+                return out;
+            }
+
+        } // namespace
+
+        ResampleTest::ResampleTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::AudioTest::ResampleTest", tempPath, context)
+        {}
+
+        void ResampleTest::run()
+        {
+            _channels();
+            _convert();
+            _resample();
+            _blocks();
+        }
+
+        void ResampleTest::_channels()
+        {
+            {
+                const auto matrix = getChannelMatrix(2, 2);
+                DJV_ASSERT(std::vector<float>({ 1.F, 0.F, 0.F, 1.F }) == matrix);
+            }
+
+            {
+                const auto matrix = getChannelMatrix(2, 1);
+                DJV_ASSERT(std::vector<float>({ .5F, .5F }) == matrix);
+            }
+
+            {
+                const auto matrix = getChannelMatrix(1, 2);
+                DJV_ASSERT(std::vector<float>({ 1.F, 1.F }) == matrix);
+            }
+
+            for (uint8_t i = 3; i <= 8; ++i)
+            {
+                for (uint8_t j = 1; j <= 2; ++j)
+                {
+                    const auto matrix = getChannelMatrix(i, j);
+                    DJV_ASSERT(i * j == matrix.size());
+                    for (uint8_t k = 0; k < j; ++k)
+                    {
+                        float sum = 0.F;
+                        for (uint8_t l = 0; l < i; ++l)
+                        {
+                            sum += matrix[k * i + l];
+                        }
+                        DJV_ASSERT(fuzzyCompare(sum, 1.F, .1e-5F));
+                    }
+                }
+            }
+
+            {
+                // 5.1 to stereo, the LFE channel is dropped.
+                const auto matrix = getChannelMatrix(6, 2);
+                const std::vector<F32_T> in = { 0.F, 0.F, 0.F, 1.F, 0.F, 0.F };
+                std::vector<F32_T> out(2);
+                mixChannels(in.data(), out.data(), 1, matrix.data(), 6, 2);
+                DJV_ASSERT(0.F == out[0]);
+                DJV_ASSERT(0.F == out[1]);
+            }
+
+            {
+                const auto matrix = getChannelMatrix(1, 2);
+                const std::vector<F32_T> in = { .25F, .5F };
+                std::vector<F32_T> out(4);
+                mixChannels(in.data(), out.data(), 2, matrix.data(), 1, 2);
+                DJV_ASSERT(std::vector<F32_T>({ .25F, .25F, .5F, .5F }) == out);
+            }
+        }
+
+        void ResampleTest::_convert()
+        {
+            const Info input(2, Type::S16, 48000);
+            const Info output(2, Type::F32, 48000);
+            auto resampler = Resampler::create(input, output, 16);
+            DJV_ASSERT(input == resampler->getInputInfo());
+            DJV_ASSERT(output == resampler->getOutputInfo());
+            DJV_ASSERT(16 == resampler->getBlockSize());
+            DJV_ASSERT(100 == resampler->getOutputSampleCountMax(100));
+
+            std::vector<S16_T> in(100 * 2);
+            for (size_t i = 0; i < in.size(); ++i)
+            {
+                in[i] = static_cast<S16_T>(i * 100);
+            }
+            std::vector<F32_T> out(100 * 2);
+            DJV_ASSERT(100 == resampler->process(
+                reinterpret_cast<const uint8_t*>(in.data()),
+                100,
+                reinterpret_cast<uint8_t*>(out.data())));
+            for (size_t i = 0; i < in.size(); ++i)
+            {
+                F32_T value = 0.F;
+                S16ToF32(in[i], value);
+                DJV_ASSERT(value == out[i]);
+            }
+        }
+
+        void ResampleTest::_resample()
+        {
+            struct Data
+            {
+                uint8_t inChannelCount;
+                size_t inSampleRate;
+                uint8_t outChannelCount;
+                size_t outSampleRate;
+            };
+            for (const auto& i : std::vector<Data>({
+                { 2, 44100, 2, 48000 },
+                { 2, 48000, 2, 44100 },
+                { 8, 96000, 2, 48000 },
+                { 1, 22050, 2, 48000 },
+                { 2, 44100, 2, 44101 } }))
+            {
+                // Resample a sine wave and compare it with the expected
+                // output away from the start and end.
+                const Info input(i.inChannelCount, Type::F32, i.inSampleRate);
+                const Info output(i.outChannelCount, Type::F32, i.outSampleRate);
+                auto resampler = Resampler::create(input, output);
+                const float frequency = 1000.F;
+                const size_t inSampleCount = i.inSampleRate / 4;
+                const auto in = getSine(inSampleCount, i.inChannelCount, frequency, i.inSampleRate);
+                std::vector<F32_T> out(resampler->getOutputSampleCountMax(inSampleCount) * i.outChannelCount);
+                const size_t outSampleCount = resampler->process(
+                    reinterpret_cast<const uint8_t*>(in.data()),
+                    inSampleCount,
+                    reinterpret_cast<uint8_t*>(out.data()));
+                const size_t expected = inSampleCount * i.outSampleRate / i.inSampleRate;
+                DJV_ASSERT(outSampleCount <= expected + 1);
+                DJV_ASSERT(outSampleCount + 256 >= expected);
+
+                const auto sine = getSine(outSampleCount, i.outChannelCount, frequency, i.outSampleRate);
+                float error = 0.F;
+                for (size_t j = 256 * i.outChannelCount; j < outSampleCount * i.outChannelCount; ++j)
+                {
+                    error = std::max(error, std::abs(sine[j] - out[j]));
+                }
+                std::stringstream ss;
+                ss << static_cast<int>(i.inChannelCount) << "/" << i.inSampleRate << " -> " <<
+                    static_cast<int>(i.outChannelCount) << "/" << i.outSampleRate << " error: " << error;
+                _print(ss.str());
+                DJV_ASSERT(error < .01F);
+            }
+
+            {
+                // Frequencies above the output Nyquist frequency should be
+                // filtered out.
+                const Info input(1, Type::F32, 96000);
+                const Info output(1, Type::F32, 48000);
+                auto resampler = Resampler::create(input, output);
+                const size_t inSampleCount = 96000 / 4;
+                const auto in = getSine(inSampleCount, 1, 30000.F, 96000);
+                std::vector<F32_T> out(resampler->getOutputSampleCountMax(inSampleCount));
+                const size_t outSampleCount = resampler->process(
+                    reinterpret_cast<const uint8_t*>(in.data()),
+                    inSampleCount,
+                    reinterpret_cast<uint8_t*>(out.data()));
+                float max = 0.F;
+                for (size_t j = 256; j < outSampleCount; ++j)
+                {
+                    max = std::max(max, std::abs(out[j]));
+                }
+                std::stringstream ss;
+                ss << "alias: " << max;
+                _print(ss.str());
+                DJV_ASSERT(max < .01F);
+            }
+        }
+
+        void ResampleTest::_blocks()
+        {
+            // Converting in blocks of different sizes should give the same
+            // result as converting all at once.
+            const Info input(2, Type::S16, 44100);
+            const Info output(2, Type::F32, 48000);
+            const size_t inSampleCount = 10000;
+            const auto sine = getSine(inSampleCount, 2, 440.F, 44100);
+            std::vector<S16_T> in(sine.size());
+            for (size_t i = 0; i < sine.size(); ++i)
+            {
+                F32ToS16(sine[i], in[i]);
+            }
+
+            auto resampler = Resampler::create(input, output, 256);
+            std::vector<F32_T> out(resampler->getOutputSampleCountMax(inSampleCount) * 2);
+            const size_t outSampleCount = resampler->process(
+                reinterpret_cast<const uint8_t*>(in.data()),
+                inSampleCount,
+                reinterpret_cast<uint8_t*>(out.data()));
+
+            resampler->reset();
+            std::vector<F32_T> out2(out.size());
+            size_t outSampleCount2 = 0;
+            size_t blockSize = 1;
+            for (size_t i = 0; i < inSampleCount; i += blockSize, blockSize = blockSize * 3 % 997 + 1)
+            {
+                const size_t size = std::min(blockSize, inSampleCount - i);
+                const size_t max = resampler->getOutputSampleCountMax(size);
+                const size_t count = resampler->process(
+                    reinterpret_cast<const uint8_t*>(in.data() + i * 2),
+                    size,
+                    reinterpret_cast<uint8_t*>(out2.data() + outSampleCount2 * 2));
+                DJV_ASSERT(count <= max);
+                outSampleCount2 += count;
+            }
+            DJV_ASSERT(outSampleCount == outSampleCount2);
+            for (size_t i = 0; i < outSampleCount * 2; ++i)
+            {
+                DJV_ASSERT(out[i] == out2[i]);
+            }
+        }
+
+    } // namespace AudioTest
+} // namespace djv
+
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AudioTest
+    {
+        class ResampleTest : public Test::ITest
+        {
+        public:
+            ResampleTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+            
+        private:
+            void _channels();
+            void _convert();
+            void _resample();
+            void _blocks();
+        };
+        
+    } // namespace AudioTest
+} // namespace djv
+
@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAudioTest/RingBufferTest.h>
+
+#include <djvAudio/RingBuffer.h>
+
+#include <sstream>
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::Audio;
+
+namespace djv
+{
+    namespace AudioTest
+    {
+        RingBufferTest::RingBufferTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::AudioTest::RingBufferTest", tempPath, context)
+        {}
+
+        void RingBufferTest::run()
+        {
+            _stats();
+            _readWrite();
+            _output();
+            _threads();
+        }
+
+        void RingBufferTest::_stats()
+        {
+            {
+                const RingBufferStats stats;
+                DJV_ASSERT(0 == stats.readCount);
+                DJV_ASSERT(0 == stats.underrunCount);
+                DJV_ASSERT(0 == stats.underrunSampleCount);
+                DJV_ASSERT(stats == RingBufferStats());
+            }
+        }
+
+        void RingBufferTest::_readWrite()
+        {
+            {
+                const Audio::Info info(2, Audio::Type::S16, 48000);
+                auto buffer = RingBuffer::create(info, 10);
+                DJV_ASSERT(info == buffer->getInfo());
+                DJV_ASSERT(10 == buffer->getSampleCount());
+                DJV_ASSERT(0 == buffer->getReadAvailable());
+                DJV_ASSERT(10 == buffer->getWriteAvailable());
+            }
+
+            {
+                const Audio::Info info(2, Audio::Type::S16, 48000);
+                auto buffer = RingBuffer::create(info, 10);
+                std::vector<S16_T> in(16 * 2);
+                for (size_t i = 0; i < in.size(); ++i)
+                {
+                    in[i] = static_cast<S16_T>(i);
+                }
+                std::vector<S16_T> out(16 * 2);
+
+                DJV_ASSERT(6 == buffer->write(reinterpret_cast<const uint8_t*>(in.data()), 6));
+                DJV_ASSERT(6 == buffer->getReadAvailable());
+                DJV_ASSERT(4 == buffer->getWriteAvailable());
+                DJV_ASSERT(4 == buffer->read(reinterpret_cast<uint8_t*>(out.data()), 4));
+                for (size_t i = 0; i < 4 * 2; ++i)
+                {
+                    DJV_ASSERT(in[i] == out[i]);
+                }
+
+                // Wrap around the end of the buffer.
+                DJV_ASSERT(8 == buffer->write(reinterpret_cast<const uint8_t*>(in.data() + 6 * 2), 10));
+                DJV_ASSERT(10 == buffer->getReadAvailable());
+                DJV_ASSERT(0 == buffer->getWriteAvailable());
+                DJV_ASSERT(0 == buffer->write(reinterpret_cast<const uint8_t*>(in.data()), 1));
+                DJV_ASSERT(10 == buffer->read(reinterpret_cast<uint8_t*>(out.data()), 16));
+                for (size_t i = 0; i < 10 * 2; ++i)
+                {
+                    DJV_ASSERT(in[4 * 2 + i] == out[i]);
+                }
+                DJV_ASSERT(0 == buffer->read(reinterpret_cast<uint8_t*>(out.data()), 1));
+
+                // Adjust the volume.
+                DJV_ASSERT(2 == buffer->write(reinterpret_cast<const uint8_t*>(in.data() + 10 * 2), 2));
+                DJV_ASSERT(2 == buffer->read(reinterpret_cast<uint8_t*>(out.data()), 2, 0.F));
+                for (size_t i = 0; i < 2 * 2; ++i)
+                {
+                    DJV_ASSERT(0 == out[i]);
+                }
+
+                buffer->write(reinterpret_cast<const uint8_t*>(in.data()), 5);
+                buffer->reset();
+                DJV_ASSERT(0 == buffer->getReadAvailable());
+                DJV_ASSERT(10 == buffer->getWriteAvailable());
+            }
+        }
+
+        void RingBufferTest::_output()
+        {
+            // Drive the buffer like an audio callback from a fake clock,
+            // with a writer that stalls part of the way through.
+            const Audio::Info info(2, Audio::Type::S16, 48000);
+            const size_t bufferSize = 4096;
+            const size_t blockSize = 256;
+            const size_t frameSize = 1000;
+            const size_t duration = info.sampleRate * 2;
+            const size_t stallStart = info.sampleRate;
+            const size_t stallEnd = stallStart + info.sampleRate / 4;
+            auto buffer = RingBuffer::create(info, bufferSize);
+            std::vector<S16_T> frame(frameSize * 2);
+            std::vector<S16_T> out(blockSize * 2);
+            size_t writeTotal = 0;
+            size_t readTotal = 0;
+            for (size_t clock = 0; clock < duration; clock += blockSize)
+            {
+                if (clock < stallStart || clock >= stallEnd)
+                {
+                    while (buffer->getWriteAvailable() >= frameSize)
+                    {
+                        for (size_t i = 0; i < frameSize; ++i)
+                        {
+                            const S16_T value = static_cast<S16_T>((writeTotal + i) & 0x7fff);
+                            frame[i * 2] = value;
+                            frame[i * 2 + 1] = value;
+                        }
+                        DJV_ASSERT(frameSize == buffer->write(reinterpret_cast<const uint8_t*>(frame.data()), frameSize));
+                        writeTotal += frameSize;
+                    }
+                }
+                if (stallStart == clock)
+                {
+                    DJV_ASSERT(0 == buffer->getStats().underrunCount);
+                }
+
+                const size_t size = buffer->readOutput(reinterpret_cast<uint8_t*>(out.data()), blockSize, 1.F);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    DJV_ASSERT(static_cast<S16_T>((readTotal + i) & 0x7fff) == out[i * 2]);
+                    DJV_ASSERT(static_cast<S16_T>((readTotal + i) & 0x7fff) == out[i * 2 + 1]);
+                }
+                for (size_t i = size; i < blockSize; ++i)
+                {
+                    DJV_ASSERT(0 == out[i * 2]);
+                    DJV_ASSERT(0 == out[i * 2 + 1]);
+                }
+                readTotal += size;
+            }
+
+            const auto stats = buffer->getStats();
+            {
+                std::stringstream ss;
+                ss << "read count: " << stats.readCount;
+                _print(ss.str());
+            }
+            {
+                std::stringstream ss;
+                ss << "underrun count: " << stats.underrunCount;
+                _print(ss.str());
+            }
+            {
+                std::stringstream ss;
+                ss << "underrun sample count: " << stats.underrunSampleCount;
+                _print(ss.str());
+            }
+            DJV_ASSERT(duration / blockSize == stats.readCount);
+            DJV_ASSERT(stats.underrunCount > 0);
+            DJV_ASSERT(stats.readCount * blockSize - readTotal == stats.underrunSampleCount);
+            DJV_ASSERT(writeTotal - readTotal == buffer->getReadAvailable());
+
+            // Running out of samples at the end of the stream is not an
+            // underrun.
+            while (buffer->getReadAvailable() > 0)
+            {
+                buffer->readOutput(reinterpret_cast<uint8_t*>(out.data()), blockSize, 1.F, false);
+            }
+            buffer->readOutput(reinterpret_cast<uint8_t*>(out.data()), blockSize, 1.F, false);
+            DJV_ASSERT(stats.underrunCount == buffer->getStats().underrunCount);
+        }
+
+        void RingBufferTest::_threads()
+        {
+            const Audio::Info info(1, Audio::Type::S32, 48000);
+            auto buffer = RingBuffer::create(info, 1000);
+            const size_t sampleCount = 1000000;
+            std::thread thread(
+                [buffer, sampleCount]
+                {
+                    std::vector<S32_T> data(300);
+                    size_t i = 0;
+                    while (i < sampleCount)
+                    {
+                        const size_t size = std::min(data.size(), sampleCount - i);
+                        for (size_t j = 0; j < size; ++j)
+                        {
+                            data[j] = static_cast<S32_T>(i + j);
+                        }
+                        size_t written = 0;
+                        while (written < size)
+                        {
+                            written += buffer->write(
+                                reinterpret_cast<const uint8_t*>(data.data() + written),
+                                size - written);
+                        }
+                        i += size;
+                    }
+                });
+            std::vector<S32_T> data(256);
+            size_t i = 0;
+            while (i < sampleCount)
+            {
+                const size_t size = buffer->read(reinterpret_cast<uint8_t*>(data.data()), data.size());
+                for (size_t j = 0; j < size; ++j, ++i)
+                {
+                    DJV_ASSERT(static_cast<S32_T>(i) == data[j]);
+                }
+            }
+            thread.join();
+            DJV_ASSERT(0 == buffer->getReadAvailable());
+        }
+
+    } // namespace AudioTest
+} // namespace djv
+
@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAudioTest/WaveformTest.h>
+
+#include <djvAudio/Waveform.h>
+
+#include <djvMath/Math.h>
+
+#include <cmath>
+#include <sstream>
+
+using namespace djv::Core;
+using namespace djv::Audio;
+
+namespace djv
+{
+    namespace AudioTest
+    {
+        namespace
+        {
+            std::vector<F32_T> getSamples(size_t sampleCount, uint8_t channelCount)
+            {
+                std::vector<F32_T> out(sampleCount * channelCount);
+                for (size_t i = 0; i < sampleCount; ++i)
+                {
+                    for (uint8_t c = 0; c < channelCount; ++c)
+                    {
+                        out[i * channelCount + c] = std::sin(i * .01F + c) * (i % 100) / 100.F;
+                    }
+                }
+                return out;
+            }
+
+        } // namespace
+
+        WaveformTest::WaveformTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::AudioTest::WaveformTest", tempPath, context)
+        {}
+
+        void WaveformTest::run()
+        {
+            _peak();
+            _build();
+            _peaks();
+        }
+
+        void WaveformTest::_peak()
+        {
+            {
+                const WaveformPeak peak;
+                DJV_ASSERT(0.F == peak.min);
+                DJV_ASSERT(0.F == peak.max);
+                DJV_ASSERT(0.F == peak.rms);
+                DJV_ASSERT(peak == WaveformPeak());
+            }
+
+            {
+                const std::vector<F32_T> data = { -.5F, .25F, 1.F, 0.F, .5F };
+                const auto peak = getPeak(data.data(), data.size(), 1);
+                DJV_ASSERT(-.5F == peak.min);
+                DJV_ASSERT(1.F == peak.max);
+                DJV_ASSERT(fuzzyCompare(peak.rms, std::sqrt(1.5625F / 5.F)));
+            }
+
+            {
+                const std::vector<F32_T> data = { .5F, -.25F };
+                const auto peak = getPeak(data.data(), 1, 2);
+                DJV_ASSERT(-.25F == peak.min);
+                DJV_ASSERT(.5F == peak.max);
+                DJV_ASSERT(peak == getPeak(data.data(), 2, 1));
+            }
+
+            {
+                const auto peak = getPeak(nullptr, 0, 2);
+                DJV_ASSERT(peak == WaveformPeak());
+            }
+        }
+
+        void WaveformTest::_build()
+        {
+            {
+                const Info info(2, Type::F32, 48000);
+                auto waveform = Waveform::create(info, 4);
+                DJV_ASSERT(info == waveform->getInfo());
+                DJV_ASSERT(4 == waveform->getBlockSize());
+                DJV_ASSERT(0 == waveform->getSampleCount());
+                DJV_ASSERT(1 == waveform->getLevelCount());
+                DJV_ASSERT(waveform->getLevel(0).empty());
+            }
+
+            {
+                // Adding samples in pieces should give the same peaks as
+                // computing them for each block.
+                const Info info(2, Type::F32, 48000);
+                const size_t sampleCount = 37;
+                const auto data = getSamples(sampleCount, 2);
+                auto waveform = Waveform::create(info, 4);
+                size_t size = 1;
+                for (size_t i = 0; i < sampleCount; i += size, size = size % 5 + 1)
+                {
+                    size = std::min(size, sampleCount - i);
+                    waveform->add(data.data() + i * 2, size);
+                }
+                waveform->finish();
+                DJV_ASSERT(sampleCount == waveform->getSampleCount());
+                DJV_ASSERT(5 == waveform->getLevelCount());
+                const auto& level = waveform->getLevel(0);
+                DJV_ASSERT(10 == level.size());
+                for (size_t i = 0; i < level.size(); ++i)
+                {
+                    const size_t start = i * 4;
+                    const auto peak = getPeak(data.data() + start * 2, std::min(sampleCount - start, static_cast<size_t>(4)), 2);
+                    DJV_ASSERT(peak.min == level[i].min);
+                    DJV_ASSERT(peak.max == level[i].max);
+                    DJV_ASSERT(fuzzyCompare(peak.rms, level[i].rms));
+                }
+                for (size_t i = 1; i < waveform->getLevelCount(); ++i)
+                {
+                    const auto& level = waveform->getLevel(i);
+                    const auto& prev = waveform->getLevel(i - 1);
+                    DJV_ASSERT((prev.size() + 1) / 2 == level.size());
+                    for (size_t j = 0; j < level.size(); ++j)
+                    {
+                        const size_t k = std::min(j * 2 + 1, prev.size() - 1);
+                        DJV_ASSERT(std::min(prev[j * 2].min, prev[k].min) == level[j].min);
+                        DJV_ASSERT(std::max(prev[j * 2].max, prev[k].max) == level[j].max);
+                    }
+                }
+
+                // Setting the peaks should rebuild the same pyramid.
+                auto waveform2 = Waveform::create(info, 4);
+                waveform2->setPeaks(level, sampleCount);
+                DJV_ASSERT(sampleCount == waveform2->getSampleCount());
+                DJV_ASSERT(waveform->getLevelCount() == waveform2->getLevelCount());
+                for (size_t i = 0; i < waveform->getLevelCount(); ++i)
+                {
+                    DJV_ASSERT(waveform->getLevel(i) == waveform2->getLevel(i));
+                }
+            }
+        }
+
+        void WaveformTest::_peaks()
+        {
+            {
+                auto waveform = Waveform::create(Info(1, Type::F32, 48000));
+                waveform->finish();
+                WaveformPeak peak;
+                peak.min = 1.F;
+                peak.max = 1.F;
+                peak.rms = 1.F;
+                std::vector<WaveformPeak> peaks(10, peak);
+                waveform->getPeaks(0, 1000, peaks.size(), peaks.data());
+                for (const auto& i : peaks)
+                {
+                    DJV_ASSERT(i == WaveformPeak());
+                }
+            }
+
+            {
+                // The peaks from the pyramid should contain the peaks
+                // computed from the samples at each zoom level.
+                const Info info(2, Type::F32, 48000);
+                const size_t sampleCount = info.sampleRate * 10;
+                const auto data = getSamples(sampleCount, 2);
+                auto waveform = Waveform::create(info, 64);
+                waveform->add(data.data(), sampleCount);
+                waveform->finish();
+                {
+                    std::stringstream ss;
+                    ss << "level count: " << waveform->getLevelCount();
+                    _print(ss.str());
+                }
+                for (const auto& range : std::vector<std::pair<int64_t, int64_t> >({
+                    { 0, static_cast<int64_t>(sampleCount) },
+                    { 1000, 1100 },
+                    { 12345, 123456 },
+                    { 0, 64 * 1024 } }))
+                {
+                    for (size_t peakCount : { 1, 7, 100, 1024 })
+                    {
+                        std::vector<WaveformPeak> peaks(peakCount);
+                        waveform->getPeaks(range.first, range.second, peakCount, peaks.data());
+                        const double samplesPerPeak = (range.second - range.first) / static_cast<double>(peakCount);
+                        for (size_t i = 0; i < peakCount; ++i)
+                        {
+                            const int64_t s0 = range.first + static_cast<int64_t>(i * samplesPerPeak);
+                            const int64_t s1 = std::max(range.first + static_cast<int64_t>((i + 1) * samplesPerPeak), s0 + 1);
+                            const auto peak = getPeak(data.data() + s0 * 2, s1 - s0, 2);
+                            DJV_ASSERT(peaks[i].min <= peak.min);
+                            DJV_ASSERT(peaks[i].max >= peak.max);
+                        }
+                    }
+                }
+
+                // Aligned ranges should give the exact peaks.
+                std::vector<WaveformPeak> peaks(16);
+                waveform->getPeaks(0, 64 * 1024, peaks.size(), peaks.data());
+                for (size_t i = 0; i < peaks.size(); ++i)
+                {
+                    const auto peak = getPeak(data.data() + i * 4096 * 2, 4096, 2);
+                    DJV_ASSERT(peak.min == peaks[i].min);
+                    DJV_ASSERT(peak.max == peaks[i].max);
+                    DJV_ASSERT(fuzzyCompare(peak.rms, peaks[i].rms, .001F));
+                }
+
+                // Peaks outside of the samples should be empty.
+                waveform->getPeaks(-200, 0, peaks.size(), peaks.data());
+                for (const auto& i : peaks)
+                {
+                    DJV_ASSERT(i == WaveformPeak());
+                }
+                waveform->getPeaks(sampleCount, sampleCount * 2, peaks.size(), peaks.data());
+                for (const auto& i : peaks)
+                {
+                    DJV_ASSERT(i == WaveformPeak());
+                }
+            }
+        }
+
+    } // namespace AudioTest
+} // namespace djv
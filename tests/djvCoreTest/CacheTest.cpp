@@ -43,6 +43,52 @@ namespace djv
                 DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2, 3 }));
                 DJV_ASSERT(cache.getValues() == std::vector<std::string>({ "b", "c" }));
             }
+
+            {
+                Memory::Cache<int, std::string> cache;
+                cache.setMax(2);
+                cache.add(1, "a");
+                cache.add(2, "b");
+                std::string value;
+                cache.get(1, value);
+                cache.add(3, "c");
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 1, 3 }));
+                cache.add(1, "d");
+                cache.add(4, "e");
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 1, 4 }));
+                DJV_ASSERT(cache.get(1, value));
+                DJV_ASSERT("d" == value);
+                cache.remove(1);
+                DJV_ASSERT(!cache.contains(1));
+                DJV_ASSERT(1 == cache.getSize());
+                cache.clear();
+                DJV_ASSERT(0 == cache.getSize());
+                DJV_ASSERT(0 == cache.getWeight());
+            }
+
+            {
+                Memory::Cache<int, std::string> cache;
+                cache.setMax(6);
+                cache.setWeightCallback(
+                    [](const std::string& value)
+                    {
+                        return value.size();
+                    });
+                cache.add(1, "aa");
+                cache.add(2, "bb");
+                cache.add(3, "cc");
+                DJV_ASSERT(3 == cache.getSize());
+                DJV_ASSERT(6 == cache.getWeight());
+                DJV_ASSERT(100.F == cache.getPercentageUsed());
+                cache.add(4, "dddd");
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 3, 4 }));
+                DJV_ASSERT(6 == cache.getWeight());
+                cache.setMax(4);
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 4 }));
+                cache.add(5, "eeeee");
+                DJV_ASSERT(0 == cache.getSize());
+                DJV_ASSERT(0 == cache.getWeight());
+            }
         }
         
     } // namespace CoreTest
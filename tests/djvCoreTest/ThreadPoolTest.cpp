@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCoreTest/ThreadPoolTest.h>
+
+#include <djvCore/ThreadPool.h>
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        ThreadPoolTest::ThreadPoolTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::CoreTest::ThreadPoolTest", tempPath, context)
+        {}
+        
+        void ThreadPoolTest::run()
+        {
+            {
+                auto threadPool = Thread::ThreadPool::create(2);
+                DJV_ASSERT(2 == threadPool->getThreadCount());
+                auto queue = threadPool->createQueue(1);
+                DJV_ASSERT(1 == queue->getConcurrency());
+                queue->setConcurrency(0);
+                DJV_ASSERT(1 == queue->getConcurrency());
+            }
+            
+            {
+                auto threadPool = Thread::ThreadPool::create(4);
+                auto queue = threadPool->createQueue(2);
+                auto queue2 = threadPool->createQueue(4);
+                std::atomic<int> running(0);
+                std::atomic<int> runningMax(0);
+                std::vector<std::future<int> > futures;
+                std::vector<std::future<int> > futures2;
+                for (int i = 0; i < 20; ++i)
+                {
+                    futures.push_back(queue->push<int>(
+                        [i, &running, &runningMax]
+                        {
+                            const int r = ++running;
+                            if (r > runningMax)
+                            {
+                                runningMax = r;
+                            }
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                            --running;
+                            return i;
+                        }));
+                    futures2.push_back(queue2->push<int>(
+                        [i]
+                        {
+                            return i;
+                        },
+                        0 == i % 2));
+                }
+                for (int i = 0; i < 20; ++i)
+                {
+                    DJV_ASSERT(i == futures[i].get());
+                    DJV_ASSERT(i == futures2[i].get());
+                }
+                std::stringstream ss;
+                ss << "running max: " << runningMax;
+                _print(ss.str());
+                DJV_ASSERT(runningMax <= 2);
+            }
+
+            {
+                auto threadPool = Thread::ThreadPool::create(1);
+                auto queue = threadPool->createQueue(1);
+                for (int i = 0; i < 20; ++i)
+                {
+                    queue->push<int>(
+                        []
+                        {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                            return 0;
+                        });
+                }
+                queue->finish();
+                DJV_ASSERT(0 == queue->getPendingCount());
+                DJV_ASSERT(0 == queue->getRunningCount());
+            }
+        }
+        
+    } // namespace CoreTest
+} // namespace djv
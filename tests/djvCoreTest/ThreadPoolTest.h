@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        class ThreadPoolTest : public Test::ITest
+        {
+        public:
+            ThreadPoolTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+        };
+        
+    } // namespace CoreTest
+} // namespace djv
+
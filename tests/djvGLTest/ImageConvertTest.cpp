@@ -76,6 +76,11 @@ namespace djv
                 {
                     for (const auto& j : types)
                     {
+                        // The YUV types are only supported as input.
+                        if (Image::isYUVType(j))
+                        {
+                            continue;
+                        }
                         for (const auto& k : {
                             Image::Layout(Image::Mirror(false, false)),
                             Image::Layout(Image::Mirror(true, false)),
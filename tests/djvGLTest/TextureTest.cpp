@@ -6,8 +6,13 @@
 
 #include <djvGL/Texture.h>
 
+#include <djvImage/Convert.h>
 #include <djvImage/Info.h>
 
+#include <djvMath/Math.h>
+
+#include <glm/vec4.hpp>
+
 using namespace djv::Core;
 using namespace djv::GL;
 
@@ -61,6 +66,54 @@ namespace djv
                     auto data2 = Image::Data::create(Image::Info(4, 4, type));
                     texture->copy(*data2, 4, 4);
                     texture->bind();
+#if !defined(DJV_GL_ES2)
+                    DJV_ASSERT((Image::isYUVType(type) && info2.isValid() ? 3 : 1) == texture->getPlaneCount());
+#endif // DJV_GL_ES2
+                }
+            }
+
+            for (const auto type : {
+                Image::Type::YUV_444P_U8,
+                Image::Type::YUV_444P_U10,
+                Image::Type::YUV_444P_U16 })
+            {
+                for (const auto coefficients : Image::getYUVCoefficientsEnums())
+                {
+                    for (const auto range : Image::getYUVRangeEnums())
+                    {
+                        // The shader conversion matches the CPU conversion.
+                        Image::Info info(1, 1, type);
+                        info.yuvCoefficients = coefficients;
+                        info.yuvRange = range;
+                        auto data = Image::Data::create(info);
+                        const float max = static_cast<float>((1 << Image::getBitDepth(type)) - 1);
+                        const float values[] = { max * .6F, max * .3F, max * .7F };
+                        const float textureMax = 1 == Image::getByteCount(type) ? 255.F : 65535.F;
+                        glm::vec4 t(0.F, 0.F, 0.F, 1.F);
+                        for (uint8_t plane = 0; plane < 3; ++plane)
+                        {
+                            const uint16_t value = static_cast<uint16_t>(values[plane]);
+                            if (1 == Image::getByteCount(type))
+                            {
+                                *data->getPlaneData(plane) = static_cast<uint8_t>(value);
+                            }
+                            else
+                            {
+                                *reinterpret_cast<uint16_t*>(data->getPlaneData(plane)) = value;
+                            }
+                            t[plane] = value / textureMax;
+                        }
+                        t = getYUVMatrix(info) * t;
+
+                        const Image::Info rgbInfo(1, 1, Image::Type::RGB_U16);
+                        auto rgb = Image::Data::create(rgbInfo);
+                        Image::Convert::create()->process(*data, rgbInfo, *rgb);
+                        const uint16_t* p = reinterpret_cast<const uint16_t*>(rgb->getData());
+                        for (size_t i = 0; i < 3; ++i)
+                        {
+                            DJV_ASSERT(fabsf(Math::clamp(t[i], 0.F, 1.F) - p[i] / 65535.F) < .005F);
+                        }
+                    }
                 }
             }
         }
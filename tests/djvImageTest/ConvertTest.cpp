@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImageTest/ConvertTest.h>
+
+#include <djvImage/Convert.h>
+#include <djvImage/Data.h>
+
+#include <djvCore/ThreadPool.h>
+
+#include <cmath>
+
+using namespace djv::Core;
+using namespace djv::Image;
+
+namespace djv
+{
+    namespace ImageTest
+    {
+        ConvertTest::ConvertTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::ImageTest::ConvertTest", tempPath, context)
+        {}
+        
+        void ConvertTest::run()
+        {
+            for (const auto& threadPool : { std::shared_ptr<Thread::ThreadPool>(), Thread::ThreadPool::create(4) })
+            {
+                auto convert = Convert::create(threadPool);
+
+                const Size size(37, 101);
+                const Layout layout(Mirror(true, true), 4, Memory::opposite(Memory::getEndian()));
+                auto data = Data::create(Info(size, Type::RGB_U16, layout));
+                for (uint16_t y = 0; y < size.h; ++y)
+                {
+                    for (uint16_t x = 0; x < size.w; ++x)
+                    {
+                        U16_T* p = reinterpret_cast<U16_T*>(data->getData(x, y));
+                        for (size_t c = 0; c < 3; ++c)
+                        {
+                            const U16_T value = x * 1000 + y * 10 + c;
+                            Memory::endian(&value, p + c, 1, 2);
+                        }
+                    }
+                }
+
+                const Info info(size, Type::RGBA_U8, Layout(Mirror(), 4));
+                auto out = Data::create(info);
+                convert->process(*data, info, *out);
+                for (uint16_t y = 0; y < size.h; ++y)
+                {
+                    for (uint16_t x = 0; x < size.w; ++x)
+                    {
+                        const U8_T* p = out->getData(x, y);
+                        for (size_t c = 0; c < 3; ++c)
+                        {
+                            const U16_T value = (size.w - 1 - x) * 1000 + (size.h - 1 - y) * 10 + c;
+                            U8_T u8 = 0;
+                            convert_U16_U8(value, u8);
+                            DJV_ASSERT(u8 == p[c]);
+                        }
+                        DJV_ASSERT(U8Range.getMax() == p[3]);
+                    }
+                }
+
+                try
+                {
+                    convert->process(*data, Info(Size(1, 1), Type::RGBA_U8), *out);
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+
+            for (const auto& threadPool : { std::shared_ptr<Thread::ThreadPool>(), Thread::ThreadPool::create(4) })
+            {
+                auto convert = Convert::create(threadPool);
+
+                // Video range black, white, and the BT.709 primaries.
+                const Size size(35, 67);
+                auto data = Data::create(Info(size, Type::YUV_420P_U8));
+                struct YUV
+                {
+                    U8_T y;
+                    U8_T cb;
+                    U8_T cr;
+                    U8_T r;
+                    U8_T g;
+                    U8_T b;
+                };
+                const std::vector<YUV> values =
+                {
+                    {  16, 128, 128,   0,   0,   0 },
+                    { 235, 128, 128, 255, 255, 255 },
+                    {  63, 102, 240, 255,   0,   0 },
+                    { 173,  42,  26,   0, 255,   0 },
+                    {  32, 240, 118,   0,   0, 255 }
+                };
+                for (uint16_t y = 0; y < size.h; ++y)
+                {
+                    for (uint16_t x = 0; x < size.w; ++x)
+                    {
+                        const auto& value = values[((y / 2) + (x / 2)) % values.size()];
+                        data->getPlaneData(0, y)[x] = value.y;
+                        data->getPlaneData(1, y / 2)[x / 2] = value.cb;
+                        data->getPlaneData(2, y / 2)[x / 2] = value.cr;
+                    }
+                }
+
+                const Info info(size, Type::RGB_U8);
+                auto out = Data::create(info);
+                convert->process(*data, info, *out);
+                for (uint16_t y = 0; y < size.h; ++y)
+                {
+                    for (uint16_t x = 0; x < size.w; ++x)
+                    {
+                        const auto& value = values[((y / 2) + (x / 2)) % values.size()];
+                        const U8_T* p = out->getData(x, y);
+                        DJV_ASSERT(std::abs(value.r - p[0]) <= 2);
+                        DJV_ASSERT(std::abs(value.g - p[1]) <= 2);
+                        DJV_ASSERT(std::abs(value.b - p[2]) <= 2);
+                    }
+                }
+
+                // Copy the planes with mirroring.
+                const Info mirrorInfo(size, Type::YUV_420P_U8, Layout(Mirror(true, true)));
+                auto mirror = Data::create(mirrorInfo);
+                convert->process(*data, mirrorInfo, *mirror);
+                for (uint8_t plane = 0; plane < mirrorInfo.getPlaneCount(); ++plane)
+                {
+                    const Size planeSize = mirrorInfo.getPlaneSize(plane);
+                    for (uint16_t y = 0; y < planeSize.h; ++y)
+                    {
+                        for (uint16_t x = 0; x < planeSize.w; ++x)
+                        {
+                            DJV_ASSERT(
+                                data->getPlaneData(plane, y)[x] ==
+                                mirror->getPlaneData(plane, planeSize.h - 1 - y)[planeSize.w - 1 - x]);
+                        }
+                    }
+                }
+
+                try
+                {
+                    auto yuv = Data::create(Info(size, Type::YUV_444P_U8));
+                    convert->process(*out, yuv->getInfo(), *yuv);
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+        }
+        
+    } // namespace ImageTest
+} // namespace djv
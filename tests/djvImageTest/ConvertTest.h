@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace ImageTest
+    {
+        class ConvertTest : public Test::ITest
+        {
+        public:
+            ConvertTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+        };
+        
+    } // namespace ImageTest
+} // namespace djv
+
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvImageTest/DataPoolTest.h>
+
+#include <djvImage/Data.h>
+#include <djvImage/DataPool.h>
+
+#include <djvCore/Memory.h>
+
+#include <sstream>
+
+using namespace djv::Core;
+using namespace djv::Image;
+
+namespace djv
+{
+    namespace ImageTest
+    {
+        DataPoolTest::DataPoolTest(
+            const System::File::Path& tempPath,
+            const std::shared_ptr<System::Context>& context) :
+            ITest("djv::ImageTest::DataPoolTest", tempPath, context)
+        {}
+        
+        void DataPoolTest::run()
+        {
+            _pool();
+            _max();
+            _data();
+        }
+                
+        void DataPoolTest::_pool()
+        {
+            {
+                auto pool = DataPool::create(Memory::megabyte);
+                DJV_ASSERT(Memory::megabyte == pool->getMaxByteCount());
+                DJV_ASSERT(!pool->hasHugePages());
+                DJV_ASSERT(DataPoolStats() == pool->getStats());
+                DJV_ASSERT(0.F == pool->getStats().getHitRate());
+                DJV_ASSERT(!pool->acquire(0));
+            }
+
+            {
+                auto pool = DataPool::create(Memory::megabyte);
+                uint8_t* a = pool->acquire(100);
+                DJV_ASSERT(a);
+                DJV_ASSERT(0 == reinterpret_cast<uintptr_t>(a) % 64);
+                uint8_t* b = pool->acquire(100);
+                DJV_ASSERT(b && b != a);
+                auto stats = pool->getStats();
+                DJV_ASSERT(2 == stats.acquireCount);
+                DJV_ASSERT(0 == stats.hitCount);
+                DJV_ASSERT(0 == stats.pooledByteCount);
+                DJV_ASSERT(stats.outstandingByteCount >= 200);
+
+                pool->release(a);
+                stats = pool->getStats();
+                DJV_ASSERT(stats.pooledByteCount > 0);
+
+                // Buffers in the same size class are re-used.
+                uint8_t* c = pool->acquire(200);
+                DJV_ASSERT(c == a);
+                stats = pool->getStats();
+                DJV_ASSERT(1 == stats.hitCount);
+                DJV_ASSERT(0 == stats.pooledByteCount);
+
+                // Buffers in a different size class are not.
+                pool->release(c);
+                uint8_t* d = pool->acquire(Memory::megabyte / 2);
+                DJV_ASSERT(d != c);
+                stats = pool->getStats();
+                DJV_ASSERT(1 == stats.hitCount);
+                {
+                    std::stringstream ss;
+                    ss << "hit rate: " << stats.getHitRate() << "%";
+                    _print(ss.str());
+                }
+
+                pool->release(b);
+                pool->release(d);
+                stats = pool->getStats();
+                DJV_ASSERT(0 == stats.outstandingByteCount);
+                pool->clear();
+                DJV_ASSERT(0 == pool->getStats().pooledByteCount);
+            }
+
+            {
+                auto pool = DataPool::create(Memory::megabyte);
+                pool->setHugePages(true);
+                DJV_ASSERT(pool->hasHugePages());
+                uint8_t* a = pool->acquire(3 * Memory::megabyte);
+                DJV_ASSERT(a);
+                a[3 * Memory::megabyte - 1] = 1;
+                pool->release(a);
+            }
+        }
+
+        void DataPoolTest::_max()
+        {
+            auto pool = DataPool::create(Memory::megabyte);
+            uint8_t* a = pool->acquire(Memory::megabyte / 2);
+            uint8_t* b = pool->acquire(Memory::megabyte / 2);
+            uint8_t* c = pool->acquire(Memory::megabyte / 2);
+            pool->release(a);
+            pool->release(b);
+            pool->release(c);
+
+            // The least recently released buffer is freed.
+            auto stats = pool->getStats();
+            DJV_ASSERT(stats.pooledByteCount <= Memory::megabyte);
+            DJV_ASSERT(pool->acquire(Memory::megabyte / 2) == c);
+            DJV_ASSERT(pool->acquire(Memory::megabyte / 2) == b);
+
+            pool->setMaxByteCount(0);
+            DJV_ASSERT(0 == pool->getStats().pooledByteCount);
+            pool->release(b);
+            pool->release(c);
+            DJV_ASSERT(0 == pool->getStats().pooledByteCount);
+
+            // The least recently released buffers are freed whatever their
+            // size class, here a and b.
+            pool->setMaxByteCount(Memory::megabyte);
+            a = pool->acquire(100);
+            b = pool->acquire(Memory::megabyte / 2);
+            c = pool->acquire(Memory::megabyte / 2);
+            uint8_t* d = pool->acquire(100);
+            pool->release(a);
+            pool->release(b);
+            pool->release(d);
+            pool->release(c);
+            DJV_ASSERT(2 == pool->getStats().hitCount);
+            DJV_ASSERT(pool->acquire(100) == d);
+            DJV_ASSERT(pool->acquire(Memory::megabyte / 2) == c);
+            DJV_ASSERT(pool->acquire(Memory::megabyte / 2) != b);
+            DJV_ASSERT(4 == pool->getStats().hitCount);
+        }
+
+        void DataPoolTest::_data()
+        {
+            auto pool = DataPool::create(Memory::megabyte);
+            const Info info(64, 64, Type::RGBA_U8);
+            const uint8_t* p = nullptr;
+            {
+                auto data = Data::create(info, pool);
+                DJV_ASSERT(data->isValid());
+                DJV_ASSERT(0 == reinterpret_cast<uintptr_t>(data->getData()) % 64);
+                data->zero();
+                p = data->getData();
+                DJV_ASSERT(pool->getStats().outstandingByteCount >= info.getDataByteCount());
+            }
+            DJV_ASSERT(0 == pool->getStats().outstandingByteCount);
+            {
+                auto data = Data::create(info, pool);
+                DJV_ASSERT(p == data->getData());
+                DJV_ASSERT(1 == pool->getStats().hitCount);
+            }
+            {
+                auto data = Data::create(info);
+                DJV_ASSERT(0 == reinterpret_cast<uintptr_t>(data->getData()) % 64);
+            }
+        }
+
+    } // namespace ImageTest
+} // namespace djv
+
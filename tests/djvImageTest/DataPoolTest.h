@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace ImageTest
+    {
+        class DataPoolTest : public Test::ITest
+        {
+        public:
+            DataPoolTest(
+                const System::File::Path& tempPath,
+                const std::shared_ptr<System::Context>&);
+            
+            void run() override;
+        
+        private:
+            void _pool();
+            void _max();
+            void _data();
+        };
+        
+    } // namespace ImageTest
+} // namespace djv
+
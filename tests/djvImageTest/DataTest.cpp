@@ -7,6 +7,9 @@
 #include <djvImage/Color.h>
 #include <djvImage/Data.h>
 
+#include <djvSystem/FileIO.h>
+#include <djvSystem/Path.h>
+
 #include <djvCore/Memory.h>
 
 using namespace djv::Core;
@@ -25,6 +28,7 @@ namespace djv
         void DataTest::run()
         {
             _data();
+            _mmap();
             _operators();
         }
                 
@@ -86,6 +90,61 @@ namespace djv
             }
         }
 
+        void DataTest::_mmap()
+        {
+            {
+                auto data = Image::Data::create(Image::Info(1, 2, Image::Type::RGB_U8));
+                DJV_ASSERT(!data->isMapped());
+                const uint8_t* p = data->getData();
+                data->detach();
+                DJV_ASSERT(p == data->getData());
+            }
+
+#if defined(DJV_MMAP)
+            {
+                const Image::Info info(4, 2, Image::Type::RGBA_U8);
+                const std::string fileName = System::File::Path(getTempPath(), "DataTest.raw").get();
+                {
+                    auto io = System::File::IO::create();
+                    io->open(fileName, System::File::Mode::Write);
+                    io->writeU8(0);
+                    for (size_t i = 0; i < info.getDataByteCount(); ++i)
+                    {
+                        io->writeU8(static_cast<uint8_t>(i));
+                    }
+                }
+
+                auto io = System::File::IO::create();
+                io->open(fileName, System::File::Mode::Read);
+                io->seek(1);
+                auto data = Image::Data::create(info, io);
+                DJV_ASSERT(data->isMapped());
+                DJV_ASSERT(io->isEOF());
+                const auto& constData = *data;
+                DJV_ASSERT(io->mmapP() - info.getDataByteCount() == constData.getData());
+                for (size_t i = 0; i < info.getDataByteCount(); ++i)
+                {
+                    DJV_ASSERT(static_cast<uint8_t>(i) == constData.getData()[i]);
+                }
+
+                // Writing to the data makes a copy.
+                data->getData()[0] = 255;
+                DJV_ASSERT(!data->isMapped());
+                DJV_ASSERT(255 == constData.getData()[0]);
+                DJV_ASSERT(1 == constData.getData()[1]);
+
+                try
+                {
+                    io->setPos(1);
+                    auto data2 = Image::Data::create(Image::Info(4, 4, Image::Type::RGBA_U8), io);
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+#endif // DJV_MMAP
+        }
+
         void DataTest::_operators()
         {
             {
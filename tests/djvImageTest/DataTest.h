@@ -19,6 +19,7 @@ namespace djv
         
         private:
             void _data();
+            void _mmap();
             void _operators();
             void _util();
         };
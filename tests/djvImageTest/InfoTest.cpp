@@ -185,6 +185,33 @@ namespace djv
                     _print(ss.str());
                 }
             }
+
+            {
+                const Image::Info info(5, 3, Image::Type::RGB_U8, Image::Layout(Image::Mirror(), 4));
+                DJV_ASSERT(1 == info.getPlaneCount());
+                DJV_ASSERT(info.size == info.getPlaneSize(0));
+                DJV_ASSERT(16 == info.getScanlineByteCount());
+                DJV_ASSERT(48 == info.getDataByteCount());
+            }
+
+            {
+                const Image::Info info(5, 3, Image::Type::YUV_420P_U10, Image::Layout(Image::Mirror(), 4));
+                DJV_ASSERT(3 == info.getPlaneCount());
+                DJV_ASSERT(Image::Size(5, 3) == info.getPlaneSize(0));
+                DJV_ASSERT(Image::Size(3, 2) == info.getPlaneSize(1));
+                DJV_ASSERT(Image::Size(3, 2) == info.getPlaneSize(2));
+                DJV_ASSERT(12 == info.getScanlineByteCount());
+                DJV_ASSERT(8 == info.getPlaneScanlineByteCount(1));
+                DJV_ASSERT(36 == info.getPlaneByteCount(0));
+                DJV_ASSERT(16 == info.getPlaneByteCount(1));
+                DJV_ASSERT(36 == info.getPlaneOffset(1));
+                DJV_ASSERT(52 == info.getPlaneOffset(2));
+                DJV_ASSERT(68 == info.getDataByteCount());
+
+                Image::Info info2 = info;
+                info2.yuvRange = Image::YUVRange::Full;
+                DJV_ASSERT(info != info2);
+            }
         }
 
         void InfoTest::_serialize()
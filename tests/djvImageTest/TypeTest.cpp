@@ -8,6 +8,10 @@
 
 #include <djvMath/Range.h>
 
+#include <djvCore/Random.h>
+
+#include <cstring>
+
 using namespace djv::Core;
 using namespace djv::Image;
 
@@ -26,7 +30,9 @@ namespace djv
             _enum();
             _constants();
             _util();
+            _yuv();
             _convert();
+            _convertISA();
             _serialize();
         }
                 
@@ -190,6 +196,52 @@ namespace djv
             }
         }
 
+        void TypeTest::_yuv()
+        {
+            for (auto i : Image::getYUVCoefficientsEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                _print("YUV coefficients: " + _getText(ss.str()));
+            }
+
+            for (auto i : Image::getYUVRangeEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                _print("YUV range: " + _getText(ss.str()));
+            }
+
+            DJV_ASSERT(!Image::isYUVType(Image::Type::RGBA_U8));
+            DJV_ASSERT(1 == Image::getPlaneCount(Image::Type::RGBA_U8));
+            DJV_ASSERT(Image::Type::RGBA_U8 == Image::getYUVConvertType(Image::Type::RGBA_U8));
+
+            struct Data
+            {
+                Image::Type type;
+                uint8_t shiftX;
+                uint8_t shiftY;
+                Image::Type convertType;
+            };
+            for (const auto& i : std::vector<Data>({
+                { Image::Type::YUV_420P_U8, 1, 1, Image::Type::RGB_U8 },
+                { Image::Type::YUV_422P_U8, 1, 0, Image::Type::RGB_U8 },
+                { Image::Type::YUV_444P_U8, 0, 0, Image::Type::RGB_U8 },
+                { Image::Type::YUV_420P_U10, 1, 1, Image::Type::RGB_U16 },
+                { Image::Type::YUV_422P_U10, 1, 0, Image::Type::RGB_U16 },
+                { Image::Type::YUV_444P_U10, 0, 0, Image::Type::RGB_U16 },
+                { Image::Type::YUV_420P_U16, 1, 1, Image::Type::RGB_U16 },
+                { Image::Type::YUV_422P_U16, 1, 0, Image::Type::RGB_U16 },
+                { Image::Type::YUV_444P_U16, 0, 0, Image::Type::RGB_U16 } }))
+            {
+                DJV_ASSERT(Image::isYUVType(i.type));
+                DJV_ASSERT(3 == Image::getPlaneCount(i.type));
+                DJV_ASSERT(i.shiftX == Image::getChromaShiftX(i.type));
+                DJV_ASSERT(i.shiftY == Image::getChromaShiftY(i.type));
+                DJV_ASSERT(i.convertType == Image::getYUVConvertType(i.type));
+            }
+        }
+
 #define CONVERT(A, RANGE, B) \
     { \
         auto bMin = static_cast<Image::B##_T>(0); \
@@ -280,6 +332,63 @@ namespace djv
             }
         }
 
+        void TypeTest::_convertISA()
+        {
+            // Compare the vectorized conversions with the scalar ones. The
+            // sizes are chosen to exercise the loop remainders.
+            const Image::ConvertISA isa = Image::getConvertISA();
+            {
+                std::stringstream ss;
+                ss << "Convert ISA: " << static_cast<int>(isa) << "/" << static_cast<int>(Image::getConvertISAMax());
+                _print(ss.str());
+            }
+            for (auto inType : Image::getTypeEnums())
+            {
+                for (auto outType : Image::getTypeEnums())
+                {
+                    for (size_t size : { 0, 1, 3, 5, 7, 15, 17, 33, 1001 })
+                    {
+                        std::vector<uint8_t> in(Image::getByteCount(inType) * size);
+                        switch (Image::getDataType(inType))
+                        {
+                        case Image::DataType::F16:
+                            for (size_t i = 0; i < in.size() / sizeof(Image::F16_T); ++i)
+                            {
+                                const Image::F16_T value = Core::Random::getRandom(-.5F, 1.5F);
+                                memcpy(in.data() + i * sizeof(Image::F16_T), &value, sizeof(Image::F16_T));
+                            }
+                            break;
+                        case Image::DataType::F32:
+                            for (size_t i = 0; i < in.size() / sizeof(Image::F32_T); ++i)
+                            {
+                                const Image::F32_T value = Core::Random::getRandom(-.5F, 1.5F);
+                                memcpy(in.data() + i * sizeof(Image::F32_T), &value, sizeof(Image::F32_T));
+                            }
+                            break;
+                        default:
+                            for (auto& i : in)
+                            {
+                                i = static_cast<uint8_t>(Core::Random::getRandom(255));
+                            }
+                            break;
+                        }
+                        const size_t outByteCount = Image::getByteCount(outType) * size;
+                        std::vector<uint8_t> scalar(outByteCount, 0);
+                        Image::setConvertISA(Image::ConvertISA::Scalar);
+                        Image::convert(in.data(), inType, scalar.data(), outType, size);
+                        for (size_t i = 1; i <= static_cast<size_t>(Image::getConvertISAMax()); ++i)
+                        {
+                            std::vector<uint8_t> out(outByteCount, 0);
+                            Image::setConvertISA(static_cast<Image::ConvertISA>(i));
+                            Image::convert(in.data(), inType, out.data(), outType, size);
+                            DJV_ASSERT(scalar == out);
+                        }
+                    }
+                }
+            }
+            Image::setConvertISA(isa);
+        }
+
         void TypeTest::_serialize()
         {
             {
@@ -21,7 +21,9 @@ namespace djv
             void _enum();
             void _constants();
             void _util();
+            void _yuv();
             void _convert();
+            void _convertISA();
             void _serialize();
         };
         
@@ -91,6 +91,29 @@ namespace djv
                 sequence.add(Frame::Range(12, 100));
                 DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 10));
             }
+
+            {
+                Frame::Sequence sequence;
+                for (Frame::Number i = 0; i < 1000; i += 2)
+                {
+                    sequence.add(Frame::Range(i));
+                }
+                DJV_ASSERT(500 == sequence.getRanges().size());
+                DJV_ASSERT(500 == sequence.getFrameCount());
+                DJV_ASSERT(998 == sequence.getFrame(499));
+                DJV_ASSERT(Frame::invalid == sequence.getFrame(500));
+                DJV_ASSERT(250 == sequence.getIndex(500));
+                DJV_ASSERT(Frame::invalidIndex == sequence.getIndex(501));
+                DJV_ASSERT(!sequence.contains(501));
+                sequence.add(Frame::Range(1, 9));
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(0, 10));
+                DJV_ASSERT(495 == sequence.getRanges().size());
+                DJV_ASSERT(505 == sequence.getFrameCount());
+                DJV_ASSERT(10 == sequence.getFrame(10));
+                DJV_ASSERT(12 == sequence.getFrame(11));
+                DJV_ASSERT(255 == sequence.getIndex(500));
+                DJV_ASSERT(504 == sequence.getLastIndex());
+            }
         }
                 
         void FrameNumberTest::_operators()
@@ -175,6 +198,12 @@ namespace djv
                 DJV_ASSERT(8 == ranges[2].getMax());
             }
             
+            {
+                std::vector<Frame::Number> frames = { 8, 3, 1, 6, 2, 5, 3 };
+                const auto sequence = Frame::fromFrames(frames);
+                DJV_ASSERT(Frame::Sequence({ Frame::Range(1, 3), Frame::Range(5, 6), Frame::Range(8) }) == sequence);
+            }
+
             {
                 const Frame::Sequence sequence(
                 {
@@ -7,6 +7,9 @@
 #include <djvSystem/DirectoryModel.h>
 #include <djvSystem/FileIO.h>
 
+#include <algorithm>
+#include <cstdio>
+
 using namespace djv::Core;
 using namespace djv::System;
 
@@ -32,6 +35,7 @@ namespace djv
                 File::Path path;
                 std::vector<File::Info> info;
                 std::vector<std::string> fileNames;
+                std::vector<File::DirectoryChange> changes;
                 bool hasUp = false;
                 std::vector<File::Path> history;
                 size_t historyIndex = 0;
@@ -57,6 +61,12 @@ namespace djv
                     {
                         fileNames = value;
                     });
+                auto changesObserver = Observer::List<File::DirectoryChange>::create(
+                    model->observeChanges(),
+                    [&changes](const std::vector<File::DirectoryChange>& value)
+                    {
+                        changes.insert(changes.end(), value.begin(), value.end());
+                    });
                 auto hasUpObserver = Observer::Value<bool>::create(
                     model->observeHasUp(),
                     [&hasUp](bool value)
@@ -150,13 +160,93 @@ namespace djv
                 
                 _tickFor(std::chrono::milliseconds(1000));
 
-                auto io = File::IO::create();
-                io->open(
-                    File::Path(path, "file.txt").get(),
-                    File::Mode::Write);
-                io->close();
+                auto hasChange = [&changes](File::DirectoryChangeType type, const std::string& fileName)
+                {
+                    File::DirectoryChange change;
+                    change.type = type;
+                    change.fileName = fileName;
+                    return std::find(changes.begin(), changes.end(), change) != changes.end();
+                };
+                auto hasFileName = [&fileNames](const std::string& value)
+                {
+                    return std::find(fileNames.begin(), fileNames.end(), value) != fileNames.end();
+                };
+                auto writeFile = [path](const std::string& fileName)
+                {
+                    auto io = File::IO::create();
+                    io->open(
+                        File::Path(path, fileName).get(),
+                        File::Mode::Write);
+                    io->close();
+                };
+                auto removeFile = [path](const std::string& fileName)
+                {
+                    std::remove(File::Path(path, fileName).get().c_str());
+                };
+                
+                {
+                    changes.clear();
+                    writeFile("file.txt");
+                    _tickFor(std::chrono::milliseconds(2000));
+                    DJV_ASSERT(hasChange(File::DirectoryChangeType::Added, "file.txt"));
+                    DJV_ASSERT(hasFileName("file.txt"));
 
-                _tickFor(std::chrono::milliseconds(1000));
+                    changes.clear();
+                    removeFile("file.txt");
+                    _tickFor(std::chrono::milliseconds(2000));
+                    DJV_ASSERT(hasChange(File::DirectoryChangeType::Removed, "file.txt"));
+                    DJV_ASSERT(!hasFileName("file.txt"));
+                }
+
+                {
+                    changes.clear();
+                    writeFile("seq.1.txt");
+                    _tickFor(std::chrono::milliseconds(2000));
+                    DJV_ASSERT(hasChange(File::DirectoryChangeType::Added, "seq.1.txt"));
+                    DJV_ASSERT(hasFileName("seq.1.txt"));
+
+                    // Adding a frame turns the file into a sequence.
+                    changes.clear();
+                    writeFile("seq.2.txt");
+                    _tickFor(std::chrono::milliseconds(2000));
+                    const auto i = std::find_if(
+                        info.begin(),
+                        info.end(),
+                        [](const File::Info& value)
+                        {
+                            return File::Type::Sequence == value.getType();
+                        });
+                    DJV_ASSERT(i != info.end());
+                    DJV_ASSERT(2 == i->getSequence().getFrameCount());
+                    const std::string sequenceFileName = i->getFileName(Math::Frame::invalid, false);
+                    DJV_ASSERT(hasChange(File::DirectoryChangeType::Modified, sequenceFileName));
+                    DJV_ASSERT(hasFileName(sequenceFileName));
+                    DJV_ASSERT(!hasFileName("seq.1.txt"));
+                    DJV_ASSERT(!hasFileName("seq.2.txt"));
+
+                    // Removing a frame turns the sequence back into a file.
+                    changes.clear();
+                    removeFile("seq.2.txt");
+                    _tickFor(std::chrono::milliseconds(2000));
+                    DJV_ASSERT(hasChange(File::DirectoryChangeType::Modified, "seq.1.txt"));
+                    DJV_ASSERT(hasFileName("seq.1.txt"));
+                    DJV_ASSERT(!hasFileName(sequenceFileName));
+                }
+
+                {
+                    // When there are too many changes the directory is listed
+                    // again instead.
+                    model->setChangesMax(0);
+                    changes.clear();
+                    writeFile("a.txt");
+                    writeFile("b.txt");
+                    removeFile("seq.1.txt");
+                    _tickFor(std::chrono::milliseconds(2000));
+                    DJV_ASSERT(changes.empty());
+                    DJV_ASSERT(hasFileName("a.txt"));
+                    DJV_ASSERT(hasFileName("b.txt"));
+                    DJV_ASSERT(!hasFileName("seq.1.txt"));
+                }
             }
         }
         
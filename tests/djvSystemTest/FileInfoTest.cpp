@@ -9,6 +9,8 @@
 
 #include <djvMath/FrameNumber.h>
 
+#include <djvCore/ThreadPool.h>
+
 #include <iomanip>
 #include <sstream>
 
@@ -223,6 +225,22 @@ namespace djv
                 File::Info info("render.1.exr");
                 DJV_ASSERT(!info.isCompatible(File::Info("/tmp/render.1.exr")));
             }
+
+            {
+                File::Info info("render.0001.exr", false);
+                info.addToSequence(File::Info("render.0002.exr", false));
+                info.addToSequence(File::Info("render.0003.exr", false));
+                DJV_ASSERT(info.removeFromSequence(File::Info("render.0002.exr", false)));
+                DJV_ASSERT(!info.removeFromSequence(File::Info("render.0002.exr", false)));
+                DJV_ASSERT(!info.removeFromSequence(File::Info("snapshot.0001.exr", false)));
+                const std::vector<Math::Frame::Range> ranges =
+                {
+                    Math::Frame::Range(1),
+                    Math::Frame::Range(3)
+                };
+                DJV_ASSERT(Math::Frame::Sequence(ranges, 4) == info.getSequence());
+                DJV_ASSERT("render.0001,0003.exr" == info.getFileName(Math::Frame::invalid, false));
+            }
         }
 
         void FileInfoTest::_operators()
@@ -309,6 +327,73 @@ namespace djv
                 const auto info = File::getSequence(path, {});
                 DJV_ASSERT(info.getPath() == path);
             }
+
+            {
+                // Group files with gaps, padding, and different names into
+                // sequences.
+                const File::Path path(getTempPath(), "FileInfoTestSequences");
+                if (!File::Info(path).doesExist())
+                {
+                    File::mkdir(path);
+                }
+                auto io = File::IO::create();
+                for (const auto& i : {
+                    "shot.0003.exr",
+                    "shot.0010.exr",
+                    "shot.0001.exr",
+                    "shot.0002.exr",
+                    "shot.0005.exr",
+                    "shot.0001.tif",
+                    "other.1.exr",
+                    "notes.txt" })
+                {
+                    io->open(File::Path(path, i).get(), File::Mode::Write);
+                    io->write(std::string("1234"));
+                    io->close();
+                }
+                File::DirectoryListOptions options;
+                options.sequences = true;
+                options.sequenceExtensions = { ".exr" };
+                const auto list = File::directoryList(path, options);
+                std::vector<std::string> fileNames;
+                for (const auto& i : list)
+                {
+                    fileNames.push_back(i.getFileName(Math::Frame::invalid, false));
+                }
+                DJV_ASSERT(std::vector<std::string>({
+                    "notes.txt",
+                    "other.1.exr",
+                    "shot.0001-0003,0005,0010.exr",
+                    "shot.0001.tif" }) == fileNames);
+                DJV_ASSERT(File::Type::File == list[1].getType());
+                DJV_ASSERT(File::Type::Sequence == list[2].getType());
+                DJV_ASSERT(5 == list[2].getSequence().getFrameCount());
+                DJV_ASSERT(4 == list[2].getSequence().getPad());
+                DJV_ASSERT(5 * 4 == list[2].getSize());
+                DJV_ASSERT(list[2].doesExist());
+
+                // List without getting information from the file system and
+                // get it afterwards in parallel.
+                options.stat = false;
+                auto list2 = File::directoryList(path, options);
+                DJV_ASSERT(list.size() == list2.size());
+                DJV_ASSERT(!list2[2].doesExist());
+                DJV_ASSERT(0 == list2[2].getSize());
+                File::stat(list2, Thread::ThreadPool::create(2));
+                for (size_t i = 0; i < list.size(); ++i)
+                {
+                    DJV_ASSERT(list[i] == list2[i]);
+                    DJV_ASSERT(list2[i].doesExist());
+                }
+
+                // Sorting by size always gets information from the file
+                // system.
+                options.sort = File::DirectoryListSort::Size;
+                options.reverseSort = true;
+                list2 = File::directoryList(path, options);
+                DJV_ASSERT("shot.0001-0003,0005,0010.exr" == list2[0].getFileName(Math::Frame::invalid, false));
+                DJV_ASSERT(list2[0].doesExist());
+            }
         }
 
         void FileInfoTest::_serialize()
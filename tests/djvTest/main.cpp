@@ -13,6 +13,7 @@
 #include <djvCoreTest/RapidJSONTest.h>
 #include <djvCoreTest/StringFormatTest.h>
 #include <djvCoreTest/StringTest.h>
+#include <djvCoreTest/ThreadPoolTest.h>
 #include <djvCoreTest/TimeTest.h>
 #include <djvCoreTest/UIDTest.h>
 #include <djvCoreTest/UndoStackTest.h>
@@ -46,6 +47,8 @@
 #include <djvSystemTest/TimerTest.h>
 
 #include <djvImageTest/ColorTest.h>
+#include <djvImageTest/ConvertTest.h>
+#include <djvImageTest/DataPoolTest.h>
 #include <djvImageTest/DataTest.h>
 #include <djvImageTest/InfoTest.h>
 #include <djvImageTest/TagsTest.h>
@@ -54,7 +57,10 @@
 #include <djvAudioTest/AudioSystemTest.h>
 #include <djvAudioTest/DataTest.h>
 #include <djvAudioTest/InfoTest.h>
+#include <djvAudioTest/ResampleTest.h>
+#include <djvAudioTest/RingBufferTest.h>
 #include <djvAudioTest/TypeTest.h>
+#include <djvAudioTest/WaveformTest.h>
 
 #include <djvGeomTest/ShapeTest.h>
 #include <djvGeomTest/TriangleMeshTest.h>
@@ -90,6 +96,7 @@
 #include <djvAVTest/SpeedTest.h>
 #include <djvAVTest/ThumbnailSystemTest.h>
 #include <djvAVTest/TimeTest.h>
+#include <djvAVTest/WaveformSystemTest.h>
 #if defined(FFmpeg_FOUND)
 #include <djvAVTest/FFmpegTest.h>
 #endif // FFmpeg_FOUND
@@ -157,6 +164,7 @@ int main(int argc, char ** argv)
         tests.emplace_back(new CoreTest::RapidJSONTest(tempPath, context));
         tests.emplace_back(new CoreTest::StringFormatTest(tempPath, context));
         tests.emplace_back(new CoreTest::StringTest(tempPath, context));
+        tests.emplace_back(new CoreTest::ThreadPoolTest(tempPath, context));
         tests.emplace_back(new CoreTest::TimeTest(tempPath, context));
         tests.emplace_back(new CoreTest::UIDTest(tempPath, context));
         tests.emplace_back(new CoreTest::UndoStackTest(tempPath, context));
@@ -190,6 +198,8 @@ int main(int argc, char ** argv)
         tests.emplace_back(new SystemTest::TimerTest(tempPath, context));
 
         tests.emplace_back(new ImageTest::ColorTest(tempPath, context));
+        tests.emplace_back(new ImageTest::ConvertTest(tempPath, context));
+        tests.emplace_back(new ImageTest::DataPoolTest(tempPath, context));
         tests.emplace_back(new ImageTest::DataTest(tempPath, context));
         tests.emplace_back(new ImageTest::InfoTest(tempPath, context));
         tests.emplace_back(new ImageTest::TypeTest(tempPath, context));
@@ -198,7 +208,10 @@ int main(int argc, char ** argv)
         tests.emplace_back(new AudioTest::AudioSystemTest(tempPath, context));
         tests.emplace_back(new AudioTest::DataTest(tempPath, context));
         tests.emplace_back(new AudioTest::InfoTest(tempPath, context));
+        tests.emplace_back(new AudioTest::ResampleTest(tempPath, context));
+        tests.emplace_back(new AudioTest::RingBufferTest(tempPath, context));
         tests.emplace_back(new AudioTest::TypeTest(tempPath, context));
+        tests.emplace_back(new AudioTest::WaveformTest(tempPath, context));
 
         tests.emplace_back(new GeomTest::ShapeTest(tempPath, context));
         tests.emplace_back(new GeomTest::TriangleMeshTest(tempPath, context));
@@ -234,6 +247,7 @@ int main(int argc, char ** argv)
         tests.emplace_back(new AVTest::SpeedTest(tempPath, context));
         tests.emplace_back(new AVTest::ThumbnailSystemTest(tempPath, context));
         tests.emplace_back(new AVTest::TimeTest(tempPath, context));
+        tests.emplace_back(new AVTest::WaveformSystemTest(tempPath, context));
 #if defined(FFmpeg_FOUND)
         tests.emplace_back(new AVTest::FFmpegTest(tempPath, context));
 #endif // FFmpeg_FOUND
@@ -20,6 +20,8 @@
 
 #include <djvSystem/Context.h>
 
+#include <thread>
+
 using namespace djv::Core;
 using namespace djv::ViewApp;
 
@@ -164,17 +166,17 @@ namespace djv
                 info.video.push_back(imageInfo);
                 auto io = context->getSystemT<AV::IO::IOSystem>();
                 auto write = io->write(value, info);
+                auto& writeQueue = write->getVideoQueue();
+                const auto& sequence = value.getSequence();
+                const size_t size = sequence.getFrameCount() > 1 ? sequence.getFrameCount() : 1;
+                for (size_t i = 0; i < size; ++i)
                 {
-                    std::lock_guard<std::mutex> lock(write->getMutex());
-                    auto& writeQueue = write->getVideoQueue();
-                    const auto& sequence = value.getSequence();
-                    const size_t size = sequence.getFrameCount() > 1 ? sequence.getFrameCount() : 1;
-                    for (size_t i = 0; i < size; ++i)
+                    while (!writeQueue.addFrame(AV::IO::VideoFrame(i, image)))
                     {
-                        writeQueue.addFrame(AV::IO::VideoFrame(i, image));
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
                     }
-                    writeQueue.setFinished(true);
                 }
+                writeQueue.setFinished(true);
                 while (write->isRunning())
                 {}
             }